@@ -0,0 +1,102 @@
+/*     Copyright 2019 Diligent Graphics LLC
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Asynchronous debug message output
+
+#include "../../Primitives/interface/DebugOutput.h"
+
+namespace Diligent
+{
+
+/// Asynchronous debug output attributes
+struct AsyncDebugOutputAttribs
+{
+    /// Callback that receives messages on the flush thread. If null, the debug
+    /// message callback that is active when async output is enabled is used.
+    DebugMessageCallbackType Callback = nullptr;
+
+    /// Maximum number of messages that may wait in the queue. Must be a power of two.
+    /// When the queue is full, new messages are dropped.
+    Uint32 QueueSize = 1024;
+
+    /// Maximum message length, including the terminating null. Longer messages are truncated.
+    Uint32 MaxMessageLength = 512;
+
+    /// Maximum number of messages per second accepted from all threads. Zero means no limit.
+    Uint32 MaxMessagesPerSecond = 0;
+
+    /// Whether consecutive identical messages should be collapsed into a single
+    /// message followed by the repetition count.
+    bool DeduplicateMessages = true;
+
+    /// Time interval, in milliseconds, after which the flush thread wakes up
+    /// even if it was not notified about new messages.
+    Uint32 FlushIntervalMs = 10;
+};
+
+
+/// Counters of the asynchronous debug output
+struct AsyncDebugOutputStats
+{
+    /// Number of messages accepted into the queue
+    Uint64 NumQueuedMessages       = 0;
+
+    /// Number of messages dropped because the queue was full
+    Uint64 NumDroppedMessages      = 0;
+
+    /// Number of messages rejected by the rate limiter
+    Uint64 NumRateLimitedMessages  = 0;
+
+    /// Number of messages collapsed by deduplication
+    Uint64 NumDuplicateMessages    = 0;
+};
+
+
+/// Replaces the debug message callback with the one that copies messages into a
+/// bounded lock-free queue and returns immediately. The messages are delivered to the
+/// original callback by the background flush thread.
+
+/// \note Fatal errors are always delivered synchronously after all queued messages
+///       have been flushed, because they are immediately followed by an exception.
+///
+///       As DebugMessageCallback, asynchronous output needs to be enabled for
+///       every executable module that wants to use it.
+void EnableAsyncDebugOutput(const AsyncDebugOutputAttribs& Attribs);
+
+/// Flushes all queued messages, stops the flush thread and restores the original debug message callback.
+
+/// \note The function waits until other threads that are outputting messages at the time
+///       of the call are finished. It must not be called from the message callback, and
+///       must not be called concurrently with EnableAsyncDebugOutput().
+void DisableAsyncDebugOutput();
+
+/// Blocks until all messages queued before the call have been delivered to the callback.
+void FlushAsyncDebugOutput();
+
+/// Returns asynchronous debug output counters.
+AsyncDebugOutputStats GetAsyncDebugOutputStats();
+
+}
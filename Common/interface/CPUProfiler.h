@@ -0,0 +1,118 @@
+/*     Copyright 2019 Diligent Graphics LLC
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Hierarchical CPU profiler
+
+// The profiler is only compiled when DILIGENT_CPU_PROFILER macro is defined
+// (see DILIGENT_ENABLE_CPU_PROFILER CMake option). Otherwise all CPU_PROFILE_* macros
+// expand to nothing and the profiler adds no code and no data to the binaries.
+
+#ifdef DILIGENT_CPU_PROFILER
+
+#include "../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Low-overhead hierarchical CPU profiler
+
+/// Every thread records events into its own fixed-size buffer that is never written by any
+/// other thread, so recording a marker does not take any locks. Events are only recorded while
+/// the capture is active (between BeginCapture() and EndCapture()). When the thread buffer
+/// is full, new events are dropped until the next capture begins.
+class CPUProfiler
+{
+public:
+    /// Maximum number of events a single thread can record during one capture
+    static constexpr Uint32 MaxEventsPerThread = 1 << 16;
+
+    /// Starts a new capture. Events recorded by all threads during the previous capture are discarded.
+    static void BeginCapture();
+
+    /// Stops the capture. Recorded events remain available until the next capture begins.
+    static void EndCapture();
+
+    static bool IsCapturing();
+
+    /// Marks the frame boundary. The method is called by IDeviceContext::FinishFrame()
+    /// of the immediate context, so applications do not need to call it directly.
+    static void MarkFrame();
+
+    /// Returns the number of frames that have been marked since the capture began.
+    static Uint32 GetCapturedFrameCount();
+
+    /// Writes the events recorded by all threads during the last capture in Chrome
+    /// trace event format (the file can be loaded by chrome://tracing).
+
+    /// \note The method must not be called while the capture is active.
+    static void GetChromeTrace(String& Trace);
+
+    /// Saves the Chrome trace of the last capture to the file. Returns false if the file could not be written.
+    static bool SaveChromeTrace(const Char* FilePath);
+
+    /// Returns the current time in nanoseconds
+    static Uint64 GetTimestamp();
+
+    /// Records the event. Name must point to a string with static storage duration (e.g. string literal).
+    static void RecordEvent(const Char* Name, Uint64 BeginTime, Uint64 EndTime);
+
+    /// RAII marker that records the event spanning its life time
+    class ScopedMarker
+    {
+    public:
+        explicit ScopedMarker(const Char* Name)noexcept;
+        ~ScopedMarker();
+
+        ScopedMarker             (const ScopedMarker&) = delete;
+        ScopedMarker& operator = (const ScopedMarker&) = delete;
+
+    private:
+        const Char* const m_Name;
+        Uint64            m_BeginTime;
+    };
+};
+
+}
+
+#define CPU_PROFILE_CONCAT_IMPL(x, y) x##y
+#define CPU_PROFILE_CONCAT(x, y) CPU_PROFILE_CONCAT_IMPL(x, y)
+
+/// Records the event spanning the remainder of the enclosing scope. Name must be a string literal.
+#define CPU_PROFILE_SCOPE(Name) Diligent::CPUProfiler::ScopedMarker CPU_PROFILE_CONCAT(_CPUProfileMarker, __LINE__){Name}
+
+/// Records the event spanning the remainder of the enclosing function
+#define CPU_PROFILE_FUNCTION() CPU_PROFILE_SCOPE(__FUNCTION__)
+
+/// Marks the frame boundary
+#define CPU_PROFILE_FRAME_BOUNDARY() Diligent::CPUProfiler::MarkFrame()
+
+#else
+
+#define CPU_PROFILE_SCOPE(Name)       do{}while(false)
+#define CPU_PROFILE_FUNCTION()        do{}while(false)
+#define CPU_PROFILE_FRAME_BOUNDARY()  do{}while(false)
+
+#endif
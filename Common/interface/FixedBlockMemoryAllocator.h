@@ -60,7 +60,20 @@ public:
 
     /// Releases memory
     virtual void Free(void *Ptr)override final;
-    
+
+    /// Allocator statistics
+    struct Stats
+    {
+        size_t BlockSize              = 0; ///< Size of one block, in bytes
+        size_t NumBlocksInPage        = 0; ///< Number of blocks in one page
+        size_t NumPages               = 0; ///< Number of memory pages allocated from the raw allocator
+        size_t NumAllocatedBlocks     = 0; ///< Number of blocks currently allocated
+        size_t PeakNumAllocatedBlocks = 0; ///< Maximum number of blocks that were allocated at the same time
+    };
+
+    /// Returns allocator statistics
+    Stats GetStats();
+
 private:
     FixedBlockMemoryAllocator             (const FixedBlockMemoryAllocator&) = delete;
     FixedBlockMemoryAllocator             (FixedBlockMemoryAllocator&&)      = delete;
@@ -197,7 +210,9 @@ private:
         }
 
         bool HasSpace()const{return m_NumFreeBlocks>0;}
-        bool HasAllocations()const{return m_NumFreeBlocks<m_NumInitializedBlocks;}
+        // Blocks that have not been initialized yet are free as well
+        bool HasAllocations()const{return m_pOwnerAllocator != nullptr && m_NumFreeBlocks < m_pOwnerAllocator->m_NumBlocksInPage;}
+        const void* GetPageStart()const{return m_pPageStart;}
     private:
 
         MemoryPage(const MemoryPage&)=delete;
@@ -213,8 +228,13 @@ private:
 
     std::vector<MemoryPage, STDAllocatorRawMem<MemoryPage> > m_PagePool;
     std::unordered_set<size_t, std::hash<size_t>, std::equal_to<size_t>, STDAllocatorRawMem<size_t> > m_AvailablePages;
-    typedef std::pair<void* const, size_t> AddrToPageIdMapElem;
-    std::unordered_map<void*, size_t, std::hash<void*>, std::equal_to<void*>, STDAllocatorRawMem<AddrToPageIdMapElem> > m_AddrToPageId;
+    // Page start addresses sorted in ascending order. Pages are never released, so the page that owns
+    // a block can be found by binary search without keeping a per-allocation map.
+    typedef std::pair<const Uint8*, size_t> PageStartToIdElem;
+    std::vector<PageStartToIdElem, STDAllocatorRawMem<PageStartToIdElem> > m_SortedPageStarts;
+
+    size_t m_NumAllocatedBlocks     = 0;
+    size_t m_PeakNumAllocatedBlocks = 0;
 
     std::mutex m_Mutex;
 
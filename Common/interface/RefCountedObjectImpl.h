@@ -26,6 +26,8 @@
 /// \file
 /// Implementation of the template base class for reference counting objects
 
+#include <new>
+
 #include "../../Primitives/interface/Object.h"
 #include "../../Primitives/interface/MemoryAllocator.h"
 #include "../../Platforms/interface/Atomics.h"
@@ -36,6 +38,11 @@
 namespace Diligent
 {
 
+/// Returns the process-wide pool that reference counters of objects created by MakeNewRCObj
+/// with a custom allocator are allocated from. The pool is never destroyed, so weak references
+/// may safely outlive the objects, their allocators and the render device.
+IMemoryAllocator& GetRefCountersAllocator();
+
 // This class controls the lifetime of a refcounted object
 class RefCountersImpl final : public IReferenceCounters
 {
@@ -152,50 +159,41 @@ public:
         if( m_ObjectState != ObjectState::Alive)
             return; // Early exit
 
-        // It is essential to INCREMENT REF COUNTER while HOLDING THE LOCK to make sure that 
-        // StrongRefCnt > 1 guarantees that the object is alive.
-
-        // If other thread started deleting the object in ReleaseStrongRef(), then m_lNumStrongReferences==0
-        // We must make sure only one thread is allowed to increment the counter to guarantee that if StrongRefCnt > 1,
-        // there is at least one real strong reference left. Otherwise the following scenario may occur:
+        // The strong reference counter is only incremented if it is not zero. Once the counter
+        // reaches zero, it can never be incremented again, so the thread that decremented it
+        // is guaranteed to be the only one that destroys the object (see TryDestroyObject()).
+        // If the counter is not zero, there is at least one real strong reference left and the
+        // object is alive. No lock is required.
         //
         //                                      m_lNumStrongReferences == 1
-        //                                                                              
-        //    Thread 1 - ReleaseStrongRef()    |     Thread 2 - GetObject()        |     Thread 3 - GetObject()
-        //                                     |                                   |
-        //  - Decrement m_lNumStrongReferences | -Increment m_lNumStrongReferences | -Increment m_lNumStrongReferences
-        //  - Read RefCount == 0               | -Read StrongRefCnt==1             | -Read StrongRefCnt==2 
-        //    Destroy the object               |                                   | -Return reference to the soon
-        //                                     |                                   |  to expire object
-        //     
-        ThreadingTools::LockHelper Lock(m_LockFlag);
-
-        auto StrongRefCnt = Atomics::AtomicIncrement(m_lNumStrongReferences);
-            
-        // Checking if m_ObjectState == ObjectState::Alive only is not reliable:
         //
-        //           This thread                    |          Another thread
-        //                                          |                                         
-        //   1. Acquire the lock                    |                                         
-        //                                          |    1. Decrement m_lNumStrongReferences  
-        //   2. Increment m_lNumStrongReferences    |    2. Test RefCount==0                  
-        //   3. Read StrongRefCnt == 1              |    3. Start destroying the object       
-        //      m_ObjectState == ObjectState::Alive |
-        //   4. DO NOT return the reference to      |    4. Wait for the lock, m_ObjectState == ObjectState::Alive
-        //      the object                          |
-        //   5. Decrement m_lNumStrongReferences    |
-        //                                          |    5. Destroy the object
-
-        if( m_ObjectState == ObjectState::Alive && StrongRefCnt > 1 )
+        //    Thread 1 - ReleaseStrongRef()    |     Thread 2 - GetObject()
+        //                                     |
+        //  - Decrement m_lNumStrongReferences | - Read m_lNumStrongReferences == 1
+        //  - Read RefCount == 0               | - Fail to replace 1 with 2, read 0
+        //    Destroy the object               | - Do not return the reference
+        //
+        auto StrongRefCnt = static_cast<Atomics::Long>(m_lNumStrongReferences);
+        for(;;)
         {
-            VERIFY( m_ObjectWrapperBuffer[0] != 0 && m_ObjectWrapperBuffer[1] != 0, "Object wrapper is not initialized");
-            // QueryInterface() must not lock the object, or a deadlock happens.
-            // The only other two methods that lock the object are ReleaseStrongRef()
-            // and ReleaseWeakRef(), which are never called by QueryInterface()
-            auto *pWrapper = reinterpret_cast<ObjectWrapperBase*>(m_ObjectWrapperBuffer);
-            pWrapper->QueryInterface(IID_Unknown, ppObject);
+            if (StrongRefCnt <= 0)
+                return;
+
+            auto PrevRefCnt = Atomics::AtomicCompareExchange(m_lNumStrongReferences, StrongRefCnt + 1, StrongRefCnt);
+            if (PrevRefCnt == StrongRefCnt)
+                break;
+
+            StrongRefCnt = PrevRefCnt;
         }
-        Atomics::AtomicDecrement(m_lNumStrongReferences);
+
+        // We now hold a strong reference, so the object cannot be destroyed by another thread
+        VERIFY( m_ObjectState == ObjectState::Alive, "Object is expected to be alive" );
+        VERIFY( m_ObjectWrapperBuffer[0] != 0 && m_ObjectWrapperBuffer[1] != 0, "Object wrapper is not initialized");
+        auto *pWrapper = reinterpret_cast<ObjectWrapperBase*>(m_ObjectWrapperBuffer);
+        pWrapper->QueryInterface(IID_Unknown, ppObject);
+
+        // If QueryInterface() failed, this may be the last reference
+        ReleaseStrongRef();
     }
 
     inline virtual CounterValueType GetNumStrongRefs()const override final
@@ -260,6 +258,27 @@ private:
         AllocatorType * const m_pAllocator;
     };
 
+    // Wrapper for the object that resides in the same memory block as the reference
+    // counters. The block is released when reference counters are destroyed.
+    template<typename ObjectType>
+    class EmbeddedObjectWrapper : public ObjectWrapperBase
+    {
+    public:
+        EmbeddedObjectWrapper(ObjectType *pObject)noexcept : 
+            m_pObject(pObject)
+        {}
+        virtual void DestroyObject()override final
+        {
+            m_pObject->~ObjectType();
+        }
+        virtual void QueryInterface(const INTERFACE_ID& iid, IObject** ppInterface)override final
+        {
+            return m_pObject->QueryInterface(iid, ppInterface);
+        }
+    private:
+        ObjectType* const m_pObject;
+    };
+
     template<typename ObjectType, typename AllocatorType>
     void Attach(ObjectType *pObject, AllocatorType *pAllocator)
     {
@@ -269,6 +288,25 @@ private:
         m_ObjectState = ObjectState::Alive;
     }
 
+    template<typename ObjectType>
+    void AttachEmbedded(ObjectType *pObject)
+    {
+        VERIFY(m_ObjectState == ObjectState::NotInitialized, "Object has already been attached");
+        static_assert(sizeof(EmbeddedObjectWrapper<ObjectType>) <= sizeof(m_ObjectWrapperBuffer), "Object wrapper buffer is too small");
+        new(m_ObjectWrapperBuffer) EmbeddedObjectWrapper<ObjectType>(pObject);
+        m_ObjectState = ObjectState::Alive;
+    }
+
+    void SetEmbeddedMemory(Uint8* pMemory)
+    {
+        m_pEmbeddedMemory = pMemory;
+    }
+
+    void SetCountersAllocator(IMemoryAllocator* pAllocator)
+    {
+        m_pCountersAllocator = pAllocator;
+    }
+
     void TryDestroyObject()
     {
         // Since RefCount==0, there are no more strong references and the only place 
@@ -429,6 +467,17 @@ private:
             // zero only after acquiring the lock. So if m_lNumWeakReferences==0, no 
             // weak reference-related code may be running
 
+            // If the object resides in the same memory block as the reference counters, the block
+            // must not be released while the object destructor is running (which may happen if the
+            // destructor releases the last weak reference). Keep the counters alive with a weak
+            // reference that is released after the object has been destroyed.
+            const bool IsEmbedded = m_pEmbeddedMemory != nullptr;
+            if (IsEmbedded)
+            {
+                Atomics::AtomicIncrement(m_lNumWeakReferences);
+                bDestroyThis = false;
+            }
+
 
             // We must explicitly unlock the object now to avoid deadlocks. Also, 
             // if this is deleted, this->m_LockFlag will expire, which will cause 
@@ -442,12 +491,30 @@ private:
             // see comments in ~ControlledObjectType()
             if( bDestroyThis )
                 SelfDestroy();
+            else if (IsEmbedded)
+                ReleaseWeakRef();
         }
     }
 
     void SelfDestroy()
     {
-        delete this;
+        if (m_pEmbeddedMemory != nullptr)
+        {
+            // Reference counters were constructed in the same memory block as the object
+            auto* pMemory = m_pEmbeddedMemory;
+            this->~RefCountersImpl();
+            delete[] pMemory;
+        }
+        else
+        {
+            // Reference counters were allocated from the counters pool. The pool is stored
+            // in the counters, so that the block is returned to the pool it came from even if
+            // the last reference is released by another module.
+            VERIFY_EXPR(m_pCountersAllocator != nullptr);
+            auto* pAllocator = m_pCountersAllocator;
+            this->~RefCountersImpl();
+            pAllocator->Free(this);
+        }
     }
 
     ~RefCountersImpl()
@@ -474,9 +541,25 @@ private:
         Destroyed
     };
     volatile ObjectState m_ObjectState = ObjectState::NotInitialized;
+
+    // Memory block that holds both the object and the reference counters (see MakeNewRCObj)
+    Uint8* m_pEmbeddedMemory = nullptr;
+    // Pool the reference counters were allocated from if they are not embedded
+    IMemoryAllocator* m_pCountersAllocator = nullptr;
 };
 
 
+/// Returns the size of the memory block that MakeNewRCObj allocates for an object of the given size
+/// when the object is created without a custom allocator.
+
+/// Reference counters are placed in the same memory block right after the object, so that
+/// creating an object requires a single allocation.
+constexpr size_t GetRCObjAllocationSize(size_t ObjectSize)
+{
+    return (ObjectSize + alignof(RefCountersImpl) - 1) / alignof(RefCountersImpl) * alignof(RefCountersImpl) + sizeof(RefCountersImpl);
+}
+
+
 /// Base class for all reference counting objects
 template<typename Base>
 class RefCountedObject : public Base
@@ -569,6 +652,12 @@ protected:
         return Allocator.Free(ptr);
     }
 
+    // Placement delete is only called by MakeNewRCObj if the constructor throws an exception.
+    // The memory is released by MakeNewRCObj.
+    void operator delete(void *ptr, void *pPlace)
+    {
+    }
+
 private:
     // Operator new is private, and can only be called by MakeNewRCObj
 
@@ -583,6 +672,11 @@ private:
         return Allocator.Allocate(Size, dbgDescription, dbgFileName, dbgLineNumber);
     }
 
+    void* operator new(size_t Size, void *pPlace)
+    {
+        return pPlace;
+    }
+
 
     // Note that the type of the reference counters is RefCountersImpl,
     // not IReferenceCounters. This avoids virtual calls from
@@ -624,25 +718,32 @@ public:
     template<typename ... CtorArgTypes>
     ObjectType* operator() (CtorArgTypes&& ... CtorArgs)
     {
+#ifndef DEVELOPMENT
+        static constexpr const char* m_dvpDescription = "<Unavailable in release build>";
+        static constexpr const char* m_dvpFileName    = "<Unavailable in release build>";
+        static constexpr Int32       m_dvpLineNumber  = -1;
+#endif
         RefCountersImpl *pNewRefCounters = nullptr;
         IReferenceCounters *pRefCounters = nullptr;
         if(m_pOwner != nullptr)
             pRefCounters = m_pOwner->GetReferenceCounters();
+        else if(m_pAllocator == nullptr)
+            return CreateWithEmbeddedCounters(std::forward<CtorArgTypes>(CtorArgs)...);
         else
         {
+            // Objects allocated by a custom allocator (e.g. device objects in fixed-block pools) take 
+            // their reference counters from the process-wide counters pool. Weak references may outlive 
+            // both the object and its allocator, so the counters must not reside in the allocator's memory.
             // Constructor of RefCountersImpl class is private and only accessible
             // by methods of MakeNewRCObj
-            pNewRefCounters = new RefCountersImpl();
+            auto& CountersAllocator = GetRefCountersAllocator();
+            pNewRefCounters = new(CountersAllocator.Allocate(sizeof(RefCountersImpl), "Reference counters", __FILE__, __LINE__)) RefCountersImpl();
+            pNewRefCounters->SetCountersAllocator(&CountersAllocator);
             pRefCounters = pNewRefCounters;
         }
         ObjectType *pObj = nullptr;
         try
         {
-#ifndef DEVELOPMENT
-            static constexpr const char* m_dvpDescription = "<Unavailable in release build>";
-            static constexpr const char* m_dvpFileName    = "<Unavailable in release build>";
-            static constexpr Int32       m_dvpLineNumber  = -1;
-#endif
             // Operators new and delete of RefCountedObject are private and only accessible
             // by methods of MakeNewRCObj
             if(m_pAllocator)
@@ -662,6 +763,33 @@ public:
     }
     
 private:
+    // The object and its reference counters are allocated in the same memory block, 
+    // so that creating the object requires a single allocation. The block is released
+    // when both strong and weak reference counts reach zero.
+    template<typename ... CtorArgTypes>
+    ObjectType* CreateWithEmbeddedCounters(CtorArgTypes&& ... CtorArgs)
+    {
+        constexpr size_t RefCountersOffset = GetRCObjAllocationSize(sizeof(ObjectType)) - sizeof(RefCountersImpl);
+        auto* pMemory = new Uint8[GetRCObjAllocationSize(sizeof(ObjectType))];
+        auto* pRefCounters = new(pMemory + RefCountersOffset) RefCountersImpl();
+        pRefCounters->SetEmbeddedMemory(pMemory);
+
+        ObjectType *pObj = nullptr;
+        try
+        {
+            pObj = new(static_cast<void*>(pMemory)) ObjectType(pRefCounters, std::forward<CtorArgTypes>(CtorArgs)... );
+        }
+        catch (...)
+        {
+            // The counters have not been attached to the object yet and are destroyed directly
+            pRefCounters->~RefCountersImpl();
+            delete[] pMemory;
+            throw;
+        }
+        pRefCounters->AttachEmbedded<ObjectType>(pObj);
+        return pObj;
+    }
+
     AllocatorType* const m_pAllocator;
     IObject*       const m_pOwner;
 
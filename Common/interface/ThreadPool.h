@@ -0,0 +1,126 @@
+/*     Copyright 2019 Diligent Graphics LLC
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <future>
+#include <deque>
+#include <vector>
+#include <functional>
+
+#include "../../Platforms/Basic/interface/DebugUtilities.h"
+
+namespace ThreadingTools
+{
+
+// Fixed-size pool of worker threads that execute tasks in FIFO order.
+// Tasks that are still queued when the pool is destroyed are executed before
+// the worker threads exit, so every future returned by EnqueueTask() is eventually satisfied.
+class ThreadPool
+{
+public:
+    // Callback that is executed by every worker thread before it starts processing tasks
+    // or after it has finished. The argument is the index of the thread in the pool.
+    using ThreadCallbackType = std::function<void(unsigned int ThreadIndex)>;
+
+    explicit ThreadPool(unsigned int       NumThreads,
+                        ThreadCallbackType OnThreadStarted = nullptr,
+                        ThreadCallbackType OnThreadStopped = nullptr) :
+        m_OnThreadStarted{std::move(OnThreadStarted)},
+        m_OnThreadStopped{std::move(OnThreadStopped)}
+    {
+        VERIFY(NumThreads > 0, "Number of threads must not be 0");
+        m_Threads.reserve(NumThreads);
+        for (unsigned int i=0; i < NumThreads; ++i)
+            m_Threads.emplace_back([this, i](){WorkerThreadProc(i);});
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> Lock{m_QueueMtx};
+            m_Stop = true;
+        }
+        m_WakeUpCV.notify_all();
+        for (auto& Thread : m_Threads)
+            Thread.join();
+        VERIFY_EXPR(m_Tasks.empty());
+    }
+
+    template<typename TaskType>
+    std::future<void> EnqueueTask(TaskType&& Task)
+    {
+        std::packaged_task<void()> PackagedTask{std::forward<TaskType>(Task)};
+        auto Future = PackagedTask.get_future();
+        {
+            std::lock_guard<std::mutex> Lock{m_QueueMtx};
+            VERIFY(!m_Stop, "Enqueuing a task into a thread pool that is being destroyed");
+            m_Tasks.emplace_back(std::move(PackagedTask));
+        }
+        m_WakeUpCV.notify_one();
+        return Future;
+    }
+
+    size_t GetNumThreads()const { return m_Threads.size(); }
+
+private:
+    void WorkerThreadProc(unsigned int ThreadIndex)
+    {
+        if (m_OnThreadStarted)
+            m_OnThreadStarted(ThreadIndex);
+
+        for (;;)
+        {
+            std::packaged_task<void()> Task;
+            {
+                std::unique_lock<std::mutex> Lock{m_QueueMtx};
+                m_WakeUpCV.wait(Lock, [this]{return m_Stop || !m_Tasks.empty();});
+                if (m_Tasks.empty())
+                    break; // m_Stop is set and there are no more tasks
+                Task = std::move(m_Tasks.front());
+                m_Tasks.pop_front();
+            }
+            // Exceptions are captured by the packaged task and rethrown by future::get()
+            Task();
+        }
+
+        if (m_OnThreadStopped)
+            m_OnThreadStopped(ThreadIndex);
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator = (const ThreadPool&) = delete;
+
+    std::mutex                             m_QueueMtx;
+    std::condition_variable                m_WakeUpCV;
+    std::deque<std::packaged_task<void()>> m_Tasks;
+    bool                                   m_Stop = false;
+    const ThreadCallbackType               m_OnThreadStarted;
+    const ThreadCallbackType               m_OnThreadStopped;
+    std::vector<std::thread>               m_Threads;
+};
+
+}
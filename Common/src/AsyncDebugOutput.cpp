@@ -0,0 +1,495 @@
+/*     Copyright 2019 Diligent Graphics LLC
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "AsyncDebugOutput.h"
+
+#include <atomic>
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <cstring>
+
+namespace Diligent
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        // Asynchronous debug output with bounded multi-producer single-consumer queue
+        // (see http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue).
+        class AsyncDebugOutput
+        {
+        public:
+            AsyncDebugOutput(const AsyncDebugOutputAttribs& Attribs, DebugMessageCallbackType Sink) :
+                m_Sink                {Sink},
+                m_QueueMask           {Attribs.QueueSize - 1},
+                m_MaxMessageLength    {Attribs.MaxMessageLength},
+                m_MaxMessagesPerSecond{Attribs.MaxMessagesPerSecond},
+                m_DeduplicateMessages {Attribs.DeduplicateMessages},
+                m_FlushInterval       {Attribs.FlushIntervalMs},
+                m_Slots               (Attribs.QueueSize),
+                m_MessageData         (size_t{Attribs.QueueSize} * size_t{Attribs.MaxMessageLength})
+            {
+                for (size_t i = 0; i < m_Slots.size(); ++i)
+                {
+                    m_Slots[i].Sequence.store(i, std::memory_order_relaxed);
+                    m_Slots[i].Message = &m_MessageData[i * m_MaxMessageLength];
+                }
+                m_RateWindowStart.store(GetTimeMs());
+                m_FlushThread = std::thread{[this](){FlushThreadProc();}};
+            }
+
+            ~AsyncDebugOutput()
+            {
+                {
+                    std::lock_guard<std::mutex> Lock{m_FlushMtx};
+                    m_StopFlushThread = true;
+                }
+                m_WakeUpCV.notify_one();
+                m_FlushThread.join();
+            }
+
+            AsyncDebugOutput             (const AsyncDebugOutput&) = delete;
+            AsyncDebugOutput& operator = (const AsyncDebugOutput&) = delete;
+
+            void Push(DebugMessageSeverity Severity, const Char* Message, const char* Function, const char* File, int Line)
+            {
+                if (Severity == DebugMessageSeverity::FatalError)
+                {
+                    // Fatal error is followed by an exception, so the message must be
+                    // delivered before the callback returns
+                    if (std::this_thread::get_id() == m_FlushThread.get_id())
+                    {
+                        // The error has been raised by the sink called by the flush thread,
+                        // which already holds the sink mutex
+                        m_Sink(Severity, Message, Function, File, Line);
+                        return;
+                    }
+                    Flush();
+                    std::lock_guard<std::mutex> Lock{m_SinkMtx};
+                    m_Sink(Severity, Message, Function, File, Line);
+                    return;
+                }
+
+                if (m_MaxMessagesPerSecond != 0 && !CheckRateLimit())
+                {
+                    m_NumRateLimitedMessages.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+
+                auto Pos = m_EnqueuePos.load(std::memory_order_relaxed);
+                MessageSlot* pSlot = nullptr;
+                for (;;)
+                {
+                    pSlot = &m_Slots[Pos & m_QueueMask];
+                    const auto Seq = pSlot->Sequence.load(std::memory_order_acquire);
+                    const auto Diff = static_cast<std::intptr_t>(Seq) - static_cast<std::intptr_t>(Pos);
+                    if (Diff == 0)
+                    {
+                        if (m_EnqueuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+                            break;
+                    }
+                    else if (Diff < 0)
+                    {
+                        // The queue is full
+                        m_NumDroppedMessages.fetch_add(1, std::memory_order_relaxed);
+                        return;
+                    }
+                    else
+                    {
+                        Pos = m_EnqueuePos.load(std::memory_order_relaxed);
+                    }
+                }
+
+                pSlot->Severity = Severity;
+                pSlot->Line     = Line;
+                CopyString(pSlot->Message,  m_MaxMessageLength,        Message);
+                CopyString(pSlot->Function, sizeof(pSlot->Function), Function);
+                CopyString(pSlot->File,     sizeof(pSlot->File),     File);
+                pSlot->HasFunction = Function != nullptr;
+                pSlot->HasFile     = File     != nullptr;
+                // Publish the message
+                pSlot->Sequence.store(Pos + 1, std::memory_order_release);
+                m_NumPublishedMessages.fetch_add(1, std::memory_order_release);
+                m_NumQueuedMessages.fetch_add(1, std::memory_order_relaxed);
+
+                m_WakeUpCV.notify_one();
+            }
+
+            void Flush()
+            {
+                if (std::this_thread::get_id() == m_FlushThread.get_id())
+                    return;
+
+                // Slots that have been reserved, but not published yet are not counted: the thread that
+                // reserved the slot may be the one that is waiting. Messages are dequeued in the order
+                // of their slots, so the queue is flushed when the number of dequeued messages reaches
+                // the number of messages published before the call.
+                const auto TargetPos = m_NumPublishedMessages.load(std::memory_order_acquire);
+                std::unique_lock<std::mutex> Lock{m_FlushMtx};
+                if (m_DequeuePos.load(std::memory_order_acquire) >= TargetPos)
+                    return;
+                m_FlushTarget    = std::max(m_FlushTarget, TargetPos);
+                m_FlushRequested = true;
+                m_WakeUpCV.notify_one();
+                m_FlushedCV.wait(Lock, [&](){return m_DequeuePos.load(std::memory_order_acquire) >= TargetPos;});
+            }
+
+            AsyncDebugOutputStats GetStats()const
+            {
+                AsyncDebugOutputStats Stats;
+                Stats.NumQueuedMessages      = m_NumQueuedMessages.load(std::memory_order_relaxed);
+                Stats.NumDroppedMessages     = m_NumDroppedMessages.load(std::memory_order_relaxed);
+                Stats.NumRateLimitedMessages = m_NumRateLimitedMessages.load(std::memory_order_relaxed);
+                Stats.NumDuplicateMessages   = m_NumDuplicateMessages.load(std::memory_order_relaxed);
+                return Stats;
+            }
+
+        private:
+            struct MessageSlot
+            {
+                std::atomic<size_t>  Sequence{0};
+                DebugMessageSeverity Severity = DebugMessageSeverity::Info;
+                int                  Line     = 0;
+                bool                 HasFunction = false;
+                bool                 HasFile     = false;
+                Char*                Message  = nullptr;
+                char                 Function[64];
+                char                 File[64];
+            };
+
+            static void CopyString(Char* Dst, size_t DstSize, const Char* Src)
+            {
+                if (Src == nullptr)
+                {
+                    Dst[0] = 0;
+                    return;
+                }
+                auto Len = strlen(Src);
+                if (Len >= DstSize)
+                    Len = DstSize - 1;
+                memcpy(Dst, Src, Len);
+                Dst[Len] = 0;
+            }
+
+            static Uint64 GetTimeMs()
+            {
+                return static_cast<Uint64>(std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now().time_since_epoch()).count());
+            }
+
+            bool CheckRateLimit()
+            {
+                // The limiter is approximate: counters of two threads that start new
+                // window simultaneously may be reset twice, which is acceptable.
+                const auto CurrTime = GetTimeMs();
+                auto WindowStart = m_RateWindowStart.load(std::memory_order_relaxed);
+                if (CurrTime - WindowStart >= 1000)
+                {
+                    if (m_RateWindowStart.compare_exchange_strong(WindowStart, CurrTime, std::memory_order_relaxed))
+                        m_RateWindowCount.store(0, std::memory_order_relaxed);
+                }
+                return m_RateWindowCount.fetch_add(1, std::memory_order_relaxed) < m_MaxMessagesPerSecond;
+            }
+
+            bool TryDequeue(MessageSlot*& pSlot)
+            {
+                const auto Pos = m_DequeuePos.load(std::memory_order_relaxed);
+                pSlot = &m_Slots[Pos & m_QueueMask];
+                const auto Seq = pSlot->Sequence.load(std::memory_order_acquire);
+                return Seq == Pos + 1;
+            }
+
+            void ReleaseSlot(MessageSlot& Slot)
+            {
+                const auto Pos = m_DequeuePos.load(std::memory_order_relaxed);
+                Slot.Sequence.store(Pos + m_QueueMask + 1, std::memory_order_release);
+                m_DequeuePos.store(Pos + 1, std::memory_order_release);
+            }
+
+            void CallSink(DebugMessageSeverity Severity, const Char* Message, const char* Function, const char* File, int Line)
+            {
+                try
+                {
+                    m_Sink(Severity, Message, Function, File, Line);
+                }
+                catch (...)
+                {
+                    // The sink may raise a fatal error, but the exception can't be
+                    // propagated from the flush thread
+                }
+            }
+
+            void FlushRepeatCount()
+            {
+                if (m_RepeatCount == 0)
+                    return;
+
+                auto Msg = FormatString("Last message repeated ", m_RepeatCount, (m_RepeatCount > 1 ? " times" : " time"));
+                CallSink(m_LastSeverity, Msg.c_str(), nullptr, nullptr, 0);
+                m_RepeatCount = 0;
+            }
+
+            void Deliver(const MessageSlot& Slot)
+            {
+                if (m_DeduplicateMessages)
+                {
+                    if (Slot.Severity == m_LastSeverity && Slot.Line == m_LastLine &&
+                        m_LastMessage == Slot.Message && m_LastFunction == Slot.Function && m_LastFile == Slot.File)
+                    {
+                        ++m_RepeatCount;
+                        m_NumDuplicateMessages.fetch_add(1, std::memory_order_relaxed);
+                        return;
+                    }
+
+                    FlushRepeatCount();
+                    m_LastSeverity = Slot.Severity;
+                    m_LastLine     = Slot.Line;
+                    m_LastMessage  = Slot.Message;
+                    m_LastFunction = Slot.Function;
+                    m_LastFile     = Slot.File;
+                }
+
+                CallSink(Slot.Severity, Slot.Message, Slot.HasFunction ? Slot.Function : nullptr, Slot.HasFile ? Slot.File : nullptr, Slot.Line);
+            }
+
+            void ProcessMessages()
+            {
+                std::lock_guard<std::mutex> SinkLock{m_SinkMtx};
+
+                MessageSlot* pSlot = nullptr;
+                while (TryDequeue(pSlot))
+                {
+                    Deliver(*pSlot);
+                    ReleaseSlot(*pSlot);
+                }
+
+                const auto NumDropped = m_NumDroppedMessages.load(std::memory_order_relaxed);
+                if (NumDropped != m_ReportedDroppedMessages)
+                {
+                    FlushRepeatCount();
+                    auto Msg = FormatString(NumDropped - m_ReportedDroppedMessages, " debug message(s) have been dropped because the async output queue is full");
+                    CallSink(DebugMessageSeverity::Warning, Msg.c_str(), nullptr, nullptr, 0);
+                    m_ReportedDroppedMessages = NumDropped;
+                }
+            }
+
+            void FlushThreadProc()
+            {
+                bool FlushPending = false;
+                for (;;)
+                {
+                    bool Stop           = false;
+                    bool FlushRequested = false;
+                    {
+                        std::unique_lock<std::mutex> Lock{m_FlushMtx};
+                        // While a flush is pending, the thread does not sleep and keeps processing
+                        // messages until the slots that precede the flush target are published
+                        if (!FlushPending)
+                            m_WakeUpCV.wait_for(Lock, std::chrono::milliseconds{m_FlushInterval}, [this](){return m_StopFlushThread || m_FlushRequested;});
+                        Stop           = m_StopFlushThread;
+                        FlushRequested = m_FlushRequested;
+                    }
+
+                    ProcessMessages();
+
+                    if (Stop || FlushRequested)
+                    {
+                        std::lock_guard<std::mutex> SinkLock{m_SinkMtx};
+                        FlushRepeatCount();
+                    }
+
+                    FlushPending = false;
+                    if (FlushRequested)
+                    {
+                        {
+                            std::lock_guard<std::mutex> Lock{m_FlushMtx};
+                            if (m_DequeuePos.load(std::memory_order_acquire) >= m_FlushTarget)
+                                m_FlushRequested = false;
+                            else
+                                FlushPending = true;
+                        }
+                        // Waiting threads are notified after every pass as each of them
+                        // waits for its own target
+                        m_FlushedCV.notify_all();
+                        if (FlushPending)
+                            std::this_thread::yield();
+                    }
+
+                    if (Stop)
+                        break;
+                }
+            }
+
+            const DebugMessageCallbackType m_Sink;
+            const size_t                   m_QueueMask;
+            const Uint32                   m_MaxMessageLength;
+            const Uint32                   m_MaxMessagesPerSecond;
+            const bool                     m_DeduplicateMessages;
+            const Uint32                   m_FlushInterval;
+
+            std::vector<MessageSlot> m_Slots;
+            std::vector<Char>        m_MessageData;
+
+            std::atomic<size_t> m_EnqueuePos{0};
+            std::atomic<size_t> m_DequeuePos{0};
+            std::atomic<size_t> m_NumPublishedMessages{0};
+
+            std::atomic<Uint64> m_RateWindowStart{0};
+            std::atomic<Uint32> m_RateWindowCount{0};
+
+            std::atomic<Uint64> m_NumQueuedMessages{0};
+            std::atomic<Uint64> m_NumDroppedMessages{0};
+            std::atomic<Uint64> m_NumRateLimitedMessages{0};
+            std::atomic<Uint64> m_NumDuplicateMessages{0};
+
+            // Flush thread state
+            Uint64               m_ReportedDroppedMessages = 0;
+            DebugMessageSeverity m_LastSeverity = DebugMessageSeverity::Info;
+            int                  m_LastLine     = 0;
+            String               m_LastMessage;
+            String               m_LastFunction;
+            String               m_LastFile;
+            Uint32               m_RepeatCount = 0;
+
+            // Serializes calls to the sink between the flush thread and fatal errors
+            std::mutex              m_SinkMtx;
+            std::mutex              m_FlushMtx;
+            std::condition_variable m_WakeUpCV;
+            std::condition_variable m_FlushedCV;
+            bool                    m_StopFlushThread = false;
+            bool                    m_FlushRequested  = false;
+            size_t                  m_FlushTarget     = 0;
+
+            std::thread m_FlushThread;
+        };
+
+        std::unique_ptr<AsyncDebugOutput> g_pAsyncOutput;
+        std::atomic<AsyncDebugOutput*>    g_pActiveAsyncOutput{nullptr};
+        // Number of threads that are currently using the active async output object
+        std::atomic<Uint32>               g_NumActiveUsers{0};
+        DebugMessageCallbackType          g_OriginalCallback = nullptr;
+
+        // Keeps the active async output object alive while it is used. The counter is incremented
+        // before the pointer is read, so once DisableAsyncDebugOutput() has reset the pointer and
+        // observed zero users, no thread can access the object anymore.
+        class ActiveAsyncOutputRef
+        {
+        public:
+            ActiveAsyncOutputRef()
+            {
+                g_NumActiveUsers.fetch_add(1, std::memory_order_seq_cst);
+                m_pAsyncOutput = g_pActiveAsyncOutput.load(std::memory_order_seq_cst);
+            }
+
+            ~ActiveAsyncOutputRef()
+            {
+                g_NumActiveUsers.fetch_sub(1, std::memory_order_release);
+            }
+
+            ActiveAsyncOutputRef             (const ActiveAsyncOutputRef&) = delete;
+            ActiveAsyncOutputRef& operator = (const ActiveAsyncOutputRef&) = delete;
+
+            AsyncDebugOutput* operator->()const { return m_pAsyncOutput; }
+            explicit operator bool()const { return m_pAsyncOutput != nullptr; }
+
+        private:
+            AsyncDebugOutput* m_pAsyncOutput = nullptr;
+        };
+
+        void AsyncDebugMessageCallback(DebugMessageSeverity Severity, const Char* Message, const char* Function, const char* File, int Line)
+        {
+            ActiveAsyncOutputRef pAsyncOutput;
+            if (pAsyncOutput)
+                pAsyncOutput->Push(Severity, Message, Function, File, Line);
+        }
+    }
+
+    void EnableAsyncDebugOutput(const AsyncDebugOutputAttribs& Attribs)
+    {
+        if (g_pAsyncOutput)
+        {
+            LOG_WARNING_MESSAGE("Asynchronous debug output is already enabled");
+            return;
+        }
+
+        if (Attribs.QueueSize == 0 || (Attribs.QueueSize & (Attribs.QueueSize - 1)) != 0)
+        {
+            LOG_ERROR_MESSAGE("Async debug output queue size (", Attribs.QueueSize, ") must be a non-zero power of two");
+            return;
+        }
+
+        if (Attribs.MaxMessageLength < 2)
+        {
+            LOG_ERROR_MESSAGE("Max message length (", Attribs.MaxMessageLength, ") is too small");
+            return;
+        }
+
+        auto Sink = Attribs.Callback != nullptr ? Attribs.Callback : DebugMessageCallback;
+        if (Sink == nullptr)
+        {
+            // There is nowhere to deliver messages to
+            return;
+        }
+
+        g_OriginalCallback = DebugMessageCallback;
+        g_pAsyncOutput.reset(new AsyncDebugOutput{Attribs, Sink});
+        g_pActiveAsyncOutput.store(g_pAsyncOutput.get(), std::memory_order_release);
+        SetDebugMessageCallback(AsyncDebugMessageCallback);
+    }
+
+    void DisableAsyncDebugOutput()
+    {
+        if (!g_pAsyncOutput)
+            return;
+
+        SetDebugMessageCallback(g_OriginalCallback);
+        g_pActiveAsyncOutput.store(nullptr, std::memory_order_seq_cst);
+        // Wait until threads that obtained the pointer before it was reset finish using the object
+        while (g_NumActiveUsers.load(std::memory_order_seq_cst) != 0)
+            std::this_thread::yield();
+        // Destructor delivers all queued messages and stops the flush thread
+        g_pAsyncOutput.reset();
+        g_OriginalCallback = nullptr;
+    }
+
+    void FlushAsyncDebugOutput()
+    {
+        ActiveAsyncOutputRef pAsyncOutput;
+        if (pAsyncOutput)
+            pAsyncOutput->Flush();
+    }
+
+    AsyncDebugOutputStats GetAsyncDebugOutputStats()
+    {
+        ActiveAsyncOutputRef pAsyncOutput;
+        if (pAsyncOutput)
+            return pAsyncOutput->GetStats();
+        else
+            return AsyncDebugOutputStats{};
+    }
+}
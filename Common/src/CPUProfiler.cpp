@@ -0,0 +1,281 @@
+/*     Copyright 2019 Diligent Graphics LLC
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "CPUProfiler.h"
+
+#ifdef DILIGENT_CPU_PROFILER
+
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+
+namespace Diligent
+{
+    namespace
+    {
+        struct ProfilerEvent
+        {
+            const Char* Name;
+            Uint64      BeginTime;
+            Uint64      EndTime;
+            Uint32      FrameNumber; // Non-zero for frame events only
+        };
+
+        // Event buffer is only written by the thread that owns it. Other threads only
+        // read events that have been published through NumEvents.
+        struct ThreadEventBuffer
+        {
+            explicit ThreadEventBuffer(Uint32 _ThreadId) : 
+                ThreadId(_ThreadId)
+            {
+                Events.resize(CPUProfiler::MaxEventsPerThread);
+            }
+
+            const Uint32               ThreadId;
+            std::atomic<Uint32>        CaptureId{0};
+            std::atomic<Uint32>        NumEvents{0};
+            std::atomic<Uint32>        NumDroppedEvents{0};
+            std::vector<ProfilerEvent> Events;
+        };
+
+        struct ProfilerState
+        {
+            std::atomic_bool    IsCapturing{false};
+            std::atomic<Uint32> CaptureId{0};
+            std::atomic<Uint32> FrameNumber{0};
+            std::atomic<Uint64> CaptureStartTime{0};
+            std::atomic<Uint64> LastFrameTime{0};
+
+            std::mutex                                      BuffersMtx;
+            std::vector<std::unique_ptr<ThreadEventBuffer>> Buffers;
+        };
+
+        ProfilerState& GetProfilerState()
+        {
+            static ProfilerState State;
+            return State;
+        }
+
+        thread_local ThreadEventBuffer* tls_pEventBuffer = nullptr;
+
+        ThreadEventBuffer& GetThreadEventBuffer()
+        {
+            if (tls_pEventBuffer == nullptr)
+            {
+                // The buffer is registered once per thread and is owned by the profiler,
+                // so that events recorded by a thread remain available after it exits.
+                auto& State = GetProfilerState();
+                std::lock_guard<std::mutex> Lock(State.BuffersMtx);
+                State.Buffers.emplace_back(new ThreadEventBuffer{static_cast<Uint32>(State.Buffers.size())});
+                tls_pEventBuffer = State.Buffers.back().get();
+            }
+            return *tls_pEventBuffer;
+        }
+
+        void RecordEventImpl(const ProfilerEvent& Event)
+        {
+            auto& State = GetProfilerState();
+            auto& Buffer = GetThreadEventBuffer();
+
+            const auto CaptureId = State.CaptureId.load(std::memory_order_acquire);
+            if (Buffer.CaptureId.load(std::memory_order_relaxed) != CaptureId)
+            {
+                // The first event of the new capture recorded by this thread: discard old events
+                Buffer.NumEvents.store(0, std::memory_order_relaxed);
+                Buffer.NumDroppedEvents.store(0, std::memory_order_relaxed);
+                Buffer.CaptureId.store(CaptureId, std::memory_order_release);
+            }
+
+            const auto EventIdx = Buffer.NumEvents.load(std::memory_order_relaxed);
+            if (EventIdx < CPUProfiler::MaxEventsPerThread)
+            {
+                Buffer.Events[EventIdx] = Event;
+                // Publish the event
+                Buffer.NumEvents.store(EventIdx + 1, std::memory_order_release);
+            }
+            else
+            {
+                Buffer.NumDroppedEvents.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        void AppendJSONString(String& Str, const Char* Text)
+        {
+            Str.push_back('"');
+            for (auto* c = Text; *c != 0; ++c)
+            {
+                if (*c == '"' || *c == '\\')
+                    Str.push_back('\\');
+                Str.push_back(*c);
+            }
+            Str.push_back('"');
+        }
+
+        void AppendMicroseconds(String& Str, Uint64 Nanoseconds)
+        {
+            Char Buffer[32];
+            snprintf(Buffer, sizeof(Buffer), "%llu.%03u", static_cast<unsigned long long>(Nanoseconds / 1000), static_cast<unsigned int>(Nanoseconds % 1000));
+            Str.append(Buffer);
+        }
+    }
+
+    void CPUProfiler::BeginCapture()
+    {
+        auto& State = GetProfilerState();
+        const auto CurrTime = GetTimestamp();
+        State.FrameNumber.store(0);
+        State.CaptureStartTime.store(CurrTime);
+        State.LastFrameTime.store(CurrTime);
+        // Incrementing capture id invalidates events in all thread buffers
+        State.CaptureId.fetch_add(1, std::memory_order_acq_rel);
+        State.IsCapturing.store(true, std::memory_order_release);
+    }
+
+    void CPUProfiler::EndCapture()
+    {
+        GetProfilerState().IsCapturing.store(false, std::memory_order_release);
+    }
+
+    bool CPUProfiler::IsCapturing()
+    {
+        return GetProfilerState().IsCapturing.load(std::memory_order_relaxed);
+    }
+
+    Uint64 CPUProfiler::GetTimestamp()
+    {
+        using namespace std::chrono;
+        return static_cast<Uint64>(duration_cast<nanoseconds>(high_resolution_clock::now().time_since_epoch()).count());
+    }
+
+    void CPUProfiler::RecordEvent(const Char* Name, Uint64 BeginTime, Uint64 EndTime)
+    {
+        if (!IsCapturing())
+            return;
+
+        RecordEventImpl(ProfilerEvent{Name, BeginTime, EndTime, 0});
+    }
+
+    void CPUProfiler::MarkFrame()
+    {
+        auto& State = GetProfilerState();
+        if (!IsCapturing())
+            return;
+
+        const auto CurrTime  = GetTimestamp();
+        const auto FrameStartTime = State.LastFrameTime.exchange(CurrTime);
+        const auto FrameNumber = State.FrameNumber.fetch_add(1) + 1;
+        RecordEventImpl(ProfilerEvent{"Frame", FrameStartTime, CurrTime, FrameNumber});
+    }
+
+    Uint32 CPUProfiler::GetCapturedFrameCount()
+    {
+        return GetProfilerState().FrameNumber.load();
+    }
+
+    void CPUProfiler::GetChromeTrace(String& Trace)
+    {
+        auto& State = GetProfilerState();
+        VERIFY(!IsCapturing(), "Chrome trace must not be requested while the capture is active");
+
+        const auto CaptureId = State.CaptureId.load(std::memory_order_acquire);
+        const auto StartTime = State.CaptureStartTime.load();
+
+        Trace = "{\"traceEvents\":[";
+        bool IsFirstEvent = true;
+
+        std::lock_guard<std::mutex> Lock(State.BuffersMtx);
+        for (const auto& pBuffer : State.Buffers)
+        {
+            if (pBuffer->CaptureId.load(std::memory_order_acquire) != CaptureId)
+                continue;
+
+            const auto NumEvents = pBuffer->NumEvents.load(std::memory_order_acquire);
+            if (auto NumDropped = pBuffer->NumDroppedEvents.load(std::memory_order_relaxed))
+            {
+                LOG_WARNING_MESSAGE(NumDropped, " CPU profiler events have been dropped by thread ", pBuffer->ThreadId,
+                                    " because the event buffer is full. Capture fewer frames or reduce the number of markers.");
+            }
+
+            for (Uint32 e = 0; e < NumEvents; ++e)
+            {
+                const auto& Event = pBuffer->Events[e];
+                // Events recorded before the capture began are not interesting
+                if (Event.BeginTime < StartTime)
+                    continue;
+
+                if (!IsFirstEvent)
+                    Trace.push_back(',');
+                IsFirstEvent = false;
+
+                Trace.append("\n{\"name\":");
+                if (Event.FrameNumber != 0)
+                    Trace.append("\"Frame ").append(std::to_string(Event.FrameNumber)).push_back('"');
+                else
+                    AppendJSONString(Trace, Event.Name);
+                Trace.append(",\"cat\":");
+                Trace.append(Event.FrameNumber != 0 ? "\"frame\"" : "\"cpu\"");
+                Trace.append(",\"ph\":\"X\",\"pid\":0,\"tid\":");
+                Trace.append(std::to_string(pBuffer->ThreadId));
+                Trace.append(",\"ts\":");
+                AppendMicroseconds(Trace, Event.BeginTime - StartTime);
+                Trace.append(",\"dur\":");
+                AppendMicroseconds(Trace, Event.EndTime - Event.BeginTime);
+                Trace.push_back('}');
+            }
+        }
+        Trace.append("\n]}\n");
+    }
+
+    bool CPUProfiler::SaveChromeTrace(const Char* FilePath)
+    {
+        String Trace;
+        GetChromeTrace(Trace);
+
+        FileWrapper File(FilePath, EFileAccessMode::Overwrite);
+        if (!File)
+        {
+            LOG_ERROR_MESSAGE("Failed to open file '", FilePath, "' to save CPU profiler trace");
+            return false;
+        }
+        return File->Write(Trace.data(), Trace.size());
+    }
+
+    CPUProfiler::ScopedMarker::ScopedMarker(const Char* Name)noexcept :
+        m_Name     {Name},
+        m_BeginTime{IsCapturing() ? GetTimestamp() : 0}
+    {
+    }
+
+    CPUProfiler::ScopedMarker::~ScopedMarker()
+    {
+        // Zero begin time indicates that the capture was not active when the scope was entered
+        if (m_BeginTime != 0)
+            RecordEvent(m_Name, m_BeginTime, GetTimestamp());
+    }
+}
+
+#endif
@@ -22,6 +22,7 @@
  */
 
 #include "pch.h"
+#include <algorithm>
 #include "FixedBlockMemoryAllocator.h"
 
 namespace Diligent
@@ -31,7 +32,7 @@ namespace Diligent
                                                          Uint32            NumBlocksInPage) :
         m_PagePool          (STD_ALLOCATOR_RAW_MEM(MemoryPage, RawMemoryAllocator, "Allocator for vector<MemoryPage>")),
         m_AvailablePages    (STD_ALLOCATOR_RAW_MEM(size_t, RawMemoryAllocator, "Allocator for unordered_set<size_t>")),
-        m_AddrToPageId      (STD_ALLOCATOR_RAW_MEM(AddrToPageIdMapElem, RawMemoryAllocator, "Allocator for unordered_map<void*, size_t>")),
+        m_SortedPageStarts  (STD_ALLOCATOR_RAW_MEM(PageStartToIdElem, RawMemoryAllocator, "Allocator for vector<pair<const Uint8*, size_t>>")),
         m_RawMemoryAllocator(RawMemoryAllocator),
         m_BlockSize         (BlockSize),
         m_NumBlocksInPage   (NumBlocksInPage)
@@ -57,8 +58,13 @@ namespace Diligent
     void FixedBlockMemoryAllocator::CreateNewPage()
     {
         m_PagePool.emplace_back( *this );
-        m_AvailablePages.insert( m_PagePool.size()-1 );
-        m_AddrToPageId.reserve( m_PagePool.size()*m_NumBlocksInPage );
+        auto PageId = m_PagePool.size()-1;
+        m_AvailablePages.insert( PageId );
+
+        PageStartToIdElem PageStart{reinterpret_cast<const Uint8*>(m_PagePool.back().GetPageStart()), PageId};
+        auto InsertPos = std::upper_bound(m_SortedPageStarts.begin(), m_SortedPageStarts.end(), PageStart,
+                                          [](const PageStartToIdElem& lhs, const PageStartToIdElem& rhs){return lhs.first < rhs.first;});
+        m_SortedPageStarts.insert(InsertPos, PageStart);
     }
 
     void* FixedBlockMemoryAllocator::Allocate( size_t Size, const Char* dbgDescription, const char* dbgFileName, const  Int32 dbgLineNumber)
@@ -75,38 +81,56 @@ namespace Diligent
         auto PageId = *m_AvailablePages.begin();
         auto &Page = m_PagePool[PageId];
         auto *Ptr = Page.Allocate();
-        m_AddrToPageId.insert( std::make_pair(Ptr, PageId) );
         if (!Page.HasSpace())
         {
             m_AvailablePages.erase(m_AvailablePages.begin());
         }
 
+        ++m_NumAllocatedBlocks;
+        m_PeakNumAllocatedBlocks = std::max(m_PeakNumAllocatedBlocks, m_NumAllocatedBlocks);
+
         return Ptr;
     }
 
     void FixedBlockMemoryAllocator::Free(void *Ptr)
     {
         std::lock_guard<std::mutex> LockGuard(m_Mutex);
-        auto PageIdIt = m_AddrToPageId.find(Ptr);
-        if (PageIdIt != m_AddrToPageId.end())
+        // Find the last page that starts at or before the block address
+        auto PageIt = std::upper_bound(m_SortedPageStarts.begin(), m_SortedPageStarts.end(), reinterpret_cast<const Uint8*>(Ptr),
+                                       [](const Uint8* pAddr, const PageStartToIdElem& Page){return pAddr < Page.first;});
+        if (PageIt != m_SortedPageStarts.begin() &&
+            reinterpret_cast<const Uint8*>(Ptr) < (PageIt-1)->first + m_BlockSize * m_NumBlocksInPage)
         {
-            auto PageId = PageIdIt->second;
+            auto PageId = (PageIt-1)->second;
             VERIFY_EXPR(PageId >= 0 && PageId < m_PagePool.size());
-            m_PagePool[PageId].DeAllocate(Ptr);
-            m_AvailablePages.insert(PageId);
-            m_AddrToPageId.erase(PageIdIt);
-            if (m_AvailablePages.size() > 1 && !m_PagePool[PageId].HasAllocations())
+            auto& Page = m_PagePool[PageId];
+            VERIFY(Page.HasAllocations(), "Page has no allocations - double freeing memory?");
+            if (!Page.HasSpace())
             {
-                // In current implementation pages are never released!
-                // Note that if we delete a page, all indices past it will be invalid
-
-                //m_PagePool.erase(m_PagePool.begin() + PageId);
-                //m_AvailablePages.erase(PageId);
+                // The page was full and is not in the available page pool
+                m_AvailablePages.insert(PageId);
             }
+            Page.DeAllocate(Ptr);
+            VERIFY_EXPR(m_NumAllocatedBlocks > 0);
+            --m_NumAllocatedBlocks;
+            // In current implementation pages are never released!
+            // Note that if we delete a page, all indices past it will be invalid
         }
         else
         {
-            UNEXPECTED("Address not found in the allocations list - double freeing memory?");
+            UNEXPECTED("Address does not belong to any page of this allocator");
         }
     }
+
+    FixedBlockMemoryAllocator::Stats FixedBlockMemoryAllocator::GetStats()
+    {
+        std::lock_guard<std::mutex> LockGuard(m_Mutex);
+        Stats AllocatorStats;
+        AllocatorStats.BlockSize              = m_BlockSize;
+        AllocatorStats.NumBlocksInPage        = m_NumBlocksInPage;
+        AllocatorStats.NumPages               = m_PagePool.size();
+        AllocatorStats.NumAllocatedBlocks     = m_NumAllocatedBlocks;
+        AllocatorStats.PeakNumAllocatedBlocks = m_PeakNumAllocatedBlocks;
+        return AllocatorStats;
+    }
 }
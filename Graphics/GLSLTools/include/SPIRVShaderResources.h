@@ -174,7 +174,8 @@ public:
                          const ShaderDesc&      shaderDesc,
                          const char*            CombinedSamplerSuffix,
                          bool                   LoadShaderStageInputs,
-                         std::string&           EntryPoint);
+                         std::string&           EntryPoint,
+                         Uint32                 ExternalDescriptorSet = ~Uint32{0});
 
     SPIRVShaderResources             (const SPIRVShaderResources&)  = delete;
     SPIRVShaderResources             (      SPIRVShaderResources&&) = delete;
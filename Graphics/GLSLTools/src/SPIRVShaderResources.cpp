@@ -22,6 +22,7 @@
  */
 
 #include <iomanip>
+#include <algorithm>
 #include "SPIRVShaderResources.h"
 #include "spirv_parser.hpp"
 #include "spirv_cross.hpp"
@@ -196,7 +197,8 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&      Allocator,
                                            const ShaderDesc&      shaderDesc,
                                            const char*            CombinedSamplerSuffix,
                                            bool                   LoadShaderStageInputs,
-                                           std::string&           EntryPoint) :
+                                           std::string&           EntryPoint,
+                                           Uint32                 ExternalDescriptorSet) :
     m_ShaderType(shaderDesc.ShaderType)
 {
     // https://github.com/KhronosGroup/SPIRV-Cross/wiki/Reflection-API-user-guide
@@ -229,6 +231,30 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&      Allocator,
 
     // The SPIR-V is now parsed, and we can perform reflection on it.
     spirv_cross::ShaderResources resources = Compiler.get_shader_resources();
+
+    if (ExternalDescriptorSet != ~Uint32{0})
+    {
+        // Resources in the external descriptor set are managed outside of the shader resource
+        // layout (e.g. by the bindless resource heap), so they are excluded from reflection and 
+        // keep the bindings assigned in the shader source
+        auto RemoveExternalResources = [&](decltype(resources.uniform_buffers)& Resources)
+        {
+            auto NewEnd = std::remove_if(Resources.begin(), Resources.end(), 
+                [&](const spirv_cross::Resource& Res)
+                {
+                    return Compiler.has_decoration(Res.id, spv::DecorationDescriptorSet) &&
+                           Compiler.get_decoration(Res.id, spv::DecorationDescriptorSet) == ExternalDescriptorSet;
+                });
+            Resources.erase(NewEnd, Resources.end());
+        };
+        RemoveExternalResources(resources.uniform_buffers);
+        RemoveExternalResources(resources.storage_buffers);
+        RemoveExternalResources(resources.storage_images);
+        RemoveExternalResources(resources.sampled_images);
+        RemoveExternalResources(resources.atomic_counters);
+        RemoveExternalResources(resources.separate_images);
+        RemoveExternalResources(resources.separate_samplers);
+    }
     
     size_t ResourceNamesPoolSize = 0;
     for (const auto& ub : resources.uniform_buffers)
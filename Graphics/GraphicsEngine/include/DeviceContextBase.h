@@ -189,11 +189,20 @@ protected:
 
     inline void SetPipelineState(PipelineStateImplType* pPipelineState, int /*Dummy*/);
 
+    /// Returns the pipeline state that must be bound when the application sets pPipelineState:
+    /// the pipeline itself if it is ready, its fallback pipeline if the fallback is ready, 
+    /// or null if there is nothing to bind. In the latter case, draw and dispatch commands
+    /// must be skipped until another pipeline is set (see m_bPipelineStateNotReady).
+    inline PipelineStateImplType* SelectReadyPipelineState(PipelineStateImplType* pPipelineState);
+
     /// Clears all cached resources
     inline void ClearStateCache();
 
 #ifdef DEVELOPMENT
+    bool DvpVerifyDrawPipelineAndIndexBuffer(Bool IsIndexed, VALUE_TYPE IndexType);
     bool DvpVerifyDrawArguments(const DrawAttribs& drawAttribs);
+    bool DvpVerifyMultiDrawArguments(const MultiDrawAttribs& Attribs);
+    bool DvpVerifyMultiDrawIndirectArguments(const MultiDrawIndirectAttribs& Attribs);
     void DvpVerifyRenderTargets();
     bool DvpVerifyDispatchArguments(const DispatchComputeAttribs &DispatchAttrs);
     void DvpVerifyStateTransitionDesc(const StateTransitionDesc& Barrier);
@@ -201,6 +210,8 @@ protected:
     bool DvpVerifyBufferState (const BufferImplType&  Buffer,  RESOURCE_STATE RequiredState, const char* OperationName);
 #else
 #   define DvpVerifyDrawArguments      (...)[](){return true;}()
+#   define DvpVerifyMultiDrawArguments (...)[](){return true;}()
+#   define DvpVerifyMultiDrawIndirectArguments(...)[](){return true;}()
 #   define DvpVerifyRenderTargets      (...)[](){return true;}()
 #   define DvpVerifyDispatchArguments  (...)[](){return true;}()
 #   define DvpVerifyStateTransitionDesc(...)do{}while(false)
@@ -227,6 +238,10 @@ protected:
     /// SetPipelineState()
     RefCntAutoPtr<PipelineStateImplType> m_pPipelineState;
 
+    /// Flag indicating that the last pipeline state set by the application is not ready yet
+    /// and has no ready fallback. Draw and dispatch commands are skipped while the flag is set.
+    bool m_bPipelineStateNotReady = false;
+
     /// Strong reference to the bound index buffer.
     /// Use final buffer implementation type to avoid virtual calls to AddRef()/Release()
     RefCntAutoPtr<BufferImplType> m_pIndexBuffer;
@@ -346,6 +361,22 @@ inline void DeviceContextBase<BaseInterface,ImplementationTraits> :: SetPipeline
     m_pPipelineState = pPipelineState;
 }
 
+template<typename BaseInterface, typename ImplementationTraits>
+inline typename DeviceContextBase<BaseInterface,ImplementationTraits>::PipelineStateImplType* 
+    DeviceContextBase<BaseInterface,ImplementationTraits> :: SelectReadyPipelineState(PipelineStateImplType* pPipelineState)
+{
+    m_bPipelineStateNotReady = false;
+    if (pPipelineState->GetStatus() == PIPELINE_STATE_STATUS_READY)
+        return pPipelineState;
+
+    auto* pFallbackPSO = ValidatedCast<PipelineStateImplType>(pPipelineState->GetFallbackPipelineState());
+    if (pFallbackPSO != nullptr && pFallbackPSO->GetStatus() == PIPELINE_STATE_STATUS_READY)
+        return pFallbackPSO;
+
+    m_bPipelineStateNotReady = true;
+    return nullptr;
+}
+
 template<typename BaseInterface, typename ImplementationTraits>
 inline bool DeviceContextBase<BaseInterface,ImplementationTraits> :: 
             CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode, int)
@@ -675,6 +706,7 @@ inline void DeviceContextBase<BaseInterface,ImplementationTraits> :: ClearStateC
     m_NumVertexStreams = 0;
 
     m_pPipelineState.Release();
+    m_bPipelineStateNotReady = false;
 
     m_pIndexBuffer.Release();
     m_IndexDataStartOffset = 0;
@@ -871,7 +903,7 @@ inline void DeviceContextBase<BaseInterface,ImplementationTraits> ::
 #ifdef DEVELOPMENT
 template<typename BaseInterface, typename ImplementationTraits>
 inline bool DeviceContextBase<BaseInterface,ImplementationTraits> ::
-            DvpVerifyDrawArguments(const DrawAttribs& drawAttribs)
+            DvpVerifyDrawPipelineAndIndexBuffer(Bool IsIndexed, VALUE_TYPE IndexType)
 {
     if (!m_pPipelineState)
     {
@@ -885,6 +917,28 @@ inline bool DeviceContextBase<BaseInterface,ImplementationTraits> ::
         return false;
     }
 
+    if (IsIndexed && IndexType != VT_UINT16 && IndexType != VT_UINT32)
+    {
+        LOG_ERROR_MESSAGE("For an indexed draw command IndexType must be VT_UINT16 or VT_UINT32");
+        return false;
+    }
+    
+    if (IsIndexed && !m_pIndexBuffer)
+    {
+        LOG_ERROR_MESSAGE("No index buffer is bound for indexed draw command");
+        return false;
+    }
+
+    return true;
+}
+
+template<typename BaseInterface, typename ImplementationTraits>
+inline bool DeviceContextBase<BaseInterface,ImplementationTraits> ::
+            DvpVerifyDrawArguments(const DrawAttribs& drawAttribs)
+{
+    if (!DvpVerifyDrawPipelineAndIndexBuffer(drawAttribs.IsIndexed, drawAttribs.IndexType))
+        return false;
+
     if (drawAttribs.pIndirectDrawAttribs == nullptr)
     {
         if (drawAttribs.NumIndices == 0)
@@ -897,16 +951,81 @@ inline bool DeviceContextBase<BaseInterface,ImplementationTraits> ::
         }
     }
 
-    if (drawAttribs.IsIndexed && drawAttribs.IndexType != VT_UINT16 && drawAttribs.IndexType != VT_UINT32)
+    return true;
+}
+
+template<typename BaseInterface, typename ImplementationTraits>
+inline bool DeviceContextBase<BaseInterface,ImplementationTraits> ::
+            DvpVerifyMultiDrawArguments(const MultiDrawAttribs& Attribs)
+{
+    if (!DvpVerifyDrawPipelineAndIndexBuffer(Attribs.IsIndexed, Attribs.IndexType))
+        return false;
+
+    if (Attribs.DrawCount != 0 && Attribs.pDrawItems == nullptr)
     {
-        LOG_ERROR_MESSAGE("For an indexed draw command IndexType must be VT_UINT16 or VT_UINT32");
+        LOG_ERROR_MESSAGE("pDrawItems must not be null when DrawCount (", Attribs.DrawCount, ") is not zero");
         return false;
     }
-    
-    if (drawAttribs.IsIndexed && !m_pIndexBuffer)
+
+    for (Uint32 i=0; i < Attribs.DrawCount; ++i)
     {
-        LOG_ERROR_MESSAGE("No index buffer is bound for indexed draw command");
+        if (Attribs.pDrawItems[i].NumInstances == 0)
+        {
+            LOG_ERROR_MESSAGE("Number of instances in draw item ", i, " is 0. Use 1 for a non-instanced draw command.");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template<typename BaseInterface, typename ImplementationTraits>
+inline bool DeviceContextBase<BaseInterface,ImplementationTraits> ::
+            DvpVerifyMultiDrawIndirectArguments(const MultiDrawIndirectAttribs& Attribs)
+{
+    if (!DvpVerifyDrawPipelineAndIndexBuffer(Attribs.IsIndexed, Attribs.IndexType))
         return false;
+
+    if (Attribs.pAttribsBuffer == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Indirect draw attributes buffer must not be null");
+        return false;
+    }
+
+    const Uint32 ArgsSize = (Attribs.IsIndexed ? 5 : 4) * sizeof(Uint32);
+    if (Attribs.DrawArgsStride != 0 && (Attribs.DrawArgsStride < ArgsSize || (Attribs.DrawArgsStride % 4) != 0))
+    {
+        LOG_ERROR_MESSAGE("Indirect draw arguments stride (", Attribs.DrawArgsStride, ") must be a multiple of 4 and not less than ", ArgsSize);
+        return false;
+    }
+
+    if (Attribs.DrawCount > 0)
+    {
+        const Uint32 Stride = Attribs.DrawArgsStride != 0 ? Attribs.DrawArgsStride : ArgsSize;
+        const Uint64 RequiredSize = Uint64{Attribs.DrawArgsOffset} + Uint64{Stride} * (Attribs.DrawCount - 1) + ArgsSize;
+        const auto& BuffDesc = Attribs.pAttribsBuffer->GetDesc();
+        if (RequiredSize > BuffDesc.uiSizeInBytes)
+        {
+            LOG_ERROR_MESSAGE("Indirect draw attributes buffer '", BuffDesc.Name, "' is too small (", BuffDesc.uiSizeInBytes, " bytes) to hold ",
+                              Attribs.DrawCount, " draw commands (", RequiredSize, " bytes are required)");
+            return false;
+        }
+    }
+
+    if (Attribs.pCountBuffer != nullptr)
+    {
+        if (!m_pDevice->GetDeviceCaps().bIndirectDrawCountSupported)
+        {
+            LOG_ERROR_MESSAGE("Indirect draw count buffer is not supported by this device");
+            return false;
+        }
+
+        const auto& CountBuffDesc = Attribs.pCountBuffer->GetDesc();
+        if (Uint64{Attribs.CountBufferOffset} + sizeof(Uint32) > CountBuffDesc.uiSizeInBytes)
+        {
+            LOG_ERROR_MESSAGE("Count buffer offset (", Attribs.CountBufferOffset, ") exceeds the size of buffer '", CountBuffDesc.Name, "'");
+            return false;
+        }
     }
 
     return true;
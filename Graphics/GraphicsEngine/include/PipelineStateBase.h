@@ -28,6 +28,8 @@
 
 #include <array>
 #include <vector>
+#include <atomic>
+#include <future>
 
 #include "PipelineState.h"
 #include "DeviceObjectBase.h"
@@ -35,6 +37,7 @@
 #include "EngineMemory.h"
 #include "GraphicsAccessories.h"
 #include "StringPool.h"
+#include "ThreadPool.h"
 
 namespace Diligent
 {
@@ -273,6 +276,8 @@ public:
 
     ~PipelineStateBase()
     {
+        VERIFY(!m_AsyncCompileTask.valid() || m_AsyncCompileTask.wait_for(std::chrono::seconds{0}) == std::future_status::ready,
+               "Asynchronous compilation is still running. Derived classes must call CancelAsyncCompilation() in their destructors.");
         /*
         /// \note Destructor cannot directly remove the object from the registry as this may cause a  
         ///       deadlock at the point where StateObjectsRegistry::Find() locks the weak pointer: if we
@@ -344,7 +349,78 @@ public:
         return m_ShaderResourceLayoutHash != ValidatedCast<const PipelineStateBase>(pPSO)->m_ShaderResourceLayoutHash;
     }
 
+    /// Implementation of IPipelineState::GetStatus()
+    virtual PIPELINE_STATE_STATUS GetStatus()const override final
+    {
+        return m_Status.load();
+    }
+
+    /// Returns the pipeline state that device contexts bind while this one is not ready
+    IPipelineState* GetFallbackPipelineState()const
+    {
+        return m_pFallbackPSO.RawPtr<IPipelineState>();
+    }
+
 protected:
+    /// Executes CompileFunc on the thread pool and sets the status to ready or failed when it
+    /// completes. Shader resource layout hash must be initialized before the method is called.
+    /// CompileFunc must only access members that are not modified after this method is called.
+    template<typename CompileFuncType>
+    void CompileAsync(ThreadingTools::ThreadPool& Pool, IPipelineState* pFallbackPSO, CompileFuncType&& CompileFunc)
+    {
+        if (pFallbackPSO != nullptr)
+        {
+            if (pFallbackPSO->GetDesc().IsComputePipeline != this->m_Desc.IsComputePipeline)
+            {
+                LOG_ERROR_MESSAGE("Fallback pipeline state '", pFallbackPSO->GetDesc().Name, "' of ", (this->m_Desc.IsComputePipeline ? "compute" : "graphics"), 
+                                  " pipeline '", this->m_Desc.Name, "' is not a ", (this->m_Desc.IsComputePipeline ? "compute" : "graphics"), " pipeline and will be ignored");
+                pFallbackPSO = nullptr;
+            }
+            else if (IsIncompatibleWith(pFallbackPSO))
+            {
+                LOG_ERROR_MESSAGE("Fallback pipeline state '", pFallbackPSO->GetDesc().Name, "' is not compatible with pipeline '", this->m_Desc.Name, 
+                                  "' and will be ignored. Shader resource binding objects created by one pipeline can't be committed when the other one is bound.");
+                pFallbackPSO = nullptr;
+            }
+        }
+        m_pFallbackPSO = pFallbackPSO;
+
+        m_Status.store(PIPELINE_STATE_STATUS_PENDING);
+        m_AsyncCompileTask = Pool.EnqueueTask(
+            [this, CompileFunc]()
+            {
+                if (m_CancelAsyncCompile.load())
+                {
+                    // The object is being destroyed
+                    m_Status.store(PIPELINE_STATE_STATUS_FAILED);
+                    return;
+                }
+
+                try
+                {
+                    CompileFunc();
+                    m_Status.store(PIPELINE_STATE_STATUS_READY);
+                }
+                catch (...)
+                {
+                    LOG_ERROR_MESSAGE("Failed to asynchronously compile pipeline state '", this->m_Desc.Name, "'");
+                    m_Status.store(PIPELINE_STATE_STATUS_FAILED);
+                }
+            }
+        );
+    }
+
+    /// Cancels asynchronous compilation if it has not started yet, or waits until it completes.
+    /// Must be called by the destructor of the derived class before it releases any objects used by the compile function.
+    void CancelAsyncCompilation()
+    {
+        if (m_AsyncCompileTask.valid())
+        {
+            m_CancelAsyncCompile.store(true);
+            m_AsyncCompileTask.wait();
+        }
+    }
+
 
     Uint32 m_BufferSlotsUsed = 0;
     Uint32 m_NumShaders      = 0;      ///< Number of shaders that this PSO uses
@@ -359,6 +435,11 @@ protected:
     RefCntAutoPtr<IShader> m_pCS; ///< Strong reference to the compute shader
     IShader* m_ppShaders[5] = {}; ///< Array of pointers to the shaders used by this PSO
     size_t m_ShaderResourceLayoutHash = 0;///< Hash computed from the shader resource layout
+
+    std::atomic<PIPELINE_STATE_STATUS> m_Status{PIPELINE_STATE_STATUS_READY};
+    std::atomic_bool                   m_CancelAsyncCompile{false};
+    std::future<void>                  m_AsyncCompileTask;
+    RefCntAutoPtr<IPipelineState>      m_pFallbackPSO;
 };
 
 }
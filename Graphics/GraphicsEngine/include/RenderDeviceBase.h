@@ -26,6 +26,11 @@
 /// \file
 /// Implementation of the Diligent::RenderDeviceBase template class and related structures
 
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include "RenderDevice.h"
 #include "DeviceObjectBase.h"
 #include "Defines.h"
@@ -39,6 +44,7 @@
 #include "FixedBlockMemoryAllocator.h"
 #include "EngineMemory.h"
 #include "STDAllocator.h"
+#include "ThreadPool.h"
 
 namespace std
 {
@@ -221,14 +227,16 @@ public:
     /// \param pEngineFactory      - engine factory that was used to create this device
     /// \param NumDeferredContexts - number of deferred device contexts 
     /// \param ObjectSizes         - device object sizes
+    /// \param PoolPageSizes       - number of objects in one page of every device object allocator
     ///
     /// \remarks Render device uses fixed block allocators (see FixedBlockMemoryAllocator) to allocate memory for
     ///          device objects. The object sizes provided to constructor are used to initialize the allocators.
-    RenderDeviceBase(IReferenceCounters*      pRefCounters,
-                     IMemoryAllocator&        RawMemAllocator, 
-                     IEngineFactory*          pEngineFactory,
-                     Uint32                   NumDeferredContexts,
-                     const DeviceObjectSizes& ObjectSizes) :
+    RenderDeviceBase(IReferenceCounters*              pRefCounters,
+                     IMemoryAllocator&                RawMemAllocator, 
+                     IEngineFactory*                  pEngineFactory,
+                     Uint32                           NumDeferredContexts,
+                     const DeviceObjectSizes&         ObjectSizes,
+                     const DeviceObjectPoolPageSizes& PoolPageSizes) :
         TObjectBase             (pRefCounters),
         m_pEngineFactory        (pEngineFactory),
         m_SamplersRegistry      (RawMemAllocator, "sampler"),
@@ -236,16 +244,16 @@ public:
         m_TexFmtInfoInitFlags   (TEX_FORMAT_NUM_FORMATS, false, STD_ALLOCATOR_RAW_MEM(bool, RawMemAllocator, "Allocator for vector<bool>") ),
         m_wpDeferredContexts    (NumDeferredContexts, RefCntWeakPtr<IDeviceContext>(), STD_ALLOCATOR_RAW_MEM(RefCntWeakPtr<IDeviceContext>, RawMemAllocator, "Allocator for vector< RefCntWeakPtr<IDeviceContext> >")),
         m_RawMemAllocator       (RawMemAllocator),
-        m_TexObjAllocator       (RawMemAllocator, ObjectSizes.TextureObjSize,   64),
-        m_TexViewObjAllocator   (RawMemAllocator, ObjectSizes.TexViewObjSize,   64),
-        m_BufObjAllocator       (RawMemAllocator, ObjectSizes.BufferObjSize,    128),
-        m_BuffViewObjAllocator  (RawMemAllocator, ObjectSizes.BuffViewObjSize,  128),
-        m_ShaderObjAllocator    (RawMemAllocator, ObjectSizes.ShaderObjSize,    32),
-        m_SamplerObjAllocator   (RawMemAllocator, ObjectSizes.SamplerObjSize,   32),
-        m_PSOAllocator          (RawMemAllocator, ObjectSizes.PSOSize,          128),
-        m_SRBAllocator          (RawMemAllocator, ObjectSizes.SRBSize,          1024),
-        m_ResMappingAllocator   (RawMemAllocator, sizeof(ResourceMappingImpl),  16),
-        m_FenceAllocator        (RawMemAllocator, ObjectSizes.FenceSize,        16)
+        m_TexObjAllocator       (RawMemAllocator, ObjectSizes.TextureObjSize,   std::max(PoolPageSizes.Textures,               1u)),
+        m_TexViewObjAllocator   (RawMemAllocator, ObjectSizes.TexViewObjSize,   std::max(PoolPageSizes.TextureViews,           1u)),
+        m_BufObjAllocator       (RawMemAllocator, ObjectSizes.BufferObjSize,    std::max(PoolPageSizes.Buffers,                1u)),
+        m_BuffViewObjAllocator  (RawMemAllocator, ObjectSizes.BuffViewObjSize,  std::max(PoolPageSizes.BufferViews,            1u)),
+        m_ShaderObjAllocator    (RawMemAllocator, ObjectSizes.ShaderObjSize,    std::max(PoolPageSizes.Shaders,                1u)),
+        m_SamplerObjAllocator   (RawMemAllocator, ObjectSizes.SamplerObjSize,   std::max(PoolPageSizes.Samplers,               1u)),
+        m_PSOAllocator          (RawMemAllocator, ObjectSizes.PSOSize,          std::max(PoolPageSizes.PipelineStates,         1u)),
+        m_SRBAllocator          (RawMemAllocator, ObjectSizes.SRBSize,          std::max(PoolPageSizes.ShaderResourceBindings, 1u)),
+        m_ResMappingAllocator   (RawMemAllocator, sizeof(ResourceMappingImpl),  std::max(PoolPageSizes.ResourceMappings,       1u)),
+        m_FenceAllocator        (RawMemAllocator, ObjectSizes.FenceSize,        std::max(PoolPageSizes.Fences,                 1u))
     {
         // Initialize texture format info
         for( Uint32 Fmt = TEX_FORMAT_UNKNOWN; Fmt < TEX_FORMAT_NUM_FORMATS; ++Fmt )
@@ -348,6 +356,42 @@ public:
         return m_pEngineFactory.RawPtr<IEngineFactory>();
     }
 
+    /// Base implementation of IRenderDevice::CreatePipelineStateAsync() for backends that 
+    /// cannot compile pipelines off the rendering thread. The pipeline is created synchronously.
+    virtual void CreatePipelineStateAsync(const PipelineStateDesc& PipelineDesc, IPipelineState* pFallbackPSO, IPipelineState** ppPipelineState)override
+    {
+        this->CreatePipelineState(PipelineDesc, ppPipelineState);
+    }
+
+    /// Returns the thread pool that compiles pipeline states created by CreatePipelineStateAsync().
+    /// The pool is created on first use.
+    ThreadingTools::ThreadPool& GetPipelineCompilerPool()
+    {
+        std::lock_guard<std::mutex> Lock{m_PipelineCompilerPoolMtx};
+        if (!m_pPipelineCompilerPool)
+        {
+            // Leave one hardware thread to the application and do not use more than four threads
+            auto NumThreads = std::min(std::max(std::thread::hardware_concurrency(), 2u) - 1u, 4u);
+            m_pPipelineCompilerPool.reset(new ThreadingTools::ThreadPool{NumThreads});
+        }
+        return *m_pPipelineCompilerPool;
+    }
+
+    /// Implementation of IRenderDevice::GetObjectPoolStats().
+    virtual void GetObjectPoolStats(DeviceObjectAllocationStats& Stats)override final
+    {
+        GetPoolStats(m_TexObjAllocator,      Stats.Textures);
+        GetPoolStats(m_TexViewObjAllocator,  Stats.TextureViews);
+        GetPoolStats(m_BufObjAllocator,      Stats.Buffers);
+        GetPoolStats(m_BuffViewObjAllocator, Stats.BufferViews);
+        GetPoolStats(m_ShaderObjAllocator,   Stats.Shaders);
+        GetPoolStats(m_SamplerObjAllocator,  Stats.Samplers);
+        GetPoolStats(m_PSOAllocator,         Stats.PipelineStates);
+        GetPoolStats(m_SRBAllocator,         Stats.ShaderResourceBindings);
+        GetPoolStats(m_ResMappingAllocator,  Stats.ResourceMappings);
+        GetPoolStats(m_FenceAllocator,       Stats.Fences);
+    }
+
     void OnCreateDeviceObject(IDeviceObject* pNewObject)
     {
     }
@@ -385,6 +429,15 @@ protected:
     
     virtual void TestTextureFormat(TEXTURE_FORMAT TexFormat) = 0;
 
+    static void GetPoolStats(FixedBlockMemoryAllocator& Allocator, DeviceObjectPoolStats& PoolStats)
+    {
+        const auto AllocatorStats = Allocator.GetStats();
+        PoolStats.NumLiveObjects     = static_cast<Uint32>(AllocatorStats.NumAllocatedBlocks);
+        PoolStats.PeakNumLiveObjects = static_cast<Uint32>(AllocatorStats.PeakNumAllocatedBlocks);
+        PoolStats.LiveObjectsSize    = static_cast<Uint64>(AllocatorStats.NumAllocatedBlocks) * AllocatorStats.BlockSize;
+        PoolStats.ReservedSize       = static_cast<Uint64>(AllocatorStats.NumPages) * AllocatorStats.NumBlocksInPage * AllocatorStats.BlockSize;
+    }
+
     /// Helper template function to facilitate device object creation
     template<typename TObjectType, typename TObjectDescType, typename TObjectConstructor>
     void CreateDeviceObject( const Char *ObjectTypeName, const TObjectDescType &Desc, TObjectType **ppObject, TObjectConstructor ConstructObject );
@@ -418,6 +471,9 @@ protected:
     FixedBlockMemoryAllocator m_SRBAllocator;            ///< Allocator for shader resource binding objects
     FixedBlockMemoryAllocator m_ResMappingAllocator;     ///< Allocator for resource mapping objects
     FixedBlockMemoryAllocator m_FenceAllocator;          ///< Allocator for fence objects
+
+    std::mutex                                  m_PipelineCompilerPoolMtx;
+    std::unique_ptr<ThreadingTools::ThreadPool> m_pPipelineCompilerPool; ///< Pipeline compiler threads, see GetPipelineCompilerPool()
 };
 
 
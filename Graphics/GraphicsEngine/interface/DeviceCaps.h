@@ -111,6 +111,14 @@ namespace Diligent
         
         /// Indicates if device supports tessellation
         Bool bTessellationSupported = True;
+
+        /// Indicates if device natively executes multiple indirect draw commands 
+        /// with a single call (see IDeviceContext::MultiDrawIndirect())
+        Bool bMultiDrawIndirectSupported = False;
+
+        /// Indicates if device supports reading the number of indirect draw commands 
+        /// from a buffer (see MultiDrawIndirectAttribs::pCountBuffer)
+        Bool bIndirectDrawCountSupported = False;
         
         /// Texture sampling capabilities. See Diligent::SamplerCaps.
         SamplerCaps SamCaps;
@@ -244,6 +244,113 @@ struct DrawAttribs
     {}
 };
 
+
+/// Describes a single draw command of a multi-draw batch.
+
+/// This structure is used by Diligent::MultiDrawAttribs.
+struct MultiDrawItem
+{
+    union
+    {
+        /// For a non-indexed draw call, number of vertices to draw.
+        Uint32 NumVertices = 0;
+
+        /// For an indexed draw call, number of indices to draw.
+        Uint32 NumIndices;
+    };
+
+    /// Number of instances to draw.
+    Uint32 NumInstances = 1;
+
+    /// For indexed rendering, a constant which is added to each index before 
+    /// accessing the vertex buffer.
+    Uint32 BaseVertex   = 0;
+
+    union
+    {
+        /// For non-indexed rendering, LOCATION of the first vertex in the vertex buffer.
+        Uint32 StartVertexLocation = 0;
+
+        /// For indexed rendering, LOCATION of the first index in the index buffer.
+        Uint32 FirstIndexLocation;
+    };
+
+    /// For instanced rendering, LOCATION in the vertex buffer to start reading instance data from.
+    Uint32 FirstInstanceLocation = 0;
+};
+
+/// Defines the multi-draw command attributes.
+
+/// This structure is used by IDeviceContext::MultiDraw().
+/// All draw commands in the batch share the same pipeline state, vertex and index buffers, 
+/// and shader resources, so the state is committed and validated only once for the entire batch.
+struct MultiDrawAttribs
+{
+    /// Number of draw commands in the pDrawItems array.
+    Uint32 DrawCount                = 0;
+
+    /// Pointer to the array of DrawCount draw commands.
+    const MultiDrawItem* pDrawItems = nullptr;
+
+    /// Indicates if index buffer will be used to index input vertices.
+    Bool IsIndexed                  = False;
+
+    /// For an indexed draw call, type of elements in the index buffer.
+    /// Allowed values: VT_UINT16 and VT_UINT32. Ignored if IsIndexed is False.
+    VALUE_TYPE IndexType            = VT_UNDEFINED;
+
+    /// Additional flags, see Diligent::DRAW_FLAGS.
+    DRAW_FLAGS Flags                = DRAW_FLAG_NONE;
+};
+
+/// Defines the multi-draw indirect command attributes.
+
+/// This structure is used by IDeviceContext::MultiDrawIndirect().
+/// For non-indexed draws, every command in the attributes buffer is defined by four Uint32 values:
+/// NumVertices, NumInstances, StartVertexLocation, FirstInstanceLocation. For indexed draws,
+/// every command is defined by five values: NumIndices, NumInstances, FirstIndexLocation, 
+/// BaseVertex, FirstInstanceLocation.
+struct MultiDrawIndirectAttribs
+{
+    /// Buffer that contains draw command arguments.
+    IBuffer* pAttribsBuffer         = nullptr;
+
+    /// Offset from the beginning of the attributes buffer to the first draw command.
+    Uint32 DrawArgsOffset           = 0;
+
+    /// Stride, in bytes, between consecutive draw commands. Zero means that
+    /// the commands are tightly packed.
+    Uint32 DrawArgsStride           = 0;
+
+    /// Number of draw commands to execute. If pCountBuffer is not null, 
+    /// this is the maximum number of draws.
+    Uint32 DrawCount                = 0;
+
+    /// Optional buffer that contains the actual number of draw commands as a Uint32 value.
+    /// The number of draws executed is the minimum of this value and DrawCount.
+    /// Requires DeviceCaps::bIndirectDrawCountSupported.
+    IBuffer* pCountBuffer           = nullptr;
+
+    /// Offset from the beginning of the count buffer to the draw count value.
+    Uint32 CountBufferOffset        = 0;
+
+    /// Indicates if index buffer will be used to index input vertices.
+    Bool IsIndexed                  = False;
+
+    /// For an indexed draw call, type of elements in the index buffer.
+    /// Allowed values: VT_UINT16 and VT_UINT32. Ignored if IsIndexed is False.
+    VALUE_TYPE IndexType            = VT_UNDEFINED;
+
+    /// Additional flags, see Diligent::DRAW_FLAGS.
+    DRAW_FLAGS Flags                = DRAW_FLAG_NONE;
+
+    /// State transition mode for the attributes buffer.
+    RESOURCE_STATE_TRANSITION_MODE AttribsBufferStateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_NONE;
+
+    /// State transition mode for the count buffer. Ignored if pCountBuffer is null.
+    RESOURCE_STATE_TRANSITION_MODE CountBufferStateTransitionMode   = RESOURCE_STATE_TRANSITION_MODE_NONE;
+};
+
 /// Defines which parts of the depth-stencil buffer to clear.
 
 /// These flags are used by IDeviceContext::ClearDepthStencil().
@@ -701,6 +808,32 @@ public:
     ///           If the application intends to use the same resources in other threads simultaneously, it needs to 
     ///           explicitly manage the states using IDeviceContext::TransitionResourceStates() method.
     virtual void Draw(DrawAttribs &DrawAttribs) = 0;
+
+
+    /// Executes a batch of draw commands.
+
+    /// \param [in] Attribs - Structure describing the batch, see Diligent::MultiDrawAttribs for details.
+    ///
+    /// \remarks  Vertex and index buffers, pipeline state and shader resources are committed
+    ///           and validated once for the entire batch.
+    ///
+    ///           If Diligent::DRAW_FLAG_VERIFY_STATES flag is set, the method reads the state of vertex/index
+    ///           buffers, so no other threads are allowed to alter the states of the same resources.
+    virtual void MultiDraw(const MultiDrawAttribs& Attribs) = 0;
+
+
+    /// Executes a batch of indirect draw commands.
+
+    /// \param [in] Attribs - Structure describing the batch, see Diligent::MultiDrawIndirectAttribs for details.
+    ///
+    /// \remarks  If AttribsBufferStateTransitionMode or CountBufferStateTransitionMode member is 
+    ///           Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION, the method may transition the state of 
+    ///           the corresponding buffer. This is not a thread safe operation, so no other thread is allowed 
+    ///           to read or write the state of the buffer.
+    ///
+    ///           If the device does not natively support multi-draw indirect (see DeviceCaps::bMultiDrawIndirectSupported),
+    ///           the batch is executed as a sequence of indirect draws.
+    virtual void MultiDrawIndirect(const MultiDrawIndirectAttribs& Attribs) = 0;
     
 
     /// Executes a dispatch compute command.
@@ -920,6 +1053,17 @@ public:
     virtual void CopyTexture(const CopyTextureAttribs& CopyAttribs) = 0;
 
 
+    /// Executes a batch of texture copy commands.
+
+    /// \param [in] pCopies   - Array of structures describing copy commands, see Diligent::CopyTextureAttribs for details.
+    /// \param [in] NumCopies - Number of elements in pCopies array.
+    ///
+    /// \remarks  In Vulkan backend, consecutive copies from the same staging texture to the same destination texture
+    ///           that use the same destination state transition mode are recorded with a single vkCmdCopyBufferToImage
+    ///           command. Other backends execute the copies one by one.
+    virtual void MultiCopyTexture(const CopyTextureAttribs* pCopies, Uint32 NumCopies) = 0;
+
+
     /// Maps the texture subresource.
 
     /// \param [in] pTexture    - Pointer to the texture to map.
@@ -934,6 +1078,8 @@ public:
     ///          subresource can be mapped, so pMapRegion must either be null, or cover the entire subresource.
     ///          In D3D11 and Vulkan backends, dynamic textures are no different from non-dynamic textures, and mapping 
     ///          with MAP_FLAG_DISCARD has exactly the same behavior.
+    ///          In OpenGL backend, only staging textures created with CPU_ACCESS_READ flag can be mapped, and only 
+    ///          for reading.
     virtual void MapTextureSubresource( ITexture*                 pTexture,
                                         Uint32                    MipLevel,
                                         Uint32                    ArraySlice,
@@ -1269,6 +1269,58 @@ namespace Diligent
         DisplayModeAttribs::SCANLINE_ORDER ScanlineOrder = DisplayModeAttribs::SCANLINE_ORDER_UNSPECIFIED;
     };
 
+    /// Number of objects in one page of the memory pools the render device uses to allocate device objects.
+
+    /// Every type of device objects is allocated from its own pool of fixed-size blocks. When all blocks
+    /// of the pool are in use, a new page that holds the given number of objects is allocated. Applications that
+    /// create many transient objects of some type (e.g. texture views) every frame may increase the page size
+    /// to reduce the number of allocations from the raw memory allocator.
+    struct DeviceObjectPoolPageSizes
+    {
+        Uint32 Textures               = 64;
+        Uint32 TextureViews           = 64;
+        Uint32 Buffers                = 128;
+        Uint32 BufferViews            = 128;
+        Uint32 Shaders                = 32;
+        Uint32 Samplers               = 32;
+        Uint32 PipelineStates         = 128;
+        Uint32 ShaderResourceBindings = 1024;
+        Uint32 ResourceMappings       = 16;
+        Uint32 Fences                 = 16;
+    };
+
+    /// Memory usage statistics of the pool that holds device objects of one type
+    struct DeviceObjectPoolStats
+    {
+        /// Number of objects currently allocated from the pool
+        Uint32 NumLiveObjects       = 0;
+
+        /// Maximum number of objects that were allocated from the pool at the same time
+        Uint32 PeakNumLiveObjects   = 0;
+
+        /// Memory occupied by the live objects in the pool, in bytes. This does not include
+        /// the reference counters or the memory that objects allocate themselves
+        Uint64 LiveObjectsSize      = 0;
+
+        /// Total size of the memory pages allocated by the pool, in bytes
+        Uint64 ReservedSize         = 0;
+    };
+
+    /// Memory usage statistics of the device object pools, see IRenderDevice::GetObjectPoolStats()
+    struct DeviceObjectAllocationStats
+    {
+        DeviceObjectPoolStats Textures;
+        DeviceObjectPoolStats TextureViews;
+        DeviceObjectPoolStats Buffers;
+        DeviceObjectPoolStats BufferViews;
+        DeviceObjectPoolStats Shaders;
+        DeviceObjectPoolStats Samplers;
+        DeviceObjectPoolStats PipelineStates;
+        DeviceObjectPoolStats ShaderResourceBindings;
+        DeviceObjectPoolStats ResourceMappings;
+        DeviceObjectPoolStats Fences;
+    };
+
     /// Engine creation attibutes
     struct EngineCreateInfo
     {
@@ -1285,6 +1337,9 @@ namespace Diligent
         /// IEngineFactoryD3D12::CreateDeviceAndContextsD3D12, and IEngineFactoryVk::CreateDeviceAndContextsVk)
         /// starting at position 1.
         Uint32                   NumDeferredContexts  = 0;
+
+        /// Page sizes of the device object memory pools, see Diligent::DeviceObjectPoolPageSizes.
+        DeviceObjectPoolPageSizes ObjectPoolPageSizes;
     };
 
 
@@ -1302,6 +1357,37 @@ namespace Diligent
         /// For linux platform only, this is the pointer to the display
         void* pDisplay = nullptr;
 #endif
+
+        /// Directory where linked program binaries are cached between runs (glGetProgramBinary/glProgramBinary).
+        /// The directory must exist. If null or empty, or if the driver does not support any program 
+        /// binary formats, programs are always compiled and linked from source.
+        /// The cache is invalidated automatically when GPU vendor, renderer or driver version changes.
+        /// When the cache is enabled, shader compilation is deferred until a program has to be linked from
+        /// source, so GLSL compilation errors are reported when the pipeline state is created rather than
+        /// when the shader is created. Shaders that request compiler output are compiled immediately.
+        const Char* ProgramBinaryCacheDirectory = nullptr;
+
+        /// Size of the persistently mapped dynamic heap that is used to suballocate space 
+        /// for dynamic uniform buffers mapped with MAP_FLAG_DISCARD. The heap requires
+        /// OpenGL 4.4 or GL_ARB_buffer_storage extension. If zero or if the extension is 
+        /// not supported, dynamic buffers are updated using buffer orphaning.
+        Uint32 DynamicHeapSize = 4 << 20;
+
+        /// Maximum number of vertex array objects cached by every GL context. When the cache is full,
+        /// the least recently used object is released. Zero means the cache size is not limited.
+        Uint32 VAOCacheSize = 1024;
+
+        /// Maximum number of framebuffer objects cached by every GL context. When the cache is full,
+        /// the least recently used object is released. Zero means the cache size is not limited.
+        Uint32 FBOCacheSize = 256;
+
+        /// Number of worker threads that own GL contexts sharing objects with the main context.
+        /// When non-zero, buffers, textures, samplers, shaders and pipeline states may be created by any
+        /// thread: requests from threads that have no current GL context are executed by the workers,
+        /// so that resource creation and initial data upload do not stall the rendering thread.
+        /// GL objects released by such threads are deleted by the immediate context in Flush() or FinishFrame().
+        /// Currently supported on Linux (GLX) only; the application must call XInitThreads().
+        Uint32 NumResourceWorkerThreads = 0;
     };
 
 
@@ -1411,6 +1497,52 @@ namespace Diligent
         Uint32 NumDynamicHeapPagesToReserve = 1;
     };
 
+    /// Index of the descriptor set that the Vulkan bindless resource heap is bound to, 
+    /// see EngineVkCreateInfo::EnableBindlessResources.
+    static constexpr Uint32 BindlessDescriptorSetVk = 2;
+
+    /// Bindings of the Vulkan bindless resource heap descriptor set. Every binding is
+    /// a runtime-sized descriptor array indexed by the view's bindless index.
+    enum BINDLESS_BINDING_VK : Uint32
+    {
+        /// Texture shader resource views (VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE)
+        BINDLESS_BINDING_VK_SAMPLED_IMAGES = 0,
+
+        /// Texture unordered access views (VK_DESCRIPTOR_TYPE_STORAGE_IMAGE)
+        BINDLESS_BINDING_VK_STORAGE_IMAGES,
+
+        /// Formatted buffer shader resource views (VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER)
+        BINDLESS_BINDING_VK_UNIFORM_TEXEL_BUFFERS,
+
+        /// Formatted buffer unordered access views (VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER)
+        BINDLESS_BINDING_VK_STORAGE_TEXEL_BUFFERS,
+
+        /// Structured and raw buffer views (VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
+        BINDLESS_BINDING_VK_STORAGE_BUFFERS,
+
+        /// Number of bindings in the bindless resource heap
+        BINDLESS_BINDING_VK_NUM_BINDINGS
+    };
+
+    /// Bindless index of a view that has no descriptor in the bindless resource heap
+    static constexpr Uint32 InvalidBindlessIndexVk = 0xFFFFFFFF;
+
+    /// Type of the callback function that is called by the Vulkan memory manager when allocating
+    /// a new device memory page would exceed the memory budget of the heap
+
+    /// \param [in] HeapIndex     - Index of the Vulkan memory heap
+    /// \param [in] Budget        - Memory budget of the heap, in bytes. If VK_EXT_memory_budget extension
+    ///                             is not supported, this is the size of the heap.
+    /// \param [in] Usage         - Current memory usage of the heap, in bytes. If VK_EXT_memory_budget extension
+    ///                             is not supported, this is the size of the pages allocated by the engine.
+    /// \param [in] RequestedSize - Size of the page that is about to be allocated, in bytes
+    /// \param [in] pUserData     - User data pointer provided in EngineVkCreateInfo::pMemoryBudgetCallbackUserData
+    ///
+    /// \note The callback is executed while the memory manager is locked, so it must not create
+    ///       resources. The page is allocated after the callback returns. Resources released by
+    ///       the callback are destroyed once the GPU is done with them.
+    using MemoryBudgetCallbackVkType = void(*)(Uint32 HeapIndex, Uint64 Budget, Uint64 Usage, Uint64 RequestedSize, void* pUserData);
+
     /// Attributes specific to Vulkan engine
     struct EngineVkCreateInfo : public EngineCreateInfo
     {
@@ -1449,6 +1581,7 @@ namespace Diligent
             bool vertexPipelineStoresAndAtomics    = false;
             bool fragmentStoresAndAtomics          = false;
             bool shaderStorageImageExtendedFormats = false;
+            bool multiDrawIndirect                 = false;
         }EnabledFeatures;
 
         /// Descriptor pool size
@@ -1503,6 +1636,49 @@ namespace Diligent
         //                                             Max  SepSm  CmbSm  SmpImg StrImg   UB     SB    UTxB   StTxB
         DescriptorPoolSize DynamicDescriptorPoolSize {2048,   256,  2048,  2048,   256,  1024,  1024,   256,   256};
 
+        /// Enables bindless resource model based on VK_EXT_descriptor_indexing extension.
+        /// When enabled, the engine maintains a global descriptor set (bindless resource heap)
+        /// that contains descriptors of all shader resource and unordered access views. 
+        /// Every view is assigned a stable index in the heap at creation time that can be
+        /// queried through ITextureViewVk::GetBindlessIndex() or IBufferViewVk::GetBindlessIndex().
+        /// The heap is bound to descriptor set BindlessDescriptorSetVk of every pipeline, see BINDLESS_BINDING_VK.
+        /// If the extension or required features are not supported by the device, the
+        /// mode is disabled and a warning is logged.
+        bool EnableBindlessResources = false;
+
+        /// Size of the bindless resource heap. Only NumSampledImageDescriptors, NumStorageImageDescriptors, 
+        /// NumStorageBufferDescriptors, NumUniformTexelBufferDescriptors and NumStorageTexelBufferDescriptors
+        /// members are used. They define the maximum number of views of every type that can exist at the same time.
+        //                                             Max  SepSm  CmbSm  SmpImg StrImg   UB     SB    UTxB   StTxB
+        DescriptorPoolSize BindlessHeapSize          {   0,     0,     0, 16384,  1024,     0,  4096,  1024,  1024};
+
+        /// Whether to suballocate small static and default vertex and index buffers from large 
+        /// shared Vulkan buffers instead of creating a dedicated VkBuffer and memory allocation
+        /// for every buffer. Buffers with other bind flags are never suballocated.
+        bool EnableBufferSuballocation = false;
+
+        /// Size of the shared buffers that small buffers are suballocated from
+        Uint32 BufferSuballocationPageSize = 4 << 20;
+
+        /// Maximum size of a buffer that can be suballocated
+        Uint32 MaxSuballocatedBufferSize = 64 << 10;
+
+        /// Callback that is called when allocating a new device memory page would exceed 
+        /// the memory budget of the heap. The application may use it to evict resources.
+        /// If the callback is null, the engine logs a warning.
+        MemoryBudgetCallbackVkType MemoryBudgetCallback = nullptr;
+
+        /// User data pointer that is passed to the memory budget callback
+        void* pMemoryBudgetCallbackUserData = nullptr;
+
+        /// Maximum number of sparsely used device memory pages that the memory manager starts
+        /// draining every frame. New allocations avoid draining pages, and draining pages are released 
+        /// as soon as all their allocations are freed. Zero value disables memory defragmentation.
+        Uint32 MemoryDefragmentationPagesPerFrame = 0;
+
+        /// Memory pages whose used size is below this fraction of the page size are considered sparse
+        float MemoryDefragmentationUsageThreshold = 0.25f;
+
         /// Allocation granularity for device-local memory
         Uint32 DeviceLocalMemoryPageSize = 16 << 20;
 
@@ -231,6 +231,19 @@ struct PipelineStateDesc : DeviceObjectAttribs
     ComputePipelineDesc ComputePipeline;
 };
 
+/// Pipeline state status
+enum PIPELINE_STATE_STATUS : Uint8
+{
+    /// The pipeline is being compiled asynchronously and cannot be used yet
+    PIPELINE_STATE_STATUS_PENDING = 0,
+
+    /// The pipeline is ready to be used
+    PIPELINE_STATE_STATUS_READY,
+
+    /// Asynchronous compilation of the pipeline failed
+    PIPELINE_STATE_STATUS_FAILED
+};
+
 // {06084AE5-6A71-4FE8-84B9-395DD489A28C}
 static constexpr INTERFACE_ID IID_PipelineState =
 { 0x6084ae5, 0x6a71, 0x4fe8, { 0x84, 0xb9, 0x39, 0x5d, 0xd4, 0x89, 0xa2, 0x8c } };
@@ -315,6 +328,14 @@ public:
     ///             The function only checks compatibility of shader resource layouts. It does not take
     ///             into account vertex shader input layout, number of outputs, etc.
     virtual bool IsCompatibleWith(const IPipelineState* pPSO)const = 0;
+
+
+    /// Returns the pipeline state status, see Diligent::PIPELINE_STATE_STATUS.
+
+    /// \remarks Pipeline states created by IRenderDevice::CreatePipelineState() are always ready.
+    ///          Pipeline states created by IRenderDevice::CreatePipelineStateAsync() remain pending
+    ///          until the compilation on the worker thread is complete.
+    virtual PIPELINE_STATE_STATUS GetStatus()const = 0;
 };
 
 }
@@ -148,6 +148,30 @@ public:
     virtual void CreatePipelineState( const PipelineStateDesc& PipelineDesc, 
                                       IPipelineState**         ppPipelineState ) = 0;
 
+
+    /// Creates a new pipeline state object that is compiled asynchronously
+
+    /// \param [in]  PipelineDesc    - Pipeline state description, see Diligent::PipelineStateDesc for details.
+    /// \param [in]  pFallbackPSO    - Optional pipeline state that device contexts bind instead of the new pipeline 
+    ///                                while it is not ready. If it is null, draw and dispatch commands are skipped
+    ///                                until the pipeline is ready. The fallback pipeline must be of the same type and
+    ///                                compatible with the new one (see IPipelineState::IsCompatibleWith()), so that
+    ///                                shader resource binding objects created by the new pipeline can be committed.
+    ///                                An incompatible fallback pipeline is ignored.
+    /// \param [out] ppPipelineState - Address of the memory location where the pointer to the
+    ///                                pipeline state interface will be stored. 
+    ///                                The function calls AddRef(), so that the new object will contain 
+    ///                                one reference.
+    /// \remarks Shader resource layouts are initialized before the method returns, so static variables
+    ///          can be accessed and shader resource binding objects can be created right away. Only the 
+    ///          driver pipeline is compiled on a worker thread. Use IPipelineState::GetStatus() to check 
+    ///          whether the pipeline is ready.\n
+    ///          Backends that cannot compile pipelines off the rendering thread create the pipeline 
+    ///          synchronously, in which case the returned object is always ready.
+    virtual void CreatePipelineStateAsync( const PipelineStateDesc& PipelineDesc,
+                                           IPipelineState*          pFallbackPSO,
+                                           IPipelineState**         ppPipelineState ) = 0;
+
     
     /// Creates a new pipeline state object
 
@@ -206,6 +230,13 @@ public:
     /// \remark This method does not increment the reference counter of the returned interface,
     ///         so the application should not call Release().
     virtual IEngineFactory* GetEngineFactory() const = 0;
+
+
+    /// Returns memory usage statistics of the pools the device allocates objects from.
+
+    /// \param [out] Stats - Statistics of every device object pool, see Diligent::DeviceObjectAllocationStats.
+    /// \remarks Pool page sizes are specified by EngineCreateInfo::ObjectPoolPageSizes.
+    virtual void GetObjectPoolStats(DeviceObjectAllocationStats& Stats) = 0;
 };
 
 }
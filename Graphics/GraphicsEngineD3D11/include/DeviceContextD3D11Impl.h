@@ -93,6 +93,10 @@ public:
 
     virtual void Draw(DrawAttribs& DrawAttribs)override final;
 
+    virtual void MultiDraw(const MultiDrawAttribs& Attribs)override final;
+
+    virtual void MultiDrawIndirect(const MultiDrawIndirectAttribs& Attribs)override final;
+
     virtual void DispatchCompute(const DispatchComputeAttribs& DispatchAttrs)override final;
 
     virtual void ClearDepthStencil(ITextureView*                  pView,
@@ -131,6 +135,8 @@ public:
 
     virtual void CopyTexture(const CopyTextureAttribs& CopyAttribs)override final;
 
+    virtual void MultiCopyTexture(const CopyTextureAttribs* pCopies, Uint32 NumCopies)override final;
+
     virtual void MapTextureSubresource( ITexture*                 pTexture,
                                         Uint32                    MipLevel,
                                         Uint32                    ArraySlice,
@@ -182,6 +188,7 @@ private:
     
     /// Commits d3d11 index buffer to d3d11 device context.
     void CommitD3D11IndexBuffer(VALUE_TYPE IndexType);
+    void PrepareForDraw(DRAW_FLAGS Flags, bool IsIndexed, VALUE_TYPE IndexType);
 
     /// Commits d3d11 vertex buffers to d3d11 device context.
     void CommitD3D11VertexBuffers(class PipelineStateD3D11Impl* pPipelineStateD3D11);
@@ -23,6 +23,7 @@
 
 #include "pch.h"
 #include "DeviceContextD3D11Impl.h"
+#include "CPUProfiler.h"
 #include "BufferD3D11Impl.h"
 #include "ShaderD3D11Impl.h"
 #include "Texture1D_D3D11.h"
@@ -619,6 +620,7 @@ namespace Diligent
 
     void DeviceContextD3D11Impl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
     {
+        CPU_PROFILE_SCOPE("DeviceContextD3D11Impl::CommitShaderResources");
         if (!DeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0 /*Dummy*/))
             return;
 
@@ -738,17 +740,14 @@ namespace Diligent
         m_bCommittedD3D11VBsUpToDate = true;
     }
 
-    void DeviceContextD3D11Impl::Draw( DrawAttribs &drawAttribs )
+    void DeviceContextD3D11Impl::PrepareForDraw(DRAW_FLAGS Flags, bool IsIndexed, VALUE_TYPE IndexType)
     {
 #ifdef DEVELOPMENT
-        if ((drawAttribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) != 0 && !DvpVerifyDrawArguments(drawAttribs))
-            return;
-
-        if ((drawAttribs.Flags & DRAW_FLAG_VERIFY_RENDER_TARGETS) != 0)
+        if ((Flags & DRAW_FLAG_VERIFY_RENDER_TARGETS) != 0)
             DvpVerifyRenderTargets();
 #endif
 
-        const bool VerifyStates = (drawAttribs.Flags & DRAW_FLAG_VERIFY_STATES) != 0;
+        const bool VerifyStates = (Flags & DRAW_FLAG_VERIFY_STATES) != 0;
         auto* pd3d11InputLayout = m_pPipelineState->GetD3D11InputLayout();
         if (pd3d11InputLayout != nullptr && !m_bCommittedD3D11VBsUpToDate)
         {
@@ -773,13 +772,13 @@ namespace Diligent
         }
 #endif
       
-        if (drawAttribs.IsIndexed)
+        if (IsIndexed)
         {
-            if (m_CommittedIBFormat != drawAttribs.IndexType)
+            if (m_CommittedIBFormat != IndexType)
                 m_bCommittedD3D11IBUpToDate = false;
             if (!m_bCommittedD3D11IBUpToDate)
             {
-                CommitD3D11IndexBuffer(drawAttribs.IndexType);
+                CommitD3D11IndexBuffer(IndexType);
             }
 #ifdef DEVELOPMENT
             if (VerifyStates)
@@ -807,6 +806,17 @@ namespace Diligent
             dbgVerifyCommittedShaders();
         }
 #endif
+    }
+
+    void DeviceContextD3D11Impl::Draw( DrawAttribs &drawAttribs )
+    {
+        CPU_PROFILE_SCOPE("DeviceContextD3D11Impl::Draw");
+#ifdef DEVELOPMENT
+        if ((drawAttribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) != 0 && !DvpVerifyDrawArguments(drawAttribs))
+            return;
+#endif
+
+        PrepareForDraw(drawAttribs.Flags, drawAttribs.IsIndexed, drawAttribs.IndexType);
 
         auto* pIndirectDrawAttribsD3D11 = ValidatedCast<BufferD3D11Impl>(drawAttribs.pIndirectDrawAttribs);
         if (pIndirectDrawAttribsD3D11 != nullptr)
@@ -836,8 +846,62 @@ namespace Diligent
         }
     }
 
+    void DeviceContextD3D11Impl::MultiDraw(const MultiDrawAttribs& Attribs)
+    {
+        CPU_PROFILE_SCOPE("DeviceContextD3D11Impl::MultiDraw");
+#ifdef DEVELOPMENT
+        if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) != 0 && !DvpVerifyMultiDrawArguments(Attribs))
+            return;
+#endif
+        if (Attribs.DrawCount == 0)
+            return;
+
+        PrepareForDraw(Attribs.Flags, Attribs.IsIndexed, Attribs.IndexType);
+
+        // D3D11 has no multi-draw command, but the state is committed only once for the entire batch
+        for (Uint32 i=0; i < Attribs.DrawCount; ++i)
+        {
+            const auto& Item = Attribs.pDrawItems[i];
+            if (Attribs.IsIndexed)
+                m_pd3d11DeviceContext->DrawIndexedInstanced( Item.NumIndices, Item.NumInstances, Item.FirstIndexLocation, Item.BaseVertex, Item.FirstInstanceLocation );
+            else
+                m_pd3d11DeviceContext->DrawInstanced( Item.NumVertices, Item.NumInstances, Item.StartVertexLocation, Item.FirstInstanceLocation );
+        }
+    }
+
+    void DeviceContextD3D11Impl::MultiDrawIndirect(const MultiDrawIndirectAttribs& Attribs)
+    {
+        CPU_PROFILE_SCOPE("DeviceContextD3D11Impl::MultiDrawIndirect");
+#ifdef DEVELOPMENT
+        if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) != 0 && !DvpVerifyMultiDrawIndirectArguments(Attribs))
+            return;
+#endif
+        if (Attribs.DrawCount == 0)
+            return;
+
+        if (Attribs.pCountBuffer != nullptr)
+        {
+            LOG_ERROR_MESSAGE("Indirect draw count buffer is not supported in Direct3D11");
+            return;
+        }
+
+        PrepareForDraw(Attribs.Flags, Attribs.IsIndexed, Attribs.IndexType);
+
+        ID3D11Buffer* pd3d11ArgsBuff = ValidatedCast<BufferD3D11Impl>(Attribs.pAttribsBuffer)->m_pd3d11Buffer;
+        const Uint32 Stride = Attribs.DrawArgsStride != 0 ? Attribs.DrawArgsStride : sizeof(UINT) * (Attribs.IsIndexed ? 5 : 4);
+        for (Uint32 i=0; i < Attribs.DrawCount; ++i)
+        {
+            const UINT ArgsOffset = Attribs.DrawArgsOffset + Stride * i;
+            if (Attribs.IsIndexed)
+                m_pd3d11DeviceContext->DrawIndexedInstancedIndirect( pd3d11ArgsBuff, ArgsOffset );
+            else
+                m_pd3d11DeviceContext->DrawInstancedIndirect( pd3d11ArgsBuff, ArgsOffset );
+        }
+    }
+
     void DeviceContextD3D11Impl::DispatchCompute( const DispatchComputeAttribs &DispatchAttrs )
     {
+        CPU_PROFILE_SCOPE("DeviceContextD3D11Impl::DispatchCompute");
 #ifdef DEVELOPMENT
         if (!DvpVerifyDispatchArguments(DispatchAttrs))
             return;
@@ -1070,6 +1134,12 @@ namespace Diligent
     }
 
 
+    void DeviceContextD3D11Impl::MultiCopyTexture(const CopyTextureAttribs* pCopies, Uint32 NumCopies)
+    {
+        for (Uint32 i=0; i < NumCopies; ++i)
+            CopyTexture(pCopies[i]);
+    }
+
     void DeviceContextD3D11Impl::MapTextureSubresource( ITexture*                 pTexture,
                                                         Uint32                    MipLevel,
                                                         Uint32                    ArraySlice,
@@ -1122,6 +1192,8 @@ namespace Diligent
 
     void DeviceContextD3D11Impl::FinishFrame()
     {
+        if (!m_bIsDeferred)
+            CPU_PROFILE_FRAME_BOUNDARY();
     }
 
     void DeviceContextD3D11Impl::SetVertexBuffers( Uint32                         StartSlot,
@@ -1893,6 +1965,7 @@ namespace Diligent
 
     void DeviceContextD3D11Impl::TransitionResourceStates(Uint32 BarrierCount, StateTransitionDesc* pResourceBarriers)
     {
+        CPU_PROFILE_SCOPE("DeviceContextD3D11Impl::TransitionResourceStates");
         for (Uint32 i=0; i < BarrierCount; ++i)
         {
             const auto& Barrier = pResourceBarriers[i];
@@ -23,6 +23,7 @@
 
 #include "pch.h"
 #include "RenderDeviceD3D11Impl.h"
+#include "CPUProfiler.h"
 #include "DeviceContextD3D11Impl.h"
 #include "BufferD3D11Impl.h"
 #include "ShaderD3D11Impl.h"
@@ -63,7 +64,8 @@ RenderDeviceD3D11Impl :: RenderDeviceD3D11Impl(IReferenceCounters*          pRef
             sizeof(PipelineStateD3D11Impl),
             sizeof(ShaderResourceBindingD3D11Impl),
             sizeof(FenceD3D11Impl)
-        }
+        },
+        EngineAttribs.ObjectPoolPageSizes
     },
     m_EngineAttribs{EngineAttribs},
     m_pd3d11Device {pd3d11Device }
@@ -141,6 +143,7 @@ void RenderDeviceD3D11Impl :: CreateBuffer(const BufferDesc& BuffDesc, const Buf
 
 void RenderDeviceD3D11Impl :: CreateShader(const ShaderCreateInfo& ShaderCI, IShader** ppShader)
 {
+    CPU_PROFILE_SCOPE("RenderDeviceD3D11Impl::CreateShader");
     CreateDeviceObject( "shader", ShaderCI.Desc, ppShader, 
         [&]()
         {
@@ -267,6 +270,7 @@ void RenderDeviceD3D11Impl :: CreateSampler(const SamplerDesc& SamplerDesc, ISam
 
 void RenderDeviceD3D11Impl::CreatePipelineState(const PipelineStateDesc& PipelineDesc, IPipelineState** ppPipelineState)
 {
+    CPU_PROFILE_SCOPE("RenderDeviceD3D11Impl::CreatePipelineState");
     CreateDeviceObject( "Pipeline state", PipelineDesc, ppPipelineState, 
         [&]()
         {
@@ -132,6 +132,12 @@ public:
 	    m_pCommandList->ExecuteIndirect(pCmdSignature, 1, pBuff, ArgsOffset, nullptr, 0);
     }
 
+	void ExecuteIndirect(ID3D12CommandSignature *pCmdSignature, UINT MaxCommandCount, ID3D12Resource *pBuff, Uint64 ArgsOffset, ID3D12Resource *pCountBuff, Uint64 CountBuffOffset)
+    {
+	    FlushResourceBarriers();
+	    m_pCommandList->ExecuteIndirect(pCmdSignature, MaxCommandCount, pBuff, ArgsOffset, pCountBuff, CountBuffOffset);
+    }
+
     void SetID(const Char* ID) { m_ID = ID; }
     ID3D12GraphicsCommandList *GetCommandList(){return m_pCommandList;}
     
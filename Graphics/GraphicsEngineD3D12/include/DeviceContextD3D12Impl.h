@@ -94,6 +94,10 @@ public:
 
     virtual void Draw( DrawAttribs& DrawAttribs )override final;
 
+    virtual void MultiDraw(const MultiDrawAttribs& Attribs)override final;
+
+    virtual void MultiDrawIndirect(const MultiDrawIndirectAttribs& Attribs)override final;
+
     virtual void DispatchCompute( const DispatchComputeAttribs& DispatchAttrs )override final;
 
     virtual void ClearDepthStencil(ITextureView*                  pView,
@@ -132,6 +136,8 @@ public:
 
     virtual void CopyTexture(const CopyTextureAttribs& CopyAttribs)override final;
 
+    virtual void MultiCopyTexture(const CopyTextureAttribs* pCopies, Uint32 NumCopies)override final;
+
     virtual void MapTextureSubresource( ITexture*                 pTexture,
                                         Uint32                    MipLevel,
                                         Uint32                    ArraySlice,
@@ -224,6 +230,8 @@ public:
 private:
     void CommitD3D12IndexBuffer(VALUE_TYPE IndexType);
     void CommitD3D12VertexBuffers(class GraphicsContext& GraphCtx);
+    class GraphicsContext& PrepareForDraw(DRAW_FLAGS Flags, bool IsIndexed, VALUE_TYPE IndexType);
+    ID3D12CommandSignature* GetDrawIndirectSignature(bool IsIndexed, Uint32 Stride);
     void CommitRenderTargets(RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
     void CommitViewports();
     void CommitScissorRects(class GraphicsContext &GraphCtx, bool ScissorEnable);
@@ -285,6 +293,9 @@ private:
     CComPtr<ID3D12CommandSignature> m_pDrawIndirectSignature;
     CComPtr<ID3D12CommandSignature> m_pDrawIndexedIndirectSignature;
     CComPtr<ID3D12CommandSignature> m_pDispatchIndirectSignature;
+    // Draw command signatures with non-default stride used by MultiDrawIndirect(),
+    // keyed by (Stride << 1) | IsIndexed
+    std::unordered_map<Uint32, CComPtr<ID3D12CommandSignature>> m_StridedDrawIndirectSignatures;
     
     D3D12DynamicHeap m_DynamicHeap;
     
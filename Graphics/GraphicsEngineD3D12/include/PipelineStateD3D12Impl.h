@@ -45,7 +45,11 @@ class PipelineStateD3D12Impl final : public PipelineStateBase<IPipelineStateD3D1
 public:
     using TPipelineStateBase = PipelineStateBase<IPipelineStateD3D12, RenderDeviceD3D12Impl>;
 
-    PipelineStateD3D12Impl( IReferenceCounters *pRefCounters, RenderDeviceD3D12Impl *pDeviceD3D12, const PipelineStateDesc &PipelineDesc );
+    PipelineStateD3D12Impl( IReferenceCounters*      pRefCounters,
+                            RenderDeviceD3D12Impl*   pDeviceD3D12,
+                            const PipelineStateDesc& PipelineDesc,
+                            bool                     AsyncCompile = false,
+                            IPipelineState*          pFallbackPSO = nullptr );
     ~PipelineStateD3D12Impl();
 
     virtual void QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface)override final;
@@ -100,6 +104,8 @@ public:
     }
 
 private:
+    // Creates D3D12 pipeline state object. Executed on a pipeline compiler thread when the PSO is created asynchronously
+    void CreateD3D12PipelineState();
 
     /// D3D12 device
     CComPtr<ID3D12PipelineState> m_pd3d12PSO;
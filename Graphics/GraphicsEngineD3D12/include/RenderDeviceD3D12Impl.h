@@ -58,6 +58,8 @@ public:
 
     virtual void CreatePipelineState(const PipelineStateDesc& PipelineDesc, IPipelineState** ppPipelineState)override final;
 
+    virtual void CreatePipelineStateAsync(const PipelineStateDesc& PipelineDesc, IPipelineState* pFallbackPSO, IPipelineState** ppPipelineState)override final;
+
     virtual void CreateBuffer(const BufferDesc& BuffDesc, const BufferData* pBuffData, IBuffer** ppBuffer)override final;
 
     virtual void CreateShader(const ShaderCreateInfo& ShaderCreateInfo, IShader** ppShader)override final;
@@ -23,6 +23,7 @@
 
 #include "pch.h"
 #include "D3D12DynamicHeap.h"
+#include "CPUProfiler.h"
 #include "RenderDeviceD3D12Impl.h"
 
 namespace Diligent
@@ -87,6 +88,7 @@ D3D12DynamicMemoryManager::D3D12DynamicMemoryManager(IMemoryAllocator&      Allo
 
 D3D12DynamicPage D3D12DynamicMemoryManager::AllocatePage(Uint64 SizeInBytes)
 {
+    CPU_PROFILE_SCOPE("D3D12DynamicMemoryManager::AllocatePage");
     std::lock_guard<std::mutex> AvailablePagesLock(m_AvailablePagesMtx);
 #ifdef DEVELOPMENT
     ++m_AllocatedPageCounter;
@@ -23,6 +23,7 @@
 
 #include "pch.h"
 #include "DescriptorHeap.h"
+#include "CPUProfiler.h"
 #include "RenderDeviceD3D12Impl.h"
 #include "D3D12Utils.h"
 
@@ -227,6 +228,7 @@ DescriptorHeapAllocation CPUDescriptorHeap::Allocate( uint32_t Count )
     // to suffice the allocation request, create a new manager
     if (Allocation.IsNull())
     {
+        CPU_PROFILE_SCOPE("CPUDescriptorHeap::CreateNewHeap");
         // Make sure the heap is large enough to accomodate the requested number of descriptors
         if(Count > m_HeapDesc.NumDescriptors)
         {
@@ -25,6 +25,7 @@
 #include <sstream>
 #include "RenderDeviceD3D12Impl.h"
 #include "DeviceContextD3D12Impl.h"
+#include "CPUProfiler.h"
 #include "SwapChainD3D12.h"
 #include "PipelineStateD3D12Impl.h"
 #include "CommandContext.h"
@@ -165,7 +166,10 @@ namespace Diligent
     
     void DeviceContextD3D12Impl::SetPipelineState(IPipelineState* pPipelineState)
     {
-        auto* pPipelineStateD3D12 = ValidatedCast<PipelineStateD3D12Impl>(pPipelineState);
+        auto* pPipelineStateD3D12 = SelectReadyPipelineState(ValidatedCast<PipelineStateD3D12Impl>(pPipelineState));
+        if (pPipelineStateD3D12 == nullptr)
+            return; // The pipeline is still being compiled and there is no fallback: skip draw commands
+
         if (PipelineStateD3D12Impl::IsSameObject(m_pPipelineState, pPipelineStateD3D12))
             return;
 
@@ -242,6 +246,10 @@ namespace Diligent
 
     void DeviceContextD3D12Impl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
     {
+        CPU_PROFILE_SCOPE("DeviceContextD3D12Impl::CommitShaderResources");
+        if (m_bPipelineStateNotReady)
+            return;
+
         if (!DeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0 /*Dummy*/))
             return;
 
@@ -362,25 +370,22 @@ namespace Diligent
         m_State.bCommittedD3D12VBsUpToDate = !DynamicBufferPresent;
     }
 
-    void DeviceContextD3D12Impl::Draw( DrawAttribs& drawAttribs )
+    GraphicsContext& DeviceContextD3D12Impl::PrepareForDraw(DRAW_FLAGS Flags, bool IsIndexed, VALUE_TYPE IndexType)
     {
 #ifdef DEVELOPMENT
-        if ((drawAttribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) != 0 && !DvpVerifyDrawArguments(drawAttribs))
-            return;
-
-        if ((drawAttribs.Flags & DRAW_FLAG_VERIFY_RENDER_TARGETS) != 0)
+        if ((Flags & DRAW_FLAG_VERIFY_RENDER_TARGETS) != 0)
             DvpVerifyRenderTargets();
 #endif
 
-        const bool VerifyStates = (drawAttribs.Flags & DRAW_FLAG_VERIFY_STATES) != 0;
+        const bool VerifyStates = (Flags & DRAW_FLAG_VERIFY_STATES) != 0;
         auto& GraphCtx = GetCmdContext().AsGraphicsContext();
-        if (drawAttribs.IsIndexed)
+        if (IsIndexed)
         {
-            if (m_State.CommittedIBFormat != drawAttribs.IndexType)
+            if (m_State.CommittedIBFormat != IndexType)
                 m_State.bCommittedD3D12IBUpToDate = false;
             if (!m_State.bCommittedD3D12IBUpToDate)
             {
-                CommitD3D12IndexBuffer(drawAttribs.IndexType);
+                CommitD3D12IndexBuffer(IndexType);
             }
 #ifdef DEVELOPMENT
             if (VerifyStates)
@@ -422,7 +427,21 @@ namespace Diligent
                 LOG_ERROR_MESSAGE("Pipeline state '", m_pPipelineState->GetDesc().Name, "' contains shader resources, but IDeviceContext::CommitShaderResources() was not called with non-null SRB" );
         }
 #endif
-        
+        return GraphCtx;
+    }
+
+    void DeviceContextD3D12Impl::Draw( DrawAttribs& drawAttribs )
+    {
+        CPU_PROFILE_SCOPE("DeviceContextD3D12Impl::Draw");
+        if (m_bPipelineStateNotReady)
+            return;
+
+#ifdef DEVELOPMENT
+        if ((drawAttribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) != 0 && !DvpVerifyDrawArguments(drawAttribs))
+            return;
+#endif
+
+        auto& GraphCtx = PrepareForDraw(drawAttribs.Flags, drawAttribs.IsIndexed, drawAttribs.IndexType);
 
         auto* pIndirectDrawAttribsD3D12 = ValidatedCast<BufferD3D12Impl>(drawAttribs.pIndirectDrawAttribs);
         if (pIndirectDrawAttribsD3D12 != nullptr)
@@ -449,8 +468,114 @@ namespace Diligent
         ++m_State.NumCommands;
     }
 
+    void DeviceContextD3D12Impl::MultiDraw(const MultiDrawAttribs& Attribs)
+    {
+        CPU_PROFILE_SCOPE("DeviceContextD3D12Impl::MultiDraw");
+        if (m_bPipelineStateNotReady)
+            return;
+
+#ifdef DEVELOPMENT
+        if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) != 0 && !DvpVerifyMultiDrawArguments(Attribs))
+            return;
+#endif
+        if (Attribs.DrawCount == 0)
+            return;
+
+        auto& GraphCtx = PrepareForDraw(Attribs.Flags, Attribs.IsIndexed, Attribs.IndexType);
+        for (Uint32 i=0; i < Attribs.DrawCount; ++i)
+        {
+            const auto& Item = Attribs.pDrawItems[i];
+            if (Attribs.IsIndexed)
+                GraphCtx.DrawIndexed(Item.NumIndices, Item.NumInstances, Item.FirstIndexLocation, Item.BaseVertex, Item.FirstInstanceLocation);
+            else
+                GraphCtx.Draw(Item.NumVertices, Item.NumInstances, Item.StartVertexLocation, Item.FirstInstanceLocation);
+        }
+        m_State.NumCommands += Attribs.DrawCount;
+    }
+
+    ID3D12CommandSignature* DeviceContextD3D12Impl::GetDrawIndirectSignature(bool IsIndexed, Uint32 Stride)
+    {
+        const Uint32 DefaultStride = sizeof(UINT) * (IsIndexed ? 5 : 4);
+        if (Stride == 0 || Stride == DefaultStride)
+            return IsIndexed ? m_pDrawIndexedIndirectSignature : m_pDrawIndirectSignature;
+
+        auto& pSignature = m_StridedDrawIndirectSignatures[(Stride << 1u) | (IsIndexed ? 1u : 0u)];
+        if (!pSignature)
+        {
+            D3D12_INDIRECT_ARGUMENT_DESC IndirectArg = {};
+            IndirectArg.Type = IsIndexed ? D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED : D3D12_INDIRECT_ARGUMENT_TYPE_DRAW;
+
+            D3D12_COMMAND_SIGNATURE_DESC CmdSignatureDesc = {};
+            CmdSignatureDesc.NodeMask         = 0;
+            CmdSignatureDesc.NumArgumentDescs = 1;
+            CmdSignatureDesc.pArgumentDescs   = &IndirectArg;
+            CmdSignatureDesc.ByteStride       = Stride;
+
+            auto *pd3d12Device = m_pDevice.RawPtr<RenderDeviceD3D12Impl>()->GetD3D12Device();
+            auto hr = pd3d12Device->CreateCommandSignature(&CmdSignatureDesc, nullptr, __uuidof(pSignature), reinterpret_cast<void**>(static_cast<ID3D12CommandSignature**>(&pSignature)) );
+            if (FAILED(hr))
+            {
+                LOG_ERROR_MESSAGE("Failed to create indirect draw command signature with stride ", Stride);
+                return nullptr;
+            }
+        }
+        return pSignature;
+    }
+
+    void DeviceContextD3D12Impl::MultiDrawIndirect(const MultiDrawIndirectAttribs& Attribs)
+    {
+        CPU_PROFILE_SCOPE("DeviceContextD3D12Impl::MultiDrawIndirect");
+        if (m_bPipelineStateNotReady)
+            return;
+
+#ifdef DEVELOPMENT
+        if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) != 0 && !DvpVerifyMultiDrawIndirectArguments(Attribs))
+            return;
+#endif
+        if (Attribs.DrawCount == 0)
+            return;
+
+        auto* pCmdSignature = GetDrawIndirectSignature(Attribs.IsIndexed, Attribs.DrawArgsStride);
+        if (pCmdSignature == nullptr)
+            return;
+
+        auto& GraphCtx = PrepareForDraw(Attribs.Flags, Attribs.IsIndexed, Attribs.IndexType);
+
+        auto* pAttribsBufferD3D12 = ValidatedCast<BufferD3D12Impl>(Attribs.pAttribsBuffer);
+#ifdef DEVELOPMENT
+        if (pAttribsBufferD3D12->GetDesc().Usage == USAGE_DYNAMIC)
+            pAttribsBufferD3D12->DvpVerifyDynamicAllocation(this);
+#endif
+        TransitionOrVerifyBufferState(GraphCtx, *pAttribsBufferD3D12, Attribs.AttribsBufferStateTransitionMode,
+                                      RESOURCE_STATE_INDIRECT_ARGUMENT, "Multi-draw indirect (DeviceContextD3D12Impl::MultiDrawIndirect)");
+        size_t ArgsBuffDataStartByteOffset = 0;
+        ID3D12Resource* pd3d12ArgsBuff = pAttribsBufferD3D12->GetD3D12Buffer(ArgsBuffDataStartByteOffset, this);
+
+        ID3D12Resource* pd3d12CountBuff = nullptr;
+        size_t CountBuffDataStartByteOffset = 0;
+        if (auto* pCountBufferD3D12 = ValidatedCast<BufferD3D12Impl>(Attribs.pCountBuffer))
+        {
+#ifdef DEVELOPMENT
+            if (pCountBufferD3D12->GetDesc().Usage == USAGE_DYNAMIC)
+                pCountBufferD3D12->DvpVerifyDynamicAllocation(this);
+#endif
+            TransitionOrVerifyBufferState(GraphCtx, *pCountBufferD3D12, Attribs.CountBufferStateTransitionMode,
+                                          RESOURCE_STATE_INDIRECT_ARGUMENT, "Reading indirect draw count (DeviceContextD3D12Impl::MultiDrawIndirect)");
+            pd3d12CountBuff = pCountBufferD3D12->GetD3D12Buffer(CountBuffDataStartByteOffset, this);
+        }
+
+        GraphCtx.ExecuteIndirect(pCmdSignature, Attribs.DrawCount,
+                                 pd3d12ArgsBuff, Attribs.DrawArgsOffset + ArgsBuffDataStartByteOffset,
+                                 pd3d12CountBuff, pd3d12CountBuff != nullptr ? Attribs.CountBufferOffset + CountBuffDataStartByteOffset : 0);
+        m_State.NumCommands += Attribs.DrawCount;
+    }
+
     void DeviceContextD3D12Impl::DispatchCompute( const DispatchComputeAttribs& DispatchAttrs )
     {
+        CPU_PROFILE_SCOPE("DeviceContextD3D12Impl::DispatchCompute");
+        if (m_bPipelineStateNotReady)
+            return;
+
 #ifdef DEVELOPMENT
         if (!DvpVerifyDispatchArguments(DispatchAttrs))
             return;
@@ -624,6 +749,8 @@ namespace Diligent
 
     void DeviceContextD3D12Impl::FinishFrame()
     {
+        if (!m_bIsDeferred)
+            CPU_PROFILE_FRAME_BOUNDARY();
 #ifdef _DEBUG
         for(const auto& MappedBuffIt : m_DbgMappedBuffers)
         {
@@ -1119,6 +1246,13 @@ namespace Diligent
                           CopyAttribs.DstTextureTransitionMode);
     }
 
+    void DeviceContextD3D12Impl::MultiCopyTexture(const CopyTextureAttribs* pCopies, Uint32 NumCopies)
+    {
+        // D3D12 copies one subresource per CopyTextureRegion() command, so there is nothing to batch
+        for (Uint32 i=0; i < NumCopies; ++i)
+            CopyTexture(pCopies[i]);
+    }
+
     void DeviceContextD3D12Impl::CopyTextureRegion(TextureD3D12Impl*               pSrcTexture,
                                                    Uint32                          SrcSubResIndex,
                                                    const D3D12_BOX*                pD3D12SrcBox,
@@ -1591,6 +1725,7 @@ namespace Diligent
 
     void DeviceContextD3D12Impl::TransitionResourceStates(Uint32 BarrierCount, StateTransitionDesc* pResourceBarriers)
     {
+        CPU_PROFILE_SCOPE("DeviceContextD3D12Impl::TransitionResourceStates");
         auto& CmdCtx = GetCmdContext();
         for(Uint32 i = 0; i < BarrierCount; ++i)
         {
@@ -62,7 +62,9 @@ private:
 
 PipelineStateD3D12Impl :: PipelineStateD3D12Impl(IReferenceCounters*      pRefCounters,
                                                  RenderDeviceD3D12Impl*   pDeviceD3D12,
-                                                 const PipelineStateDesc& PipelineDesc) : 
+                                                 const PipelineStateDesc& PipelineDesc,
+                                                 bool                     AsyncCompile,
+                                                 IPipelineState*          pFallbackPSO) : 
     TPipelineStateBase{pRefCounters, pDeviceD3D12, PipelineDesc},
     m_SRBMemAllocator {GetRawAllocator()}
 {
@@ -148,9 +150,43 @@ PipelineStateD3D12Impl :: PipelineStateD3D12Impl(IReferenceCounters*      pRefCo
     }
     m_RootSig.Finalize(pd3d12Device);
 
-    if (PipelineDesc.IsComputePipeline)
+    if (*m_Desc.Name != 0)
+    {
+        String RootSignatureDesc("Root signature for PSO '");
+        RootSignatureDesc.append(m_Desc.Name);
+        RootSignatureDesc.push_back('\'');
+        m_RootSig.GetD3D12RootSignature()->SetName(WidenString(RootSignatureDesc).c_str());
+    }
+
+    if(PipelineDesc.SRBAllocationGranularity > 1)
+    {
+        std::array<size_t, MaxShadersInPipeline> ShaderVarMgrDataSizes = {};
+        for (Uint32 s = 0; s < m_NumShaders; ++s)
+        {
+            std::array<SHADER_RESOURCE_VARIABLE_TYPE, 2> AllowedVarTypes = { SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC };
+            Uint32 NumVariablesUnused = 0;
+            ShaderVarMgrDataSizes[s] = ShaderVariableManagerD3D12::GetRequiredMemorySize(m_pShaderResourceLayouts[s], AllowedVarTypes.data(), static_cast<Uint32>(AllowedVarTypes.size()), NumVariablesUnused);
+        }
+
+        auto CacheMemorySize = m_RootSig.GetResourceCacheRequiredMemSize();
+        m_SRBMemAllocator.Initialize(PipelineDesc.SRBAllocationGranularity, m_NumShaders, ShaderVarMgrDataSizes.data(), 1, &CacheMemorySize);
+    }
+
+    m_ShaderResourceLayoutHash = m_RootSig.GetHash();
+
+    if (AsyncCompile)
+        CompileAsync(pDeviceD3D12->GetPipelineCompilerPool(), pFallbackPSO, [this](){ CreateD3D12PipelineState(); });
+    else
+        CreateD3D12PipelineState();
+}
+
+void PipelineStateD3D12Impl::CreateD3D12PipelineState()
+{
+    auto pd3d12Device = m_pDevice->GetD3D12Device();
+
+    if (m_Desc.IsComputePipeline)
     {
-        auto& ComputePipeline = PipelineDesc.ComputePipeline;
+        auto& ComputePipeline = m_Desc.ComputePipeline;
 
         if( ComputePipeline.pCS == nullptr )
             LOG_ERROR_AND_THROW("Compute shader is not set in the pipeline desc");
@@ -181,7 +217,7 @@ PipelineStateD3D12Impl :: PipelineStateD3D12Impl(IReferenceCounters*      pRefCo
     }
     else
     {
-        const auto& GraphicsPipeline = PipelineDesc.GraphicsPipeline;
+        const auto& GraphicsPipeline = m_Desc.GraphicsPipeline;
         D3D12_GRAPHICS_PIPELINE_STATE_DESC d3d12PSODesc = {};
             
         for (Uint32 s=0; s < m_NumShaders; ++s)
@@ -259,33 +295,13 @@ PipelineStateD3D12Impl :: PipelineStateD3D12Impl(IReferenceCounters*      pRefCo
     }
 
     if (*m_Desc.Name != 0)
-    {
         m_pd3d12PSO->SetName(WidenString(m_Desc.Name).c_str());
-        String RootSignatureDesc("Root signature for PSO '");
-        RootSignatureDesc.append(m_Desc.Name);
-        RootSignatureDesc.push_back('\'');
-        m_RootSig.GetD3D12RootSignature()->SetName(WidenString(RootSignatureDesc).c_str());
-    }
-
-    if(PipelineDesc.SRBAllocationGranularity > 1)
-    {
-        std::array<size_t, MaxShadersInPipeline> ShaderVarMgrDataSizes = {};
-        for (Uint32 s = 0; s < m_NumShaders; ++s)
-        {
-            std::array<SHADER_RESOURCE_VARIABLE_TYPE, 2> AllowedVarTypes = { SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC };
-            Uint32 NumVariablesUnused = 0;
-            ShaderVarMgrDataSizes[s] = ShaderVariableManagerD3D12::GetRequiredMemorySize(m_pShaderResourceLayouts[s], AllowedVarTypes.data(), static_cast<Uint32>(AllowedVarTypes.size()), NumVariablesUnused);
-        }
-
-        auto CacheMemorySize = m_RootSig.GetResourceCacheRequiredMemSize();
-        m_SRBMemAllocator.Initialize(PipelineDesc.SRBAllocationGranularity, m_NumShaders, ShaderVarMgrDataSizes.data(), 1, &CacheMemorySize);
-    }
-
-    m_ShaderResourceLayoutHash = m_RootSig.GetHash();
 }
 
 PipelineStateD3D12Impl::~PipelineStateD3D12Impl()
 {
+    CancelAsyncCompilation();
+
     auto& ShaderResLayoutAllocator = GetRawAllocator();
     for(Uint32 s = 0; s < m_NumShaders; ++s)
     {
@@ -23,6 +23,7 @@
 
 #include "pch.h"
 #include "RenderDeviceD3D12Impl.h"
+#include "CPUProfiler.h"
 #include "PipelineStateD3D12Impl.h"
 #include "ShaderD3D12Impl.h"
 #include "TextureD3D12Impl.h"
@@ -63,7 +64,8 @@ RenderDeviceD3D12Impl :: RenderDeviceD3D12Impl(IReferenceCounters*           pRe
             sizeof(PipelineStateD3D12Impl),
             sizeof(ShaderResourceBindingD3D12Impl),
             sizeof(FenceD3D12Impl)
-        }
+        },
+        EngineCI.ObjectPoolPageSizes
     },
     m_pd3d12Device  {pd3d12Device},
     m_EngineAttribs {EngineCI    },
@@ -89,6 +91,8 @@ RenderDeviceD3D12Impl :: RenderDeviceD3D12Impl(IReferenceCounters*           pRe
     m_DeviceCaps.MinorVersion = 0;
     m_DeviceCaps.bSeparableProgramSupported = True;
     m_DeviceCaps.bMultithreadedResourceCreationSupported = True;
+    m_DeviceCaps.bMultiDrawIndirectSupported = True;
+    m_DeviceCaps.bIndirectDrawCountSupported = True;
 }
 
 RenderDeviceD3D12Impl::~RenderDeviceD3D12Impl()
@@ -287,6 +291,7 @@ IMPLEMENT_QUERY_INTERFACE( RenderDeviceD3D12Impl, IID_RenderDeviceD3D12, TRender
 
 void RenderDeviceD3D12Impl::CreatePipelineState(const PipelineStateDesc& PipelineDesc, IPipelineState** ppPipelineState)
 {
+    CPU_PROFILE_SCOPE("RenderDeviceD3D12Impl::CreatePipelineState");
     CreateDeviceObject("Pipeline State", PipelineDesc, ppPipelineState, 
         [&]()
         {
@@ -297,6 +302,19 @@ void RenderDeviceD3D12Impl::CreatePipelineState(const PipelineStateDesc& Pipelin
     );
 }
 
+void RenderDeviceD3D12Impl::CreatePipelineStateAsync(const PipelineStateDesc& PipelineDesc, IPipelineState* pFallbackPSO, IPipelineState** ppPipelineState)
+{
+    CPU_PROFILE_SCOPE("RenderDeviceD3D12Impl::CreatePipelineStateAsync");
+    CreateDeviceObject("Pipeline State", PipelineDesc, ppPipelineState, 
+        [&]()
+        {
+            PipelineStateD3D12Impl *pPipelineStateD3D12( NEW_RC_OBJ(m_PSOAllocator, "PipelineStateD3D12Impl instance", PipelineStateD3D12Impl)(this, PipelineDesc, true, pFallbackPSO) );
+            pPipelineStateD3D12->QueryInterface( IID_PipelineState, reinterpret_cast<IObject**>(ppPipelineState) );
+            OnCreateDeviceObject( pPipelineStateD3D12 );
+        } 
+    );
+}
+
 void RenderDeviceD3D12Impl :: CreateBufferFromD3DResource(ID3D12Resource* pd3d12Buffer, const BufferDesc& BuffDesc, RESOURCE_STATE InitialState, IBuffer** ppBuffer)
 {
     CreateDeviceObject("buffer", BuffDesc, ppBuffer, 
@@ -326,6 +344,7 @@ void RenderDeviceD3D12Impl :: CreateBuffer(const BufferDesc& BuffDesc, const Buf
 
 void RenderDeviceD3D12Impl :: CreateShader(const ShaderCreateInfo& ShaderCI, IShader** ppShader)
 {
+    CPU_PROFILE_SCOPE("RenderDeviceD3D12Impl::CreateShader");
     CreateDeviceObject( "shader", ShaderCI.Desc, ppShader, 
         [&]()
         {
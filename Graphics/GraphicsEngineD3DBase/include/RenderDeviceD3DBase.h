@@ -37,12 +37,13 @@ template<typename BaseInterface>
 class RenderDeviceD3DBase : public RenderDeviceBase<BaseInterface>
 {
 public:
-    RenderDeviceD3DBase(IReferenceCounters*      pRefCounters, 
-                        IMemoryAllocator&        RawMemAllocator, 
-                        IEngineFactory*          pEngineFactory,
-                        Uint32                   NumDeferredContexts,
-                        const DeviceObjectSizes& ObjectSizes) : 
-        RenderDeviceBase<BaseInterface>(pRefCounters, RawMemAllocator, pEngineFactory, NumDeferredContexts, ObjectSizes)
+    RenderDeviceD3DBase(IReferenceCounters*              pRefCounters, 
+                        IMemoryAllocator&                RawMemAllocator, 
+                        IEngineFactory*                  pEngineFactory,
+                        Uint32                           NumDeferredContexts,
+                        const DeviceObjectSizes&         ObjectSizes,
+                        const DeviceObjectPoolPageSizes& PoolPageSizes) : 
+        RenderDeviceBase<BaseInterface>(pRefCounters, RawMemAllocator, pEngineFactory, NumDeferredContexts, ObjectSizes, PoolPageSizes)
     {
         // Flag texture formats always supported in D3D11 and D3D12
 
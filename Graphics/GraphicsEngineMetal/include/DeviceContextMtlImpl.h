@@ -89,6 +89,10 @@ public:
 
     virtual void Draw(DrawAttribs& DrawAttribs)override final;
 
+    virtual void MultiDraw(const MultiDrawAttribs& Attribs)override final;
+
+    virtual void MultiDrawIndirect(const MultiDrawIndirectAttribs& Attribs)override final;
+
     virtual void DispatchCompute(const DispatchComputeAttribs& DispatchAttrs)override final;
 
     virtual void ClearDepthStencil(ITextureView*                  pView,
@@ -127,6 +131,8 @@ public:
 
     virtual void CopyTexture(const CopyTextureAttribs& CopyAttribs)override final;
 
+    virtual void MultiCopyTexture(const CopyTextureAttribs* pCopies, Uint32 NumCopies)override final;
+
     virtual void MapTextureSubresource( ITexture*                 pTexture,
                                         Uint32                    MipLevel,
                                         Uint32                    ArraySlice,
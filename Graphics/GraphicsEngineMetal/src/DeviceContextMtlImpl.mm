@@ -107,6 +107,26 @@ namespace Diligent
         LOG_ERROR_MESSAGE("DeviceContextMtlImpl::Draw() is not implemented");
     }
 
+    void DeviceContextMtlImpl::MultiDraw(const MultiDrawAttribs& Attribs)
+    {
+#ifdef DEVELOPMENT
+        if (!DvpVerifyMultiDrawArguments(Attribs))
+            return;
+#endif
+
+        LOG_ERROR_MESSAGE("DeviceContextMtlImpl::MultiDraw() is not implemented");
+    }
+
+    void DeviceContextMtlImpl::MultiDrawIndirect(const MultiDrawIndirectAttribs& Attribs)
+    {
+#ifdef DEVELOPMENT
+        if (!DvpVerifyMultiDrawIndirectArguments(Attribs))
+            return;
+#endif
+
+        LOG_ERROR_MESSAGE("DeviceContextMtlImpl::MultiDrawIndirect() is not implemented");
+    }
+
     void DeviceContextMtlImpl::DispatchCompute( const DispatchComputeAttribs &DispatchAttrs )
     {
 #ifdef DEVELOPMENT
@@ -243,6 +263,12 @@ namespace Diligent
         LOG_ERROR_MESSAGE("DeviceContextMtlImpl::CopyTexture() is not implemented");
     }
 
+    void DeviceContextMtlImpl::MultiCopyTexture(const CopyTextureAttribs* pCopies, Uint32 NumCopies)
+    {
+        for (Uint32 i=0; i < NumCopies; ++i)
+            CopyTexture(pCopies[i]);
+    }
+
 
     void DeviceContextMtlImpl::MapTextureSubresource( ITexture*                 pTexture,
                                                       Uint32                    MipLevel,
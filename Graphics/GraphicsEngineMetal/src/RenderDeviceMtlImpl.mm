@@ -59,7 +59,8 @@ RenderDeviceMtlImpl :: RenderDeviceMtlImpl(IReferenceCounters*        pRefCounte
             sizeof(PipelineStateMtlImpl),
             sizeof(ShaderResourceBindingMtlImpl),
             sizeof(FenceMtlImpl)
-        }
+        },
+        EngineAttribs.ObjectPoolPageSizes
     },
     m_EngineAttribs(EngineAttribs)
 {
@@ -31,6 +31,7 @@
 #include "BufferViewGLImpl.h"
 #include "RenderDeviceGLImpl.h"
 #include "GLContextState.h"
+#include "GLDynamicHeap.h"
 
 namespace Diligent
 {
@@ -63,10 +64,18 @@ public:
     virtual void QueryInterface( const INTERFACE_ID& IID, IObject** ppInterface )override;
 
     void UpdateData(DeviceContextGLImpl* pCtxGL, Uint32 Offset, Uint32 Size, const PVoid pData);
-    void CopyData(GLContextState& CtxState, BufferGLImpl& SrcBufferGL, Uint32 SrcOffset, Uint32 DstOffset, Uint32 Size);
-    void Map(GLContextState& CtxState, MAP_TYPE MapType, Uint32 MapFlags, PVoid& pMappedData );
+    void CopyData(GLContextState& CtxState, const GLDynamicHeap* pDynamicHeap, BufferGLImpl& SrcBufferGL, Uint32 SrcOffset, Uint32 DstOffset, Uint32 Size);
+    void Map(GLContextState& CtxState, GLDynamicHeap* pDynamicHeap, MAP_TYPE MapType, Uint32 MapFlags, PVoid& pMappedData );
     void Unmap();
 
+    /// Returns true if the buffer contents currently reside in the dynamic heap
+    bool IsInDynamicHeap()const { return m_DynamicHeapOffset != GLDynamicHeap::InvalidOffset; }
+    Uint32 GetDynamicHeapOffset()const { return m_DynamicHeapOffset; }
+
+#ifdef DEVELOPMENT
+    void DvpVerifyDynamicAllocation(const GLDynamicHeap* pDynamicHeap)const;
+#endif
+
     void BufferMemoryBarrier( Uint32 RequiredBarriers, class GLContextState &GLContextState );
 
     const GLObjectWrappers::GLBufferObj& GetGLHandle(){ return m_GlBuffer; }
@@ -82,8 +91,14 @@ private:
 
     GLObjectWrappers::GLBufferObj m_GlBuffer;
     Uint32 m_uiMapTarget;
+    Bool m_bMappedWithDSA = False;
     const GLenum m_GLUsageHint;
     const Bool m_bUseMapWriteDiscardBugWA;
+    // Dynamic uniform buffers are suballocated from the dynamic heap of the context when mapped 
+    // with MAP_FLAG_DISCARD, and are bound with glBindBufferRange() at the allocation offset
+    const Bool m_bUseDynamicHeap;
+    Uint32 m_DynamicHeapOffset = GLDynamicHeap::InvalidOffset;
+    Uint64 m_DynamicHeapFrame  = 0;
 };
 
 }
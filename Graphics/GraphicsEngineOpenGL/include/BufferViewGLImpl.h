@@ -35,7 +35,6 @@ namespace Diligent
 
 class FixedBlockMemoryAllocator;
 class IRenderDevice;
-class IDeviceContext;
 class BufferGLImpl;
 struct BufferViewDesc;
 
@@ -47,7 +46,6 @@ public:
 
     BufferViewGLImpl( IReferenceCounters*   pRefCounters,
                       RenderDeviceGLImpl*   pDevice, 
-                      IDeviceContext*       pContext,
                       const BufferViewDesc& ViewDesc, 
                       BufferGLImpl*         pBuffer,
                       bool                  bIsDefaultView);
@@ -31,6 +31,7 @@
 #include "BufferGLImpl.h"
 #include "TextureBaseGL.h"
 #include "PipelineStateGLImpl.h"
+#include "GLDynamicHeap.h"
 
 namespace Diligent
 {
@@ -48,7 +49,7 @@ class DeviceContextGLImpl final : public DeviceContextBase<IDeviceContextGL, Dev
 public:
     using TDeviceContextBase = DeviceContextBase<IDeviceContextGL, DeviceContextGLImplTraits>;
 
-    DeviceContextGLImpl(IReferenceCounters* pRefCounters, class RenderDeviceGLImpl* pDeviceGL, bool bIsDeferred);
+    DeviceContextGLImpl(IReferenceCounters* pRefCounters, class RenderDeviceGLImpl* pDeviceGL, bool bIsDeferred, const EngineGLCreateInfo& EngineCI);
 
     /// Queries the specific interface, see IObject::QueryInterface() for details.
     virtual void QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface )override final;
@@ -85,6 +86,10 @@ public:
 
     virtual void Draw(DrawAttribs& DrawAttribs)override final;
 
+    virtual void MultiDraw(const MultiDrawAttribs& Attribs)override final;
+
+    virtual void MultiDrawIndirect(const MultiDrawIndirectAttribs& Attribs)override final;
+
     virtual void DispatchCompute(const DispatchComputeAttribs& DispatchAttrs)override final;
 
     virtual void ClearDepthStencil(ITextureView*                  pView,
@@ -123,6 +128,8 @@ public:
 
     virtual void CopyTexture(const CopyTextureAttribs& CopyAttribs)override final;
 
+    virtual void MultiCopyTexture(const CopyTextureAttribs* pCopies, Uint32 NumCopies)override final;
+
     virtual void MapTextureSubresource(ITexture*                 pTexture,
                                        Uint32                    MipLevel,
                                        Uint32                    ArraySlice,
@@ -164,6 +171,9 @@ public:
 
     void ResetVAO();
 
+    /// Returns the dynamic heap, or null if persistently mapped buffers are not supported
+    GLDynamicHeap* GetDynamicHeap(){ return m_pDynamicHeap.get(); }
+
 protected:
     friend class BufferGLImpl;
     friend class TextureBaseGL;
@@ -172,6 +182,10 @@ protected:
     GLContextState m_ContextState;
 
 private:
+    void PrepareForDraw(DRAW_FLAGS Flags, bool IsIndexed, VALUE_TYPE IndexType, GLenum& GlTopology, GLenum& GlIndexType);
+    void DrawDirect(GLenum GlTopology, GLenum GlIndexType, Uint32 IndexSize, bool IsIndexed, const MultiDrawItem& Item);
+    void PostDraw();
+
     Uint32 m_CommitedResourcesTentativeBarriers;
 
     std::vector<class TextureBaseGL*> m_BoundWritableTextures;
@@ -179,6 +193,34 @@ private:
 
     bool m_bVAOIsUpToDate = false;
     GLObjectWrappers::GLFrameBufferObj m_DefaultFBO;
+
+    std::unique_ptr<GLDynamicHeap> m_pDynamicHeap;
+
+    // Buffer ranges collected by BindProgramResources() to be bound with a single glBindBuffersRange() call
+    struct MultiBindBufferRanges
+    {
+        void Reset(Uint32 Count)
+        {
+            Buffers.assign(Count, 0);
+            Offsets.assign(Count, 0);
+            Sizes  .assign(Count, 0);
+        }
+
+        void Set(Uint32 Index, GLuint Buffer, GLintptr Offset, GLsizeiptr Size)
+        {
+            Buffers[Index] = Buffer;
+            Offsets[Index] = Offset;
+            Sizes  [Index] = Size;
+        }
+
+        void Bind(GLenum Target)const;
+
+        std::vector<GLuint>     Buffers;
+        std::vector<GLintptr>   Offsets;
+        std::vector<GLsizeiptr> Sizes;
+    }m_MultiBindBuffers;
+    std::vector<const GLObjectWrappers::GLTextureObj*> m_MultiBindTextures;
+    std::vector<const GLObjectWrappers::GLSamplerObj*> m_MultiBindSamplers;
 };
 
 }
@@ -23,11 +23,14 @@
 
 #pragma once
 
+#include <list>
+
 #include "GraphicsTypes.h"
 #include "TextureView.h"
 #include "LockHelper.h"
 #include "HashUtils.h"
 #include "GLObjectWrapper.h"
+#include "RenderDeviceGL.h"
 
 namespace Diligent
 {
@@ -35,7 +38,8 @@ namespace Diligent
 class FBOCache
 {
 public:
-    FBOCache();
+    // MaxSize is the maximum number of FBOs in the cache. Zero means the size is not limited.
+    explicit FBOCache(Uint32 MaxSize);
     ~FBOCache();
 
     FBOCache(const FBOCache&)  = delete;
@@ -49,6 +53,9 @@ public:
                                                      class GLContextState& ContextState);
     void OnReleaseTexture(ITexture* pTexture);
 
+    // Adds the statistics of this cache to Stats
+    void AccumulateStatistics(ObjectCacheStatisticsGL& Stats);
+
 private:
     // This structure is used as the key to find FBO
     struct FBOCacheKey
@@ -65,7 +72,14 @@ private:
         Diligent::UniqueIdentifier DSId;
         TextureViewDesc DSVDesc;
 
-        mutable size_t Hash;
+        // The hash is computed by ComputeHash() once the key is fully initialized
+        size_t Hash;
+
+        void ComputeHash();
+
+        // Calls Handler for every distinct texture referenced by the key
+        template<typename HandlerType>
+        void ProcessTextures(HandlerType Handler)const;
 
         bool operator == (const FBOCacheKey &Key)const;
 
@@ -85,13 +99,32 @@ private:
     };
 
 
+    // Keys in the LRU list and in the texture map point to the keys stored in m_Cache. 
+    // Unlike iterators, pointers to the elements of unordered_map are not invalidated by rehashing.
+    using LRUListType = std::list<const FBOCacheKey*>;
+    struct CacheEntry
+    {
+        GLObjectWrappers::GLFrameBufferObj FBO;
+        LRUListType::iterator              LRUIt;
+    };
+    using CacheType = std::unordered_map<FBOCacheKey, CacheEntry, FBOCacheKeyHashFunc>;
+
+    void EraseEntry(CacheType::iterator It);
+
     friend class RenderDeviceGLImpl;
     ThreadingTools::LockFlag m_CacheLockFlag;
-    std::unordered_map<FBOCacheKey, GLObjectWrappers::GLFrameBufferObj, FBOCacheKeyHashFunc> m_Cache;
+    const Uint32 m_MaxSize;
+    CacheType    m_Cache;
+    // Most recently used keys are at the front of the list
+    LRUListType  m_LRUList;
     
     // Multimap that sets up correspondence between unique texture id and all
     // FBOs it is used in
-    std::unordered_multimap<Diligent::UniqueIdentifier, FBOCacheKey> m_TexIdToKey;
+    std::unordered_multimap<Diligent::UniqueIdentifier, const FBOCacheKey*> m_TexIdToKey;
+
+    Uint64 m_NumHits      = 0;
+    Uint64 m_NumMisses    = 0;
+    Uint64 m_NumEvictions = 0;
 };
 
 }
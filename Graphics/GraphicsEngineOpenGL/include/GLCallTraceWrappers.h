@@ -0,0 +1,185 @@
+/*     Copyright 2019 Diligent Graphics LLC
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+// Wrappers that route GL calls through GLCallTrace. The header must be included after the GL
+// headers. Functions loaded by GLEW are wrapped by GLEW_GET_FUN() macro (see pch.h), GL1.1 functions
+// exported by the GL library directly are wrapped by the macros at the end of this file.
+
+#include <cstdio>
+#include <cstdint>
+#include <type_traits>
+
+#include "GLCallTrace.h"
+
+namespace Diligent
+{
+
+namespace GLTraceDetail
+{
+
+template<typename T>
+typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+    FormatArg(String& Str, T Val)
+{
+    Str += std::to_string(static_cast<long long>(Val));
+}
+
+template<typename T>
+typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type
+    FormatArg(String& Str, T Val)
+{
+    Str += std::to_string(static_cast<unsigned long long>(Val));
+}
+
+template<typename T>
+typename std::enable_if<std::is_floating_point<T>::value>::type
+    FormatArg(String& Str, T Val)
+{
+    char Buffer[32];
+    snprintf(Buffer, sizeof(Buffer), "%.9g", static_cast<double>(Val));
+    Str += Buffer;
+}
+
+template<typename T>
+typename std::enable_if<std::is_pointer<T>::value>::type
+    FormatArg(String& Str, T Ptr)
+{
+    if (Ptr == nullptr)
+    {
+        Str += "NULL";
+        return;
+    }
+    char Buffer[32];
+    snprintf(Buffer, sizeof(Buffer), "0x%llx", static_cast<unsigned long long>(reinterpret_cast<std::uintptr_t>(Ptr)));
+    Str += Buffer;
+}
+
+inline void FormatArgs(String&)
+{
+}
+
+template<typename FirstArgType, typename... RestArgTypes>
+void FormatArgs(String& Str, const FirstArgType& FirstArg, const RestArgTypes&... RestArgs)
+{
+    FormatArg(Str, FirstArg);
+    if (sizeof...(RestArgTypes) > 0)
+        Str += ", ";
+    FormatArgs(Str, RestArgs...);
+}
+
+}
+
+/// Callable object that replaces GL function pointer and counts every call to the function
+template<typename ReturnType, typename... ArgTypes>
+class GLTracedFunction
+{
+public:
+    using FunctionPtrType = ReturnType (GLAPIENTRY *)(ArgTypes...);
+
+    GLTracedFunction(FunctionPtrType pFunction, const Char* Name) :
+        m_pFunction(pFunction),
+        m_Name     (Name)
+    {}
+
+    ReturnType operator()(ArgTypes... Args)const
+    {
+        if (GLCallTrace::CountCall(m_Name))
+        {
+            String ArgsStr;
+            GLTraceDetail::FormatArgs(ArgsStr, Args...);
+            GLCallTrace::AddToTrace(m_Name, std::move(ArgsStr));
+        }
+        return m_pFunction(Args...);
+    }
+
+    // Allows checking if the function is available, e.g. if(glCopyImageSubData)
+    operator FunctionPtrType()const { return m_pFunction; }
+
+private:
+    FunctionPtrType const m_pFunction;
+    const Char* const     m_Name;
+};
+
+template<typename ReturnType, typename... ArgTypes>
+GLTracedFunction<ReturnType, ArgTypes...> MakeGLTracedFunction(ReturnType (GLAPIENTRY *pFunction)(ArgTypes...), const Char* Name)
+{
+    return GLTracedFunction<ReturnType, ArgTypes...>{pFunction, Name};
+}
+
+}
+
+#define DILIGENT_TRACED_GL11_FUNCTION(Func) Diligent::MakeGLTracedFunction(::Func, #Func)
+
+#define glBindTexture             DILIGENT_TRACED_GL11_FUNCTION(glBindTexture)
+#define glBlendFunc               DILIGENT_TRACED_GL11_FUNCTION(glBlendFunc)
+#define glClear                   DILIGENT_TRACED_GL11_FUNCTION(glClear)
+#define glClearColor              DILIGENT_TRACED_GL11_FUNCTION(glClearColor)
+#define glClearDepth              DILIGENT_TRACED_GL11_FUNCTION(glClearDepth)
+#define glClearStencil            DILIGENT_TRACED_GL11_FUNCTION(glClearStencil)
+#define glColorMask               DILIGENT_TRACED_GL11_FUNCTION(glColorMask)
+#define glCopyTexImage2D          DILIGENT_TRACED_GL11_FUNCTION(glCopyTexImage2D)
+#define glCopyTexSubImage2D       DILIGENT_TRACED_GL11_FUNCTION(glCopyTexSubImage2D)
+#define glCullFace                DILIGENT_TRACED_GL11_FUNCTION(glCullFace)
+#define glDeleteTextures          DILIGENT_TRACED_GL11_FUNCTION(glDeleteTextures)
+#define glDepthFunc               DILIGENT_TRACED_GL11_FUNCTION(glDepthFunc)
+#define glDepthMask               DILIGENT_TRACED_GL11_FUNCTION(glDepthMask)
+#define glDisable                 DILIGENT_TRACED_GL11_FUNCTION(glDisable)
+#define glDrawArrays              DILIGENT_TRACED_GL11_FUNCTION(glDrawArrays)
+#define glDrawBuffer              DILIGENT_TRACED_GL11_FUNCTION(glDrawBuffer)
+#define glDrawElements            DILIGENT_TRACED_GL11_FUNCTION(glDrawElements)
+#define glEnable                  DILIGENT_TRACED_GL11_FUNCTION(glEnable)
+#define glFinish                  DILIGENT_TRACED_GL11_FUNCTION(glFinish)
+#define glFlush                   DILIGENT_TRACED_GL11_FUNCTION(glFlush)
+#define glFrontFace               DILIGENT_TRACED_GL11_FUNCTION(glFrontFace)
+#define glGenTextures             DILIGENT_TRACED_GL11_FUNCTION(glGenTextures)
+#define glGetBooleanv             DILIGENT_TRACED_GL11_FUNCTION(glGetBooleanv)
+#define glGetError                DILIGENT_TRACED_GL11_FUNCTION(glGetError)
+#define glGetFloatv               DILIGENT_TRACED_GL11_FUNCTION(glGetFloatv)
+#define glGetIntegerv             DILIGENT_TRACED_GL11_FUNCTION(glGetIntegerv)
+#define glGetString               DILIGENT_TRACED_GL11_FUNCTION(glGetString)
+#define glGetTexImage             DILIGENT_TRACED_GL11_FUNCTION(glGetTexImage)
+#define glGetTexLevelParameteriv  DILIGENT_TRACED_GL11_FUNCTION(glGetTexLevelParameteriv)
+#define glGetTexParameteriv       DILIGENT_TRACED_GL11_FUNCTION(glGetTexParameteriv)
+#define glHint                    DILIGENT_TRACED_GL11_FUNCTION(glHint)
+#define glIsEnabled               DILIGENT_TRACED_GL11_FUNCTION(glIsEnabled)
+#define glLineWidth               DILIGENT_TRACED_GL11_FUNCTION(glLineWidth)
+#define glPixelStorei             DILIGENT_TRACED_GL11_FUNCTION(glPixelStorei)
+#define glPolygonMode             DILIGENT_TRACED_GL11_FUNCTION(glPolygonMode)
+#define glPolygonOffset           DILIGENT_TRACED_GL11_FUNCTION(glPolygonOffset)
+#define glReadBuffer              DILIGENT_TRACED_GL11_FUNCTION(glReadBuffer)
+#define glReadPixels              DILIGENT_TRACED_GL11_FUNCTION(glReadPixels)
+#define glScissor                 DILIGENT_TRACED_GL11_FUNCTION(glScissor)
+#define glStencilFunc             DILIGENT_TRACED_GL11_FUNCTION(glStencilFunc)
+#define glStencilMask             DILIGENT_TRACED_GL11_FUNCTION(glStencilMask)
+#define glStencilOp               DILIGENT_TRACED_GL11_FUNCTION(glStencilOp)
+#define glTexImage1D              DILIGENT_TRACED_GL11_FUNCTION(glTexImage1D)
+#define glTexImage2D              DILIGENT_TRACED_GL11_FUNCTION(glTexImage2D)
+#define glTexParameterf           DILIGENT_TRACED_GL11_FUNCTION(glTexParameterf)
+#define glTexParameterfv          DILIGENT_TRACED_GL11_FUNCTION(glTexParameterfv)
+#define glTexParameteri           DILIGENT_TRACED_GL11_FUNCTION(glTexParameteri)
+#define glTexParameteriv          DILIGENT_TRACED_GL11_FUNCTION(glTexParameteriv)
+#define glTexSubImage1D           DILIGENT_TRACED_GL11_FUNCTION(glTexSubImage1D)
+#define glTexSubImage2D           DILIGENT_TRACED_GL11_FUNCTION(glTexSubImage2D)
+#define glViewport                DILIGENT_TRACED_GL11_FUNCTION(glViewport)
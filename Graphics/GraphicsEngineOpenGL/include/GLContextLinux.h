@@ -23,6 +23,8 @@
 
 #pragma once
 
+#include <unordered_map>
+
 namespace Diligent
 {
     class GLContext
@@ -36,9 +38,20 @@ namespace Diligent
 
         NativeGLContextType GetCurrentNativeGLContext();
 
+        // Creates a context that shares objects with the context current in the calling thread.
+        // Returns null if the context can't be created.
+        NativeGLContextType CreateSharedContext();
+        // Makes the shared context current in the calling thread (no drawable is bound), 
+        // or releases the current context if Context is null
+        bool MakeSharedContextCurrent(NativeGLContextType Context);
+        void DestroySharedContext(NativeGLContextType Context);
+
     private:
         void *m_pNativeWindow = nullptr;
         void *m_pDisplay = nullptr;
         NativeGLContextType m_Context;
+        // X display connection of every shared context. Each shared context has its own
+        // connection, which is closed when the context is destroyed.
+        std::unordered_map<NativeGLContextType, Display*> m_SharedCtxDisplays;
     };
 }
@@ -23,6 +23,8 @@
 
 #pragma once
 
+#include <limits>
+
 #include "GraphicsTypes.h"
 #include "GLObjectWrapper.h"
 #include "UniqueIdentifier.h"
@@ -43,6 +45,12 @@ public:
     void SetActiveTexture( Int32 Index );
     void BindTexture( Int32 Index, GLenum BindTarget, const GLObjectWrappers::GLTextureObj &Tex);
     void BindSampler( Uint32 Index, const GLObjectWrappers::GLSamplerObj &GLSampler);
+    // Multi-bind versions of BindTexture() and BindSampler() that bind objects to consecutive units 
+    // starting at FirstIndex with a single glBindTextures()/glBindSamplers() call. Null pointers unbind 
+    // the units. Only the range of units whose bindings change is updated. The active texture unit is 
+    // not affected. Must only be used when ContextCaps::bMultiBindSupported is true.
+    void BindTextures( Uint32 FirstIndex, Uint32 Count, const GLObjectWrappers::GLTextureObj* const* ppTextures );
+    void BindSamplers( Uint32 FirstIndex, Uint32 Count, const GLObjectWrappers::GLSamplerObj* const* ppSamplers );
     void BindImage( Uint32 Index, class TextureViewGLImpl *pTexView, GLint MipLevel, GLboolean IsLayered, GLint Layer, GLenum Access, GLenum Format );
     void BindImage( Uint32 Index, class BufferViewGLImpl *pBuffView, GLenum Access, GLenum Format );
     void EnsureMemoryBarrier(Uint32 RequiredBarriers, class AsyncWritableResource *pRes = nullptr);
@@ -83,6 +91,10 @@ public:
         bool bFillModeSelectionSupported = True;
         GLint m_iMaxCombinedTexUnits = 0;
         GLint m_iMaxDrawBuffers = 0;
+        // GL_ARB_multi_bind (core in GL4.4)
+        bool bMultiBindSupported = false;
+        // GL_ARB_direct_state_access (core in GL4.5)
+        bool bDirectStateAccessSupported = false;
     };
     const ContextCaps& GetContextCaps(){return m_Caps;}
 
@@ -137,6 +149,9 @@ private:
     };
     std::vector< BoundImageInfo > m_BoundImages;
 
+    // Scratch array of GL handles used by multi-bind functions
+    std::vector< GLuint > m_MultiBindHandles;
+
     Uint32 m_PendingMemoryBarriers = 0;
 
     class EnableStateHelper
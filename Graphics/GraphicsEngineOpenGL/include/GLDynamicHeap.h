@@ -0,0 +1,91 @@
+/*     Copyright 2019 Diligent Graphics LLC
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <deque>
+
+#include "BasicTypes.h"
+#include "MemoryAllocator.h"
+#include "RingBuffer.h"
+#include "GLObjectWrapper.h"
+
+namespace Diligent
+{
+
+/// Dynamic upload heap used by the device context to allocate space for the contents of dynamic buffers
+
+/// The heap is a single buffer created with glBufferStorage() that is persistently and coherently mapped
+/// for its entire lifetime. Space is suballocated from the buffer in a ring-buffer fashion, and every frame 
+/// is protected by a fence that is inserted by FinishFrame(). The space used by the frame is reclaimed once 
+/// the fence is signaled, so writing to the heap never stalls the GPU and does not require orphaning.
+class GLDynamicHeap
+{
+public:
+    GLDynamicHeap(IMemoryAllocator& Allocator, Uint32 Size, Uint32 Alignment);
+    ~GLDynamicHeap();
+
+    GLDynamicHeap(const GLDynamicHeap&)  = delete;
+    GLDynamicHeap(      GLDynamicHeap&&) = delete;
+    GLDynamicHeap& operator = (const GLDynamicHeap&)  = delete;
+    GLDynamicHeap& operator = (      GLDynamicHeap&&) = delete;
+
+    static constexpr Uint32 InvalidOffset = static_cast<Uint32>(-1);
+
+    /// Allocates Size bytes in the heap and returns the offset of the allocation, or InvalidOffset if 
+    /// there is not enough space even after all frames that are not used by the GPU have been released.
+    /// The allocation remains valid until the end of the current frame.
+    Uint32 Allocate(Uint32 Size);
+
+    /// Returns the CPU address of the memory at the given offset from the start of the heap
+    void* GetCPUAddress(Uint32 Offset)const
+    {
+        VERIFY_EXPR(Offset < m_RingBuffer.GetMaxSize());
+        return m_pMappedData + Offset;
+    }
+
+    /// Closes the current frame by inserting a fence into the GL command stream and 
+    /// releases space used by all frames that have been completed by the GPU
+    void FinishFrame();
+
+    /// Returns the number of the current frame that allocations are made from
+    Uint64 GetCurrentFrame()const { return m_CurrentFrame; }
+
+    const GLObjectWrappers::GLBufferObj& GetGLBuffer()const { return m_GLBuffer; }
+
+private:
+    void ReleaseCompletedFrames(bool WaitForOldestFrame);
+
+    GLObjectWrappers::GLBufferObj m_GLBuffer;
+    Uint8*                        m_pMappedData = nullptr;
+    RingBuffer                    m_RingBuffer;
+    const Uint32                  m_Alignment;
+
+    // Fences that protect frames that have not been completed by the GPU yet, in submission order
+    std::deque<std::pair<Uint64, GLObjectWrappers::GLSyncObj> > m_PendingFrames;
+    Uint64 m_CurrentFrame = 1;
+    // Set when an allocation fails to avoid repeating the warning for every buffer
+    bool   m_bOverflowReported = false;
+};
+
+}
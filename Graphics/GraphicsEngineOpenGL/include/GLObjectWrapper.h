@@ -23,11 +23,28 @@
 
 #pragma once
 
+#include <functional>
 #include "UniqueIdentifier.h"
 
 namespace GLObjectWrappers
 {
 
+/// Queue that receives GL objects released by threads that must not delete them directly,
+/// e.g. threads that have no current GL context
+class IDeferredReleaseQueue
+{
+public:
+    /// Returns true if the calling thread must not delete GL objects directly
+    virtual bool MustDeferRelease() = 0;
+
+    /// Enqueues the function that deletes the GL object
+    virtual void DeferRelease(std::function<void()>&& ReleaseFunc) = 0;
+};
+
+/// Installs the process-wide deferred release queue. Null uninstalls the queue.
+void SetDeferredReleaseQueue(IDeferredReleaseQueue* pQueue);
+IDeferredReleaseQueue* GetDeferredReleaseQueue();
+
 template<class CreateReleaseHelperType>
 class GLObjWrapper
 {
@@ -87,7 +104,15 @@ public:
     {
         if (m_uiHandle)
         {
-            m_CreateReleaseHelper.Release(m_uiHandle);
+            auto* pReleaseQueue = GetDeferredReleaseQueue();
+            if (pReleaseQueue != nullptr && pReleaseQueue->MustDeferRelease())
+            {
+                auto Handle = m_uiHandle;
+                auto Helper = m_CreateReleaseHelper;
+                pReleaseQueue->DeferRelease([Handle, Helper]()mutable{ Helper.Release(Handle); });
+            }
+            else
+                m_CreateReleaseHelper.Release(m_uiHandle);
             m_uiHandle = 0;
         }
     }
@@ -0,0 +1,79 @@
+/*     Copyright 2019 Diligent Graphics LLC
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+
+#include "BasicTypes.h"
+#include "GLObjectWrapper.h"
+
+namespace Diligent
+{
+
+/// On-disk cache of linked program binaries (glGetProgramBinary/glProgramBinary)
+
+/// Every program is stored in a separate file named after the program hash. In addition to the
+/// driver binary, the file keeps program resources serialized by GLProgramResources::Serialize(),
+/// so that a program found in the cache requires neither compilation, linking nor reflection.
+/// Files written by a different driver (vendor, renderer or version string) are ignored and 
+/// overwritten when the program is linked again. The cache may be used by several threads simultaneously.
+class GLProgramBinaryCache
+{
+public:
+    GLProgramBinaryCache(const Char* CacheDirectory);
+    ~GLProgramBinaryCache();
+
+    GLProgramBinaryCache(const GLProgramBinaryCache&)  = delete;
+    GLProgramBinaryCache(      GLProgramBinaryCache&&) = delete;
+    GLProgramBinaryCache& operator = (const GLProgramBinaryCache&)  = delete;
+    GLProgramBinaryCache& operator = (      GLProgramBinaryCache&&) = delete;
+
+    /// Loads the binary of the program identified by ProgramHash into GLProg and reads serialized program resources.
+    /// Returns false if the program is not found in the cache or if the driver rejects the binary. In the latter 
+    /// case, GLProg must not be used and the program must be linked from source into a new program object.
+    bool LoadProgram(size_t ProgramHash, const GLObjectWrappers::GLProgramObj& GLProg, std::vector<Uint8>& ResourceData);
+
+    /// Writes the binary of the linked program GLProg and its serialized resources to the cache
+    void StoreProgram(size_t ProgramHash, const GLObjectWrappers::GLProgramObj& GLProg, const std::vector<Uint8>& ResourceData);
+
+private:
+    String GetFilePath(size_t ProgramHash)const;
+
+    String m_CacheDirectory;
+    // Hash of the vendor, renderer and version strings of the driver that created the cache files
+    size_t m_DriverHash = 0;
+    // Set when a file can't be written to the cache directory to avoid repeating the error for every program
+    std::atomic_bool m_DisableStoring{false};
+
+    // Serializes file access so that a file is never read while it is being written by another thread
+    std::mutex m_FileMtx;
+
+    std::atomic<Uint32> m_NumLoaded  {0};
+    std::atomic<Uint32> m_NumRejected{0};
+    std::atomic<Uint32> m_NumStored  {0};
+};
+
+}
@@ -64,6 +64,22 @@ namespace Diligent
                           Uint32&                               ImageBinding,
                           Uint32&                               StorageBufferBinding);
 
+        /// Serializes program resources so that they can be restored by LoadSerializedUniforms() 
+        /// without querying the program (see GLProgramBinaryCache)
+        void Serialize(std::vector<Uint8>& Data)const;
+
+        /// Restores resources serialized by Serialize() for a program loaded from binary and assigns bindings
+        /// the same way LoadUniforms() does. Returns false if the data is malformed, in which case neither 
+        /// the object nor the binding counters are modified.
+        bool LoadSerializedUniforms(SHADER_TYPE                           ShaderStages,
+                                    const GLObjectWrappers::GLProgramObj& GLProgram,
+                                    class GLContextState&                 State,
+                                    const std::vector<Uint8>&             Data,
+                                    Uint32&                               UniformBufferBinding,
+                                    Uint32&                               SamplerBinding,
+                                    Uint32&                               ImageBinding,
+                                    Uint32&                               StorageBufferBinding);
+
         struct GLResourceAttribs
         {
 /*  0 */    const Char*                             Name;
@@ -460,6 +476,9 @@ namespace Diligent
                                std::vector<ImageInfo>&         Images,
                                std::vector<StorageBlockInfo>&  StorageBlocks);
 
+        // Assigns bindings of all resources in the program. The program must be current.
+        void ApplyBindings(const GLObjectWrappers::GLProgramObj& GLProgram)const;
+
 
         // There could be more than one stage if using non-separable programs
         SHADER_TYPE         m_ShaderStages = SHADER_TYPE_UNKNOWN; 
@@ -24,12 +24,18 @@
 #pragma once
 
 #include <memory>
+#include <functional>
+#include <mutex>
+#include <vector>
 #include "RenderDeviceBase.h"
 #include "GLContext.h"
 #include "VAOCache.h"
 #include "BaseInterfacesGL.h"
 #include "FBOCache.h"
 #include "TexRegionRender.h"
+#include "GLProgramBinaryCache.h"
+#include "GLContextState.h"
+#include "ThreadPool.h"
 
 enum class GPU_VENDOR
 {
@@ -88,6 +94,10 @@ public:
 
     virtual void IdleGPU()override final;
 
+    virtual void GetVAOCacheStatistics(ObjectCacheStatisticsGL& Stats)override final;
+
+    virtual void GetFBOCacheStatistics(ObjectCacheStatisticsGL& Stats)override final;
+
     const GPUInfo& GetGPUInfo(){ return m_GPUInfo; }
 
     FBOCache& GetFBOCache(GLContext::NativeGLContextType Context);
@@ -102,6 +112,31 @@ public:
 
     void InitTexRegionRender();
 
+    /// Returns the program binary cache, or null if the cache is disabled
+    GLProgramBinaryCache* GetProgramBinaryCache(){ return m_pProgramBinaryCache.get(); }
+
+    /// Returns true if GL objects requested by the calling thread must be created by a resource
+    /// worker thread, i.e. worker threads are enabled and the calling thread has no current GL context
+    bool ShouldUseResourceWorker()
+    {
+        return m_pResourceWorkerPool && m_GLContext.GetCurrentNativeGLContext() == GLContext::NativeGLContextType{};
+    }
+
+    /// Executes the task on a resource worker thread and waits until all GL commands issued by 
+    /// the task are complete, so that the objects it creates may be used by any other context
+    void ExecuteOnResourceWorker(const std::function<void()>& Task);
+
+    /// Returns the state of the GL context that must be used to create objects in the calling thread: 
+    /// the state of the resource worker context or the state of the immediate context
+    GLContextState& GetResourceCreationContextState();
+
+    /// Returns true if the calling thread is a resource worker thread
+    static bool IsResourceWorkerThread();
+
+    /// Deletes GL objects released by threads that had no current GL context.
+    /// Must be called by the thread that owns the immediate context.
+    void PurgeDeferredReleases();
+
 protected:
     friend class DeviceContextGLImpl;
     friend class TextureBaseGL;
@@ -119,15 +154,58 @@ protected:
 
     ThreadingTools::LockFlag m_VAOCacheLockFlag;
     std::unordered_map<GLContext::NativeGLContextType, VAOCache> m_VAOCache;
+    const Uint32 m_VAOCacheSize;
 
     ThreadingTools::LockFlag m_FBOCacheLockFlag;
     std::unordered_map<GLContext::NativeGLContextType, FBOCache> m_FBOCache;
+    const Uint32 m_FBOCacheSize;
 
     GPUInfo m_GPUInfo;
 
     std::unique_ptr<TexRegionRender> m_pTexRegionRender;
+
+    std::unique_ptr<GLProgramBinaryCache> m_pProgramBinaryCache;
+
+    // Every resource worker thread owns a context that shares objects with the main context
+    struct ResourceWorker
+    {
+        GLContext::NativeGLContextType   Context = {};
+        std::unique_ptr<GLContextState>  pContextState;
+        // Vertex array objects are not shared between contexts. Every worker keeps its own VAO bound
+        // so that buffers may be bound to GL_ELEMENT_ARRAY_BUFFER in core profile contexts.
+        GLObjectWrappers::GLVertexArrayObj VAO{false};
+    };
+    std::vector<ResourceWorker> m_ResourceWorkers;
+    std::unique_ptr<ThreadingTools::ThreadPool> m_pResourceWorkerPool;
+
+    // When worker threads are enabled, objects may be released by threads that have no current
+    // GL context. Such objects are deleted by the rendering thread, which also owns the non-shared 
+    // objects (VAOs and FBOs) that may be released from the caches by these threads.
+    class DeferredReleaseQueue final : public GLObjectWrappers::IDeferredReleaseQueue
+    {
+    public:
+        DeferredReleaseQueue(GLContext& Context) : m_GLContext{Context} {}
+
+        virtual bool MustDeferRelease()override final
+        {
+            return m_GLContext.GetCurrentNativeGLContext() == GLContext::NativeGLContextType{};
+        }
+
+        virtual void DeferRelease(std::function<void()>&& ReleaseFunc)override final;
+
+        void Purge();
+
+    private:
+        GLContext& m_GLContext;
+        std::mutex m_Mtx;
+        std::vector<std::function<void()>> m_PendingReleases;
+    };
+    DeferredReleaseQueue m_DeferredReleaseQueue{m_GLContext};
     
 private:
+    void InitResourceWorkers(Uint32 NumThreads);
+    void DestroyResourceWorkers();
+
     virtual void TestTextureFormat( TEXTURE_FORMAT TexFormat )override final;
     bool CheckExtension(const Char* ExtensionString);
     void FlagSupportedTexFormats();
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <mutex>
 #include "BaseInterfacesGL.h"
 #include "ShaderGL.h"
 #include "ShaderBase.h"
@@ -81,11 +82,37 @@ public:
     virtual Uint32 GetResourceCount()const override final;
     virtual ShaderResourceDesc GetResource(Uint32 Index)const override final;
 
-    static GLObjectWrappers::GLProgramObj LinkProgram(IShader** ppShaders, Uint32 NumShaders, bool IsSeparableProgram);
+    /// Creates the program from the shaders, loads program resources and assigns bindings.
+    /// If the program binary cache is enabled, the program and its resources are loaded from the cache
+    /// when possible, and are written to the cache after the program is linked otherwise.
+    static GLObjectWrappers::GLProgramObj CreateProgram(IShader**             ppShaders,
+                                                        Uint32                NumShaders,
+                                                        bool                  IsSeparableProgram,
+                                                        SHADER_TYPE           ShaderStages,
+                                                        class GLContextState& State,
+                                                        GLProgramResources&   Resources,
+                                                        Uint32&               UniformBufferBinding,
+                                                        Uint32&               SamplerBinding,
+                                                        Uint32&               ImageBinding,
+                                                        Uint32&               StorageBufferBinding);
 
 private:
+    static GLObjectWrappers::GLProgramObj LinkProgram(IShader** ppShaders, Uint32 NumShaders, bool IsSeparableProgram);
+
+    void CompileShader(const String& GLSLSource, IDataBlob** ppCompilerOutput);
+
+    // Returns the shader object, compiling the shader first if compilation has been deferred
+    const GLObjectWrappers::GLShaderObj& GetGLShaderObj();
+
     GLObjectWrappers::GLShaderObj m_GLShaderObj;
     GLProgramResources            m_Resources;
+
+    // Hash of the GLSL source that identifies the shader in the program binary cache
+    size_t m_SourceHash = 0;
+    // When the program binary cache is enabled, compilation is deferred until the shader is 
+    // linked into a program that is not found in the cache. The source is kept until then.
+    String     m_DeferredGLSLSource;
+    std::mutex m_DeferredCompileMtx;
 };
 
 }
@@ -89,11 +89,33 @@ public:
 
     virtual void UpdateData( class GLContextState& CtxState, Uint32 MipLevel, Uint32 Slice, const Box& DstBox, const TextureSubResData& SubresData ) = 0;
 
+    /// Returns the pixel pack buffer that keeps the data of a staging texture created with CPU_ACCESS_READ flag.
+    /// For all other textures, the buffer is null.
+    const GLObjectWrappers::GLBufferObj& GetPixelPackBuffer()const{ return m_PixelPackBuffer; }
+
+    /// Returns the offset of the subresource in the pixel pack buffer. Subresources are tightly packed
+    /// slice by slice, every row is aligned by GL_PACK_ALIGNMENT (4 bytes).
+    Uint32 GetPixelPackBufferOffset(Uint32 MipLevel, Uint32 Slice)const;
+    static Uint32 GetPixelPackRowStride(Uint32 RowSize){ return (RowSize + 3u) & ~3u; }
+
 protected:
     virtual void CreateViewInternal( const struct TextureViewDesc& ViewDesc, class ITextureView** ppView, bool bIsDefaultView )override;
     void SetDefaultGLParameters();
+    // Copies the source texture region into the pixel pack buffer of this staging texture
+    void ReadPixelsToPackBuffer(DeviceContextGLImpl* pDeviceCtxGL,
+                                TextureBaseGL*       pSrcTextureGL,
+                                Uint32               SrcMipLevel,
+                                Uint32               SrcSlice,
+                                const Box&           SrcBox,
+                                Uint32               DstMipLevel,
+                                Uint32               DstSlice,
+                                Uint32               DstX,
+                                Uint32               DstY,
+                                Uint32               DstZ);
 
     GLObjectWrappers::GLTextureObj m_GlTexture;
+    GLObjectWrappers::GLBufferObj  m_PixelPackBuffer{false};
+    Uint32                         m_PixelPackBufferSize = 0;
     const GLenum m_BindTarget;
     const GLenum m_GLTexFormat;
     //Uint32 m_uiMapTarget;
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <cstring>
+#include <list>
 #include "GraphicsTypes.h"
 #include "Buffer.h"
 #include "InputLayout.h"
@@ -31,6 +32,7 @@
 #include "HashUtils.h"
 #include "DeviceContextBase.h"
 #include "BaseInterfacesGL.h"
+#include "RenderDeviceGL.h"
 
 namespace Diligent
 {
@@ -38,7 +40,8 @@ namespace Diligent
 class VAOCache
 {
 public:
-    VAOCache();
+    // MaxSize is the maximum number of VAOs in the cache. Zero means the size is not limited.
+    explicit VAOCache(Uint32 MaxSize);
     ~VAOCache();
 
     VAOCache(const VAOCache&)  = delete;
@@ -58,6 +61,9 @@ public:
     void OnDestroyBuffer(IBuffer* pBuffer);
     void OnDestroyPSO(IPipelineState* pPSO);
 
+    // Adds the statistics of this cache to Stats
+    void AccumulateStatistics(ObjectCacheStatisticsGL& Stats);
+
 private:
     // This structure is used as the key to find VAO
     struct VAOCacheKey
@@ -86,11 +92,28 @@ private:
             Uint32           Offset;
         }Streams[MaxBufferSlots];
         
-        mutable size_t Hash = 0;
+        // The hash is computed by ComputeHash() once the key is fully initialized
+        size_t Hash = 0;
+
+        void ComputeHash()
+        {
+            Hash = Diligent::ComputeHash(PSOUId, IndexBufferUId, NumUsedSlots);
+            for (Uint32 slot = 0; slot < NumUsedSlots; ++slot)
+            {
+                const auto& CurrStream = Streams[slot];
+                // Stride and offset are combined into one value to save one HashCombine() per stream
+                HashCombine(Hash, CurrStream.BufferUId, (Uint64{CurrStream.Offset} << 32) | Uint64{CurrStream.Stride});
+            }
+        }
+
+        // Calls Handler for every distinct non-null buffer referenced by the key, including the index buffer
+        template<typename HandlerType>
+        void ProcessBuffers(HandlerType Handler)const;
 
         bool operator == (const VAOCacheKey &Key)const
         {
-            return PSOUId          == Key.PSOUId          &&
+            return Hash            == Key.Hash            &&
+                   PSOUId          == Key.PSOUId          &&
                    IndexBufferUId  == Key.IndexBufferUId  &&
                    NumUsedSlots    == Key.NumUsedSlots    &&
                    std::memcmp(Streams, Key.Streams, sizeof(StreamAttribs) * NumUsedSlots) == 0;
@@ -101,34 +124,40 @@ private:
     {
         std::size_t operator() ( const VAOCacheKey& Key )const
         {
-            if (Key.Hash == 0)
-            {
-                std::size_t Seed = 0;
-                HashCombine(Seed, Key.PSOUId, Key.IndexBufferUId, Key.NumUsedSlots);
-                for (Uint32 slot = 0; slot < Key.NumUsedSlots; ++slot)
-                {
-                    auto &CurrStream = Key.Streams[slot];
-                    HashCombine(Seed, CurrStream.BufferUId);
-                    HashCombine(Seed, CurrStream.Offset);
-                    HashCombine(Seed, CurrStream.Stride);
-                }
-                Key.Hash = Seed;
-            }
             return Key.Hash;
         }
     };
 
+    // Keys in the LRU list and in the reverse maps point to the keys stored in m_Cache. 
+    // Unlike iterators, pointers to the elements of unordered_map are not invalidated by rehashing.
+    using LRUListType = std::list<const VAOCacheKey*>;
+    struct CacheEntry
+    {
+        GLObjectWrappers::GLVertexArrayObj VAO;
+        LRUListType::iterator              LRUIt;
+    };
+    using CacheType = std::unordered_map<VAOCacheKey, CacheEntry, VAOCacheKeyHashFunc>;
+    using IdToKeyMapType = std::unordered_multimap<UniqueIdentifier, const VAOCacheKey*>;
+
+    void EraseEntry(CacheType::iterator It);
+    void EraseEntries(IdToKeyMapType& IdToKey, UniqueIdentifier Id);
 
     friend class RenderDeviceGLImpl;
     ThreadingTools::LockFlag m_CacheLockFlag;
-    std::unordered_map<VAOCacheKey, GLObjectWrappers::GLVertexArrayObj, VAOCacheKeyHashFunc> m_Cache;
-    std::unordered_multimap<const IPipelineState*, VAOCacheKey> m_PSOToKey;
-    std::unordered_multimap<const IBuffer*, VAOCacheKey> m_BuffToKey;
+    const Uint32   m_MaxSize;
+    CacheType      m_Cache;
+    // Most recently used keys are at the front of the list
+    LRUListType    m_LRUList;
+    IdToKeyMapType m_PSOToKey;
+    IdToKeyMapType m_BuffToKey;
+
+    Uint64 m_NumHits      = 0;
+    Uint64 m_NumMisses    = 0;
+    Uint64 m_NumEvictions = 0;
 
     // Any draw command fails if no VAO is bound. We will use this empty
     // VAO for draw commands with null input layout, such as these that
     // only use VertexID as input.
     GLObjectWrappers::GLVertexArrayObj m_EmptyVAO;
 };
-
 }
@@ -34,6 +34,13 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <algorithm>
+#include <atomic>
+
+#if defined(DILIGENT_GL_CALL_TRACING) && (PLATFORM_WIN32 || PLATFORM_LINUX || PLATFORM_MACOS)
+    // Route every function loaded by GLEW through GLCallTrace (see GLCallTraceWrappers.h)
+#   define GLEW_GET_FUN(x) Diligent::MakeGLTracedFunction(x, #x)
+#   define DILIGENT_USE_GL_CALL_TRACE_WRAPPERS 1
+#endif
 
 #if PLATFORM_WIN32
 
@@ -105,6 +112,10 @@
 #   error Unsupported platform
 #endif
 
+#ifdef DILIGENT_USE_GL_CALL_TRACE_WRAPPERS
+#   include "GLCallTraceWrappers.h"
+#endif
+
 #include "Errors.h"
 
 #include "PlatformDefinitions.h"
@@ -115,6 +126,49 @@
 #include "RenderDevice.h"
 #include "BaseInterfacesGL.h"
 
+// In release builds, CHECK_GL_ERROR() only calls glGetError() once every DILIGENT_GL_ERROR_CHECK_INTERVAL
+// invocations (see the CMake option with the same name). If the interval is 0, the errors are only
+// checked once per frame by IDeviceContext::FinishFrame(). Development builds check every command.
+#ifndef DILIGENT_GL_ERROR_CHECK_INTERVAL
+#   define DILIGENT_GL_ERROR_CHECK_INTERVAL 1
+#endif
+
+#if !defined(DEVELOPMENT) && DILIGENT_GL_ERROR_CHECK_INTERVAL != 1
+#   define DILIGENT_GL_BATCHED_ERROR_CHECKS 1
+#else
+#   define DILIGENT_GL_BATCHED_ERROR_CHECKS 0
+#endif
+
+#if DILIGENT_GL_BATCHED_ERROR_CHECKS
+
+#if DILIGENT_GL_ERROR_CHECK_INTERVAL > 0
+namespace Diligent
+{
+    inline bool IsGLErrorCheckDue()
+    {
+        static std::atomic<Uint32> NumChecks{0};
+        return NumChecks.fetch_add(1, std::memory_order_relaxed) % DILIGENT_GL_ERROR_CHECK_INTERVAL == 0;
+    }
+}
+
+#define CHECK_GL_ERROR(...)\
+{                                       \
+    if( Diligent::IsGLErrorCheckDue() ) \
+    {                                   \
+        auto err = glGetError();        \
+        if( err != GL_NO_ERROR )        \
+        {                               \
+            LogError<false>(__FUNCTION__, __FILE__, __LINE__, __VA_ARGS__, "\nGL Error Code: ", err, "\nThe error may have been raised by any command since the previous check"); \
+            UNEXPECTED("Error");        \
+        }                               \
+    }                                   \
+}
+#else
+#   define CHECK_GL_ERROR(...) do{}while(false)
+#endif
+
+#else
+
 #define CHECK_GL_ERROR(...)\
 {                                       \
     auto err = glGetError();            \
@@ -125,11 +179,37 @@
     }                                   \
 }
 
+#endif
+
+// When the checks are batched, errors raised by the commands whose checks were skipped remain queued.
+// REPORT_PENDING_GL_ERRORS() logs and clears them, and must be called before the commands whose errors
+// are queried by CHECK_GL_ERROR_AND_THROW() or directly by glGetError(). The number of iterations is 
+// limited as every error flag is returned once, but some drivers keep returning GL_CONTEXT_LOST.
+#if DILIGENT_GL_BATCHED_ERROR_CHECKS
+#define REPORT_PENDING_GL_ERRORS()\
+{                                       \
+    for( int i = 0; i < 8; ++i )        \
+    {                                   \
+        auto err = glGetError();        \
+        if( err == GL_NO_ERROR )        \
+            break;                      \
+        LOG_ERROR_MESSAGE("GL error ", err, " has been raised by one of the commands issued since the previous check"); \
+    }                                   \
+}
+#else
+#   define REPORT_PENDING_GL_ERRORS() do{}while(false)
+#endif
+
+// Object creation failures must be detected immediately, so CHECK_GL_ERROR_AND_THROW() always calls glGetError().
+// The remaining error flags are cleared, so that they are not attributed to the following commands.
 #define CHECK_GL_ERROR_AND_THROW(...)\
 {                                       \
     auto err = glGetError();            \
     if( err != GL_NO_ERROR )            \
+    {                                   \
+        REPORT_PENDING_GL_ERRORS();     \
         LogError<true>(__FUNCTION__, __FILE__, __LINE__, __VA_ARGS__, "\nGL Error Code: ", err); \
+    }                                   \
 }
 
 #ifdef DEVELOPMENT
@@ -0,0 +1,100 @@
+/*     Copyright 2019 Diligent Graphics LLC
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// GL API call counting and tracing layer
+
+// The layer is only compiled when DILIGENT_GL_CALL_TRACING macro is defined (see
+// DILIGENT_ENABLE_GL_CALL_TRACING CMake option). In this case every GL function called by
+// the OpenGL backend on Windows, Linux and MacOS goes through a wrapper that counts the call
+// and, while the capture is active, appends it to the trace. Otherwise the backend calls GL
+// directly and the layer adds no code to the binaries.
+
+#ifdef DILIGENT_GL_CALL_TRACING
+
+#include <vector>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// GL API call counter and tracer
+class GLCallTrace
+{
+public:
+    /// Number of calls made to one GL entry point during a frame
+    struct EntryPointStats
+    {
+        /// Entry point name, e.g. "glBindBuffer"
+        String Name;
+
+        /// Number of calls to the entry point
+        Uint32 NumCalls = 0;
+
+        /// Number of calls whose arguments were identical to the arguments of the previous call
+        /// of the same entry point. These are usually redundant state changes.
+        /// Arguments are only compared while the capture is active.
+        Uint32 NumRepeatedCalls = 0;
+    };
+
+    /// Returns the statistics of the last completed frame sorted by the number of calls
+    /// in descending order.
+    static void GetFrameStatistics(std::vector<EntryPointStats>& Stats);
+
+    /// Returns the total number of GL calls made during the last completed frame
+    static Uint32 GetFrameCallCount();
+
+    /// Starts a new capture. The trace recorded during the previous capture is discarded.
+    static void BeginCapture();
+
+    /// Stops the capture. The recorded trace remains available until the next capture begins.
+    static void EndCapture();
+
+    static bool IsCapturing();
+
+    /// Marks the frame boundary. The method is called by IDeviceContext::FinishFrame()
+    /// of the immediate context, so applications do not need to call it directly.
+    static void MarkFrame();
+
+    /// Writes the trace of the last capture as text, one call per line with all argument values.
+    /// Frames are separated by comment lines. Pointer arguments are recorded as addresses,
+    /// the data they reference is not captured.
+    static void GetTrace(String& Trace);
+
+    /// Saves the trace of the last capture to the file. Returns false if the file could not be written.
+    static bool SaveTrace(const Char* FilePath);
+
+    /// Counts the call. Returns true if the call must also be added to the trace with AddToTrace().
+    /// Name must point to a string with static storage duration.
+    static bool CountCall(const Char* Name);
+
+    /// Adds the call to the trace. Args is the comma-separated list of argument values.
+    static void AddToTrace(const Char* Name, String&& Args);
+};
+
+}
+
+#endif
@@ -36,6 +36,25 @@ namespace Diligent
 static constexpr INTERFACE_ID IID_RenderDeviceGL =
 { 0xb4b395b9, 0xac99, 0x4e8a, { 0xb7, 0xe1, 0x9d, 0xca, 0xd, 0x48, 0x56, 0x18 } };
 
+/// Statistics of the vertex array object or framebuffer object cache
+
+/// GL vertex array and framebuffer objects are not shared between GL contexts, so every
+/// context has its own caches. The statistics are accumulated by the caches of all contexts.
+struct ObjectCacheStatisticsGL
+{
+    /// Number of objects currently in the caches
+    Uint32 NumObjects   = 0;
+
+    /// Number of lookups that found an existing object
+    Uint64 NumHits      = 0;
+
+    /// Number of lookups that created a new object
+    Uint64 NumMisses    = 0;
+
+    /// Number of least recently used objects released because the cache was full
+    Uint64 NumEvictions = 0;
+};
+
 /// Interface to the render device object implemented in OpenGL
 class IRenderDeviceGL : public IRenderDevice
 {
@@ -76,6 +95,16 @@ public:
                                           const BufferDesc& BuffDesc,
                                           RESOURCE_STATE    InitialState,
                                           IBuffer**         ppBuffer) = 0;
+
+    /// Returns vertex array object cache statistics accumulated since the device was created
+
+    /// \param [out] Stats - Cache statistics, see Diligent::ObjectCacheStatisticsGL.
+    virtual void GetVAOCacheStatistics(ObjectCacheStatisticsGL& Stats) = 0;
+
+    /// Returns framebuffer object cache statistics accumulated since the device was created
+
+    /// \param [out] Stats - Cache statistics, see Diligent::ObjectCacheStatisticsGL.
+    virtual void GetFBOCacheStatistics(ObjectCacheStatisticsGL& Stats) = 0;
 };
 
 }
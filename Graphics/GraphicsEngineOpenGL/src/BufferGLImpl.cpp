@@ -41,6 +41,13 @@ static bool GetUseMapWriteDiscardBugWA(RenderDeviceGLImpl *pDeviceGL)
     return pDeviceGL->GetGPUInfo().Vendor == GPU_VENDOR::INTEL;
 }
 
+static bool GetUseDynamicHeap(const BufferDesc& Desc)
+{
+    // Vertex and index buffers are referenced by VAOs that are cached per buffer object,
+    // so only uniform buffers can be bound from the dynamic heap
+    return Desc.Usage == USAGE_DYNAMIC && Desc.BindFlags == BIND_UNIFORM_BUFFER;
+}
+
 static GLenum GetBufferBindTarget(const BufferDesc& Desc)
 {
     GLenum Target = GL_ARRAY_BUFFER;
@@ -85,14 +92,16 @@ BufferGLImpl::BufferGLImpl(IReferenceCounters*          pRefCounters,
     m_GlBuffer                {true                                 }, // Create buffer immediately
     m_uiMapTarget             {0                                    },
     m_GLUsageHint             {UsageToGLUsage(BuffDesc.Usage)       },
-    m_bUseMapWriteDiscardBugWA{GetUseMapWriteDiscardBugWA(pDeviceGL)}
+    m_bUseMapWriteDiscardBugWA{GetUseMapWriteDiscardBugWA(pDeviceGL)},
+    m_bUseDynamicHeap         {GetUseDynamicHeap(BuffDesc)          }
 {
     if( BuffDesc.Usage == USAGE_STATIC && (pBuffData == nullptr || pBuffData->pData == nullptr) )
         LOG_ERROR_AND_THROW("Static buffer must be initialized with data at creation time");
 
     auto Target = GetBufferBindTarget(BuffDesc);
 
-    if (Target == GL_ARRAY_BUFFER || Target == GL_ELEMENT_ARRAY_BUFFER)
+    // pCtxGL is null when the buffer is created by a resource worker thread that keeps its own VAO bound
+    if ((Target == GL_ARRAY_BUFFER || Target == GL_ELEMENT_ARRAY_BUFFER) && pCtxGL != nullptr)
     {
         // We must unbind VAO because otherwise we will break the bindings
         pCtxGL->ResetVAO();
@@ -159,7 +168,7 @@ static BufferDesc GetBufferDescFromGLHandle(DeviceContextGLImpl* pCtxGL, BufferD
     // If binding a buffer to a target does not work, these operations can be skipped
     GLenum BindTarget = GetBufferBindTarget(BuffDesc);
 
-    if (BindTarget == GL_ARRAY_BUFFER || BindTarget == GL_ELEMENT_ARRAY_BUFFER)
+    if ((BindTarget == GL_ARRAY_BUFFER || BindTarget == GL_ELEMENT_ARRAY_BUFFER) && pCtxGL != nullptr)
     {
         // We must unbind VAO because otherwise we will break the bindings
         pCtxGL->ResetVAO();
@@ -202,7 +211,8 @@ BufferGLImpl::BufferGLImpl(IReferenceCounters*          pRefCounters,
     m_GlBuffer                {true, GLObjectWrappers::GLBufferObjCreateReleaseHelper(GLHandle)},
     m_uiMapTarget             {0                                    },
     m_GLUsageHint             {UsageToGLUsage(BuffDesc.Usage)       },
-    m_bUseMapWriteDiscardBugWA{GetUseMapWriteDiscardBugWA(pDeviceGL)}
+    m_bUseMapWriteDiscardBugWA{GetUseMapWriteDiscardBugWA(pDeviceGL)},
+    m_bUseDynamicHeap         {GetUseDynamicHeap(BuffDesc)          }
 {
 }
 
@@ -215,16 +225,26 @@ IMPLEMENT_QUERY_INTERFACE(BufferGLImpl, IID_BufferGL, TBufferBase)
 
 void BufferGLImpl :: UpdateData(DeviceContextGLImpl* pCtxGL, Uint32 Offset, Uint32 Size, const PVoid pData)
 {
-    // We must unbind VAO because otherwise we will break the bindings
-    pCtxGL->ResetVAO();
-
     BufferMemoryBarrier(
         GL_BUFFER_UPDATE_BARRIER_BIT,// Reads or writes to buffer objects via any OpenGL API functions that allow 
                                      // modifying their contents will reflect data written by shaders prior to the barrier. 
                                      // Additionally, writes via these commands issued after the barrier will wait on 
                                      // the completion of any shader writes to the same memory initiated prior to the barrier.
         pCtxGL->GetContextState());
-    
+
+#if GL_ARB_direct_state_access
+    if (pCtxGL->GetContextState().GetContextCaps().bDirectStateAccessSupported)
+    {
+        // The buffer is not bound to any target, so VAO bindings are not affected
+        glNamedBufferSubData(m_GlBuffer, Offset, Size, pData);
+        CHECK_GL_ERROR("glNamedBufferSubData() failed");
+        return;
+    }
+#endif
+
+    // We must unbind VAO because otherwise we will break the bindings
+    pCtxGL->ResetVAO();
+
     glBindBuffer(GL_ARRAY_BUFFER, m_GlBuffer);
     // All buffer bind targets (GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER etc.) relate to the same 
     // kind of objects. As a result they are all equivalent from a transfer point of view.
@@ -234,7 +254,7 @@ void BufferGLImpl :: UpdateData(DeviceContextGLImpl* pCtxGL, Uint32 Offset, Uint
 }
 
 
-void BufferGLImpl :: CopyData(GLContextState& CtxState, BufferGLImpl& SrcBufferGL, Uint32 SrcOffset, Uint32 DstOffset, Uint32 Size)
+void BufferGLImpl :: CopyData(GLContextState& CtxState, const GLDynamicHeap* pDynamicHeap, BufferGLImpl& SrcBufferGL, Uint32 SrcOffset, Uint32 DstOffset, Uint32 Size)
 {
     BufferMemoryBarrier(
         GL_BUFFER_UPDATE_BARRIER_BIT,// Reads or writes to buffer objects via any OpenGL API functions that allow 
@@ -251,18 +271,68 @@ void BufferGLImpl :: CopyData(GLContextState& CtxState, BufferGLImpl& SrcBufferG
     // Neither target is used for anything else by OpenGL, and so you can safely bind buffers to them for 
     // the purposes of copying or staging data without disturbing OpenGL state or needing to keep track of 
     // what was bound to the target before your copy.
-    glBindBuffer(GL_COPY_WRITE_BUFFER, m_GlBuffer);
-    glBindBuffer(GL_COPY_READ_BUFFER, SrcBufferGL.m_GlBuffer);
+    GLuint DstGLBuffer = m_GlBuffer;
+    if (IsInDynamicHeap())
+    {
+        VERIFY_EXPR(pDynamicHeap != nullptr);
+        DstGLBuffer = pDynamicHeap->GetGLBuffer();
+        DstOffset  += m_DynamicHeapOffset;
+    }
+    GLuint SrcGLBuffer = SrcBufferGL.m_GlBuffer;
+    if (SrcBufferGL.IsInDynamicHeap())
+    {
+        VERIFY_EXPR(pDynamicHeap != nullptr);
+        SrcGLBuffer = pDynamicHeap->GetGLBuffer();
+        SrcOffset  += SrcBufferGL.m_DynamicHeapOffset;
+    }
+
+#if GL_ARB_direct_state_access
+    if (CtxState.GetContextCaps().bDirectStateAccessSupported)
+    {
+        glCopyNamedBufferSubData(SrcGLBuffer, DstGLBuffer, SrcOffset, DstOffset, Size);
+        CHECK_GL_ERROR("glCopyNamedBufferSubData() failed");
+        return;
+    }
+#endif
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, DstGLBuffer);
+    glBindBuffer(GL_COPY_READ_BUFFER, SrcGLBuffer);
     glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, SrcOffset, DstOffset, Size);
     CHECK_GL_ERROR("glCopyBufferSubData() failed");
     glBindBuffer(GL_COPY_READ_BUFFER, 0);
     glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
 }
 
-void BufferGLImpl :: Map(GLContextState& CtxState, MAP_TYPE MapType, Uint32 MapFlags, PVoid &pMappedData)
+void BufferGLImpl :: Map(GLContextState& CtxState, GLDynamicHeap* pDynamicHeap, MAP_TYPE MapType, Uint32 MapFlags, PVoid &pMappedData)
 {
     VERIFY( m_uiMapTarget == 0, "Buffer is already mapped");
 
+    if (pDynamicHeap != nullptr && m_bUseDynamicHeap && MapType == MAP_WRITE)
+    {
+        if (MapFlags & MAP_FLAG_DISCARD)
+        {
+            // Instead of orphaning the buffer storage, allocate new space in the persistently mapped heap.
+            // The heap is coherent, so neither flushing nor unmapping is required.
+            auto Offset = pDynamicHeap->Allocate(m_Desc.uiSizeInBytes);
+            if (Offset != GLDynamicHeap::InvalidOffset)
+            {
+                m_DynamicHeapOffset = Offset;
+                m_DynamicHeapFrame  = pDynamicHeap->GetCurrentFrame();
+                pMappedData = pDynamicHeap->GetCPUAddress(Offset);
+                return;
+            }
+        }
+        else if ((MapFlags & MAP_FLAG_DO_NOT_SYNCHRONIZE) != 0 && IsInDynamicHeap() && m_DynamicHeapFrame == pDynamicHeap->GetCurrentFrame())
+        {
+            // With MAP_FLAG_DO_NOT_SYNCHRONIZE, the application only writes to the parts of the buffer 
+            // that are not used by the GPU, so the allocation can be written to directly
+            pMappedData = pDynamicHeap->GetCPUAddress(m_DynamicHeapOffset);
+            return;
+        }
+    }
+    // Buffer contents are written to the buffer's own storage
+    m_DynamicHeapOffset = GLDynamicHeap::InvalidOffset;
+
     BufferMemoryBarrier(
         GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT,// Access by the client to persistent mapped regions of buffer 
                                             // objects will reflect data written by shaders prior to the barrier. 
@@ -270,7 +340,10 @@ void BufferGLImpl :: Map(GLContextState& CtxState, MAP_TYPE MapType, Uint32 MapF
         CtxState);
 
     m_uiMapTarget = ( MapType == MAP_READ ) ? GL_COPY_READ_BUFFER : GL_COPY_WRITE_BUFFER;
-    glBindBuffer(m_uiMapTarget, m_GlBuffer);
+    // With direct state access, the buffer is not bound, and the map target only indicates that the buffer is mapped
+    m_bMappedWithDSA = CtxState.GetContextCaps().bDirectStateAccessSupported;
+    if (!m_bMappedWithDSA)
+        glBindBuffer(m_uiMapTarget, m_GlBuffer);
 
     // !!!WARNING!!! GL_MAP_UNSYNCHRONIZED_BIT is not the same thing as MAP_FLAG_DO_NOT_WAIT.
     // If GL_MAP_UNSYNCHRONIZED_BIT flag is set, OpenGL will not attempt to synchronize operations 
@@ -299,7 +372,12 @@ void BufferGLImpl :: Map(GLContextState& CtxState, MAP_TYPE MapType, Uint32 MapF
                     // implementation to simply reallocate storage for that buffer object under-the-hood.
                     // Since NULL is passed, if there wasn't a need for synchronization to begin with, 
                     // this can be reduced to a no-op.
-                    glBufferData(m_uiMapTarget, m_Desc.uiSizeInBytes, nullptr, m_GLUsageHint);
+#if GL_ARB_direct_state_access
+                    if (m_bMappedWithDSA)
+                        glNamedBufferData(m_GlBuffer, m_Desc.uiSizeInBytes, nullptr, m_GLUsageHint);
+                    else
+#endif
+                        glBufferData(m_uiMapTarget, m_Desc.uiSizeInBytes, nullptr, m_GLUsageHint);
                     CHECK_GL_ERROR("glBufferData() failed");
                     Access |= GL_MAP_WRITE_BIT;
                 }
@@ -334,6 +412,16 @@ void BufferGLImpl :: Map(GLContextState& CtxState, MAP_TYPE MapType, Uint32 MapF
         default: UNEXPECTED( "Unknown map type" );
     }
 
+#if GL_ARB_direct_state_access
+    if (m_bMappedWithDSA)
+    {
+        pMappedData = glMapNamedBufferRange(m_GlBuffer, 0, m_Desc.uiSizeInBytes,  Access);
+        CHECK_GL_ERROR("glMapNamedBufferRange() failed");
+        VERIFY( pMappedData, "Map failed" );
+        return;
+    }
+#endif
+
     pMappedData = glMapBufferRange(m_uiMapTarget, 0, m_Desc.uiSizeInBytes,  Access);
     CHECK_GL_ERROR("glMapBufferRange() failed");
     VERIFY( pMappedData, "Map failed" );
@@ -342,8 +430,26 @@ void BufferGLImpl :: Map(GLContextState& CtxState, MAP_TYPE MapType, Uint32 MapF
 
 void BufferGLImpl::Unmap()
 {
-    glBindBuffer(m_uiMapTarget, m_GlBuffer);
-    auto Result = glUnmapBuffer(m_uiMapTarget);
+    if (m_uiMapTarget == 0)
+    {
+        // The buffer was mapped from the coherent dynamic heap that is never unmapped
+        VERIFY(IsInDynamicHeap(), "Buffer is not mapped");
+        return;
+    }
+
+    GLboolean Result = GL_FALSE;
+#if GL_ARB_direct_state_access
+    if (m_bMappedWithDSA)
+    {
+        Result = glUnmapNamedBuffer(m_GlBuffer);
+    }
+    else
+#endif
+    {
+        glBindBuffer(m_uiMapTarget, m_GlBuffer);
+        Result = glUnmapBuffer(m_uiMapTarget);
+        glBindBuffer(m_uiMapTarget, 0);
+    }
     // glUnmapBuffer() returns TRUE unless data values in the buffer's data store have
     // become corrupted during the period that the buffer was mapped. Such corruption
     // can be the result of a screen resolution change or other window system - dependent
@@ -353,10 +459,21 @@ void BufferGLImpl::Unmap()
     // has occurred, glUnmapBuffer() returns FALSE, and the contents of the buffer's
     // data store become undefined.
     VERIFY( Result != GL_FALSE, "Failed to unmap buffer. The data may have been corrupted" ); (void)Result;
-    glBindBuffer(m_uiMapTarget, 0);
     m_uiMapTarget = 0;
 }
 
+#ifdef DEVELOPMENT
+void BufferGLImpl::DvpVerifyDynamicAllocation(const GLDynamicHeap* pDynamicHeap)const
+{
+    if (!IsInDynamicHeap())
+        return;
+
+    VERIFY_EXPR(pDynamicHeap != nullptr);
+    auto CurrentFrame = pDynamicHeap->GetCurrentFrame();
+    DEV_CHECK_ERR(m_DynamicHeapFrame == CurrentFrame, "Dynamic allocation of dynamic buffer '", m_Desc.Name, "' in frame ", CurrentFrame, " is out-of-date. Note: contents of dynamic uniform buffers is discarded at the end of every frame. A buffer must be mapped before its first use in any frame.");
+}
+#endif
+
 void BufferGLImpl::BufferMemoryBarrier( Uint32 RequiredBarriers, GLContextState &GLContextState )
 {
 #if GL_ARB_shader_image_load_store
@@ -389,6 +506,15 @@ void BufferGLImpl::CreateViewInternal(const BufferViewDesc& OrigViewDesc, class
     
     *ppView = nullptr;
 
+    auto* pDeviceGL = GetDevice();
+    if (pDeviceGL->ShouldUseResourceWorker())
+    {
+        pDeviceGL->ExecuteOnResourceWorker([&](){ CreateViewInternal(OrigViewDesc, ppView, bIsDefaultView); });
+        return;
+    }
+
+    REPORT_PENDING_GL_ERRORS();
+
     try
     {
         auto ViewDesc = OrigViewDesc;
@@ -398,10 +524,7 @@ void BufferGLImpl::CreateViewInternal(const BufferViewDesc& OrigViewDesc, class
         auto &BuffViewAllocator = pDeviceGLImpl->GetBuffViewObjAllocator();
         VERIFY( &BuffViewAllocator == &m_dbgBuffViewAllocator, "Buff view allocator does not match allocator provided at buffer initialization" );
 
-        auto pContext = pDeviceGLImpl->GetImmediateContext();
-        VERIFY( pContext, "Immediate context has been released" );
-        
-        *ppView = NEW_RC_OBJ(BuffViewAllocator, "BufferViewGLImpl instance", BufferViewGLImpl, bIsDefaultView ? this : nullptr)(pDeviceGLImpl, pContext, ViewDesc, this, bIsDefaultView);
+        *ppView = NEW_RC_OBJ(BuffViewAllocator, "BufferViewGLImpl instance", BufferViewGLImpl, bIsDefaultView ? this : nullptr)(pDeviceGLImpl, ViewDesc, this, bIsDefaultView);
         
         if( !bIsDefaultView )
             (*ppView)->AddRef();
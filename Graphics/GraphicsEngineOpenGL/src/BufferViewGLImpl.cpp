@@ -33,7 +33,6 @@ namespace Diligent
 {
     BufferViewGLImpl::BufferViewGLImpl( IReferenceCounters*     pRefCounters,
                                         RenderDeviceGLImpl*     pDevice, 
-                                        IDeviceContext*         pContext,
                                         const BufferViewDesc&   ViewDesc, 
                                         BufferGLImpl*           pBuffer,
                                         bool                    bIsDefaultView) :
@@ -60,8 +59,7 @@ namespace Diligent
 #   pragma warning(pop)
 #endif
 
-            auto* pContextGL = ValidatedCast<DeviceContextGLImpl>(pContext);
-            auto& ContextState = pContextGL->GetContextState();
+            auto& ContextState = pDevice->GetResourceCreationContextState();
 
             m_GLTexBuffer.Create();
             ContextState.BindTexture(-1, GL_TEXTURE_BUFFER, m_GLTexBuffer);
@@ -28,6 +28,8 @@
 
 #include "SwapChainGL.h"
 #include "DeviceContextGLImpl.h"
+#include "CPUProfiler.h"
+#include "GLCallTrace.h"
 #include "RenderDeviceGLImpl.h"
 #include "GLTypeConversions.h"
 
@@ -45,12 +47,13 @@
 #include "PipelineStateGLImpl.h"
 #include "FenceGLImpl.h"
 #include "ShaderResourceBindingGLImpl.h"
+#include "EngineMemory.h"
 
 using namespace std;
 
 namespace Diligent
 {
-    DeviceContextGLImpl::DeviceContextGLImpl(IReferenceCounters* pRefCounters, class RenderDeviceGLImpl* pDeviceGL, bool bIsDeferred) : 
+    DeviceContextGLImpl::DeviceContextGLImpl(IReferenceCounters* pRefCounters, class RenderDeviceGLImpl* pDeviceGL, bool bIsDeferred, const EngineGLCreateInfo& EngineCI) : 
         TDeviceContextBase
         {
             pRefCounters,
@@ -63,6 +66,27 @@ namespace Diligent
     {
         m_BoundWritableTextures.reserve( 16 );
         m_BoundWritableBuffers.reserve( 16 );
+
+#if GL_ARB_buffer_storage
+        const auto& DeviceCaps = pDeviceGL->GetDeviceCaps();
+        bool bBufferStorageSupported = DeviceCaps.DevType == DeviceType::OpenGL &&
+                                       (DeviceCaps.MajorVersion >= 5 || (DeviceCaps.MajorVersion == 4 && DeviceCaps.MinorVersion >= 4) ||
+                                        pDeviceGL->CheckExtension("GL_ARB_buffer_storage"));
+        if (EngineCI.DynamicHeapSize != 0 && bBufferStorageSupported)
+        {
+            GLint UBOffsetAlignment = 0;
+            glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &UBOffsetAlignment);
+            CHECK_GL_ERROR("Failed to get uniform buffer offset alignment");
+            try
+            {
+                m_pDynamicHeap.reset(new GLDynamicHeap{GetRawAllocator(), EngineCI.DynamicHeapSize, static_cast<Uint32>(UBOffsetAlignment)});
+            }
+            catch (const std::runtime_error&)
+            {
+                LOG_WARNING_MESSAGE("Failed to create dynamic heap. Dynamic buffers will be updated using buffer orphaning.");
+            }
+        }
+#endif
     }
 
     IMPLEMENT_QUERY_INTERFACE( DeviceContextGLImpl, IID_DeviceContextGL, TDeviceContextBase )
@@ -145,6 +169,7 @@ namespace Diligent
 
     void DeviceContextGLImpl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
     {
+        CPU_PROFILE_SCOPE("DeviceContextGLImpl::CommitShaderResources");
         if (!DeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0))
             return;
 
@@ -356,6 +381,17 @@ namespace Diligent
             CommitRenderTargets();
     }
 
+    void DeviceContextGLImpl::MultiBindBufferRanges::Bind(GLenum Target)const
+    {
+#if GL_ARB_multi_bind
+        // Offsets and sizes are ignored for zero buffers, which unbind the corresponding binding points
+        glBindBuffersRange(Target, 0, static_cast<GLsizei>(Buffers.size()), Buffers.data(), Offsets.data(), Sizes.data());
+        DEV_CHECK_GL_ERROR("Failed to bind buffer ranges");
+#else
+        UNSUPPORTED("GL_ARB_multi_bind is not supported");
+#endif
+    }
+
     void DeviceContextGLImpl::BindProgramResources(Uint32& NewMemoryBarriers, IShaderResourceBinding* pResBinding)
     {
         if (!m_pPipelineState)
@@ -376,6 +412,12 @@ namespace Diligent
         VERIFY_EXPR(m_BoundWritableTextures.empty());
         VERIFY_EXPR(m_BoundWritableBuffers.empty());
 
+        // With GL_ARB_multi_bind, bindings of every resource class are collected and set with a single call.
+        // Units that have no resource in the cache are unbound rather than left unchanged.
+        const bool UseMultiBind = m_ContextState.GetContextCaps().bMultiBindSupported;
+
+        if (UseMultiBind)
+            m_MultiBindBuffers.Reset(ResourceCache.GetUBCount());
         for (Uint32 ub = 0; ub < ResourceCache.GetUBCount(); ++ub)
         {
             const auto& UB = ResourceCache.GetConstUB(ub);
@@ -388,9 +430,36 @@ namespace Diligent
                                         // will reflect data written by shaders prior to the barrier
                 m_ContextState);
 
-            glBindBufferBase(GL_UNIFORM_BUFFER, ub, pBufferGL->m_GlBuffer);
+            if (pBufferGL->IsInDynamicHeap())
+            {
+#ifdef DEVELOPMENT
+                pBufferGL->DvpVerifyDynamicAllocation(m_pDynamicHeap.get());
+#endif
+                if (UseMultiBind)
+                {
+                    m_MultiBindBuffers.Set(ub, m_pDynamicHeap->GetGLBuffer(), pBufferGL->GetDynamicHeapOffset(), pBufferGL->GetDesc().uiSizeInBytes);
+                    continue;
+                }
+                glBindBufferRange(GL_UNIFORM_BUFFER, ub, m_pDynamicHeap->GetGLBuffer(), pBufferGL->GetDynamicHeapOffset(), pBufferGL->GetDesc().uiSizeInBytes);
+            }
+            else
+            {
+                if (UseMultiBind)
+                {
+                    m_MultiBindBuffers.Set(ub, pBufferGL->m_GlBuffer, 0, pBufferGL->GetDesc().uiSizeInBytes);
+                    continue;
+                }
+                glBindBufferBase(GL_UNIFORM_BUFFER, ub, pBufferGL->m_GlBuffer);
+            }
             DEV_CHECK_GL_ERROR("Failed to bind uniform buffer to slot ", ub);
-            //glBindBufferRange(GL_UNIFORM_BUFFER, it->Index, pBufferGL->m_GlBuffer, 0, pBufferGL->GetDesc().uiSizeInBytes);
+        }
+        if (UseMultiBind && ResourceCache.GetUBCount() > 0)
+            m_MultiBindBuffers.Bind(GL_UNIFORM_BUFFER);
+
+        if (UseMultiBind)
+        {
+            m_MultiBindTextures.assign(ResourceCache.GetSamplerCount(), nullptr);
+            m_MultiBindSamplers.assign(ResourceCache.GetSamplerCount(), nullptr);
         }
 
         for (Uint32 s = 0; s < ResourceCache.GetSamplerCount(); ++s)
@@ -405,7 +474,10 @@ namespace Diligent
                 auto* pTexViewGL = Sam.pView.RawPtr<TextureViewGLImpl>();
                 auto* pTextureGL = ValidatedCast<TextureBaseGL>(Sam.pTexture);
                 VERIFY_EXPR(pTextureGL == pTexViewGL->GetTexture());
-                m_ContextState.BindTexture(s, pTexViewGL->GetBindTarget(), pTexViewGL->GetHandle());
+                if (UseMultiBind)
+                    m_MultiBindTextures[s] = &pTexViewGL->GetHandle();
+                else
+                    m_ContextState.BindTexture(s, pTexViewGL->GetBindTarget(), pTexViewGL->GetHandle());
 
                 pTextureGL->TextureMemoryBarrier(
                     GL_TEXTURE_FETCH_BARRIER_BIT, // Texture fetches from shaders, including fetches from buffer object 
@@ -413,7 +485,11 @@ namespace Diligent
                                                   // written by shaders prior to the barrier
                     m_ContextState);
 
-                if (Sam.pSampler)
+                if (UseMultiBind)
+                {
+                    m_MultiBindSamplers[s] = Sam.pSampler ? &Sam.pSampler->GetHandle() : nullptr;
+                }
+                else if (Sam.pSampler)
                 {
                     m_ContextState.BindSampler(s, Sam.pSampler->GetHandle());
                 }
@@ -428,8 +504,16 @@ namespace Diligent
                 auto* pBufferGL = ValidatedCast<BufferGLImpl>(Sam.pBuffer);
                 VERIFY_EXPR(pBufferGL == pBufViewGL->GetBuffer());
 
-                m_ContextState.BindTexture(s, GL_TEXTURE_BUFFER, pBufViewGL->GetTexBufferHandle());
-                m_ContextState.BindSampler(s, GLObjectWrappers::GLSamplerObj(false)); // Use default texture sampling parameters
+                if (UseMultiBind)
+                {
+                    m_MultiBindTextures[s] = &pBufViewGL->GetTexBufferHandle();
+                    // Sampler remains null to use default texture sampling parameters
+                }
+                else
+                {
+                    m_ContextState.BindTexture(s, GL_TEXTURE_BUFFER, pBufViewGL->GetTexBufferHandle());
+                    m_ContextState.BindSampler(s, GLObjectWrappers::GLSamplerObj(false)); // Use default texture sampling parameters
+                }
 
                 pBufferGL->BufferMemoryBarrier(
                     GL_TEXTURE_FETCH_BARRIER_BIT, // Texture fetches from shaders, including fetches from buffer object 
@@ -438,7 +522,14 @@ namespace Diligent
                     m_ContextState);
             }
         }
+        if (UseMultiBind && ResourceCache.GetSamplerCount() > 0)
+        {
+            m_ContextState.BindTextures(0, ResourceCache.GetSamplerCount(), m_MultiBindTextures.data());
+            m_ContextState.BindSamplers(0, ResourceCache.GetSamplerCount(), m_MultiBindSamplers.data());
+        }
 
+        // glBindImageTextures() always binds the entire mip level 0 with GL_READ_WRITE access and the internal 
+        // format of the texture, so it can't be used for views that select a mip level, a slice or a format
 #if GL_ARB_shader_image_load_store
         for (Uint32 img = 0; img < ResourceCache.GetImageCount(); ++img)
         {
@@ -528,11 +619,13 @@ namespace Diligent
 
 
 #if GL_ARB_shader_storage_buffer_object
+        if (UseMultiBind)
+            m_MultiBindBuffers.Reset(ResourceCache.GetSSBOCount());
         for (Uint32 ssbo = 0; ssbo < ResourceCache.GetSSBOCount(); ++ssbo)
         {
             const auto& SSBO = ResourceCache.GetConstSSBO(ssbo);
             if (!SSBO.pBufferView)
-                return;
+                continue;
             
             auto* pBufferViewGL = SSBO.pBufferView.RawPtr<BufferViewGLImpl>();
             const auto& ViewDesc = pBufferViewGL->GetDesc();
@@ -544,12 +637,21 @@ namespace Diligent
                                                 // will reflect writes prior to the barrier
                 m_ContextState);
 
-            glBindBufferRange(GL_SHADER_STORAGE_BUFFER, ssbo, pBufferGL->m_GlBuffer, ViewDesc.ByteOffset, ViewDesc.ByteWidth);
-            DEV_CHECK_GL_ERROR("Failed to bind shader storage buffer");
+            if (UseMultiBind)
+            {
+                m_MultiBindBuffers.Set(ssbo, pBufferGL->m_GlBuffer, ViewDesc.ByteOffset, ViewDesc.ByteWidth);
+            }
+            else
+            {
+                glBindBufferRange(GL_SHADER_STORAGE_BUFFER, ssbo, pBufferGL->m_GlBuffer, ViewDesc.ByteOffset, ViewDesc.ByteWidth);
+                DEV_CHECK_GL_ERROR("Failed to bind shader storage buffer");
+            }
 
             if (ViewDesc.ViewType == BUFFER_VIEW_UNORDERED_ACCESS)
                 m_BoundWritableBuffers.push_back(pBufferGL);
         }
+        if (UseMultiBind && ResourceCache.GetSSBOCount() > 0)
+            m_MultiBindBuffers.Bind(GL_SHADER_STORAGE_BUFFER);
 #endif
 
 
@@ -606,13 +708,10 @@ namespace Diligent
 #endif
     }
 
-    void DeviceContextGLImpl::Draw(DrawAttribs &drawAttribs)
+    void DeviceContextGLImpl::PrepareForDraw(DRAW_FLAGS Flags, bool IsIndexed, VALUE_TYPE IndexType, GLenum& GlTopology, GLenum& GlIndexType)
     {
 #ifdef DEVELOPMENT
-        if ((drawAttribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) != 0 && !DvpVerifyDrawArguments(drawAttribs))
-            return;
-
-        if ((drawAttribs.Flags & DRAW_FLAG_VERIFY_RENDER_TARGETS) != 0)
+        if ((Flags & DRAW_FLAG_VERIFY_RENDER_TARGETS) != 0)
             DvpVerifyRenderTargets();
 #endif
 
@@ -624,7 +723,7 @@ namespace Diligent
         if (!m_bVAOIsUpToDate)
         {
             auto& VAOCache = pRenderDeviceGL->GetVAOCache(CurrNativeGLContext);
-            IBuffer* pIndexBuffer = drawAttribs.IsIndexed ? m_pIndexBuffer.RawPtr() : nullptr;
+            IBuffer* pIndexBuffer = IsIndexed ? m_pIndexBuffer.RawPtr() : nullptr;
             if (PipelineDesc.InputLayout.NumElements > 0 || pIndexBuffer != nullptr)
             {
                 const auto& VAO = VAOCache.GetVAO( m_pPipelineState, pIndexBuffer, m_VertexStreams, m_NumVertexStreams, m_ContextState );
@@ -641,7 +740,6 @@ namespace Diligent
             m_bVAOIsUpToDate = true;
         }
 
-        GLenum GlTopology;
         auto Topology = PipelineDesc.PrimitiveTopology;
         if (Topology >= PRIMITIVE_TOPOLOGY_1_CONTROL_POINT_PATCHLIST)
         {
@@ -657,23 +755,90 @@ namespace Diligent
         {
             GlTopology = PrimitiveTopologyToGLTopology( Topology );
         }
-        GLenum IndexType = 0;
-        Uint32 FirstIndexByteOffset = 0;
-        if (drawAttribs.IsIndexed)
+
+        GlIndexType = 0;
+        if (IsIndexed)
         {
-            IndexType = TypeToGLType( drawAttribs.IndexType );
-            VERIFY( IndexType == GL_UNSIGNED_BYTE || IndexType == GL_UNSIGNED_SHORT || IndexType == GL_UNSIGNED_INT,
+            GlIndexType = TypeToGLType( IndexType );
+            VERIFY( GlIndexType == GL_UNSIGNED_BYTE || GlIndexType == GL_UNSIGNED_SHORT || GlIndexType == GL_UNSIGNED_INT,
                     "Unsupported index type" );
             VERIFY( m_pIndexBuffer, "Index Buffer is not bound to the pipeline" );
-            FirstIndexByteOffset = static_cast<Uint32>(GetValueSize( drawAttribs.IndexType )) * drawAttribs.FirstIndexLocation + m_IndexDataStartOffset;
         }
+    }
+
+    void DeviceContextGLImpl::PostDraw()
+    {
+        // IMPORTANT: new pending memory barriers in the context must be set
+        // after all previous barriers have been executed.
+        // m_CommitedResourcesTentativeBarriers contains memory barriers that will be required 
+        // AFTER the actual draw/dispatch command is executed. 
+        m_ContextState.SetPendingMemoryBarriers( m_CommitedResourcesTentativeBarriers );
+        m_CommitedResourcesTentativeBarriers = 0;
+    }
 
+    void DeviceContextGLImpl::DrawDirect(GLenum GlTopology, GLenum GlIndexType, Uint32 IndexSize, bool IsIndexed, const MultiDrawItem& Item)
+    {
         // NOTE: Base Vertex and Base Instance versions are not supported even in OpenGL ES 3.1
         // This functionality can be emulated by adjusting stream offsets. This, however may cause
         // errors in case instance data is read from the same stream as vertex data. Thus handling
         // such cases is left to the application
 
         // http://www.opengl.org/wiki/Vertex_Rendering
+        const Uint32 FirstIndexByteOffset = IsIndexed ? IndexSize * Item.FirstIndexLocation + m_IndexDataStartOffset : 0;
+        if (Item.NumInstances > 1)
+        {
+            if (IsIndexed)
+            {
+                if (Item.BaseVertex)
+                {
+                    if (Item.FirstInstanceLocation)
+                        glDrawElementsInstancedBaseVertexBaseInstance(GlTopology, Item.NumIndices, GlIndexType, reinterpret_cast<GLvoid*>( static_cast<size_t>(FirstIndexByteOffset) ), Item.NumInstances, Item.BaseVertex, Item.FirstInstanceLocation);
+                    else
+                        glDrawElementsInstancedBaseVertex(GlTopology, Item.NumIndices, GlIndexType, reinterpret_cast<GLvoid*>( static_cast<size_t>(FirstIndexByteOffset) ), Item.NumInstances, Item.BaseVertex);
+                }
+                else
+                {
+                    if (Item.FirstInstanceLocation)
+                        glDrawElementsInstancedBaseInstance(GlTopology, Item.NumIndices, GlIndexType, reinterpret_cast<GLvoid*>( static_cast<size_t>(FirstIndexByteOffset) ), Item.NumInstances, Item.FirstInstanceLocation);
+                    else
+                        glDrawElementsInstanced(GlTopology, Item.NumIndices, GlIndexType, reinterpret_cast<GLvoid*>( static_cast<size_t>(FirstIndexByteOffset) ), Item.NumInstances);
+                }
+            }
+            else
+            {
+                if (Item.FirstInstanceLocation)
+                    glDrawArraysInstancedBaseInstance(GlTopology, Item.StartVertexLocation, Item.NumVertices, Item.NumInstances, Item.FirstInstanceLocation);
+                else
+                    glDrawArraysInstanced(GlTopology, Item.StartVertexLocation, Item.NumVertices, Item.NumInstances);
+            }
+        }
+        else
+        {
+            if (IsIndexed)
+            {
+                if (Item.BaseVertex)
+                    glDrawElementsBaseVertex(GlTopology, Item.NumIndices, GlIndexType, reinterpret_cast<GLvoid*>( static_cast<size_t>(FirstIndexByteOffset) ), Item.BaseVertex);
+                else
+                    glDrawElements(GlTopology, Item.NumIndices, GlIndexType, reinterpret_cast<GLvoid*>( static_cast<size_t>(FirstIndexByteOffset)));
+            }
+            else
+                glDrawArrays(GlTopology, Item.StartVertexLocation, Item.NumVertices);
+        }
+        DEV_CHECK_GL_ERROR( "OpenGL draw command failed" );
+    }
+
+    void DeviceContextGLImpl::Draw(DrawAttribs &drawAttribs)
+    {
+        CPU_PROFILE_SCOPE("DeviceContextGLImpl::Draw");
+#ifdef DEVELOPMENT
+        if ((drawAttribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) != 0 && !DvpVerifyDrawArguments(drawAttribs))
+            return;
+#endif
+
+        GLenum GlTopology  = 0;
+        GLenum GlIndexType = 0;
+        PrepareForDraw(drawAttribs.Flags, drawAttribs.IsIndexed, drawAttribs.IndexType, GlTopology, GlIndexType);
+
         auto* pIndirectDrawAttribsGL = static_cast<BufferGLImpl*>(drawAttribs.pIndirectDrawAttribs);
         if (pIndirectDrawAttribsGL != nullptr)
         {
@@ -700,7 +865,7 @@ namespace Diligent
                 //    GLuint  baseVertex;
                 //    GLuint  baseInstance;
                 //} DrawElementsIndirectCommand;
-                glDrawElementsIndirect( GlTopology, IndexType, reinterpret_cast<const void*>( static_cast<size_t>(drawAttribs.IndirectDrawArgsOffset) ) );
+                glDrawElementsIndirect( GlTopology, GlIndexType, reinterpret_cast<const void*>( static_cast<size_t>(drawAttribs.IndirectDrawArgsOffset) ) );
                 // Note that on GLES 3.1, baseInstance is present but reserved and must be zero
                 DEV_CHECK_GL_ERROR( "glDrawElementsIndirect() failed" );
             }
@@ -724,58 +889,136 @@ namespace Diligent
         }
         else
         {
-            if (drawAttribs.NumInstances > 1)
+            MultiDrawItem Item;
+            Item.NumIndices            = drawAttribs.NumIndices;
+            Item.NumInstances          = drawAttribs.NumInstances;
+            Item.BaseVertex            = drawAttribs.BaseVertex;
+            Item.FirstIndexLocation    = drawAttribs.FirstIndexLocation;
+            Item.FirstInstanceLocation = drawAttribs.FirstInstanceLocation;
+            const auto IndexSize = drawAttribs.IsIndexed ? static_cast<Uint32>(GetValueSize(drawAttribs.IndexType)) : 0;
+            DrawDirect(GlTopology, GlIndexType, IndexSize, drawAttribs.IsIndexed, Item);
+        }
+
+        PostDraw();
+    }
+
+    void DeviceContextGLImpl::MultiDraw(const MultiDrawAttribs& Attribs)
+    {
+        CPU_PROFILE_SCOPE("DeviceContextGLImpl::MultiDraw");
+#ifdef DEVELOPMENT
+        if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) != 0 && !DvpVerifyMultiDrawArguments(Attribs))
+            return;
+#endif
+        if (Attribs.DrawCount == 0)
+            return;
+
+        GLenum GlTopology  = 0;
+        GLenum GlIndexType = 0;
+        PrepareForDraw(Attribs.Flags, Attribs.IsIndexed, Attribs.IndexType, GlTopology, GlIndexType);
+
+        const auto IndexSize = Attribs.IsIndexed ? static_cast<Uint32>(GetValueSize(Attribs.IndexType)) : 0;
+        for (Uint32 i=0; i < Attribs.DrawCount; ++i)
+            DrawDirect(GlTopology, GlIndexType, IndexSize, Attribs.IsIndexed, Attribs.pDrawItems[i]);
+
+        PostDraw();
+    }
+
+    void DeviceContextGLImpl::MultiDrawIndirect(const MultiDrawIndirectAttribs& Attribs)
+    {
+        CPU_PROFILE_SCOPE("DeviceContextGLImpl::MultiDrawIndirect");
+#ifdef DEVELOPMENT
+        if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) != 0 && !DvpVerifyMultiDrawIndirectArguments(Attribs))
+            return;
+#endif
+        if (Attribs.DrawCount == 0)
+            return;
+
+#if GL_ARB_draw_indirect
+        GLenum GlTopology  = 0;
+        GLenum GlIndexType = 0;
+        PrepareForDraw(Attribs.Flags, Attribs.IsIndexed, Attribs.IndexType, GlTopology, GlIndexType);
+
+        auto* pAttribsBufferGL = static_cast<BufferGLImpl*>(Attribs.pAttribsBuffer);
+        pAttribsBufferGL->BufferMemoryBarrier(GL_COMMAND_BARRIER_BIT, m_ContextState);
+        glBindBuffer( GL_DRAW_INDIRECT_BUFFER, pAttribsBufferGL->m_GlBuffer );
+
+        const auto& DeviceCaps = m_pDevice->GetDeviceCaps();
+        const auto* pFirstArgs = reinterpret_cast<const void*>( static_cast<size_t>(Attribs.DrawArgsOffset) );
+        if (Attribs.pCountBuffer != nullptr)
+        {
+#if GL_ARB_indirect_parameters
+            VERIFY(DeviceCaps.bIndirectDrawCountSupported, "Indirect draw count is not supported by this device");
+            auto* pCountBufferGL = static_cast<BufferGLImpl*>(Attribs.pCountBuffer);
+            // Parameter buffer reads are covered by the command barrier as well
+            pCountBufferGL->BufferMemoryBarrier(GL_COMMAND_BARRIER_BIT, m_ContextState);
+            glBindBuffer( GL_PARAMETER_BUFFER_ARB, pCountBufferGL->m_GlBuffer );
+
+            // GL_PARAMETER_BUFFER_ARB and GL_PARAMETER_BUFFER are the same binding point. Core GL4.6 functions 
+            // are used when they are available, extension functions otherwise.
+            const auto DrawCountOffset = static_cast<GLintptr>(Attribs.CountBufferOffset);
+            const auto MaxDrawCount    = static_cast<GLsizei>(Attribs.DrawCount);
+            const auto Stride          = static_cast<GLsizei>(Attribs.DrawArgsStride);
+            if (Attribs.IsIndexed)
             {
-                if (drawAttribs.IsIndexed)
-                {
-                    if (drawAttribs.BaseVertex)
-                    {
-                        if (drawAttribs.FirstInstanceLocation)
-                            glDrawElementsInstancedBaseVertexBaseInstance(GlTopology, drawAttribs.NumIndices, IndexType, reinterpret_cast<GLvoid*>( static_cast<size_t>(FirstIndexByteOffset) ), drawAttribs.NumInstances, drawAttribs.BaseVertex, drawAttribs.FirstInstanceLocation);
-                        else
-                            glDrawElementsInstancedBaseVertex(GlTopology, drawAttribs.NumIndices, IndexType, reinterpret_cast<GLvoid*>( static_cast<size_t>(FirstIndexByteOffset) ), drawAttribs.NumInstances, drawAttribs.BaseVertex);
-                    }
-                    else
-                    {
-                        if (drawAttribs.FirstInstanceLocation)
-                            glDrawElementsInstancedBaseInstance(GlTopology, drawAttribs.NumIndices, IndexType, reinterpret_cast<GLvoid*>( static_cast<size_t>(FirstIndexByteOffset) ), drawAttribs.NumInstances, drawAttribs.FirstInstanceLocation);
-                        else
-                            glDrawElementsInstanced(GlTopology, drawAttribs.NumIndices, IndexType, reinterpret_cast<GLvoid*>( static_cast<size_t>(FirstIndexByteOffset) ), drawAttribs.NumInstances);
-                    }
-                }
+#if GL_VERSION_4_6
+                if (glMultiDrawElementsIndirectCount != nullptr)
+                    glMultiDrawElementsIndirectCount( GlTopology, GlIndexType, pFirstArgs, DrawCountOffset, MaxDrawCount, Stride );
                 else
-                {
-                    if (drawAttribs.FirstInstanceLocation)
-                        glDrawArraysInstancedBaseInstance(GlTopology, drawAttribs.StartVertexLocation, drawAttribs.NumVertices, drawAttribs.NumInstances, drawAttribs.FirstInstanceLocation);
-                    else
-                        glDrawArraysInstanced(GlTopology, drawAttribs.StartVertexLocation, drawAttribs.NumVertices, drawAttribs.NumInstances);
-                }
+#endif
+                    glMultiDrawElementsIndirectCountARB( GlTopology, GlIndexType, pFirstArgs, DrawCountOffset, MaxDrawCount, Stride );
             }
             else
             {
-                if (drawAttribs.IsIndexed)
-                {
-                    if (drawAttribs.BaseVertex)
-                        glDrawElementsBaseVertex(GlTopology, drawAttribs.NumIndices, IndexType, reinterpret_cast<GLvoid*>( static_cast<size_t>(FirstIndexByteOffset) ), drawAttribs.BaseVertex);
-                    else
-                        glDrawElements(GlTopology, drawAttribs.NumIndices, IndexType, reinterpret_cast<GLvoid*>( static_cast<size_t>(FirstIndexByteOffset)));
-                }
+#if GL_VERSION_4_6
+                if (glMultiDrawArraysIndirectCount != nullptr)
+                    glMultiDrawArraysIndirectCount( GlTopology, pFirstArgs, DrawCountOffset, MaxDrawCount, Stride );
+                else
+#endif
+                    glMultiDrawArraysIndirectCountARB( GlTopology, pFirstArgs, DrawCountOffset, MaxDrawCount, Stride );
+            }
+            DEV_CHECK_GL_ERROR( "Multi-draw indirect count command failed" );
+
+            glBindBuffer( GL_PARAMETER_BUFFER_ARB, 0 );
+#else
+            UNSUPPORTED("Indirect draw count is not supported");
+#endif
+        }
+        else if (DeviceCaps.bMultiDrawIndirectSupported)
+        {
+#if GL_ARB_multi_draw_indirect
+            // Zero stride means tightly packed commands, same as in MultiDrawIndirectAttribs
+            if (Attribs.IsIndexed)
+                glMultiDrawElementsIndirect( GlTopology, GlIndexType, pFirstArgs, Attribs.DrawCount, Attribs.DrawArgsStride );
+            else
+                glMultiDrawArraysIndirect( GlTopology, pFirstArgs, Attribs.DrawCount, Attribs.DrawArgsStride );
+            DEV_CHECK_GL_ERROR( "Multi-draw indirect command failed" );
+#endif
+        }
+        else
+        {
+            const Uint32 Stride = Attribs.DrawArgsStride != 0 ? Attribs.DrawArgsStride : (Attribs.IsIndexed ? 5 : 4) * sizeof(GLuint);
+            for (Uint32 i=0; i < Attribs.DrawCount; ++i)
+            {
+                const auto* pOffset = reinterpret_cast<const void*>( static_cast<size_t>(Attribs.DrawArgsOffset) + size_t{Stride} * i );
+                if (Attribs.IsIndexed)
+                    glDrawElementsIndirect( GlTopology, GlIndexType, pOffset );
                 else
-                    glDrawArrays(GlTopology, drawAttribs.StartVertexLocation, drawAttribs.NumVertices);
+                    glDrawArraysIndirect( GlTopology, pOffset );
             }
-            DEV_CHECK_GL_ERROR( "OpenGL draw command failed" );
+            DEV_CHECK_GL_ERROR( "Indirect draw command failed" );
         }
 
-        // IMPORTANT: new pending memory barriers in the context must be set
-        // after all previous barriers have been executed.
-        // m_CommitedResourcesTentativeBarriers contains memory barriers that will be required 
-        // AFTER the actual draw/dispatch command is executed. 
-        m_ContextState.SetPendingMemoryBarriers( m_CommitedResourcesTentativeBarriers );
-        m_CommitedResourcesTentativeBarriers = 0;
+        glBindBuffer( GL_DRAW_INDIRECT_BUFFER, 0 );
+
+        PostDraw();
+#else
+        LOG_ERROR_MESSAGE("Indirect rendering is not supported");
+#endif
     }
 
     void DeviceContextGLImpl::DispatchCompute(const DispatchComputeAttribs& DispatchAttrs)
     {
+        CPU_PROFILE_SCOPE("DeviceContextGLImpl::DispatchCompute");
 #ifdef DEVELOPMENT
         if (!DvpVerifyDispatchArguments(DispatchAttrs))
             return;
@@ -931,11 +1174,24 @@ namespace Diligent
 
     void DeviceContextGLImpl::Flush()
     {
+        m_pDevice.RawPtr<RenderDeviceGLImpl>()->PurgeDeferredReleases();
         glFlush();
     }
 
     void DeviceContextGLImpl::FinishFrame()
     {
+        m_pDevice.RawPtr<RenderDeviceGLImpl>()->PurgeDeferredReleases();
+        if (m_pDynamicHeap)
+            m_pDynamicHeap->FinishFrame();
+
+        // Report errors raised by the commands whose checks were skipped
+        REPORT_PENDING_GL_ERRORS();
+
+#ifdef DILIGENT_GL_CALL_TRACING
+        GLCallTrace::MarkFrame();
+#endif
+
+        CPU_PROFILE_FRAME_BOUNDARY();
     }
 
     void DeviceContextGLImpl::FinishCommandList(class ICommandList** ppCommandList)
@@ -1009,14 +1265,14 @@ namespace Diligent
 
         auto* pSrcBufferGL = ValidatedCast<BufferGLImpl>(pSrcBuffer);
         auto* pDstBufferGL = ValidatedCast<BufferGLImpl>(pDstBuffer);
-        pDstBufferGL->CopyData(m_ContextState, *pSrcBufferGL, SrcOffset, DstOffset, Size);
+        pDstBufferGL->CopyData(m_ContextState, m_pDynamicHeap.get(), *pSrcBufferGL, SrcOffset, DstOffset, Size);
     }
 
     void DeviceContextGLImpl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAGS MapFlags, PVoid& pMappedData)
     {
         TDeviceContextBase::MapBuffer(pBuffer, MapType, MapFlags, pMappedData);
         auto* pBufferGL = ValidatedCast<BufferGLImpl>(pBuffer);
-        pBufferGL->Map(m_ContextState, MapType, MapFlags, pMappedData);
+        pBufferGL->Map(m_ContextState, m_pDynamicHeap.get(), MapType, MapFlags, pMappedData);
     }
 
     void DeviceContextGLImpl::UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType)
@@ -1048,6 +1304,12 @@ namespace Diligent
                             CopyAttribs.DstMipLevel, CopyAttribs.DstSlice, CopyAttribs.DstX, CopyAttribs.DstY, CopyAttribs.DstZ);
     }
 
+    void DeviceContextGLImpl::MultiCopyTexture(const CopyTextureAttribs* pCopies, Uint32 NumCopies)
+    {
+        for (Uint32 i=0; i < NumCopies; ++i)
+            CopyTexture(pCopies[i]);
+    }
+
     void DeviceContextGLImpl::MapTextureSubresource(ITexture*                 pTexture,
                                                     Uint32                    MipLevel,
                                                     Uint32                    ArraySlice,
@@ -1057,15 +1319,70 @@ namespace Diligent
                                                     MappedTextureSubresource& MappedData)
     {
         TDeviceContextBase::MapTextureSubresource(pTexture, MipLevel, ArraySlice, MapType, MapFlags, pMapRegion, MappedData);
-        LOG_ERROR_MESSAGE("Texture mapping is not supported in OpenGL");
         MappedData = MappedTextureSubresource{};
+
+        auto* pTextureGL = ValidatedCast<TextureBaseGL>(pTexture);
+        const auto& PixelPackBuffer = pTextureGL->GetPixelPackBuffer();
+        if (PixelPackBuffer == 0 || MapType != MAP_READ)
+        {
+            LOG_ERROR_MESSAGE("Only staging textures created with CPU_ACCESS_READ flag can be mapped for reading in OpenGL");
+            return;
+        }
+
+        const auto& TexDesc  = pTextureGL->GetDesc();
+        const auto  MipProps = GetMipLevelProperties(TexDesc, MipLevel);
+        const auto& FmtAttribs = GetTextureFormatAttribs(TexDesc.Format);
+        Box FullExtentBox;
+        if (pMapRegion == nullptr)
+        {
+            FullExtentBox.MaxX = MipProps.LogicalWidth;
+            FullExtentBox.MaxY = MipProps.LogicalHeight;
+            FullExtentBox.MaxZ = MipProps.Depth;
+            pMapRegion = &FullExtentBox;
+        }
+
+        const auto RowStride   = TextureBaseGL::GetPixelPackRowStride(MipProps.RowSize);
+        const auto DepthStride = RowStride * MipProps.StorageHeight;
+        const auto TexelSize   = Uint32{FmtAttribs.ComponentSize} * Uint32{FmtAttribs.NumComponents};
+        const auto Slice       = TexDesc.Type == RESOURCE_DIM_TEX_3D ? 0 : ArraySlice;
+        const auto MapOffset   = pTextureGL->GetPixelPackBufferOffset(MipLevel, Slice) + pMapRegion->MinZ * DepthStride + pMapRegion->MinY * RowStride + pMapRegion->MinX * TexelSize;
+        const auto MapSize     = (pMapRegion->MaxZ - pMapRegion->MinZ - 1) * DepthStride + (pMapRegion->MaxY - pMapRegion->MinY - 1) * RowStride + (pMapRegion->MaxX - pMapRegion->MinX) * TexelSize;
+
+        // GL_MAP_UNSYNCHRONIZED_BIT can't be combined with GL_MAP_READ_BIT. If the application has waited for
+        // a fence signaled after the copy, the pixel transfer is complete and mapping does not stall.
+        if ((MapFlags & MAP_FLAG_DO_NOT_SYNCHRONIZE) == 0)
+            LOG_INFO_MESSAGE_ONCE("Mapping staging textures for reading waits for pending copies. Use fences to avoid stalls.");
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, PixelPackBuffer);
+        auto* pData = glMapBufferRange(GL_PIXEL_PACK_BUFFER, MapOffset, MapSize, GL_MAP_READ_BIT);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        if (pData == nullptr)
+        {
+            LOG_ERROR_MESSAGE("Failed to map pixel pack buffer of texture '", TexDesc.Name, "'. Note that only one subresource of a texture can be mapped at a time in OpenGL");
+            return;
+        }
+
+        MappedData.pData       = pData;
+        MappedData.Stride      = RowStride;
+        MappedData.DepthStride = DepthStride;
     }
 
 
     void DeviceContextGLImpl::UnmapTextureSubresource(ITexture* pTexture, Uint32 MipLevel, Uint32 ArraySlice)
     {
         TDeviceContextBase::UnmapTextureSubresource( pTexture, MipLevel, ArraySlice);
-        LOG_ERROR_MESSAGE("Texture mapping is not supported in OpenGL");
+
+        auto* pTextureGL = ValidatedCast<TextureBaseGL>(pTexture);
+        const auto& PixelPackBuffer = pTextureGL->GetPixelPackBuffer();
+        if (PixelPackBuffer == 0)
+        {
+            LOG_ERROR_MESSAGE("Only staging textures created with CPU_ACCESS_READ flag can be mapped in OpenGL");
+            return;
+        }
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, PixelPackBuffer);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
     }
 
     void DeviceContextGLImpl::GenerateMips( ITextureView* pTexView )
@@ -33,7 +33,7 @@ namespace Diligent
 
 bool FBOCache::FBOCacheKey::operator == (const FBOCacheKey &Key)const
 {
-    if( Hash !=0 && Key.Hash !=0 && Hash != Key.Hash )
+    if( Hash != Key.Hash )
         return false;
 
     if( NumRenderTargets != Key.NumRenderTargets )
@@ -58,28 +58,49 @@ bool FBOCache::FBOCacheKey::operator == (const FBOCacheKey &Key)const
     return true;
 }
 
-std::size_t FBOCache::FBOCacheKeyHashFunc::operator() ( const FBOCacheKey& Key )const
+void FBOCache::FBOCacheKey::ComputeHash()
 {
-    if( Key.Hash == 0 )
+    std::hash<TextureViewDesc> TexViewDescHasher;
+    Hash = 0;
+    HashCombine( Hash, NumRenderTargets );
+    for( Uint32 rt = 0; rt < NumRenderTargets; ++rt )
     {
-        std::hash<TextureViewDesc> TexViewDescHasher;
-        Key.Hash = 0;
-        HashCombine( Key.Hash, Key.NumRenderTargets );
-        for( Uint32 rt = 0; rt < Key.NumRenderTargets; ++rt )
-        {
-            HashCombine( Key.Hash, Key.RTIds[rt] );
-            if( Key.RTIds[rt] )
-                HashCombine( Key.Hash, TexViewDescHasher( Key.RTVDescs[rt] ) );
-        }
-        HashCombine( Key.Hash, Key.DSId );
-        if( Key.DSId )
-            HashCombine( Key.Hash, TexViewDescHasher( Key.DSVDesc ) );
+        HashCombine( Hash, RTIds[rt] );
+        if( RTIds[rt] )
+            HashCombine( Hash, TexViewDescHasher( RTVDescs[rt] ) );
     }
+    HashCombine( Hash, DSId );
+    if( DSId )
+        HashCombine( Hash, TexViewDescHasher( DSVDesc ) );
+}
+
+template<typename HandlerType>
+void FBOCache::FBOCacheKey::ProcessTextures(HandlerType Handler)const
+{
+    // Different subresources of the same texture may be bound to several attachments
+    for( Uint32 rt = 0; rt < NumRenderTargets; ++rt )
+    {
+        if( RTIds[rt] == 0 )
+            continue;
+
+        bool IsDuplicate = false;
+        for( Uint32 prev_rt = 0; prev_rt < rt && !IsDuplicate; ++prev_rt )
+            IsDuplicate = RTIds[prev_rt] == RTIds[rt];
+        if( !IsDuplicate )
+            Handler(RTIds[rt]);
+    }
+    if( DSId != 0 && std::find(RTIds, RTIds + NumRenderTargets, DSId) == RTIds + NumRenderTargets )
+        Handler(DSId);
+}
+
+std::size_t FBOCache::FBOCacheKeyHashFunc::operator() ( const FBOCacheKey& Key )const
+{
     return Key.Hash;
 }
 
 
-FBOCache::FBOCache()
+FBOCache::FBOCache(Uint32 MaxSize) :
+    m_MaxSize{MaxSize}
 {
     m_Cache.max_load_factor(0.5f);
     m_TexIdToKey.max_load_factor(0.5f);
@@ -88,20 +109,54 @@ FBOCache::FBOCache()
 FBOCache::~FBOCache()
 {
     VERIFY( m_Cache.empty(), "FBO cache is not empty. Are there any unreleased objects?" );
+    VERIFY( m_LRUList.empty(), "LRU list is not empty" );
     VERIFY( m_TexIdToKey.empty(), "TexIdToKey cache is not empty.");
 }
 
+void FBOCache::EraseEntry(CacheType::iterator It)
+{
+    const auto* pKey = &It->first;
+    pKey->ProcessTextures(
+        [&](UniqueIdentifier TexId)
+        {
+            auto EqualRange = m_TexIdToKey.equal_range(TexId);
+            for( auto RefIt = EqualRange.first; RefIt != EqualRange.second; ++RefIt )
+            {
+                if( RefIt->second == pKey )
+                {
+                    m_TexIdToKey.erase(RefIt);
+                    return;
+                }
+            }
+            UNEXPECTED("Reference to the key is not found");
+        }
+    );
+    m_LRUList.erase(It->second.LRUIt);
+    m_Cache.erase(It);
+}
+
 void FBOCache::OnReleaseTexture(ITexture *pTexture)
 {
     ThreadingTools::LockHelper CacheLock(m_CacheLockFlag);
     auto *pTexGL = ValidatedCast<TextureBaseGL>( pTexture );
-    // Find all FBOs that this texture used in
-    auto EqualRange = m_TexIdToKey.equal_range(pTexGL->GetUniqueID());
-    for(auto It = EqualRange.first; It != EqualRange.second; ++It)
+    auto TexId = pTexGL->GetUniqueID();
+    // Release all FBOs that this texture is used in. EraseEntry() removes the 
+    // reference from m_TexIdToKey, so the loop terminates.
+    for( auto RefIt = m_TexIdToKey.find(TexId); RefIt != m_TexIdToKey.end(); RefIt = m_TexIdToKey.find(TexId) )
     {
-        m_Cache.erase(It->second);
+        auto It = m_Cache.find(*RefIt->second);
+        VERIFY_EXPR(It != m_Cache.end());
+        EraseEntry(It);
     }
-    m_TexIdToKey.erase(EqualRange.first, EqualRange.second);
+}
+
+void FBOCache::AccumulateStatistics(ObjectCacheStatisticsGL& Stats)
+{
+    ThreadingTools::LockHelper CacheLock(m_CacheLockFlag);
+    Stats.NumObjects   += static_cast<Uint32>(m_Cache.size());
+    Stats.NumHits      += m_NumHits;
+    Stats.NumMisses    += m_NumMisses;
+    Stats.NumEvictions += m_NumEvictions;
 }
 
 const GLObjectWrappers::GLFrameBufferObj& FBOCache::GetFBO( Uint32 NumRenderTargets, 
@@ -153,14 +208,30 @@ const GLObjectWrappers::GLFrameBufferObj& FBOCache::GetFBO( Uint32 NumRenderTarg
         Key.DSVDesc = pDepthStencil->GetDesc();
     }
 
+    Key.ComputeHash();
+
     // Try to find FBO in the map
     auto It = m_Cache.find(Key);
     if( It != m_Cache.end() )
     {
-        return It->second;
+        ++m_NumHits;
+        // Move the key to the front of the LRU list
+        m_LRUList.splice(m_LRUList.begin(), m_LRUList, It->second.LRUIt);
+        return It->second.FBO;
     }
     else
     {
+        ++m_NumMisses;
+        if( m_MaxSize != 0 && m_Cache.size() >= m_MaxSize )
+        {
+            // Release the least recently used FBO. If it is bound to the context, it is
+            // replaced by the new FBO that is bound below, so it is safe to delete it.
+            auto LRUIt = m_Cache.find(*m_LRUList.back());
+            VERIFY_EXPR(LRUIt != m_Cache.end());
+            EraseEntry(LRUIt);
+            ++m_NumEvictions;
+        }
+
         // Create new FBO
         GLObjectWrappers::GLFrameBufferObj NewFBO(true);
 
@@ -264,18 +335,15 @@ const GLObjectWrappers::GLFrameBufferObj& FBOCache::GetFBO( Uint32 NumRenderTarg
             UNEXPECTED( "Framebuffer is incomplete" );
         }
 
-        auto NewElems = m_Cache.emplace( std::make_pair(Key, std::move(NewFBO)) );
+        auto NewElems = m_Cache.emplace( std::make_pair(Key, CacheEntry{std::move(NewFBO), LRUListType::iterator{}}) );
         // New element must be actually inserted
         VERIFY( NewElems.second, "New element was not inserted" ); 
-        if( Key.DSId  )
-            m_TexIdToKey.insert( std::make_pair(Key.DSId, Key) );
-        for( Uint32 rt = 0; rt < NumRenderTargets; ++rt )
-        {
-            if( Key.RTIds[rt] )
-                m_TexIdToKey.insert( std::make_pair(Key.RTIds[rt], Key) );
-        }
+        const auto* pKey = &NewElems.first->first;
+        m_LRUList.push_front(pKey);
+        NewElems.first->second.LRUIt = m_LRUList.begin();
+        pKey->ProcessTextures([&](UniqueIdentifier TexId){ m_TexIdToKey.insert( std::make_pair(TexId, pKey) ); });
 
-        return NewElems.first->second;
+        return NewElems.first->second.FBO;
     }
 }
 
@@ -0,0 +1,226 @@
+/*     Copyright 2019 Diligent Graphics LLC
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "GLCallTrace.h"
+
+#ifdef DILIGENT_GL_CALL_TRACING
+
+#include <atomic>
+#include <mutex>
+#include <cstring>
+
+#include "FileWrapper.h"
+
+namespace Diligent
+{
+    namespace
+    {
+        struct EntryPointCounters
+        {
+            Uint32 NumCalls         = 0;
+            Uint32 NumRepeatedCalls = 0;
+            // Arguments of the last call recorded while the capture is active
+            String LastArgs;
+            bool   HasLastArgs      = false;
+        };
+
+        struct TraceState
+        {
+            std::atomic_bool IsCapturing{false};
+
+            std::mutex Mtx;
+            // Counters of the current frame. String literals with the same entry point name
+            // may have different addresses in different translation units, so the counters
+            // are merged by name when the frame ends.
+            std::unordered_map<const Char*, EntryPointCounters> FrameCounters;
+            std::vector<GLCallTrace::EntryPointStats>           LastFrameStats;
+            Uint32 LastFrameCallCount = 0;
+            Uint32 CapturedFrameCount = 0;
+            String Trace;
+        };
+
+        TraceState& GetTraceState()
+        {
+            static TraceState State;
+            return State;
+        }
+
+        // Functions loaded by GLEW are named after the pointer variables, e.g. "__glewBindBuffer"
+        const Char* const GLEWPrefix    = "__glew";
+        const size_t      GLEWPrefixLen = 6;
+
+        void AppendEntryPointName(String& Str, const Char* Name)
+        {
+            if (strncmp(Name, GLEWPrefix, GLEWPrefixLen) == 0)
+            {
+                Str += "gl";
+                Str += Name + GLEWPrefixLen;
+            }
+            else
+                Str += Name;
+        }
+
+        void AppendFrameMarker(String& Trace, Uint32 FrameNumber)
+        {
+            Trace += "// Frame ";
+            Trace += std::to_string(FrameNumber);
+            Trace += '\n';
+        }
+    }
+
+    void GLCallTrace::GetFrameStatistics(std::vector<EntryPointStats>& Stats)
+    {
+        auto& State = GetTraceState();
+        std::lock_guard<std::mutex> Lock{State.Mtx};
+        Stats = State.LastFrameStats;
+    }
+
+    Uint32 GLCallTrace::GetFrameCallCount()
+    {
+        auto& State = GetTraceState();
+        std::lock_guard<std::mutex> Lock{State.Mtx};
+        return State.LastFrameCallCount;
+    }
+
+    void GLCallTrace::BeginCapture()
+    {
+        auto& State = GetTraceState();
+        std::lock_guard<std::mutex> Lock{State.Mtx};
+        State.Trace.clear();
+        State.CapturedFrameCount = 0;
+        AppendFrameMarker(State.Trace, 0);
+        for (auto& it : State.FrameCounters)
+        {
+            it.second.LastArgs.clear();
+            it.second.HasLastArgs = false;
+        }
+        State.IsCapturing.store(true);
+    }
+
+    void GLCallTrace::EndCapture()
+    {
+        auto& State = GetTraceState();
+        std::lock_guard<std::mutex> Lock{State.Mtx};
+        State.IsCapturing.store(false);
+    }
+
+    bool GLCallTrace::IsCapturing()
+    {
+        return GetTraceState().IsCapturing.load();
+    }
+
+    bool GLCallTrace::CountCall(const Char* Name)
+    {
+        auto& State = GetTraceState();
+        std::lock_guard<std::mutex> Lock{State.Mtx};
+        ++State.FrameCounters[Name].NumCalls;
+        return State.IsCapturing.load();
+    }
+
+    void GLCallTrace::AddToTrace(const Char* Name, String&& Args)
+    {
+        auto& State = GetTraceState();
+        std::lock_guard<std::mutex> Lock{State.Mtx};
+        // The capture may have ended since CountCall() returned
+        if (!State.IsCapturing.load())
+            return;
+
+        AppendEntryPointName(State.Trace, Name);
+        State.Trace += '(';
+        State.Trace += Args;
+        State.Trace += ")\n";
+
+        auto& Counters = State.FrameCounters[Name];
+        if (Counters.HasLastArgs && Counters.LastArgs == Args)
+            ++Counters.NumRepeatedCalls;
+        Counters.LastArgs    = std::move(Args);
+        Counters.HasLastArgs = true;
+    }
+
+    void GLCallTrace::MarkFrame()
+    {
+        auto& State = GetTraceState();
+        std::lock_guard<std::mutex> Lock{State.Mtx};
+
+        std::unordered_map<String, EntryPointStats> MergedStats;
+        Uint32 TotalCalls = 0;
+        for (auto& it : State.FrameCounters)
+        {
+            auto& Counters = it.second;
+            if (Counters.NumCalls == 0)
+                continue;
+
+            String Name;
+            AppendEntryPointName(Name, it.first);
+            auto& Stats = MergedStats[Name];
+            Stats.NumCalls         += Counters.NumCalls;
+            Stats.NumRepeatedCalls += Counters.NumRepeatedCalls;
+            TotalCalls             += Counters.NumCalls;
+
+            Counters.NumCalls         = 0;
+            Counters.NumRepeatedCalls = 0;
+        }
+
+        State.LastFrameStats.clear();
+        State.LastFrameStats.reserve(MergedStats.size());
+        for (auto& it : MergedStats)
+        {
+            State.LastFrameStats.emplace_back(std::move(it.second));
+            State.LastFrameStats.back().Name = it.first;
+        }
+        std::sort(State.LastFrameStats.begin(), State.LastFrameStats.end(),
+                  [](const EntryPointStats& lhs, const EntryPointStats& rhs)
+                  {
+                      return lhs.NumCalls != rhs.NumCalls ? lhs.NumCalls > rhs.NumCalls : lhs.Name < rhs.Name;
+                  });
+        State.LastFrameCallCount = TotalCalls;
+
+        if (State.IsCapturing.load())
+            AppendFrameMarker(State.Trace, ++State.CapturedFrameCount);
+    }
+
+    void GLCallTrace::GetTrace(String& Trace)
+    {
+        auto& State = GetTraceState();
+        std::lock_guard<std::mutex> Lock{State.Mtx};
+        VERIFY(!State.IsCapturing.load(), "The trace must not be requested while the capture is active");
+        Trace = State.Trace;
+    }
+
+    bool GLCallTrace::SaveTrace(const Char* FilePath)
+    {
+        String Trace;
+        GetTrace(Trace);
+
+        FileWrapper File(FilePath, EFileAccessMode::Overwrite);
+        if (!File)
+        {
+            LOG_ERROR_MESSAGE("Failed to open file '", FilePath, "' to save GL call trace");
+            return false;
+        }
+        return File->Write(Trace.data(), Trace.size());
+    }
+}
+
+#endif
@@ -178,4 +178,102 @@ namespace Diligent
     {
         return glXGetCurrentContext();
     }
+
+    GLContext::NativeGLContextType GLContext::CreateSharedContext()
+    {
+        auto ShareCtx = glXGetCurrentContext();
+        auto* display = glXGetCurrentDisplay();
+        VERIFY(ShareCtx != 0 && display != nullptr, "Shared contexts must be created by the thread that owns the main GL context");
+
+        int FBConfigId = 0, Screen = 0;
+        glXQueryContext(display, ShareCtx, GLX_FBCONFIG_ID, &FBConfigId);
+        glXQueryContext(display, ShareCtx, GLX_SCREEN, &Screen);
+
+        // Making a context current without a drawable requires GLX_ARB_create_context (GL3.0+ contexts)
+        const auto* GLXExtensions = glXQueryExtensionsString(display, Screen);
+        auto CreateContextAttribsARB = reinterpret_cast<PFNGLXCREATECONTEXTATTRIBSARBPROC>(
+            glXGetProcAddressARB(reinterpret_cast<const GLubyte*>("glXCreateContextAttribsARB")));
+        if (GLXExtensions == nullptr || strstr(GLXExtensions, "GLX_ARB_create_context") == nullptr || CreateContextAttribsARB == nullptr)
+        {
+            LOG_WARNING_MESSAGE("GLX_ARB_create_context is not supported: unable to create shared GL context");
+            return 0;
+        }
+
+        // The shared context is used by another thread while the application keeps making GLX calls on its
+        // display. Xlib connections must not be used by several threads at once unless XInitThreads() has
+        // been called, so every shared context gets its own connection to the same X server.
+        auto* SharedCtxDisplay = XOpenDisplay(DisplayString(display));
+        if (SharedCtxDisplay == nullptr)
+        {
+            LOG_WARNING_MESSAGE("Failed to open X display connection for shared GL context");
+            return 0;
+        }
+
+        // Shared context must use the same frame buffer configuration as the main context
+        int FBConfigAttribs[] = {GLX_FBCONFIG_ID, FBConfigId, None};
+        int NumConfigs = 0;
+        auto* pFBConfigs = glXChooseFBConfig(SharedCtxDisplay, Screen, FBConfigAttribs, &NumConfigs);
+        if (pFBConfigs == nullptr || NumConfigs == 0)
+        {
+            LOG_WARNING_MESSAGE("Failed to find frame buffer configuration of the main GL context");
+            if (pFBConfigs != nullptr)
+                XFree(pFBConfigs);
+            XCloseDisplay(SharedCtxDisplay);
+            return 0;
+        }
+
+        // Request the same version and profile as the main context has
+        GLint MajorVersion = 0, MinorVersion = 0, ProfileMask = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &MajorVersion);
+        glGetIntegerv(GL_MINOR_VERSION, &MinorVersion);
+        glGetIntegerv(GL_CONTEXT_PROFILE_MASK, &ProfileMask);
+        if (glGetError() != GL_NO_ERROR || ProfileMask == 0)
+            ProfileMask = GLX_CONTEXT_COMPATIBILITY_PROFILE_BIT_ARB;
+        int ContextAttribs[] =
+        {
+            GLX_CONTEXT_MAJOR_VERSION_ARB, MajorVersion,
+            GLX_CONTEXT_MINOR_VERSION_ARB, MinorVersion,
+            GLX_CONTEXT_PROFILE_MASK_ARB,  ProfileMask,
+            None
+        };
+        auto Context = CreateContextAttribsARB(SharedCtxDisplay, pFBConfigs[0], ShareCtx, 1 /*direct*/, ContextAttribs);
+        XFree(pFBConfigs);
+        if (Context == 0)
+        {
+            LOG_WARNING_MESSAGE("Failed to create shared GL context");
+            XCloseDisplay(SharedCtxDisplay);
+            return 0;
+        }
+        m_SharedCtxDisplays.emplace(Context, SharedCtxDisplay);
+        return Context;
+    }
+
+    bool GLContext::MakeSharedContextCurrent(NativeGLContextType Context)
+    {
+        if (Context == 0)
+        {
+            // Release the context that is current in the calling thread
+            auto* display = glXGetCurrentDisplay();
+            return display == nullptr || glXMakeContextCurrent(display, None, None, nullptr) != 0;
+        }
+
+        // Shared contexts are only created and destroyed while no thread uses them,
+        // so the map can be read without synchronization
+        auto DisplayIt = m_SharedCtxDisplays.find(Context);
+        VERIFY(DisplayIt != m_SharedCtxDisplays.end(), "Context was not created by CreateSharedContext()");
+        if (DisplayIt == m_SharedCtxDisplays.end())
+            return false;
+        return glXMakeContextCurrent(DisplayIt->second, None, None, Context) != 0;
+    }
+
+    void GLContext::DestroySharedContext(NativeGLContextType Context)
+    {
+        auto DisplayIt = m_SharedCtxDisplays.find(Context);
+        VERIFY(DisplayIt != m_SharedCtxDisplays.end(), "Context was not created by CreateSharedContext()");
+        if (DisplayIt == m_SharedCtxDisplays.end())
+            return;
+        glXDestroyContext(DisplayIt->second, Context);
+        XCloseDisplay(DisplayIt->second);
+        m_SharedCtxDisplays.erase(DisplayIt);
+    }
 }
@@ -53,6 +53,20 @@ namespace Diligent
             VERIFY_EXPR(m_Caps.m_iMaxDrawBuffers > 0);
         }
 
+        if (DeviceCaps.DevType == DeviceType::OpenGL)
+        {
+            auto IsGLVersionOrAbove = [&](Int32 Major, Int32 Minor)
+            {
+                return DeviceCaps.MajorVersion > Major || (DeviceCaps.MajorVersion == Major && DeviceCaps.MinorVersion >= Minor);
+            };
+#if GL_ARB_multi_bind
+            m_Caps.bMultiBindSupported = IsGLVersionOrAbove(4, 4) || pDeviceGL->CheckExtension("GL_ARB_multi_bind");
+#endif
+#if GL_ARB_direct_state_access
+            m_Caps.bDirectStateAccessSupported = IsGLVersionOrAbove(4, 5) || pDeviceGL->CheckExtension("GL_ARB_direct_state_access");
+#endif
+        }
+
         m_BoundTextures.reserve( m_Caps.m_iMaxCombinedTexUnits );
         m_BoundSamplers.reserve( 32 );
         m_BoundImages.reserve( 32 );
@@ -229,6 +243,74 @@ namespace Diligent
         }
     }
 
+    template<class ObjectType>
+    bool UpdateBoundObjectsRange( std::vector< UniqueIdentifier >& BoundObjectIDs, Uint32 FirstIndex, Uint32 Count, const ObjectType* const* ppNewObjects, 
+                                  std::vector< GLuint >& GLHandles, Uint32 &FirstChanged, Uint32 &NumChanged )
+    {
+        if( FirstIndex + Count > BoundObjectIDs.size() )
+            BoundObjectIDs.resize( FirstIndex + Count, -1 );
+        GLHandles.resize( Count );
+
+        Uint32 EndChanged = 0;
+        FirstChanged = Count;
+        for( Uint32 i = 0; i < Count; ++i )
+        {
+            GLuint& GLHandle = GLHandles[i];
+            bool Changed = false;
+            if( ppNewObjects[i] != nullptr )
+            {
+                Changed = UpdateBoundObject( BoundObjectIDs[FirstIndex + i], *ppNewObjects[i], GLHandle );
+            }
+            else
+            {
+                GLHandle = 0;
+                Changed = BoundObjectIDs[FirstIndex + i] != 0;
+                BoundObjectIDs[FirstIndex + i] = 0;
+            }
+
+            if( Changed )
+            {
+                FirstChanged = std::min( FirstChanged, i );
+                EndChanged = i + 1;
+            }
+        }
+        NumChanged = EndChanged > FirstChanged ? EndChanged - FirstChanged : 0;
+        return NumChanged > 0;
+    }
+
+    void GLContextState::BindTextures( Uint32 FirstIndex, Uint32 Count, const GLObjectWrappers::GLTextureObj* const* ppTextures )
+    {
+#if GL_ARB_multi_bind
+        VERIFY( m_Caps.bMultiBindSupported, "Multi-bind is not supported" );
+        VERIFY( FirstIndex + Count <= static_cast<Uint32>(m_Caps.m_iMaxCombinedTexUnits), "Texture unit is out of range" );
+        Uint32 FirstChanged = 0, NumChanged = 0;
+        if( UpdateBoundObjectsRange( m_BoundTextures, FirstIndex, Count, ppTextures, m_MultiBindHandles, FirstChanged, NumChanged ) )
+        {
+            // glBindTextures() binds every texture to the target it was created with,
+            // while zero handles unbind all targets of the corresponding units
+            glBindTextures( FirstIndex + FirstChanged, NumChanged, m_MultiBindHandles.data() + FirstChanged );
+            DEV_CHECK_GL_ERROR( "Failed to bind textures to slots ", FirstIndex + FirstChanged, "..", FirstIndex + FirstChanged + NumChanged - 1 );
+        }
+#else
+        UNSUPPORTED("GL_ARB_multi_bind is not supported");
+#endif
+    }
+
+    void GLContextState::BindSamplers( Uint32 FirstIndex, Uint32 Count, const GLObjectWrappers::GLSamplerObj* const* ppSamplers )
+    {
+#if GL_ARB_multi_bind
+        VERIFY( m_Caps.bMultiBindSupported, "Multi-bind is not supported" );
+        Uint32 FirstChanged = 0, NumChanged = 0;
+        if( UpdateBoundObjectsRange( m_BoundSamplers, FirstIndex, Count, ppSamplers, m_MultiBindHandles, FirstChanged, NumChanged ) )
+        {
+            glBindSamplers( FirstIndex + FirstChanged, NumChanged, m_MultiBindHandles.data() + FirstChanged );
+            DEV_CHECK_GL_ERROR( "Failed to bind samplers to slots ", FirstIndex + FirstChanged, "..", FirstIndex + FirstChanged + NumChanged - 1 );
+        }
+#else
+        UNSUPPORTED("GL_ARB_multi_bind is not supported");
+#endif
+    }
+
     void GLContextState::BindImage( Uint32 Index,
         TextureViewGLImpl *pTexView,
         GLint MipLevel,
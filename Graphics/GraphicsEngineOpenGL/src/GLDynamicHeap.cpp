@@ -0,0 +1,149 @@
+/*     Copyright 2019 Diligent Graphics LLC
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include <limits>
+#include <algorithm>
+
+#include "GLDynamicHeap.h"
+
+namespace Diligent
+{
+
+GLDynamicHeap::GLDynamicHeap(IMemoryAllocator& Allocator, Uint32 Size, Uint32 Alignment) :
+    m_GLBuffer  {true                    },
+    m_RingBuffer{Size, Allocator         },
+    m_Alignment {std::max(Alignment, 16u)}
+{
+    VERIFY(IsPowerOfTwo(m_Alignment), "Alignment (", m_Alignment, ") must be power of 2");
+
+#if GL_ARB_buffer_storage
+    REPORT_PENDING_GL_ERRORS();
+    // Dynamic heap must not be bound to any of the targets used by the context state or VAOs
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_GLBuffer);
+
+    // GL_MAP_PERSISTENT_BIT allows the buffer to be used by the GL while it is mapped.
+    // GL_MAP_COHERENT_BIT makes writes by the client visible to the server without explicit 
+    // flushes or memory barriers. Storage created by glBufferStorage() is immutable, so the 
+    // buffer can't be orphaned, and synchronization is performed by frame fences instead.
+    const GLbitfield StorageFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBufferStorage(GL_COPY_WRITE_BUFFER, Size, nullptr, StorageFlags);
+    CHECK_GL_ERROR_AND_THROW("Failed to create storage for the dynamic heap");
+
+    m_pMappedData = reinterpret_cast<Uint8*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, Size, StorageFlags));
+    CHECK_GL_ERROR_AND_THROW("Failed to persistently map the dynamic heap");
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    if (m_pMappedData == nullptr)
+        LOG_ERROR_AND_THROW("Failed to persistently map the dynamic heap");
+
+    LOG_INFO_MESSAGE("Created ", Size >> 10, " KB persistently mapped dynamic heap");
+#else
+    LOG_ERROR_AND_THROW("Persistently mapped buffers are not supported on this platform");
+#endif
+}
+
+GLDynamicHeap::~GLDynamicHeap()
+{
+    // Space used by the current frame must be returned to the ring buffer as well
+    m_RingBuffer.FinishCurrentFrame(m_CurrentFrame);
+    m_PendingFrames.clear();
+    m_RingBuffer.ReleaseCompletedFrames(std::numeric_limits<Uint64>::max());
+
+    // The buffer is implicitly unmapped when it is deleted. GL defers the deletion
+    // until the buffer is no longer used by any commands in flight.
+}
+
+Uint32 GLDynamicHeap::Allocate(Uint32 Size)
+{
+    auto Offset = m_RingBuffer.Allocate(Size, m_Alignment);
+    if (Offset == RingBuffer::InvalidOffset)
+    {
+        ReleaseCompletedFrames(false);
+        Offset = m_RingBuffer.Allocate(Size, m_Alignment);
+
+        // Space used by the current frame can't be reclaimed, so we can only 
+        // wait for the frames that are still being processed by the GPU
+        while (Offset == RingBuffer::InvalidOffset && !m_PendingFrames.empty())
+        {
+            ReleaseCompletedFrames(true);
+            Offset = m_RingBuffer.Allocate(Size, m_Alignment);
+        }
+    }
+
+    if (Offset == RingBuffer::InvalidOffset)
+    {
+        if (!m_bOverflowReported)
+        {
+            LOG_WARNING_MESSAGE("Dynamic heap of size ", m_RingBuffer.GetMaxSize(), " is exhausted. Dynamic buffers will be updated using buffer orphaning "
+                                "for the remainder of the frame. Increase EngineGLCreateInfo::DynamicHeapSize or make sure that FinishFrame() is called at "
+                                "the end of every frame.");
+            m_bOverflowReported = true;
+        }
+        return InvalidOffset;
+    }
+
+    return static_cast<Uint32>(Offset);
+}
+
+void GLDynamicHeap::FinishFrame()
+{
+    GLObjectWrappers::GLSyncObj FrameFence( glFenceSync(
+            GL_SYNC_GPU_COMMANDS_COMPLETE, // Condition must always be GL_SYNC_GPU_COMMANDS_COMPLETE
+            0 // Flags, must be 0
+        )
+    );
+    CHECK_GL_ERROR( "Failed to create gl fence" );
+
+    m_RingBuffer.FinishCurrentFrame(m_CurrentFrame);
+    m_PendingFrames.emplace_back(m_CurrentFrame, std::move(FrameFence));
+    ++m_CurrentFrame;
+
+    ReleaseCompletedFrames(false);
+}
+
+void GLDynamicHeap::ReleaseCompletedFrames(bool WaitForOldestFrame)
+{
+    Uint64 CompletedFrame = 0;
+    while (!m_PendingFrames.empty())
+    {
+        auto& Frame = m_PendingFrames.front();
+        auto res = glClientWaitSync(Frame.second, 
+            WaitForOldestFrame ? GL_SYNC_FLUSH_COMMANDS_BIT : 0,
+            WaitForOldestFrame ? std::numeric_limits<GLuint64>::max() : 0 // Timeout in nanoseconds
+        );
+        if (res != GL_ALREADY_SIGNALED && res != GL_CONDITION_SATISFIED)
+            break;
+
+        CompletedFrame = Frame.first;
+        m_PendingFrames.pop_front();
+        // Only wait for the oldest frame, and poll the remaining ones
+        WaitForOldestFrame = false;
+    }
+
+    if (CompletedFrame != 0)
+        m_RingBuffer.ReleaseCompletedFrames(CompletedFrame);
+}
+
+}
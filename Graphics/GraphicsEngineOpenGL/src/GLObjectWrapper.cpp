@@ -22,10 +22,23 @@
  */
 
 #include "pch.h"
+#include <atomic>
 #include "GLObjectWrapper.h"
 
 namespace GLObjectWrappers
 {
+    static std::atomic<IDeferredReleaseQueue*> g_pDeferredReleaseQueue{nullptr};
+
+    void SetDeferredReleaseQueue(IDeferredReleaseQueue* pQueue)
+    {
+        g_pDeferredReleaseQueue.store(pQueue);
+    }
+
+    IDeferredReleaseQueue* GetDeferredReleaseQueue()
+    {
+        return g_pDeferredReleaseQueue.load();
+    }
+
     const char *GLBufferObjCreateReleaseHelper  :: Name = "buffer";
     const char *GLProgramObjCreateReleaseHelper :: Name = "program";
     const char *GLShaderObjCreateReleaseHelper  :: Name = "shader";
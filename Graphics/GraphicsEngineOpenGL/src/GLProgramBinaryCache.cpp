@@ -0,0 +1,192 @@
+/*     Copyright 2019 Diligent Graphics LLC
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "GLProgramBinaryCache.h"
+#include "FileWrapper.h"
+#include "HashUtils.h"
+
+namespace Diligent
+{
+
+namespace
+{
+
+struct ProgramFileHeader
+{
+    static constexpr Uint32 ExpectedMagic   = 0x50474C44; // "DGLP"
+    static constexpr Uint32 CurrentVersion  = 1;
+
+    Uint32 Magic            = ExpectedMagic;
+    Uint32 Version          = CurrentVersion;
+    Uint64 DriverHash       = 0;
+    Uint64 ProgramHash      = 0;
+    Uint32 BinaryFormat     = 0;
+    Uint32 BinarySize       = 0;
+    Uint32 ResourceDataSize = 0;
+    Uint32 Padding          = 0;
+};
+
+String GetGLString(GLenum Name)
+{
+    auto* Str = glGetString(Name);
+    return Str != nullptr ? String{reinterpret_cast<const char*>(Str)} : String{};
+}
+
+}
+
+GLProgramBinaryCache::GLProgramBinaryCache(const Char* CacheDirectory) :
+    m_CacheDirectory{CacheDirectory}
+{
+    VERIFY_EXPR(!m_CacheDirectory.empty());
+    if (m_CacheDirectory.back() != '/' && m_CacheDirectory.back() != '\\')
+        m_CacheDirectory.push_back(FileSystem::GetSlashSymbol());
+
+    // Program binaries are only guaranteed to be accepted by the same driver that produced them
+    m_DriverHash = ComputeHash(GetGLString(GL_VENDOR), GetGLString(GL_RENDERER), GetGLString(GL_VERSION));
+    LOG_INFO_MESSAGE("GL program binary cache directory: ", m_CacheDirectory);
+}
+
+GLProgramBinaryCache::~GLProgramBinaryCache()
+{
+    LOG_INFO_MESSAGE("GL program binary cache: ", m_NumLoaded.load(), " program(s) loaded, ", m_NumRejected.load(), " rejected by the driver, ", m_NumStored.load(), " stored");
+}
+
+String GLProgramBinaryCache::GetFilePath(size_t ProgramHash)const
+{
+    char FileName[32];
+    snprintf(FileName, sizeof(FileName), "%016llX.glprog", static_cast<unsigned long long>(ProgramHash));
+    return m_CacheDirectory + FileName;
+}
+
+bool GLProgramBinaryCache::LoadProgram(size_t ProgramHash, const GLObjectWrappers::GLProgramObj& GLProg, std::vector<Uint8>& ResourceData)
+{
+    const auto FilePath = GetFilePath(ProgramHash);
+    ProgramFileHeader  Header;
+    std::vector<Uint8> Binary;
+    {
+        std::lock_guard<std::mutex> Lock{m_FileMtx};
+        if (!FileSystem::FileExists(FilePath.c_str()))
+            return false;
+
+        FileWrapper File{FilePath.c_str(), EFileAccessMode::Read};
+        if (!File)
+            return false;
+
+        const auto FileSize = File->GetSize();
+        if (FileSize < sizeof(Header) || !File->Read(&Header, sizeof(Header)))
+            return false;
+
+        if (Header.Magic       != ProgramFileHeader::ExpectedMagic  ||
+            Header.Version     != ProgramFileHeader::CurrentVersion ||
+            Header.DriverHash  != static_cast<Uint64>(m_DriverHash) ||
+            Header.ProgramHash != static_cast<Uint64>(ProgramHash)  ||
+            Header.BinarySize  == 0 ||
+            FileSize != sizeof(Header) + size_t{Header.BinarySize} + size_t{Header.ResourceDataSize})
+        {
+            // The file was written by another driver, another engine version, or is truncated
+            return false;
+        }
+
+        Binary.resize(Header.BinarySize);
+        ResourceData.resize(Header.ResourceDataSize);
+        if (!File->Read(Binary.data(), Binary.size()) ||
+            (!ResourceData.empty() && !File->Read(ResourceData.data(), ResourceData.size())))
+        {
+            LOG_WARNING_MESSAGE("Failed to read GL program binary from file '", FilePath, '\'');
+            return false;
+        }
+    }
+
+    REPORT_PENDING_GL_ERRORS();
+    glProgramBinary(GLProg, Header.BinaryFormat, Binary.data(), static_cast<GLsizei>(Binary.size()));
+    // glProgramBinary generates GL_INVALID_ENUM if the format is not supported by the driver anymore
+    auto Error = glGetError();
+
+    GLint IsLinked = GL_FALSE;
+    glGetProgramiv(GLProg, GL_LINK_STATUS, &IsLinked);
+    if (Error != GL_NO_ERROR || !IsLinked)
+    {
+        // The driver may reject a binary at any time, for instance after an update that did not change
+        // the version string. The program will be linked from source and the file will be overwritten.
+        ++m_NumRejected;
+        return false;
+    }
+
+    ++m_NumLoaded;
+    return true;
+}
+
+void GLProgramBinaryCache::StoreProgram(size_t ProgramHash, const GLObjectWrappers::GLProgramObj& GLProg, const std::vector<Uint8>& ResourceData)
+{
+    if (m_DisableStoring)
+        return;
+
+    GLint BinaryLength = 0;
+    glGetProgramiv(GLProg, GL_PROGRAM_BINARY_LENGTH, &BinaryLength);
+    CHECK_GL_ERROR("Failed to get program binary length");
+    if (BinaryLength <= 0)
+        return;
+
+    std::vector<Uint8> Binary(static_cast<size_t>(BinaryLength));
+    GLsizei BytesWritten = 0;
+    GLenum  BinaryFormat = 0;
+    REPORT_PENDING_GL_ERRORS();
+    glGetProgramBinary(GLProg, BinaryLength, &BytesWritten, &BinaryFormat, Binary.data());
+    if (glGetError() != GL_NO_ERROR || BytesWritten <= 0)
+    {
+        LOG_WARNING_MESSAGE("Failed to get GL program binary");
+        return;
+    }
+
+    ProgramFileHeader Header;
+    Header.DriverHash       = static_cast<Uint64>(m_DriverHash);
+    Header.ProgramHash      = static_cast<Uint64>(ProgramHash);
+    Header.BinaryFormat     = BinaryFormat;
+    Header.BinarySize       = static_cast<Uint32>(BytesWritten);
+    Header.ResourceDataSize = static_cast<Uint32>(ResourceData.size());
+
+    const auto FilePath = GetFilePath(ProgramHash);
+    std::lock_guard<std::mutex> Lock{m_FileMtx};
+    FileWrapper File{FilePath.c_str(), EFileAccessMode::Overwrite};
+    if (!File)
+    {
+        LOG_WARNING_MESSAGE("Failed to create file '", FilePath, "'. GL program binaries will not be written to the cache.");
+        m_DisableStoring = true;
+        return;
+    }
+
+    if (!File->Write(&Header, sizeof(Header)) ||
+        !File->Write(Binary.data(), Header.BinarySize) ||
+        (!ResourceData.empty() && !File->Write(ResourceData.data(), ResourceData.size())))
+    {
+        // Truncated file will be rejected by the size check in LoadProgram()
+        LOG_WARNING_MESSAGE("Failed to write GL program binary to file '", FilePath, '\'');
+        return;
+    }
+
+    ++m_NumStored;
+}
+
+}
@@ -229,6 +229,7 @@ void GLProgramResources::LoadUniforms(SHADER_TYPE                           Shad
     // Query the maximum name length of the active uniform block (including null terminator)
     GLint activeUniformBlockMaxLength = 0;
     // On Intel driver, this call might fail:
+    REPORT_PENDING_GL_ERRORS();
     glGetProgramiv(GLProgram, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &activeUniformBlockMaxLength);
     //CHECK_GL_ERROR_AND_THROW("Unable to get the maximum uniform block name length\n");
     if (glGetError() != GL_NO_ERROR)
@@ -348,13 +349,7 @@ void GLProgramResources::LoadUniforms(SHADER_TYPE                           Shad
                     dataType
                 );
 
-                for (GLint arr_ind = 0; arr_ind < size; ++arr_ind)
-                {
-                    // glProgramUniform1i is not available in GLES3.0
-                    glUniform1i(UniformLocation + arr_ind, SamplerBinding++);
-                    CHECK_GL_ERROR("Failed to set binding point for sampler uniform '", Name.data(), '\'');
-                }
-
+                SamplerBinding += static_cast<Uint32>(size);
                 break;
             }
 
@@ -411,34 +406,7 @@ void GLProgramResources::LoadUniforms(SHADER_TYPE                           Shad
                     UniformLocation,
                     dataType );
 
-                for (GLint arr_ind = 0; arr_ind < size; ++arr_ind)
-                {
-                    // glUniform1i for image uniforms is not supported in at least GLES3.2.
-                    // glProgramUniform1i is not available in GLES3.0
-                    glUniform1i(UniformLocation + arr_ind, ImageBinding++);
-                    if (glGetError() != GL_NO_ERROR)
-                    {
-                        if (size > 1)
-                        {
-                            LOG_WARNING_MESSAGE("Failed to set binding for image uniform '", Name.data(), "'[", arr_ind,
-                                                "]. Expected binding: ", ImageBinding, 
-                                                " Make sure that this binding is explicitly assigned in shader source code."
-                                                " Note that if the source code is converted from HLSL and if images are only used"
-                                                " by a single shader stage, then bindings automatically assigned by HLSL->GLSL"
-                                                " converter will work fine.");
-                        }
-                        else
-                        {
-                            LOG_WARNING_MESSAGE("Failed to set binding for image uniform '", Name.data(), "'."
-                                                " Expected binding: ", ImageBinding, 
-                                                " Make sure that this binding is explicitly assigned in shader source code."
-                                                " Note that if the source code is converted from HLSL and if images are only used"
-                                                " by a single shader stage, then bindings automatically assigned by HLSL->GLSL"
-                                                " converter will work fine.");
-                        }
-                    }
-                }
-
+                ImageBinding += static_cast<Uint32>(size);
                 break;
             }
 #endif
@@ -508,8 +476,10 @@ void GLProgramResources::LoadUniforms(SHADER_TYPE                           Shad
             );
         }
 
-        glUniformBlockBinding(GLProgram, UniformBlockIndex, UniformBufferBinding++);
-        CHECK_GL_ERROR("glUniformBlockBinding() failed");
+        // Every array element occupies its own binding, including inactive elements, which
+        // keeps bindings consistent with LoadSerializedUniforms()
+        const auto& Block = UniformBlocks.back();
+        UniformBufferBinding = Block.Binding + Block.ArraySize;
     }
 
 #if GL_ARB_shader_storage_buffer_object
@@ -564,28 +534,298 @@ void GLProgramResources::LoadUniforms(SHADER_TYPE                           Shad
             );
         }
 
-        if (glShaderStorageBlockBinding)
+        const auto& Block = StorageBlocks.back();
+        StorageBufferBinding = Block.Binding + Block.ArraySize;
+    }
+#endif
+
+    AllocateResources(UniformBlocks, Samplers, Images, StorageBlocks);
+    ApplyBindings(GLProgram);
+
+    State.SetProgram(GLObjectWrappers::GLProgramObj{false});
+}
+
+void GLProgramResources::ApplyBindings(const GLObjectWrappers::GLProgramObj& GLProgram)const
+{
+    // The program must be current as glProgramUniform1i is not available in GLES3.0
+
+    for (Uint32 ub=0; ub < m_NumUniformBuffers; ++ub)
+    {
+        const auto& UB = GetUniformBuffer(ub);
+        // Elements of uniform block arrays have consecutive indices
+        for (Uint32 arr_ind = 0; arr_ind < UB.ArraySize; ++arr_ind)
+        {
+            glUniformBlockBinding(GLProgram, UB.UBIndex + arr_ind, UB.Binding + arr_ind);
+            CHECK_GL_ERROR("glUniformBlockBinding() failed");
+        }
+    }
+
+    for (Uint32 s=0; s < m_NumSamplers; ++s)
+    {
+        const auto& Sam = GetSampler(s);
+        for (Uint32 arr_ind = 0; arr_ind < Sam.ArraySize; ++arr_ind)
         {
-            glShaderStorageBlockBinding(GLProgram, SBIndex, StorageBufferBinding);
-            CHECK_GL_ERROR("glShaderStorageBlockBinding() failed");
+            glUniform1i(Sam.Location + arr_ind, Sam.Binding + arr_ind);
+            CHECK_GL_ERROR("Failed to set binding point for sampler uniform '", Sam.Name, '\'');
         }
-        else
+    }
+
+    // Errors of the image bindings are queried directly
+    REPORT_PENDING_GL_ERRORS();
+    for (Uint32 img=0; img < m_NumImages; ++img)
+    {
+        const auto& Img = GetImage(img);
+        for (Uint32 arr_ind = 0; arr_ind < Img.ArraySize; ++arr_ind)
         {
-            LOG_WARNING_MESSAGE("glShaderStorageBlockBinding is not available on this device and "
-                                "the engine is unable to automatically assign shader storage block bindindg for '",
-                                Name.data(), "' variable. Expected binding: ", StorageBufferBinding, 
-                                " Make sure that this binding is explicitly assigned in shader source code."
-                                " Note that if the source code is converted from HLSL and if storage blocks are only used"
-                                " by a single shader stage, then bindings automatically assigned by HLSL->GLSL"
-                                " converter will work fine.");
+            // glUniform1i for image uniforms is not supported in at least GLES3.2.
+            glUniform1i(Img.Location + arr_ind, Img.Binding + arr_ind);
+            if (glGetError() != GL_NO_ERROR)
+            {
+                LOG_WARNING_MESSAGE("Failed to set binding for image uniform '", Img.GetPrintName(arr_ind), "'."
+                                    " Expected binding: ", Img.Binding + arr_ind, 
+                                    " Make sure that this binding is explicitly assigned in shader source code."
+                                    " Note that if the source code is converted from HLSL and if images are only used"
+                                    " by a single shader stage, then bindings automatically assigned by HLSL->GLSL"
+                                    " converter will work fine.");
+            }
+        }
+    }
+
+#if GL_ARB_shader_storage_buffer_object
+    for (Uint32 sb=0; sb < m_NumStorageBlocks; ++sb)
+    {
+        const auto& SB = GetStorageBlock(sb);
+        for (Uint32 arr_ind = 0; arr_ind < SB.ArraySize; ++arr_ind)
+        {
+            if (glShaderStorageBlockBinding)
+            {
+                glShaderStorageBlockBinding(GLProgram, SB.SBIndex + arr_ind, SB.Binding + arr_ind);
+                CHECK_GL_ERROR("glShaderStorageBlockBinding() failed");
+            }
+            else
+            {
+                LOG_WARNING_MESSAGE("glShaderStorageBlockBinding is not available on this device and "
+                                    "the engine is unable to automatically assign shader storage block bindindg for '",
+                                    SB.GetPrintName(arr_ind), "' variable. Expected binding: ", SB.Binding + arr_ind, 
+                                    " Make sure that this binding is explicitly assigned in shader source code."
+                                    " Note that if the source code is converted from HLSL and if storage blocks are only used"
+                                    " by a single shader stage, then bindings automatically assigned by HLSL->GLSL"
+                                    " converter will work fine.");
+            }
         }
-        ++StorageBufferBinding;
     }
 #endif
+}
 
-    State.SetProgram(GLObjectWrappers::GLProgramObj{false});
 
+namespace
+{
+
+// Serialized resources are only read by the same build on the same machine (see GLProgramBinaryCache),
+// so values are written in native byte order
+class ResourceDataWriter
+{
+public:
+    explicit ResourceDataWriter(std::vector<Uint8>& Data) : 
+        m_Data{Data}
+    {}
+
+    void Write(Uint32 Value)
+    {
+        const auto* Bytes = reinterpret_cast<const Uint8*>(&Value);
+        m_Data.insert(m_Data.end(), Bytes, Bytes + sizeof(Value));
+    }
+
+    void Write(const Char* Str)
+    {
+        const auto Len = strlen(Str);
+        Write(static_cast<Uint32>(Len));
+        m_Data.insert(m_Data.end(), Str, Str + Len);
+    }
+
+private:
+    std::vector<Uint8>& m_Data;
+};
+
+class ResourceDataReader
+{
+public:
+    explicit ResourceDataReader(const std::vector<Uint8>& Data) : 
+        m_pCurr{Data.data()},
+        m_pEnd {Data.data() + Data.size()}
+    {}
+
+    bool Read(Uint32& Value)
+    {
+        if (static_cast<size_t>(m_pEnd - m_pCurr) < sizeof(Value))
+            return false;
+        memcpy(&Value, m_pCurr, sizeof(Value));
+        m_pCurr += sizeof(Value);
+        return true;
+    }
+
+    bool Read(String& Str)
+    {
+        Uint32 Len = 0;
+        if (!Read(Len) || Len == 0 || static_cast<size_t>(m_pEnd - m_pCurr) < Len)
+            return false;
+        Str.assign(reinterpret_cast<const Char*>(m_pCurr), Len);
+        m_pCurr += Len;
+        return true;
+    }
+
+    bool IsEnd()const { return m_pCurr == m_pEnd; }
+
+private:
+    const Uint8*       m_pCurr;
+    const Uint8* const m_pEnd;
+};
+
+}
+
+void GLProgramResources::Serialize(std::vector<Uint8>& Data)const
+{
+    // Bindings are not serialized: they are reassigned when the data is loaded, in the same
+    // order as LoadUniforms() assigns them, starting from the binding counters of the pipeline.
+    ResourceDataWriter Writer{Data};
+    Writer.Write(m_NumUniformBuffers);
+    Writer.Write(m_NumSamplers);
+    Writer.Write(m_NumImages);
+    Writer.Write(m_NumStorageBlocks);
+
+    for (Uint32 ub=0; ub < m_NumUniformBuffers; ++ub)
+    {
+        const auto& UB = GetUniformBuffer(ub);
+        Writer.Write(UB.Name);
+        Writer.Write(UB.ArraySize);
+        Writer.Write(UB.UBIndex);
+    }
+
+    for (Uint32 s=0; s < m_NumSamplers; ++s)
+    {
+        const auto& Sam = GetSampler(s);
+        Writer.Write(Sam.Name);
+        Writer.Write(static_cast<Uint32>(Sam.ResourceType));
+        Writer.Write(Sam.ArraySize);
+        Writer.Write(static_cast<Uint32>(Sam.Location));
+        Writer.Write(Sam.SamplerType);
+    }
+
+    for (Uint32 img=0; img < m_NumImages; ++img)
+    {
+        const auto& Img = GetImage(img);
+        Writer.Write(Img.Name);
+        Writer.Write(static_cast<Uint32>(Img.ResourceType));
+        Writer.Write(Img.ArraySize);
+        Writer.Write(static_cast<Uint32>(Img.Location));
+        Writer.Write(Img.ImageType);
+    }
+
+    for (Uint32 sb=0; sb < m_NumStorageBlocks; ++sb)
+    {
+        const auto& SB = GetStorageBlock(sb);
+        Writer.Write(SB.Name);
+        Writer.Write(SB.ArraySize);
+        Writer.Write(static_cast<Uint32>(SB.SBIndex));
+    }
+}
+
+bool GLProgramResources::LoadSerializedUniforms(SHADER_TYPE                           ShaderStages,
+                                                const GLObjectWrappers::GLProgramObj& GLProgram,
+                                                GLContextState&                       State,
+                                                const std::vector<Uint8>&             Data,
+                                                Uint32&                               UniformBufferBinding,
+                                                Uint32&                               SamplerBinding,
+                                                Uint32&                               ImageBinding,
+                                                Uint32&                               StorageBufferBinding)
+{
+    VERIFY(m_UniformBuffers == nullptr, "Resources have already been loaded");
+
+    std::vector<UniformBufferInfo> UniformBlocks;
+    std::vector<SamplerInfo>       Samplers;
+    std::vector<ImageInfo>         Images;
+    std::vector<StorageBlockInfo>  StorageBlocks;
+    std::unordered_set<String>     NamesPool;
+
+    // Bindings are only committed to the output counters when the entire data is valid
+    Uint32 UBBinding  = UniformBufferBinding;
+    Uint32 SamBinding = SamplerBinding;
+    Uint32 ImgBinding = ImageBinding;
+    Uint32 SBBinding  = StorageBufferBinding;
+
+    ResourceDataReader Reader{Data};
+    Uint32 NumUBs = 0, NumSamplers = 0, NumImages = 0, NumSBs = 0;
+    if (!Reader.Read(NumUBs) || !Reader.Read(NumSamplers) || !Reader.Read(NumImages) || !Reader.Read(NumSBs))
+        return false;
+
+    // Every resource takes at least 12 bytes, which bounds the counts by the data size
+    if (size_t{NumUBs} + size_t{NumSamplers} + size_t{NumImages} + size_t{NumSBs} > Data.size() / 12)
+        return false;
+
+    auto IsValidArraySize = [](Uint32 ArraySize)
+    {
+        return ArraySize >= 1 && ArraySize <= 65536;
+    };
+
+    String Name;
+    UniformBlocks.reserve(NumUBs);
+    for (Uint32 ub=0; ub < NumUBs; ++ub)
+    {
+        Uint32 ArraySize = 0, UBIndex = 0;
+        if (!Reader.Read(Name) || !Reader.Read(ArraySize) || !Reader.Read(UBIndex) || !IsValidArraySize(ArraySize))
+            return false;
+        UniformBlocks.emplace_back(NamesPool.emplace(Name).first->c_str(), ShaderStages, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, UBBinding, ArraySize, UBIndex);
+        UBBinding += ArraySize;
+    }
+
+    Samplers.reserve(NumSamplers);
+    for (Uint32 s=0; s < NumSamplers; ++s)
+    {
+        Uint32 ResourceType = 0, ArraySize = 0, Location = 0, SamplerType = 0;
+        if (!Reader.Read(Name) || !Reader.Read(ResourceType) || !Reader.Read(ArraySize) || !Reader.Read(Location) || !Reader.Read(SamplerType) ||
+            (ResourceType != SHADER_RESOURCE_TYPE_TEXTURE_SRV && ResourceType != SHADER_RESOURCE_TYPE_BUFFER_SRV) || !IsValidArraySize(ArraySize))
+            return false;
+        Samplers.emplace_back(NamesPool.emplace(Name).first->c_str(), ShaderStages, static_cast<SHADER_RESOURCE_TYPE>(ResourceType), SamBinding, ArraySize, static_cast<GLint>(Location), SamplerType);
+        SamBinding += ArraySize;
+    }
+
+    Images.reserve(NumImages);
+    for (Uint32 img=0; img < NumImages; ++img)
+    {
+        Uint32 ResourceType = 0, ArraySize = 0, Location = 0, ImageType = 0;
+        if (!Reader.Read(Name) || !Reader.Read(ResourceType) || !Reader.Read(ArraySize) || !Reader.Read(Location) || !Reader.Read(ImageType) ||
+            (ResourceType != SHADER_RESOURCE_TYPE_TEXTURE_UAV && ResourceType != SHADER_RESOURCE_TYPE_BUFFER_UAV) || !IsValidArraySize(ArraySize))
+            return false;
+        Images.emplace_back(NamesPool.emplace(Name).first->c_str(), ShaderStages, static_cast<SHADER_RESOURCE_TYPE>(ResourceType), ImgBinding, ArraySize, static_cast<GLint>(Location), ImageType);
+        ImgBinding += ArraySize;
+    }
+
+    StorageBlocks.reserve(NumSBs);
+    for (Uint32 sb=0; sb < NumSBs; ++sb)
+    {
+        Uint32 ArraySize = 0, SBIndex = 0;
+        if (!Reader.Read(Name) || !Reader.Read(ArraySize) || !Reader.Read(SBIndex) || !IsValidArraySize(ArraySize))
+            return false;
+        StorageBlocks.emplace_back(NamesPool.emplace(Name).first->c_str(), ShaderStages, SHADER_RESOURCE_TYPE_BUFFER_UAV, SBBinding, ArraySize, static_cast<GLint>(SBIndex));
+        SBBinding += ArraySize;
+    }
+
+    if (!Reader.IsEnd())
+        return false;
+
+    m_ShaderStages = ShaderStages;
     AllocateResources(UniformBlocks, Samplers, Images, StorageBlocks);
+
+    // Program binaries do not retain bindings assigned by glUniform1i and glUniformBlockBinding
+    State.SetProgram(GLProgram);
+    ApplyBindings(GLProgram);
+    State.SetProgram(GLObjectWrappers::GLProgramObj{false});
+
+    UniformBufferBinding = UBBinding;
+    SamplerBinding       = SamBinding;
+    ImageBinding         = ImgBinding;
+    StorageBufferBinding = SBBinding;
+    return true;
 }
 
 ShaderResourceDesc GLProgramResources::GetResourceDesc(Uint32 Index)const
@@ -63,9 +63,7 @@ PipelineStateGLImpl::PipelineStateGLImpl(IReferenceCounters*      pRefCounters,
     auto& DeviceCaps = pDeviceGL->GetDeviceCaps();
     VERIFY( DeviceCaps.DevType != DeviceType::Undefined, "Device caps are not initialized" );
 
-    auto pImmediateCtx = m_pDevice->GetImmediateContext();
-    VERIFY_EXPR(pImmediateCtx);
-    auto& GLState = pImmediateCtx.RawPtr<DeviceContextGLImpl>()->GetContextState();
+    auto& GLState = pDeviceGL->GetResourceCreationContextState();
 
     {
         m_TotalUniformBufferBindings = 0;
@@ -83,20 +81,19 @@ PipelineStateGLImpl::PipelineStateGLImpl(IReferenceCounters*      pRefCounters,
             {
                 auto* pShaderGL = GetShader<ShaderGLImpl>(i);
                 const auto& ShaderDesc = pShaderGL->GetDesc();
-                m_GLPrograms.emplace_back(ShaderGLImpl::LinkProgram(&m_ppShaders[i], 1, true));
-                // Load uniforms and assign bindings
-                m_ProgramResources[i].LoadUniforms(ShaderDesc.ShaderType, m_GLPrograms[i], GLState,
-                    m_TotalUniformBufferBindings,
-                    m_TotalSamplerBindings,
-                    m_TotalImageBindings,
-                    m_TotalStorageBufferBindings);
+                // Link the program (or load it from the binary cache), load uniforms and assign bindings
+                m_GLPrograms.emplace_back(
+                    ShaderGLImpl::CreateProgram(&m_ppShaders[i], 1, true, ShaderDesc.ShaderType, GLState, m_ProgramResources[i],
+                        m_TotalUniformBufferBindings,
+                        m_TotalSamplerBindings,
+                        m_TotalImageBindings,
+                        m_TotalStorageBufferBindings));
 
                 HashCombine(m_ShaderResourceLayoutHash, m_ProgramResources[i].GetHash());
             }
         }
         else
         {
-            m_GLPrograms.emplace_back(ShaderGLImpl::LinkProgram(m_ppShaders, m_NumShaders, false));
             m_ProgramResources.resize(1);
             SHADER_TYPE ShaderStages = SHADER_TYPE_UNKNOWN;
             for (Uint32 i = 0; i < m_NumShaders; ++i)
@@ -104,11 +101,12 @@ PipelineStateGLImpl::PipelineStateGLImpl(IReferenceCounters*      pRefCounters,
                 const auto& ShaderDesc = m_ppShaders[i]->GetDesc();
                 ShaderStages |= ShaderDesc.ShaderType;
             }
-            m_ProgramResources[0].LoadUniforms(ShaderStages, m_GLPrograms[0], GLState,
+            m_GLPrograms.emplace_back(
+                ShaderGLImpl::CreateProgram(m_ppShaders, m_NumShaders, false, ShaderStages, GLState, m_ProgramResources[0],
                     m_TotalUniformBufferBindings,
                     m_TotalSamplerBindings,
                     m_TotalImageBindings,
-                    m_TotalStorageBufferBindings);
+                    m_TotalStorageBufferBindings));
 
             m_ShaderResourceLayoutHash = m_ProgramResources[0].GetHash();
         }
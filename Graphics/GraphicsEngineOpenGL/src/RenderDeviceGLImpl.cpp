@@ -24,6 +24,7 @@
 #include "pch.h"
 
 #include "RenderDeviceGLImpl.h"
+#include "CPUProfiler.h"
 
 #include "BufferGLImpl.h"
 #include "ShaderGLImpl.h"
@@ -47,6 +48,9 @@
 namespace Diligent
 {
 
+// State of the shared context owned by the current resource worker thread, or null
+static thread_local GLContextState* t_pWorkerContextState = nullptr;
+
 RenderDeviceGLImpl :: RenderDeviceGLImpl(IReferenceCounters*        pRefCounters,
                                          IMemoryAllocator&          RawMemAllocator,
                                          IEngineFactory*            pEngineFactory,
@@ -69,10 +73,13 @@ RenderDeviceGLImpl :: RenderDeviceGLImpl(IReferenceCounters*        pRefCounters
             sizeof(PipelineStateGLImpl),
             sizeof(ShaderResourceBindingGLImpl),
             sizeof(FenceGLImpl)
-        }
+        },
+        InitAttribs.ObjectPoolPageSizes
     },
     // Device caps must be filled in before the constructor of Pipeline Cache is called!
-    m_GLContext{InitAttribs, m_DeviceCaps, pSCDesc}
+    m_GLContext{InitAttribs, m_DeviceCaps, pSCDesc},
+    m_VAOCacheSize{InitAttribs.VAOCacheSize},
+    m_FBOCacheSize{InitAttribs.FBOCacheSize}
 {
     GLint NumExtensions = 0;
     glGetIntegerv( GL_NUM_EXTENSIONS,& NumExtensions );
@@ -101,10 +108,178 @@ RenderDeviceGLImpl :: RenderDeviceGLImpl(IReferenceCounters*        pRefCounters
         m_GPUInfo.Vendor = GPU_VENDOR::ATI;
     else if( Vendor.find( "qualcomm" ) )
         m_GPUInfo.Vendor = GPU_VENDOR::QUALCOMM;
+
+    if (InitAttribs.ProgramBinaryCacheDirectory != nullptr && *InitAttribs.ProgramBinaryCacheDirectory != 0)
+    {
+        GLint NumProgramBinaryFormats = 0;
+        REPORT_PENDING_GL_ERRORS();
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &NumProgramBinaryFormats);
+        if (glGetError() == GL_NO_ERROR && NumProgramBinaryFormats > 0)
+            m_pProgramBinaryCache.reset(new GLProgramBinaryCache{InitAttribs.ProgramBinaryCacheDirectory});
+        else
+            LOG_WARNING_MESSAGE("The driver does not support any program binary formats. GL program binary cache is disabled.");
+    }
+
+    if (InitAttribs.NumResourceWorkerThreads > 0)
+        InitResourceWorkers(InitAttribs.NumResourceWorkerThreads);
 }
 
 RenderDeviceGLImpl :: ~RenderDeviceGLImpl()
 {
+    DestroyResourceWorkers();
+    PurgeDeferredReleases();
+}
+
+void RenderDeviceGLImpl :: InitResourceWorkers(Uint32 NumThreads)
+{
+#if PLATFORM_LINUX
+    // Shared contexts must be created while the main context is current
+    m_ResourceWorkers.resize(NumThreads);
+    for (auto& Worker : m_ResourceWorkers)
+    {
+        Worker.Context = m_GLContext.CreateSharedContext();
+        if (Worker.Context == GLContext::NativeGLContextType{})
+        {
+            LOG_WARNING_MESSAGE("Failed to create shared GL contexts. Resources will only be created by the rendering thread.");
+            DestroyResourceWorkers();
+            return;
+        }
+    }
+
+    m_pResourceWorkerPool.reset(
+        new ThreadingTools::ThreadPool
+        {
+            NumThreads,
+            [this](unsigned int ThreadIndex)
+            {
+                auto& Worker = m_ResourceWorkers[ThreadIndex];
+                if (!m_GLContext.MakeSharedContextCurrent(Worker.Context))
+                {
+                    LOG_ERROR_MESSAGE("Failed to make shared GL context current in resource worker thread ", ThreadIndex);
+                    return;
+                }
+                Worker.pContextState.reset(new GLContextState{this});
+                Worker.VAO.Create();
+                glBindVertexArray(Worker.VAO);
+                t_pWorkerContextState = Worker.pContextState.get();
+            },
+            [this](unsigned int ThreadIndex)
+            {
+                auto& Worker = m_ResourceWorkers[ThreadIndex];
+                t_pWorkerContextState = nullptr;
+                if (Worker.pContextState)
+                {
+                    Worker.VAO.Release();
+                    Worker.pContextState.reset();
+                    m_GLContext.MakeSharedContextCurrent(GLContext::NativeGLContextType{});
+                }
+            }
+        }
+    );
+    GLObjectWrappers::SetDeferredReleaseQueue(&m_DeferredReleaseQueue);
+    m_DeviceCaps.bMultithreadedResourceCreationSupported = True;
+    LOG_INFO_MESSAGE("Started ", NumThreads, " GL resource worker thread(s)");
+#else
+    (void)NumThreads;
+    LOG_WARNING_MESSAGE("GL resource worker threads are not supported on this platform");
+#endif
+}
+
+void RenderDeviceGLImpl :: DestroyResourceWorkers()
+{
+    // Worker threads release their contexts before they exit
+    m_pResourceWorkerPool.reset();
+    if (GLObjectWrappers::GetDeferredReleaseQueue() == &m_DeferredReleaseQueue)
+        GLObjectWrappers::SetDeferredReleaseQueue(nullptr);
+#if PLATFORM_LINUX
+    for (auto& Worker : m_ResourceWorkers)
+    {
+        if (Worker.Context != GLContext::NativeGLContextType{})
+            m_GLContext.DestroySharedContext(Worker.Context);
+    }
+#endif
+    m_ResourceWorkers.clear();
+}
+
+void RenderDeviceGLImpl :: ExecuteOnResourceWorker(const std::function<void()>& Task)
+{
+    VERIFY_EXPR(m_pResourceWorkerPool);
+    auto Future = m_pResourceWorkerPool->EnqueueTask(
+        [&Task]()
+        {
+            if (t_pWorkerContextState == nullptr)
+            {
+                LOG_ERROR_MESSAGE("Resource worker thread has no current GL context");
+                return;
+            }
+
+            Task();
+
+            // Objects modified in one context are only guaranteed to be visible to other contexts
+            // once the commands that modified them are complete. Wait for the fence in the worker
+            // thread so that the rendering thread may use the objects right away.
+            if (glFenceSync != nullptr)
+            {
+                auto Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                GLbitfield WaitFlags = GL_SYNC_FLUSH_COMMANDS_BIT;
+                for (;;)
+                {
+                    auto Res = glClientWaitSync(Fence, WaitFlags, 1000000000ull);
+                    if (Res != GL_TIMEOUT_EXPIRED)
+                    {
+                        if (Res == GL_WAIT_FAILED)
+                            LOG_ERROR_MESSAGE("Failed to wait for resource creation fence");
+                        break;
+                    }
+                    // Commands have already been flushed
+                    WaitFlags = 0;
+                }
+                glDeleteSync(Fence);
+            }
+            else
+            {
+                glFinish();
+            }
+        }
+    );
+    Future.get();
+}
+
+GLContextState& RenderDeviceGLImpl :: GetResourceCreationContextState()
+{
+    if (t_pWorkerContextState != nullptr)
+        return *t_pWorkerContextState;
+
+    auto spDeviceContext = GetImmediateContext();
+    VERIFY(spDeviceContext, "Immediate device context has been destroyed");
+    return spDeviceContext.RawPtr<DeviceContextGLImpl>()->GetContextState();
+}
+
+void RenderDeviceGLImpl :: DeferredReleaseQueue :: DeferRelease(std::function<void()>&& ReleaseFunc)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_PendingReleases.emplace_back(std::move(ReleaseFunc));
+}
+
+void RenderDeviceGLImpl :: DeferredReleaseQueue :: Purge()
+{
+    std::vector<std::function<void()>> PendingReleases;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        PendingReleases.swap(m_PendingReleases);
+    }
+    for (auto& ReleaseFunc : PendingReleases)
+        ReleaseFunc();
+}
+
+void RenderDeviceGLImpl :: PurgeDeferredReleases()
+{
+    m_DeferredReleaseQueue.Purge();
+}
+
+bool RenderDeviceGLImpl :: IsResourceWorkerThread()
+{
+    return t_pWorkerContextState != nullptr;
 }
 
 IMPLEMENT_QUERY_INTERFACE( RenderDeviceGLImpl, IID_RenderDeviceGL, TRenderDeviceBase )
@@ -116,12 +291,21 @@ void RenderDeviceGLImpl :: InitTexRegionRender()
 
 void RenderDeviceGLImpl :: CreateBuffer(const BufferDesc& BuffDesc, const BufferData* pBuffData, IBuffer **ppBuffer, bool bIsDeviceInternal)
 {
+    if (ShouldUseResourceWorker())
+    {
+        ExecuteOnResourceWorker([&](){ CreateBuffer(BuffDesc, pBuffData, ppBuffer, bIsDeviceInternal); });
+        return;
+    }
+
+    REPORT_PENDING_GL_ERRORS();
+
     CreateDeviceObject( "buffer", BuffDesc, ppBuffer, 
         [&]()
         {
             auto spDeviceContext = GetImmediateContext();
             VERIFY(spDeviceContext, "Immediate device context has been destroyed");
-            auto* pDeviceContextGL = spDeviceContext.RawPtr<DeviceContextGLImpl>();
+            // Immediate context state must not be touched by resource worker threads
+            auto* pDeviceContextGL = IsResourceWorkerThread() ? nullptr : spDeviceContext.RawPtr<DeviceContextGLImpl>();
 
             BufferGLImpl *pBufferOGL( NEW_RC_OBJ(m_BufObjAllocator, "BufferGLImpl instance", BufferGLImpl)
                                                 (m_BuffViewObjAllocator, this, pDeviceContextGL, BuffDesc, pBuffData, bIsDeviceInternal ) );
@@ -140,12 +324,21 @@ void RenderDeviceGLImpl :: CreateBuffer(const BufferDesc& BuffDesc, const Buffer
 void RenderDeviceGLImpl :: CreateBufferFromGLHandle(Uint32 GLHandle, const BufferDesc& BuffDesc, RESOURCE_STATE InitialState, IBuffer **ppBuffer)
 {
     VERIFY(GLHandle, "GL buffer handle must not be null");
+    if (ShouldUseResourceWorker())
+    {
+        ExecuteOnResourceWorker([&](){ CreateBufferFromGLHandle(GLHandle, BuffDesc, InitialState, ppBuffer); });
+        return;
+    }
+
+    REPORT_PENDING_GL_ERRORS();
+
     CreateDeviceObject( "buffer", BuffDesc, ppBuffer, 
         [&]()
         {
             auto spDeviceContext = GetImmediateContext();
             VERIFY(spDeviceContext, "Immediate device context has been destroyed");
-            auto* pDeviceContextGL = spDeviceContext.RawPtr<DeviceContextGLImpl>();
+            // Immediate context state must not be touched by resource worker threads
+            auto* pDeviceContextGL = IsResourceWorkerThread() ? nullptr : spDeviceContext.RawPtr<DeviceContextGLImpl>();
 
             BufferGLImpl *pBufferOGL( NEW_RC_OBJ(m_BufObjAllocator, "BufferGLImpl instance", BufferGLImpl)
                                                 (m_BuffViewObjAllocator, this, pDeviceContextGL, BuffDesc, GLHandle, false ) );
@@ -158,6 +351,15 @@ void RenderDeviceGLImpl :: CreateBufferFromGLHandle(Uint32 GLHandle, const Buffe
 
 void RenderDeviceGLImpl :: CreateShader(const ShaderCreateInfo& ShaderCreateInfo, IShader** ppShader, bool bIsDeviceInternal)
 {
+    CPU_PROFILE_SCOPE("RenderDeviceGLImpl::CreateShader");
+    if (ShouldUseResourceWorker())
+    {
+        ExecuteOnResourceWorker([&](){ CreateShader(ShaderCreateInfo, ppShader, bIsDeviceInternal); });
+        return;
+    }
+
+    REPORT_PENDING_GL_ERRORS();
+
     CreateDeviceObject( "shader", ShaderCreateInfo.Desc, ppShader, 
         [&]()
         {
@@ -177,12 +379,18 @@ void RenderDeviceGLImpl :: CreateShader(const ShaderCreateInfo& ShaderCreateInfo
 
 void RenderDeviceGLImpl :: CreateTexture(const TextureDesc& TexDesc, const TextureData* pData, ITexture **ppTexture, bool bIsDeviceInternal)
 {
+    if (ShouldUseResourceWorker())
+    {
+        ExecuteOnResourceWorker([&](){ CreateTexture(TexDesc, pData, ppTexture, bIsDeviceInternal); });
+        return;
+    }
+
+    REPORT_PENDING_GL_ERRORS();
+
     CreateDeviceObject( "texture", TexDesc, ppTexture, 
         [&]()
         {
-            auto spDeviceContext = GetImmediateContext();
-            VERIFY(spDeviceContext, "Immediate device context has been destroyed");
-            auto& GLState = spDeviceContext.RawPtr<DeviceContextGLImpl>()->GetContextState();
+            auto& GLState = GetResourceCreationContextState();
 
             const auto& FmtInfo = GetTextureFormatInfo( TexDesc.Format );
             if( !FmtInfo.Supported )
@@ -246,12 +454,18 @@ void RenderDeviceGLImpl::CreateTexture(const TextureDesc& TexDesc, const Texture
 void RenderDeviceGLImpl::CreateTextureFromGLHandle(Uint32 GLHandle, const TextureDesc& TexDesc, RESOURCE_STATE InitialState, ITexture **ppTexture)
 {
     VERIFY(GLHandle, "GL texture handle must not be null");
+    if (ShouldUseResourceWorker())
+    {
+        ExecuteOnResourceWorker([&](){ CreateTextureFromGLHandle(GLHandle, TexDesc, InitialState, ppTexture); });
+        return;
+    }
+
+    REPORT_PENDING_GL_ERRORS();
+
     CreateDeviceObject( "texture", TexDesc, ppTexture,
         [&]()
         {
-            auto spDeviceContext = GetImmediateContext();
-            VERIFY(spDeviceContext, "Immediate device context has been destroyed");
-            auto& GLState = spDeviceContext.RawPtr<DeviceContextGLImpl>()->GetContextState();
+            auto& GLState = GetResourceCreationContextState();
 
             TextureBaseGL *pTextureOGL = nullptr;
             switch(TexDesc.Type)
@@ -303,6 +517,14 @@ void RenderDeviceGLImpl::CreateTextureFromGLHandle(Uint32 GLHandle, const Textur
 
 void RenderDeviceGLImpl :: CreateSampler(const SamplerDesc& SamplerDesc, ISampler **ppSampler, bool bIsDeviceInternal)
 {
+    if (ShouldUseResourceWorker())
+    {
+        ExecuteOnResourceWorker([&](){ CreateSampler(SamplerDesc, ppSampler, bIsDeviceInternal); });
+        return;
+    }
+
+    REPORT_PENDING_GL_ERRORS();
+
     CreateDeviceObject( "sampler", SamplerDesc, ppSampler, 
         [&]()
         {
@@ -332,6 +554,15 @@ void RenderDeviceGLImpl::CreatePipelineState( const PipelineStateDesc& PipelineD
 
 void RenderDeviceGLImpl::CreatePipelineState(const PipelineStateDesc& PipelineDesc, IPipelineState **ppPipelineState, bool bIsDeviceInternal)
 {
+    CPU_PROFILE_SCOPE("RenderDeviceGLImpl::CreatePipelineState");
+    if (ShouldUseResourceWorker())
+    {
+        ExecuteOnResourceWorker([&](){ CreatePipelineState(PipelineDesc, ppPipelineState, bIsDeviceInternal); });
+        return;
+    }
+
+    REPORT_PENDING_GL_ERRORS();
+
     CreateDeviceObject( "Pipeline state", PipelineDesc, ppPipelineState, 
         [&]()
         {
@@ -521,6 +752,7 @@ void RenderDeviceGLImpl::FlagSupportedTexFormats()
             // Immediate context has not been created yet, so use raw GL functions
             glBindTexture( GL_TEXTURE_2D, TestGLTex );
             CHECK_GL_ERROR( "Failed to bind texture" );
+            REPORT_PENDING_GL_ERRORS();
             glTexStorage2D( GL_TEXTURE_2D, 1, GLFmt, TestTextureDim, TestTextureDim );
             if (glGetError() == GL_NO_ERROR)
             {
@@ -571,6 +803,7 @@ template<typename CreateFuncType>
 bool CreateTestGLTexture(GLContextState& GlCtxState, GLenum BindTarget, const GLObjectWrappers::GLTextureObj& GLTexObj, CreateFuncType CreateFunc)
 {
     GlCtxState.BindTexture(-1, BindTarget, GLTexObj);
+    REPORT_PENDING_GL_ERRORS();
     CreateFunc();
     bool bSuccess = glGetError() == GL_NO_ERROR;
     GlCtxState.BindTexture(-1, BindTarget, GLObjectWrappers::GLTextureObj(false) );
@@ -648,6 +881,7 @@ void RenderDeviceGLImpl::TestTextureFormat( TEXTURE_FORMAT TexFormat )
             if( bTestDepthAttachment )
             {
                 GLenum Attachment = TexFormatInfo.ComponentType == COMPONENT_TYPE_DEPTH ? GL_DEPTH_ATTACHMENT : GL_DEPTH_STENCIL_ATTACHMENT;
+                REPORT_PENDING_GL_ERRORS();
                 glFramebufferTexture2D( GL_DRAW_FRAMEBUFFER, Attachment, GL_TEXTURE_2D, TestGLTex, 0 );
                 if( glGetError() == GL_NO_ERROR )
                 {
@@ -666,12 +900,14 @@ void RenderDeviceGLImpl::TestTextureFormat( TEXTURE_FORMAT TexFormat )
                     glDrawBuffers( _countof( DrawBuffers ), DrawBuffers );
                     CHECK_GL_ERROR( "Failed to set draw buffers via glDrawBuffers()" );
 
+                    REPORT_PENDING_GL_ERRORS();
                     GLenum Status = glCheckFramebufferStatus( GL_FRAMEBUFFER );
                     TexFormatInfo.DepthRenderable = (glGetError() == GL_NO_ERROR) && (Status == GL_FRAMEBUFFER_COMPLETE);
                 }
             }
             else if( bTestColorAttachment )
             {
+                REPORT_PENDING_GL_ERRORS();
                 glFramebufferTexture2D( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, TestGLTex, 0 );
                 if( glGetError() == GL_NO_ERROR )
                 {
@@ -679,6 +915,7 @@ void RenderDeviceGLImpl::TestTextureFormat( TEXTURE_FORMAT TexFormat )
                     glDrawBuffers( _countof( DrawBuffers ), DrawBuffers );
                     CHECK_GL_ERROR( "Failed to set draw buffers via glDrawBuffers()" );
 
+                    REPORT_PENDING_GL_ERRORS();
                     GLenum Status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
                     TexFormatInfo.ColorRenderable = (glGetError() == GL_NO_ERROR) && (Status == GL_FRAMEBUFFER_COMPLETE);
                 }
@@ -734,6 +971,7 @@ void RenderDeviceGLImpl :: QueryDeviceCaps()
         // Test glPolygonMode() function to check if it fails
         // (It does fail on NVidia Shield tablet, but works fine 
         // on Intel hw)
+        REPORT_PENDING_GL_ERRORS();
         VERIFY( glGetError() == GL_NO_ERROR, "Unhandled gl error encountered" );
         m_DeviceCaps.bWireframeFillSupported = True;
         glPolygonMode( GL_FRONT_AND_BACK, GL_LINE );
@@ -743,13 +981,34 @@ void RenderDeviceGLImpl :: QueryDeviceCaps()
         if( glGetError() != GL_NO_ERROR )
             m_DeviceCaps.bWireframeFillSupported = False;
     }
+
+    if (m_DeviceCaps.DevType == DeviceType::OpenGL)
+    {
+        auto IsGLVersionOrAbove = [&](Int32 Major, Int32 Minor)
+        {
+            return m_DeviceCaps.MajorVersion > Major || (m_DeviceCaps.MajorVersion == Major && m_DeviceCaps.MinorVersion >= Minor);
+        };
+#if GL_ARB_multi_draw_indirect
+        // glMultiDrawArraysIndirect()/glMultiDrawElementsIndirect() are core in GL4.3
+        m_DeviceCaps.bMultiDrawIndirectSupported = IsGLVersionOrAbove(4, 3) || CheckExtension("GL_ARB_multi_draw_indirect");
+#endif
+#if GL_ARB_indirect_parameters
+        // glMultiDraw*IndirectCount() are core in GL4.6 and are available as glMultiDraw*IndirectCountARB() 
+        // through GL_ARB_indirect_parameters extension
+        m_DeviceCaps.bIndirectDrawCountSupported = m_DeviceCaps.bMultiDrawIndirectSupported &&
+            ((IsGLVersionOrAbove(4, 6) && glMultiDrawArraysIndirectCount != nullptr) || CheckExtension("GL_ARB_indirect_parameters"));
+#endif
+    }
 }
 
 
 FBOCache& RenderDeviceGLImpl::GetFBOCache(GLContext::NativeGLContextType Context)
 {
     ThreadingTools::LockHelper FBOCacheLock(m_FBOCacheLockFlag);
-    return m_FBOCache[Context];
+    auto It = m_FBOCache.find(Context);
+    if (It == m_FBOCache.end())
+        It = m_FBOCache.emplace(std::piecewise_construct, std::forward_as_tuple(Context), std::forward_as_tuple(m_FBOCacheSize)).first;
+    return It->second;
 }
 
 void RenderDeviceGLImpl::OnReleaseTexture(ITexture *pTexture)
@@ -762,7 +1021,10 @@ void RenderDeviceGLImpl::OnReleaseTexture(ITexture *pTexture)
 VAOCache& RenderDeviceGLImpl::GetVAOCache(GLContext::NativeGLContextType Context)
 {
     ThreadingTools::LockHelper VAOCacheLock(m_VAOCacheLockFlag);
-    return m_VAOCache[Context];
+    auto It = m_VAOCache.find(Context);
+    if (It == m_VAOCache.end())
+        It = m_VAOCache.emplace(std::piecewise_construct, std::forward_as_tuple(Context), std::forward_as_tuple(m_VAOCacheSize)).first;
+    return It->second;
 }
 
 void RenderDeviceGLImpl::OnDestroyPSO(IPipelineState *pPSO)
@@ -784,4 +1046,20 @@ void RenderDeviceGLImpl::IdleGPU()
     glFinish();
 }
 
+void RenderDeviceGLImpl::GetVAOCacheStatistics(ObjectCacheStatisticsGL& Stats)
+{
+    Stats = ObjectCacheStatisticsGL{};
+    ThreadingTools::LockHelper VAOCacheLock(m_VAOCacheLockFlag);
+    for (auto& VAOCacheIt : m_VAOCache)
+        VAOCacheIt.second.AccumulateStatistics(Stats);
+}
+
+void RenderDeviceGLImpl::GetFBOCacheStatistics(ObjectCacheStatisticsGL& Stats)
+{
+    Stats = ObjectCacheStatisticsGL{};
+    ThreadingTools::LockHelper FBOCacheLock(m_FBOCacheLockFlag);
+    for (auto& FBOCacheIt : m_FBOCache)
+        FBOCacheIt.second.AccumulateStatistics(Stats);
+}
+
 }
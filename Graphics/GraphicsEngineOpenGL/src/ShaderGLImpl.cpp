@@ -28,6 +28,7 @@
 #include "DeviceContextGLImpl.h"
 #include "DataBlobImpl.h"
 #include "GLSLSourceBuilder.h"
+#include "GLProgramBinaryCache.h"
 
 using namespace Diligent;
 
@@ -48,7 +49,33 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*      pRefCounters,
     m_GLShaderObj{true, GLObjectWrappers::GLShaderObjCreateReleaseHelper{GetGLShaderType(m_Desc.ShaderType)}}
 {
     auto GLSLSource = BuildGLSLSourceString(CreationAttribs, pDeviceGL->GetDeviceCaps(), TargetGLSLCompiler::driver);
+    m_SourceHash = ComputeHash(static_cast<Int32>(m_Desc.ShaderType), GLSLSource);
 
+    if (pDeviceGL->GetProgramBinaryCache() != nullptr && CreationAttribs.ppCompilerOutput == nullptr)
+    {
+        // Programs that use this shader may be found in the program binary cache, in which case
+        // the shader does not need to be compiled at all
+        m_DeferredGLSLSource = std::move(GLSLSource);
+    }
+    else
+    {
+        CompileShader(GLSLSource, CreationAttribs.ppCompilerOutput);
+    }
+
+    if (pDeviceGL->GetDeviceCaps().bSeparableProgramSupported)
+    {
+        IShader* ThisShader[] = {this};
+        Uint32  UniformBufferBinding = 0;   
+        Uint32  SamplerBinding       = 0;
+        Uint32  ImageBinding         = 0;
+        Uint32  StorageBufferBinding = 0;
+        auto& GLState = pDeviceGL->GetResourceCreationContextState();
+        CreateProgram(ThisShader, 1, true, m_Desc.ShaderType, GLState, m_Resources, UniformBufferBinding, SamplerBinding, ImageBinding, StorageBufferBinding);
+    }
+}
+
+void ShaderGLImpl::CompileShader(const String& GLSLSource, IDataBlob** ppCompilerOutput)
+{
     // Note: there is a simpler way to create the program:
     //m_uiShaderSeparateProg = glCreateShaderProgramv(GL_VERTEX_SHADER, _countof(ShaderStrings), ShaderStrings);
     // NOTE: glCreateShaderProgramv() is considered equivalent to both a shader compilation and a program linking 
@@ -80,7 +107,7 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*      pRefCounters,
             FullSource.append(str);
 
         std::stringstream ErrorMsgSS;
-		ErrorMsgSS << "Failed to compile shader file '"<< (CreationAttribs.Desc.Name != nullptr ? CreationAttribs.Desc.Name : "") << '\'' << std::endl;
+		ErrorMsgSS << "Failed to compile shader file '"<< m_Desc.Name << '\'' << std::endl;
         int infoLogLen = 0;
         // The function glGetShaderiv() tells how many bytes to allocate; the length includes the NULL terminator. 
         glGetShaderiv(m_GLShaderObj, GL_INFO_LOG_LENGTH, &infoLogLen);
@@ -97,7 +124,7 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*      pRefCounters,
             ErrorMsgSS << "InfoLog:" << std::endl << infoLog.data() << std::endl;
         }
 
-        if (CreationAttribs.ppCompilerOutput != nullptr)
+        if (ppCompilerOutput != nullptr)
         {
             // infoLogLen accounts for null terminator
             auto* pOutputDataBlob = MakeNewRCObj<DataBlobImpl>()(infoLogLen + FullSource.length() + 1);
@@ -105,7 +132,7 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*      pRefCounters,
             if (infoLogLen > 0)
                 memcpy(DataPtr, infoLog.data(), infoLogLen);
             memcpy(DataPtr + infoLogLen, FullSource.data(), FullSource.length() + 1);
-            pOutputDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(CreationAttribs.ppCompilerOutput));
+            pOutputDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppCompilerOutput));
         }
         else
         {
@@ -115,20 +142,21 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*      pRefCounters,
 
         LOG_ERROR_AND_THROW(ErrorMsgSS.str().c_str());
     }
+}
 
-    if (pDeviceGL->GetDeviceCaps().bSeparableProgramSupported)
+const GLObjectWrappers::GLShaderObj& ShaderGLImpl::GetGLShaderObj()
+{
+    // Programs that share the shader may be created by several resource worker threads at the same time
+    std::lock_guard<std::mutex> Lock(m_DeferredCompileMtx);
+    if (!m_DeferredGLSLSource.empty())
     {
-        IShader* ThisShader[] = {this};
-        GLObjectWrappers::GLProgramObj Program = LinkProgram(ThisShader, 1, true);
-        Uint32  UniformBufferBinding = 0;   
-        Uint32  SamplerBinding       = 0;
-        Uint32  ImageBinding         = 0;
-        Uint32  StorageBufferBinding = 0;
-        auto pImmediateCtx = m_pDevice->GetImmediateContext();
-        VERIFY_EXPR(pImmediateCtx);
-        auto& GLState = pImmediateCtx.RawPtr<DeviceContextGLImpl>()->GetContextState();
-        m_Resources.LoadUniforms(m_Desc.ShaderType, Program, GLState, UniformBufferBinding, SamplerBinding, ImageBinding, StorageBufferBinding);
+        // The source is only released after successful compilation, so that every program
+        // that uses a shader that failed to compile reports the error
+        CompileShader(m_DeferredGLSLSource, nullptr);
+        m_DeferredGLSLSource.clear();
+        m_DeferredGLSLSource.shrink_to_fit();
     }
+    return m_GLShaderObj;
 }
 
 ShaderGLImpl::~ShaderGLImpl()
@@ -138,6 +166,61 @@ ShaderGLImpl::~ShaderGLImpl()
 IMPLEMENT_QUERY_INTERFACE( ShaderGLImpl, IID_ShaderGL, TShaderBase )
 
 
+GLObjectWrappers::GLProgramObj ShaderGLImpl::CreateProgram(IShader**           ppShaders,
+                                                           Uint32              NumShaders,
+                                                           bool                IsSeparableProgram,
+                                                           SHADER_TYPE         ShaderStages,
+                                                           GLContextState&     State,
+                                                           GLProgramResources& Resources,
+                                                           Uint32&             UniformBufferBinding,
+                                                           Uint32&             SamplerBinding,
+                                                           Uint32&             ImageBinding,
+                                                           Uint32&             StorageBufferBinding)
+{
+    VERIFY_EXPR(NumShaders > 0);
+    auto* pProgramCache = ValidatedCast<ShaderGLImpl>(ppShaders[0])->GetDevice()->GetProgramBinaryCache();
+
+    size_t ProgramHash = 0;
+    if (pProgramCache != nullptr)
+    {
+        ProgramHash = ComputeHash(IsSeparableProgram, static_cast<Int32>(ShaderStages), NumShaders);
+        for (Uint32 i = 0; i < NumShaders; ++i)
+            HashCombine(ProgramHash, ValidatedCast<ShaderGLImpl>(ppShaders[i])->m_SourceHash);
+
+        GLObjectWrappers::GLProgramObj GLProg(true);
+        // GL_PROGRAM_SEPARABLE is not guaranteed to be restored from the binary
+        if (IsSeparableProgram)
+            glProgramParameteri(GLProg, GL_PROGRAM_SEPARABLE, GL_TRUE);
+
+        std::vector<Uint8> ResourceData;
+        if (pProgramCache->LoadProgram(ProgramHash, GLProg, ResourceData))
+        {
+            if (!Resources.LoadSerializedUniforms(ShaderStages, GLProg, State, ResourceData, UniformBufferBinding, SamplerBinding, ImageBinding, StorageBufferBinding))
+            {
+                // The binary has been accepted, so only reflection needs to be repeated
+                LOG_WARNING_MESSAGE("Serialized resources of a cached GL program are invalid and will be reloaded from the program");
+                Resources.LoadUniforms(ShaderStages, GLProg, State, UniformBufferBinding, SamplerBinding, ImageBinding, StorageBufferBinding);
+            }
+            return GLProg;
+        }
+        // The program is not in the cache or the binary was rejected: GLProg is released and
+        // the program is linked from source into a new object
+    }
+
+    auto GLProg = LinkProgram(ppShaders, NumShaders, IsSeparableProgram);
+    Resources.LoadUniforms(ShaderStages, GLProg, State, UniformBufferBinding, SamplerBinding, ImageBinding, StorageBufferBinding);
+
+    if (pProgramCache != nullptr)
+    {
+        std::vector<Uint8> ResourceData;
+        Resources.Serialize(ResourceData);
+        pProgramCache->StoreProgram(ProgramHash, GLProg, ResourceData);
+    }
+
+    return GLProg;
+}
+
+
 GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(IShader** ppShaders, Uint32 NumShaders, bool IsSeparableProgram)
 {
     VERIFY(!IsSeparableProgram || NumShaders == 1, "Number of shaders must be 1 when separable program is created");
@@ -148,10 +231,14 @@ GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(IShader** ppShaders, Ui
     if (IsSeparableProgram)
         glProgramParameteri(GLProg, GL_PROGRAM_SEPARABLE, GL_TRUE);
 
+    // Drivers may discard program binaries unless the hint is set before linking
+    if (ValidatedCast<ShaderGLImpl>(ppShaders[0])->GetDevice()->GetProgramBinaryCache() != nullptr)
+        glProgramParameteri(GLProg, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
     for (Uint32 i = 0; i < NumShaders; ++i)
     {
         auto* pCurrShader = ValidatedCast<ShaderGLImpl>(ppShaders[i]);
-        glAttachShader(GLProg, pCurrShader->m_GLShaderObj);
+        glAttachShader(GLProg, pCurrShader->GetGLShaderObj());
         CHECK_GL_ERROR("glAttachShader() failed");
     }
 
@@ -190,7 +277,7 @@ GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(IShader** ppShaders, Ui
     for (Uint32 i = 0; i < NumShaders; ++i)
     {
         auto* pCurrShader = ValidatedCast<ShaderGLImpl>(ppShaders[i]);
-        glDetachShader(GLProg, pCurrShader->m_GLShaderObj);
+        glDetachShader(GLProg, pCurrShader->GetGLShaderObj());
         CHECK_GL_ERROR("glDetachShader() failed");
     }
 
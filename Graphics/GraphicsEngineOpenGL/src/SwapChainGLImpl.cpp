@@ -81,6 +81,12 @@ void SwapChainGLImpl::Present(Uint32 SyncInterval)
     auto *pDeviceGL = m_pRenderDevice.RawPtr<RenderDeviceGLImpl>();
     auto &GLContext = pDeviceGL->m_GLContext;
     GLContext.SwapBuffers();
+
+    auto pDeviceContext = m_wpDeviceContext.Lock();
+    if (pDeviceContext && m_SwapChainDesc.IsPrimary)
+    {
+        pDeviceContext.RawPtr<DeviceContextGLImpl>()->FinishFrame();
+    }
 #elif PLATFORM_MACOS
     LOG_ERROR("Swap buffers operation must be performed by the app on MacOS");
 #else
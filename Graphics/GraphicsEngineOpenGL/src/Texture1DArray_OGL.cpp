@@ -114,7 +114,10 @@ void Texture1DArray_OGL::UpdateData( GLContextState&          ContextState,
 {
     TextureBaseGL::UpdateData(ContextState, MipLevel, Slice, DstBox, SubresData);
 
-    ContextState.BindTexture( -1, m_BindTarget, m_GlTexture );
+    // With direct state access, the texture is updated without binding it to a texture unit
+    const bool UseDSA = ContextState.GetContextCaps().bDirectStateAccessSupported;
+    if (!UseDSA)
+        ContextState.BindTexture(-1, m_BindTarget, m_GlTexture);
 
     // Bind buffer if it is provided; copy from CPU memory otherwise
     GLuint UnpackBuffer = 0;
@@ -136,6 +139,14 @@ void Texture1DArray_OGL::UpdateData( GLContextState&          ContextState,
     glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
     glPixelStorei(GL_UNPACK_SKIP_ROWS, 0 );
 
+#if GL_ARB_direct_state_access
+    if (UseDSA)
+    {
+        glTextureSubImage2D(m_GlTexture, MipLevel, DstBox.MinX, Slice, DstBox.MaxX - DstBox.MinX, 1, TransferAttribs.PixelFormat, TransferAttribs.DataType,
+                            SubresData.pSrcBuffer != nullptr ? reinterpret_cast<void*>(static_cast<size_t>(SubresData.SrcOffset)) : SubresData.pData);
+    }
+    else
+#endif
     glTexSubImage2D(m_BindTarget, MipLevel, 
                     DstBox.MinX, 
                     Slice, 
@@ -152,7 +163,8 @@ void Texture1DArray_OGL::UpdateData( GLContextState&          ContextState,
     if(UnpackBuffer != 0)
         glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 
-    ContextState.BindTexture( -1, m_BindTarget, GLObjectWrappers::GLTextureObj(false) );
+    if (!UseDSA)
+        ContextState.BindTexture( -1, m_BindTarget, GLObjectWrappers::GLTextureObj(false) );
 }
 
 void Texture1DArray_OGL::AttachToFramebuffer( const TextureViewDesc& ViewDesc, GLenum AttachmentPoint )
@@ -111,7 +111,10 @@ void Texture1D_OGL::UpdateData( GLContextState&           ContextState,
 {
     TextureBaseGL::UpdateData(ContextState, MipLevel, Slice, DstBox, SubresData);
 
-    ContextState.BindTexture( -1, m_BindTarget, m_GlTexture );
+    // With direct state access, the texture is updated without binding it to a texture unit
+    const bool UseDSA = ContextState.GetContextCaps().bDirectStateAccessSupported;
+    if (!UseDSA)
+        ContextState.BindTexture(-1, m_BindTarget, m_GlTexture);
 
     // Bind buffer if it is provided; copy from CPU memory otherwise
     GLuint UnpackBuffer = 0;
@@ -133,6 +136,14 @@ void Texture1D_OGL::UpdateData( GLContextState&           ContextState,
     glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
     glPixelStorei(GL_UNPACK_SKIP_ROWS, 0 );
 
+#if GL_ARB_direct_state_access
+    if (UseDSA)
+    {
+        glTextureSubImage1D(m_GlTexture, MipLevel, DstBox.MinX, DstBox.MaxX - DstBox.MinX, TransferAttribs.PixelFormat, TransferAttribs.DataType,
+                            SubresData.pSrcBuffer != nullptr ? reinterpret_cast<void*>(static_cast<size_t>(SubresData.SrcOffset)) : SubresData.pData);
+    }
+    else
+#endif
     glTexSubImage1D(m_BindTarget, MipLevel,
                     DstBox.MinX, 
                     DstBox.MaxX - DstBox.MinX,
@@ -146,7 +157,8 @@ void Texture1D_OGL::UpdateData( GLContextState&           ContextState,
     if(UnpackBuffer != 0)
         glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 
-    ContextState.BindTexture( -1, m_BindTarget, GLObjectWrappers::GLTextureObj(false) );
+    if (!UseDSA)
+        ContextState.BindTexture( -1, m_BindTarget, GLObjectWrappers::GLTextureObj(false) );
 }
 
 void Texture1D_OGL::AttachToFramebuffer( const TextureViewDesc& ViewDesc, GLenum AttachmentPoint )
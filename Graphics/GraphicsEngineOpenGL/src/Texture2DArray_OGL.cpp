@@ -136,7 +136,10 @@ void Texture2DArray_OGL::UpdateData(GLContextState&             ContextState,
 {
     TextureBaseGL::UpdateData(ContextState, MipLevel, Slice, DstBox, SubresData);
 
-    ContextState.BindTexture(-1, m_BindTarget, m_GlTexture);
+    // With direct state access, the texture is updated without binding it to a texture unit
+    const bool UseDSA = ContextState.GetContextCaps().bDirectStateAccessSupported;
+    if (!UseDSA)
+        ContextState.BindTexture(-1, m_BindTarget, m_GlTexture);
 
     // Bind buffer if it is provided; copy from CPU memory otherwise
     GLuint UnpackBuffer = 0;
@@ -177,6 +180,14 @@ void Texture2DArray_OGL::UpdateData(GLContextState&             ContextState,
         auto UpdateRegionHeight = DstBox.MaxY - DstBox.MinY;
         UpdateRegionWidth  = std::min(UpdateRegionWidth,  MipWidth  - DstBox.MinX);
         UpdateRegionHeight = std::min(UpdateRegionHeight, MipHeight - DstBox.MinY);
+#if GL_ARB_direct_state_access
+        if (UseDSA)
+        {
+            glCompressedTextureSubImage3D(m_GlTexture, MipLevel, DstBox.MinX, DstBox.MinY, Slice, UpdateRegionWidth, UpdateRegionHeight, 1, m_GLTexFormat, ((DstBox.MaxY - DstBox.MinY + 3)/4) * SubresData.Stride,
+                                          SubresData.pSrcBuffer != nullptr ? reinterpret_cast<void*>(static_cast<size_t>(SubresData.SrcOffset)) : SubresData.pData);
+        }
+        else
+#endif
         glCompressedTexSubImage3D(m_BindTarget, MipLevel, 
                         DstBox.MinX, 
                         DstBox.MinY, 
@@ -207,6 +218,14 @@ void Texture2DArray_OGL::UpdateData(GLContextState&             ContextState,
         glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
         glPixelStorei(GL_UNPACK_SKIP_ROWS, 0 );
 
+#if GL_ARB_direct_state_access
+        if (UseDSA)
+        {
+            glTextureSubImage3D(m_GlTexture, MipLevel, DstBox.MinX, DstBox.MinY, Slice, DstBox.MaxX - DstBox.MinX, DstBox.MaxY - DstBox.MinY, 1, TransferAttribs.PixelFormat, TransferAttribs.DataType,
+                                SubresData.pSrcBuffer != nullptr ? reinterpret_cast<void*>(static_cast<size_t>(SubresData.SrcOffset)) : SubresData.pData);
+        }
+        else
+#endif
         glTexSubImage3D(m_BindTarget, MipLevel, 
                         DstBox.MinX, 
                         DstBox.MinY,
@@ -225,7 +244,8 @@ void Texture2DArray_OGL::UpdateData(GLContextState&             ContextState,
     if(UnpackBuffer != 0)
         glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 
-    ContextState.BindTexture( -1, m_BindTarget, GLObjectWrappers::GLTextureObj(false) );
+    if (!UseDSA)
+        ContextState.BindTexture( -1, m_BindTarget, GLObjectWrappers::GLTextureObj(false) );
 }
 
 void Texture2DArray_OGL::AttachToFramebuffer( const TextureViewDesc& ViewDesc, GLenum AttachmentPoint )
@@ -116,7 +116,10 @@ void Texture3D_OGL::UpdateData( GLContextState&             ContextState,
 {
     TextureBaseGL::UpdateData(ContextState, MipLevel, Slice, DstBox, SubresData);
 
-    ContextState.BindTexture(-1, m_BindTarget, m_GlTexture);
+    // With direct state access, the texture is updated without binding it to a texture unit
+    const bool UseDSA = ContextState.GetContextCaps().bDirectStateAccessSupported;
+    if (!UseDSA)
+        ContextState.BindTexture(-1, m_BindTarget, m_GlTexture);
 
     // Bind buffer if it is provided; copy from CPU memory otherwise
     GLuint UnpackBuffer = 0;
@@ -146,6 +149,14 @@ void Texture3D_OGL::UpdateData( GLContextState&             ContextState,
     VERIFY( (SubresData.DepthStride % SubresData.Stride)==0, "Depth stride is not multiple of stride" );
     glPixelStorei(GL_UNPACK_IMAGE_HEIGHT, SubresData.DepthStride / SubresData.Stride);
 
+#if GL_ARB_direct_state_access
+    if (UseDSA)
+    {
+        glTextureSubImage3D(m_GlTexture, MipLevel, DstBox.MinX, DstBox.MinY, DstBox.MinZ, DstBox.MaxX - DstBox.MinX, DstBox.MaxY - DstBox.MinY, DstBox.MaxZ - DstBox.MinZ, TransferAttribs.PixelFormat, TransferAttribs.DataType,
+                            SubresData.pSrcBuffer != nullptr ? reinterpret_cast<void*>(static_cast<size_t>(SubresData.SrcOffset)) : SubresData.pData);
+    }
+    else
+#endif
     glTexSubImage3D(m_BindTarget, MipLevel, 
                     DstBox.MinX, 
                     DstBox.MinY,
@@ -164,7 +175,8 @@ void Texture3D_OGL::UpdateData( GLContextState&             ContextState,
     if(UnpackBuffer != 0)
         glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 
-    ContextState.BindTexture( -1, m_BindTarget, GLObjectWrappers::GLTextureObj(false) );
+    if (!UseDSA)
+        ContextState.BindTexture( -1, m_BindTarget, GLObjectWrappers::GLTextureObj(false) );
 }
 
 void Texture3D_OGL::AttachToFramebuffer( const TextureViewDesc& ViewDesc, GLenum AttachmentPoint )
@@ -58,6 +58,43 @@ TextureBaseGL::TextureBaseGL(IReferenceCounters*            pRefCounters,
     VERIFY( m_GLTexFormat != 0, "Unsupported texture format" );
     if( TexDesc.Usage == USAGE_STATIC && pInitData == nullptr )
         LOG_ERROR_AND_THROW("Static Texture must be initialized with data at creation time");
+
+    if (m_Desc.Usage == USAGE_STAGING && (m_Desc.CPUAccessFlags & CPU_ACCESS_READ) != 0)
+    {
+        // Similar to other backends, readback textures keep their data in a buffer. Copy operations
+        // read pixels into the buffer asynchronously, and mapping the texture maps the buffer.
+        if (GetTextureFormatAttribs(m_Desc.Format).ComponentType == COMPONENT_TYPE_COMPRESSED)
+            LOG_ERROR_AND_THROW("Staging textures with compressed formats can't be read back in OpenGL");
+
+        Uint32 SliceSize = 0;
+        for (Uint32 Mip = 0; Mip < m_Desc.MipLevels; ++Mip)
+        {
+            auto MipProps = GetMipLevelProperties(m_Desc, Mip);
+            SliceSize += GetPixelPackRowStride(MipProps.RowSize) * MipProps.StorageHeight * MipProps.Depth;
+        }
+        m_PixelPackBufferSize = SliceSize * (m_Desc.Type == RESOURCE_DIM_TEX_3D ? 1 : m_Desc.ArraySize);
+
+        m_PixelPackBuffer.Create();
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, m_PixelPackBuffer);
+        glBufferData(GL_PIXEL_PACK_BUFFER, m_PixelPackBufferSize, nullptr, GL_STREAM_READ);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        CHECK_GL_ERROR_AND_THROW("Failed to create pixel pack buffer for staging texture '", m_Desc.Name, '\'');
+    }
+}
+
+Uint32 TextureBaseGL::GetPixelPackBufferOffset(Uint32 MipLevel, Uint32 Slice)const
+{
+    VERIFY(m_PixelPackBuffer != 0, "This texture has no pixel pack buffer");
+    Uint32 SliceSize = 0;
+    Uint32 MipOffset = 0;
+    for (Uint32 Mip = 0; Mip < m_Desc.MipLevels; ++Mip)
+    {
+        if (Mip == MipLevel)
+            MipOffset = SliceSize;
+        auto MipProps = GetMipLevelProperties(m_Desc, Mip);
+        SliceSize += GetPixelPackRowStride(MipProps.RowSize) * MipProps.StorageHeight * MipProps.Depth;
+    }
+    return SliceSize * Slice + MipOffset;
 }
 
 static GLenum GetTextureInternalFormat(GLContextState& GLState, GLenum BindTarget, const GLObjectWrappers::GLTextureObj& GLTex, TEXTURE_FORMAT TexFmtFromDesc)
@@ -155,6 +192,7 @@ static TextureDesc GetTextureDescFromGLHandle(GLContextState& GLState, TextureDe
 
     // GL_TEXTURE_IMMUTABLE_LEVELS is only supported in GL4.3+ and GLES3.1+
     GLint MipLevels = 0;
+    REPORT_PENDING_GL_ERRORS();
     glGetTexParameteriv(BindTarget, GL_TEXTURE_IMMUTABLE_LEVELS, &MipLevels);
     if(glGetError() == GL_NO_ERROR)
     {
@@ -207,6 +245,15 @@ void TextureBaseGL::CreateViewInternal( const struct TextureViewDesc &OrigViewDe
 
     *ppView = nullptr;
 
+    auto* pDeviceGL = GetDevice();
+    if (pDeviceGL->ShouldUseResourceWorker())
+    {
+        pDeviceGL->ExecuteOnResourceWorker([&](){ CreateViewInternal(OrigViewDesc, ppView, bIsDefaultView); });
+        return;
+    }
+
+    REPORT_PENDING_GL_ERRORS();
+
     try
     {
         auto ViewDesc = OrigViewDesc;
@@ -397,6 +444,12 @@ void TextureBaseGL :: CopyData(DeviceContextGLImpl* pDeviceCtxGL,
         pSrcBox = &SrcBox;
     }
 
+    if (m_PixelPackBuffer != 0)
+    {
+        ReadPixelsToPackBuffer(pDeviceCtxGL, pSrcTextureGL, SrcMipLevel, SrcSlice, *pSrcBox, DstMipLevel, DstSlice, DstX, DstY, DstZ);
+        return;
+    }
+
 #if GL_ARB_copy_image
     if( glCopyImageSubData )
     {
@@ -495,6 +548,93 @@ void TextureBaseGL :: CopyData(DeviceContextGLImpl* pDeviceCtxGL,
 }
 
 
+void TextureBaseGL::ReadPixelsToPackBuffer(DeviceContextGLImpl* pDeviceCtxGL,
+                                           TextureBaseGL*       pSrcTextureGL,
+                                           Uint32               SrcMipLevel,
+                                           Uint32               SrcSlice,
+                                           const Box&           SrcBox,
+                                           Uint32               DstMipLevel,
+                                           Uint32               DstSlice,
+                                           Uint32               DstX,
+                                           Uint32               DstY,
+                                           Uint32               DstZ)
+{
+    const auto& SrcTexDesc = pSrcTextureGL->GetDesc();
+    const auto  TransferAttribs = GetNativePixelTransferAttribs(m_Desc.Format);
+    const auto& FmtAttribs = GetTextureFormatAttribs(m_Desc.Format);
+    const auto  MipProps   = GetMipLevelProperties(m_Desc, DstMipLevel);
+    const auto  RowStride  = GetPixelPackRowStride(MipProps.RowSize);
+    const auto  TexelSize  = Uint32{FmtAttribs.ComponentSize} * Uint32{FmtAttribs.NumComponents};
+    const auto  Width  = SrcBox.MaxX - SrcBox.MinX;
+    const auto  Height = SrcBox.MaxY - SrcBox.MinY;
+    const auto  Depth  = SrcBox.MaxZ - SrcBox.MinZ;
+    size_t DstOffset = GetPixelPackBufferOffset(DstMipLevel, m_Desc.Type == RESOURCE_DIM_TEX_3D ? 0 : DstSlice) +
+                       (size_t{DstZ} * MipProps.StorageHeight + DstY) * RowStride + size_t{DstX} * TexelSize;
+    VERIFY(DstOffset + (size_t{Depth - 1} * MipProps.StorageHeight + Height - 1) * RowStride + size_t{Width} * TexelSize <= m_PixelPackBufferSize,
+           "Copy region is out of the pixel pack buffer bounds");
+
+    // Make shader writes to the source texture visible to pixel transfer operations
+    pSrcTextureGL->TextureMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT, pDeviceCtxGL->GetContextState());
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_PixelPackBuffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glPixelStorei(GL_PACK_ROW_LENGTH, MipProps.StorageWidth);
+
+    bool bCopied = false;
+#if GL_ARB_get_texture_sub_image
+    if (glGetTextureSubImage != nullptr)
+    {
+        // Array slice or cube face is addressed by z offset
+        GLint SrcSliceY = (SrcTexDesc.Type == RESOURCE_DIM_TEX_1D_ARRAY) ? SrcSlice : 0;
+        GLint SrcSliceZ = (SrcTexDesc.Type == RESOURCE_DIM_TEX_2D_ARRAY || SrcTexDesc.Type == RESOURCE_DIM_TEX_CUBE || SrcTexDesc.Type == RESOURCE_DIM_TEX_CUBE_ARRAY) ? SrcSlice : 0;
+        // Depth slices are tightly packed after the rows of the previous slice
+        glPixelStorei(GL_PACK_IMAGE_HEIGHT, MipProps.StorageHeight);
+        glGetTextureSubImage(pSrcTextureGL->GetGLHandle(), SrcMipLevel,
+                             SrcBox.MinX, SrcBox.MinY + SrcSliceY, SrcBox.MinZ + SrcSliceZ,
+                             Width, Height, Depth,
+                             TransferAttribs.PixelFormat, TransferAttribs.DataType,
+                             static_cast<GLsizei>(m_PixelPackBufferSize - DstOffset),
+                             reinterpret_cast<void*>(DstOffset));
+        glPixelStorei(GL_PACK_IMAGE_HEIGHT, 0);
+        CHECK_GL_ERROR("glGetTextureSubImage() failed");
+        bCopied = true;
+    }
+#endif
+
+    if (!bCopied)
+    {
+        // Read pixels through a temporary framebuffer. AttachToFramebuffer() uses both draw and read
+        // framebuffers, so both bindings are restored afterwards to keep the context state cache valid.
+        GLint PrevDrawFBO = 0, PrevReadFBO = 0;
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &PrevDrawFBO);
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &PrevReadFBO);
+
+        GLObjectWrappers::GLFrameBufferObj TmpFBO{true};
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, TmpFBO);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, TmpFBO);
+        for (Uint32 DepthSlice = 0; DepthSlice < Depth; ++DepthSlice)
+        {
+            TextureViewDesc ViewDesc;
+            ViewDesc.ViewType        = TEXTURE_VIEW_RENDER_TARGET;
+            ViewDesc.TextureDim      = SrcTexDesc.Type;
+            ViewDesc.MostDetailedMip = SrcMipLevel;
+            ViewDesc.FirstArraySlice = SrcSlice + SrcBox.MinZ + DepthSlice;
+            ViewDesc.NumArraySlices  = 1;
+            pSrcTextureGL->AttachToFramebuffer(ViewDesc, GL_COLOR_ATTACHMENT0);
+            glReadBuffer(GL_COLOR_ATTACHMENT0);
+            glReadPixels(SrcBox.MinX, SrcBox.MinY, Width, Height, TransferAttribs.PixelFormat, TransferAttribs.DataType,
+                         reinterpret_cast<void*>(DstOffset + size_t{DepthSlice} * MipProps.StorageHeight * RowStride));
+            CHECK_GL_ERROR("glReadPixels() failed");
+        }
+
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(PrevDrawFBO));
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(PrevReadFBO));
+    }
+
+    glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
 void TextureBaseGL::TextureMemoryBarrier( Uint32 RequiredBarriers, GLContextState &GLContextState )
 {
 #if GL_ARB_shader_image_load_store
@@ -123,7 +123,10 @@ void TextureCubeArray_OGL::UpdateData( GLContextState&           ContextState,
 {
     TextureBaseGL::UpdateData(ContextState, MipLevel, Slice, DstBox, SubresData);
 
-    ContextState.BindTexture(-1, m_BindTarget, m_GlTexture);
+    // With direct state access, the texture is updated without binding it to a texture unit
+    const bool UseDSA = ContextState.GetContextCaps().bDirectStateAccessSupported;
+    if (!UseDSA)
+        ContextState.BindTexture(-1, m_BindTarget, m_GlTexture);
 
     // Bind buffer if it is provided; copy from CPU memory otherwise
     GLuint UnpackBuffer = 0;
@@ -167,6 +170,14 @@ void TextureCubeArray_OGL::UpdateData( GLContextState&           ContextState,
         auto UpdateRegionHeight = DstBox.MaxY - DstBox.MinY;
         UpdateRegionWidth  = std::min(UpdateRegionWidth,  MipWidth  - DstBox.MinX);
         UpdateRegionHeight = std::min(UpdateRegionHeight, MipHeight - DstBox.MinY);
+#if GL_ARB_direct_state_access
+        if (UseDSA)
+        {
+            glCompressedTextureSubImage3D(m_GlTexture, MipLevel, DstBox.MinX, DstBox.MinY, Slice, UpdateRegionWidth, UpdateRegionHeight, 1, m_GLTexFormat, ((DstBox.MaxY - DstBox.MinY + 3)/4) * SubresData.Stride,
+                                          SubresData.pSrcBuffer != nullptr ? reinterpret_cast<void*>(static_cast<size_t>(SubresData.SrcOffset)) : SubresData.pData);
+        }
+        else
+#endif
         glCompressedTexSubImage3D(m_BindTarget, MipLevel, 
                         DstBox.MinX, 
                         DstBox.MinY, 
@@ -205,6 +216,14 @@ void TextureCubeArray_OGL::UpdateData( GLContextState&           ContextState,
 
         // Target must be GL_TEXTURE_3D, GL_TEXTURE_2D_ARRAY, or GL_TEXTURE_CUBE_MAP_ARRAY.
         // (NO individual cubemap faces GL_TEXTURE_CUBE_MAP_POSITIVE_X .. GL_TEXTURE_CUBE_MAP_NEGATIVE_Z!!!)
+#if GL_ARB_direct_state_access
+        if (UseDSA)
+        {
+            glTextureSubImage3D(m_GlTexture, MipLevel, DstBox.MinX, DstBox.MinY, Slice, DstBox.MaxX - DstBox.MinX, DstBox.MaxY - DstBox.MinY, 1, TransferAttribs.PixelFormat, TransferAttribs.DataType,
+                                SubresData.pSrcBuffer != nullptr ? reinterpret_cast<void*>(static_cast<size_t>(SubresData.SrcOffset)) : SubresData.pData);
+        }
+        else
+#endif
         glTexSubImage3D(m_BindTarget, MipLevel, 
                         DstBox.MinX, 
                         DstBox.MinY,
@@ -223,7 +242,8 @@ void TextureCubeArray_OGL::UpdateData( GLContextState&           ContextState,
     if(UnpackBuffer != 0)
         glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 
-    ContextState.BindTexture( -1, m_BindTarget, GLObjectWrappers::GLTextureObj(false) );
+    if (!UseDSA)
+        ContextState.BindTexture( -1, m_BindTarget, GLObjectWrappers::GLTextureObj(false) );
 }
 
 void TextureCubeArray_OGL::AttachToFramebuffer( const TextureViewDesc& ViewDesc, GLenum AttachmentPoint )
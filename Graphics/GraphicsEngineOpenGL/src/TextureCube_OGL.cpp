@@ -135,7 +135,10 @@ void TextureCube_OGL::UpdateData( GLContextState&           ContextState,
 
     // Texture must be bound as GL_TEXTURE_CUBE_MAP, but glTexSubImage2D() 
     // then takes one of GL_TEXTURE_CUBE_MAP_POSITIVE_X ... GL_TEXTURE_CUBE_MAP_NEGATIVE_Z
-    ContextState.BindTexture(-1, m_BindTarget, m_GlTexture);
+    // With direct state access, the texture is updated without binding it to a texture unit
+    const bool UseDSA = ContextState.GetContextCaps().bDirectStateAccessSupported;
+    if (!UseDSA)
+        ContextState.BindTexture(-1, m_BindTarget, m_GlTexture);
 
     auto CubeMapFaceBindTarget = CubeMapFaces[Slice];
 
@@ -182,6 +185,15 @@ void TextureCube_OGL::UpdateData( GLContextState&           ContextState,
         auto UpdateRegionHeight = DstBox.MaxY - DstBox.MinY;
         UpdateRegionWidth  = std::min(UpdateRegionWidth,  MipWidth  - DstBox.MinX);
         UpdateRegionHeight = std::min(UpdateRegionHeight, MipHeight - DstBox.MinY);
+#if GL_ARB_direct_state_access
+        if (UseDSA)
+        {
+            // Direct state access functions address cube map faces as layers of a 3D texture
+            glCompressedTextureSubImage3D(m_GlTexture, MipLevel, DstBox.MinX, DstBox.MinY, Slice, UpdateRegionWidth, UpdateRegionHeight, 1, m_GLTexFormat, ((DstBox.MaxY - DstBox.MinY + 3)/4) * SubresData.Stride,
+                                          SubresData.pSrcBuffer != nullptr ? reinterpret_cast<void*>(static_cast<size_t>(SubresData.SrcOffset)) : SubresData.pData);
+        }
+        else
+#endif
         glCompressedTexSubImage2D(CubeMapFaceBindTarget, MipLevel, 
                         DstBox.MinX, 
                         DstBox.MinY, 
@@ -212,6 +224,15 @@ void TextureCube_OGL::UpdateData( GLContextState&           ContextState,
 
         // Texture must be bound as GL_TEXTURE_CUBE_MAP, but glTexSubImage2D() 
         // takes one of GL_TEXTURE_CUBE_MAP_POSITIVE_X ... GL_TEXTURE_CUBE_MAP_NEGATIVE_Z
+#if GL_ARB_direct_state_access
+        if (UseDSA)
+        {
+            // Direct state access functions address cube map faces as layers of a 3D texture
+            glTextureSubImage3D(m_GlTexture, MipLevel, DstBox.MinX, DstBox.MinY, Slice, DstBox.MaxX - DstBox.MinX, DstBox.MaxY - DstBox.MinY, 1, TransferAttribs.PixelFormat, TransferAttribs.DataType,
+                                SubresData.pSrcBuffer != nullptr ? reinterpret_cast<void*>(static_cast<size_t>(SubresData.SrcOffset)) : SubresData.pData);
+        }
+        else
+#endif
         glTexSubImage2D(CubeMapFaceBindTarget, MipLevel, 
                         DstBox.MinX, 
                         DstBox.MinY, 
@@ -228,7 +249,8 @@ void TextureCube_OGL::UpdateData( GLContextState&           ContextState,
     if(UnpackBuffer != 0)
         glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 
-    ContextState.BindTexture( -1, m_BindTarget, GLObjectWrappers::GLTextureObj(false) );
+    if (!UseDSA)
+        ContextState.BindTexture( -1, m_BindTarget, GLObjectWrappers::GLTextureObj(false) );
 }
 
 void TextureCube_OGL::AttachToFramebuffer( const TextureViewDesc& ViewDesc, GLenum AttachmentPoint )
@@ -34,7 +34,28 @@
 namespace Diligent
 {
 
-VAOCache::VAOCache() : 
+template<typename HandlerType>
+void VAOCache::VAOCacheKey::ProcessBuffers(HandlerType Handler)const
+{
+    // The same buffer may be bound to several slots and also be used as the index buffer
+    if (IndexBufferUId != 0)
+        Handler(IndexBufferUId);
+    for (Uint32 slot = 0; slot < NumUsedSlots; ++slot)
+    {
+        auto BufferUId = Streams[slot].BufferUId;
+        if (BufferUId == 0 || BufferUId == IndexBufferUId)
+            continue;
+
+        bool IsDuplicate = false;
+        for (Uint32 prev_slot = 0; prev_slot < slot && !IsDuplicate; ++prev_slot)
+            IsDuplicate = Streams[prev_slot].BufferUId == BufferUId;
+        if (!IsDuplicate)
+            Handler(BufferUId);
+    }
+}
+
+VAOCache::VAOCache(Uint32 MaxSize) : 
+    m_MaxSize {MaxSize},
     m_EmptyVAO{true}
 {
     m_Cache.max_load_factor(0.5f);
@@ -45,30 +66,63 @@ VAOCache::VAOCache() :
 VAOCache::~VAOCache()
 {
     VERIFY(m_Cache.empty(), "VAO cache is not empty. Are there any unreleased objects?");
+    VERIFY(m_LRUList.empty(), "LRU list is not empty");
     VERIFY(m_PSOToKey.empty(), "PSOToKey hash is not empty" );
     VERIFY(m_BuffToKey.empty(), "BuffToKey hash is not empty");
 }
 
-void VAOCache::OnDestroyBuffer(IBuffer* pBuffer)
+void VAOCache::EraseEntry(CacheType::iterator It)
 {
-    ThreadingTools::LockHelper CacheLock(m_CacheLockFlag);
-    auto EqualRange = m_BuffToKey.equal_range(pBuffer);
-    for(auto It = EqualRange.first; It != EqualRange.second; ++It)
+    const auto* pKey = &It->first;
+    auto RemoveKeyRef = [pKey](IdToKeyMapType& IdToKey, UniqueIdentifier Id)
     {
-        m_Cache.erase(It->second);
+        auto EqualRange = IdToKey.equal_range(Id);
+        for (auto RefIt = EqualRange.first; RefIt != EqualRange.second; ++RefIt)
+        {
+            if (RefIt->second == pKey)
+            {
+                IdToKey.erase(RefIt);
+                return;
+            }
+        }
+        UNEXPECTED("Reference to the key is not found");
+    };
+    RemoveKeyRef(m_PSOToKey, pKey->PSOUId);
+    pKey->ProcessBuffers([&](UniqueIdentifier BufferUId){ RemoveKeyRef(m_BuffToKey, BufferUId); });
+    m_LRUList.erase(It->second.LRUIt);
+    m_Cache.erase(It);
+}
+
+void VAOCache::EraseEntries(IdToKeyMapType& IdToKey, UniqueIdentifier Id)
+{
+    // EraseEntry() removes the reference from IdToKey, so the loop terminates
+    for (auto RefIt = IdToKey.find(Id); RefIt != IdToKey.end(); RefIt = IdToKey.find(Id))
+    {
+        auto It = m_Cache.find(*RefIt->second);
+        VERIFY_EXPR(It != m_Cache.end());
+        EraseEntry(It);
     }
-    m_BuffToKey.erase(EqualRange.first, EqualRange.second);
+}
+
+void VAOCache::OnDestroyBuffer(IBuffer* pBuffer)
+{
+    ThreadingTools::LockHelper CacheLock(m_CacheLockFlag);
+    EraseEntries(m_BuffToKey, ValidatedCast<BufferGLImpl>(pBuffer)->GetUniqueID());
 }
 
 void VAOCache::OnDestroyPSO(IPipelineState *pPSO)
 {
     ThreadingTools::LockHelper CacheLock(m_CacheLockFlag);
-    auto EqualRange = m_PSOToKey.equal_range(pPSO);
-    for(auto It = EqualRange.first; It != EqualRange.second; ++It)
-    {
-        m_Cache.erase(It->second);
-    }
-    m_PSOToKey.erase(EqualRange.first, EqualRange.second);
+    EraseEntries(m_PSOToKey, ValidatedCast<PipelineStateGLImpl>(pPSO)->GetUniqueID());
+}
+
+void VAOCache::AccumulateStatistics(ObjectCacheStatisticsGL& Stats)
+{
+    ThreadingTools::LockHelper CacheLock(m_CacheLockFlag);
+    Stats.NumObjects   += static_cast<Uint32>(m_Cache.size());
+    Stats.NumHits      += m_NumHits;
+    Stats.NumMisses    += m_NumMisses;
+    Stats.NumEvictions += m_NumEvictions;
 }
 
 const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetVAO(IPipelineState*                pPSO,
@@ -152,14 +206,30 @@ const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetVAO(IPipelineState*
             GLContextState);
     }
 
+    Key.ComputeHash();
+
     // Try to find VAO in the map
     auto It = m_Cache.find(Key);
     if( It != m_Cache.end() )
     {
-        return It->second;
+        ++m_NumHits;
+        // Move the key to the front of the LRU list
+        m_LRUList.splice(m_LRUList.begin(), m_LRUList, It->second.LRUIt);
+        return It->second.VAO;
     }
     else
     {
+        ++m_NumMisses;
+        if (m_MaxSize != 0 && m_Cache.size() >= m_MaxSize)
+        {
+            // Release the least recently used VAO. If it is bound to the context, it is 
+            // replaced by the new VAO that is bound below, so it is safe to delete it.
+            auto LRUIt = m_Cache.find(*m_LRUList.back());
+            VERIFY_EXPR(LRUIt != m_Cache.end());
+            EraseEntry(LRUIt);
+            ++m_NumEvictions;
+        }
+
         // Create new VAO
         GLObjectWrappers::GLVertexArrayObj NewVAO(true);
 
@@ -211,18 +281,16 @@ const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetVAO(IPipelineState*
             glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, pIndBufferOGL->m_GlBuffer);
         }
             
-        auto NewElems = m_Cache.emplace( std::make_pair(Key, std::move(NewVAO)) );
+        auto NewElems = m_Cache.emplace( std::make_pair(Key, CacheEntry{std::move(NewVAO), LRUListType::iterator{}}) );
         // New element must be actually inserted
         VERIFY( NewElems.second, "New element was not inserted into the cache" ); 
-        m_PSOToKey.insert( std::make_pair(pPSO, Key) );
-        for(Uint32 Slot = 0; Slot < Key.NumUsedSlots; ++Slot)
-        {
-            auto* pCurrBuff = VertexBuffers[Slot];
-            if( pCurrBuff )
-                m_BuffToKey.insert( std::make_pair(pCurrBuff, Key) );
-        }
+        const auto* pKey = &NewElems.first->first;
+        m_LRUList.push_front(pKey);
+        NewElems.first->second.LRUIt = m_LRUList.begin();
+        m_PSOToKey.insert( std::make_pair(pKey->PSOUId, pKey) );
+        pKey->ProcessBuffers([&](UniqueIdentifier BufferUId){ m_BuffToKey.insert( std::make_pair(BufferUId, pKey) ); });
 
-        return NewElems.first->second;
+        return NewElems.first->second.VAO;
     }
 }
 
@@ -0,0 +1,113 @@
+/*     Copyright 2019 Diligent Graphics LLC
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::BindlessResourceHeapVk class
+
+#include <array>
+#include <vector>
+#include <mutex>
+#include "GraphicsTypes.h"
+#include "VulkanUtilities/VulkanObjectWrappers.h"
+
+namespace Diligent
+{
+
+class RenderDeviceVkImpl;
+
+// Bindless resource heap is a single global descriptor set that contains descriptors of all
+// shader resource and unordered access views. Every binding of the set is a runtime-sized array
+// (see BINDLESS_BINDING_VK), and every view is assigned a stable index in the array of its type
+// at creation time. Descriptors are written only once when the view is created and the set
+// is never reallocated, which removes per-draw descriptor set allocation and update.
+// The set layout is created with VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT, so unused
+// entries need not be valid, and with VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT, so new
+// descriptors can be written while the set is bound in command buffers that are being recorded
+// or executed.
+//
+// Index of a released view is returned to the free list only when all command buffers that 
+// might have referenced it are complete, which guarantees that a descriptor is never overwritten 
+// while the GPU may still access it.
+class BindlessResourceHeapVk
+{
+public:
+    BindlessResourceHeapVk(RenderDeviceVkImpl&                           DeviceVkImpl,
+                           const EngineVkCreateInfo::DescriptorPoolSize& HeapSize);
+    ~BindlessResourceHeapVk();
+
+    BindlessResourceHeapVk             (const BindlessResourceHeapVk&) = delete;
+    BindlessResourceHeapVk             (BindlessResourceHeapVk&&)      = delete;
+    BindlessResourceHeapVk& operator = (const BindlessResourceHeapVk&) = delete;
+    BindlessResourceHeapVk& operator = (BindlessResourceHeapVk&&)      = delete;
+
+    // Allocates an entry in the sampled or storage image array and writes the descriptor.
+    // Returns InvalidBindlessIndexVk if the array is full.
+    Uint32 AllocateImageDescriptor(BINDLESS_BINDING_VK Binding, VkImageView vkImageView, VkImageLayout Layout);
+
+    // Allocates an entry in the uniform or storage texel buffer array and writes the descriptor
+    Uint32 AllocateTexelBufferDescriptor(BINDLESS_BINDING_VK Binding, VkBufferView vkBufferView);
+
+    // Allocates an entry in the storage buffer array and writes the descriptor
+    Uint32 AllocateStorageBufferDescriptor(VkBuffer vkBuffer, VkDeviceSize Offset, VkDeviceSize Range);
+
+    // Returns the index to the free list once all command buffers submitted
+    // to the queues identified by CmdQueueMask are complete
+    void FreeDescriptor(BINDLESS_BINDING_VK Binding, Uint32 Index, Uint64 CmdQueueMask);
+
+    VkDescriptorSetLayout GetVkDescriptorSetLayout()     const { return m_SetLayout;      }
+    VkDescriptorSet       GetVkDescriptorSet()           const { return m_vkSet;          }
+
+    // Empty layout and set are used to fill the gaps in pipeline layouts that 
+    // do not use all descriptor sets preceding BindlessDescriptorSetVk
+    VkDescriptorSetLayout GetEmptyVkDescriptorSetLayout()const { return m_EmptySetLayout; }
+    VkDescriptorSet       GetEmptyVkDescriptorSet()      const { return m_vkEmptySet;     }
+
+private:
+    Uint32 AllocateIndex(BINDLESS_BINDING_VK Binding);
+    void   ReleaseIndex (BINDLESS_BINDING_VK Binding, Uint32 Index);
+
+    RenderDeviceVkImpl& m_DeviceVkImpl;
+
+    VulkanUtilities::DescriptorPoolWrapper      m_Pool;
+    VulkanUtilities::DescriptorSetLayoutWrapper m_SetLayout;
+    VulkanUtilities::DescriptorSetLayoutWrapper m_EmptySetLayout;
+    VkDescriptorSet                             m_vkSet      = VK_NULL_HANDLE;
+    VkDescriptorSet                             m_vkEmptySet = VK_NULL_HANDLE;
+
+    struct IndexAllocator
+    {
+        Uint32              Capacity    = 0;
+        // All indices starting with FirstUnused have never been allocated
+        Uint32              FirstUnused = 0;
+        std::vector<Uint32> FreeIndices;
+    };
+
+    // Protects index allocators as well as descriptor writes. The descriptor set is updated with 
+    // VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT, but host access to it must still be externally synchronized.
+    std::mutex m_Mutex;
+    std::array<IndexAllocator, BINDLESS_BINDING_VK_NUM_BINDINGS> m_Allocators;
+};
+
+}
@@ -0,0 +1,114 @@
+/*     Copyright 2019 Diligent Graphics LLC
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::BufferSuballocatorVk class
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include "VariableSizeAllocationsManager.h"
+#include "VulkanUtilities/VulkanObjectWrappers.h"
+#include "VulkanUtilities/VulkanMemoryManager.h"
+
+namespace Diligent
+{
+
+class RenderDeviceVkImpl;
+
+// Region of a shared VkBuffer that backs a small buffer object
+struct BufferSuballocationVk
+{
+    VkBuffer     vkBuffer = VK_NULL_HANDLE;
+    VkDeviceSize Offset   = 0;
+    VkDeviceSize Size     = 0;
+    // Page the region was allocated from. Only used by the suballocator.
+    void*        pPage    = nullptr;
+
+    bool IsValid()const{return vkBuffer != VK_NULL_HANDLE;}
+};
+
+// Buffer suballocator packs small static and default buffers into large shared VkBuffers. 
+// Every page is a VkBuffer bound to its own device-local memory allocation, and buffers with 
+// the same VkBufferUsageFlags share pages. Regions within a page are managed by 
+// VariableSizeAllocationsManager. This reduces the number of VkBuffer objects and memory 
+// allocations, and improves locality of vertex and index data.
+//
+// A region is returned to its page only when all command buffers that might have referenced 
+// it are complete. Empty pages are released, except for one page of every usage.
+class BufferSuballocatorVk
+{
+public:
+    BufferSuballocatorVk(RenderDeviceVkImpl& DeviceVkImpl,
+                         Uint32              PageSize,
+                         Uint32              MaxBufferSize);
+    ~BufferSuballocatorVk();
+
+    BufferSuballocatorVk             (const BufferSuballocatorVk&) = delete;
+    BufferSuballocatorVk             (BufferSuballocatorVk&&)      = delete;
+    BufferSuballocatorVk& operator = (const BufferSuballocatorVk&) = delete;
+    BufferSuballocatorVk& operator = (BufferSuballocatorVk&&)      = delete;
+
+    // Returns true if a buffer of the given size can be suballocated
+    bool IsSuballocationAllowed(VkDeviceSize Size)const{return Size > 0 && Size <= m_MaxBufferSize;}
+
+    // Allocates a region of a shared buffer created with the given usage flags.
+    // Returns an invalid allocation if a new page could not be created.
+    BufferSuballocationVk Allocate(VkBufferUsageFlags Usage, VkDeviceSize Size);
+
+    // Returns the region to its page once all command buffers submitted
+    // to the queues identified by CmdQueueMask are complete
+    void Free(BufferSuballocationVk&& Allocation, Uint64 CmdQueueMask);
+
+private:
+    struct Page
+    {
+        Page(VkBufferUsageFlags _Usage, VkDeviceSize Size);
+
+        const VkBufferUsageFlags                Usage;
+        // The buffer is destroyed before its memory is released
+        VulkanUtilities::VulkanMemoryAllocation Memory;
+        VulkanUtilities::BufferWrapper          Buffer;
+        VariableSizeAllocationsManager          AllocMgr;
+    };
+
+    void ReleaseRegion(Page* pPage, VkDeviceSize Offset, VkDeviceSize Size);
+
+    RenderDeviceVkImpl& m_DeviceVkImpl;
+    const VkDeviceSize  m_PageSize;
+    const VkDeviceSize  m_MaxBufferSize;
+    const VkDeviceSize  m_Alignment;
+
+    std::mutex                         m_Mutex;
+    std::vector<std::unique_ptr<Page>> m_Pages;
+
+    // Statistics are logged when the suballocator is destroyed
+    size_t       m_PeakPageCount     = 0;
+    VkDeviceSize m_UsedSize          = 0;
+    VkDeviceSize m_PeakUsedSize      = 0;
+    Uint64       m_NumAllocations    = 0;
+};
+
+}
@@ -56,12 +56,21 @@ public:
 
     virtual VkBufferView GetVkBufferView()const override final{return m_BuffView;}
 
+    virtual Uint32 GetBindlessIndex()const override final{return m_BindlessIndex;}
+
+    // Allocates the view's descriptor in the bindless resource heap. 
+    // Only called for shader resource and unordered access views.
+    void AllocateBindlessIndex(BindlessResourceHeapVk& BindlessHeap);
+
     const BufferVkImpl* GetBufferVk()const;
           BufferVkImpl* GetBufferVk();
 
 protected:
 
     VulkanUtilities::BufferViewWrapper m_BuffView;
+
+    Uint32              m_BindlessIndex   = InvalidBindlessIndexVk;
+    BINDLESS_BINDING_VK m_BindlessBinding = BINDLESS_BINDING_VK_STORAGE_BUFFERS;
 };
 
 }
@@ -69,12 +69,18 @@ public:
     void DvpVerifyDynamicAllocation(DeviceContextVkImpl* pCtx)const;
 #endif
 
+    // Returns the offset of the buffer data in the VkBuffer returned by GetVkBuffer().
+    // The offset is non-zero for dynamic and suballocated buffers.
     Uint32 GetDynamicOffset(Uint32 CtxId, DeviceContextVkImpl* pCtx)const
     {
         if(m_VulkanBuffer != VK_NULL_HANDLE)
         {
             return 0;
         }
+        else if (m_Suballocation.IsValid())
+        {
+            return static_cast<Uint32>(m_Suballocation.Offset);
+        }
         else
         {
             VERIFY(m_Desc.Usage == USAGE_DYNAMIC, "Dynamic buffer is expected");
@@ -101,6 +107,10 @@ public:
         return (GetAccessFlags() & AccessFlags) == AccessFlags;
     }
 
+    // Suballocated buffers share VkBuffer with other buffers, see EngineVkCreateInfo::EnableBufferSuballocation
+    bool IsSuballocated()const{return m_Suballocation.IsValid();}
+    VkDeviceSize GetSuballocationOffset()const{return m_Suballocation.Offset;}
+
 private:
     friend class DeviceContextVkImpl;
 
@@ -113,6 +123,7 @@ private:
 
     VulkanUtilities::BufferWrapper          m_VulkanBuffer;
     VulkanUtilities::VulkanMemoryAllocation m_MemoryAllocation;
+    BufferSuballocationVk                   m_Suballocation;
 };
 
 }
@@ -42,10 +42,14 @@ public:
     CommandListVkImpl(IReferenceCounters*  pRefCounters,
                       RenderDeviceVkImpl*  pDevice,
                       IDeviceContext*      pDeferredCtx,
-                      VkCommandBuffer      vkCmdBuff) :
-        TCommandListBase {pRefCounters, pDevice},
-        m_pDeferredCtx   {pDeferredCtx},
-        m_vkCmdBuff      {vkCmdBuff   }
+                      VkCommandBuffer      vkCmdBuff,
+                      VkRenderPass         InheritedRenderPass  = VK_NULL_HANDLE,
+                      VkFramebuffer        InheritedFramebuffer = VK_NULL_HANDLE) :
+        TCommandListBase      {pRefCounters, pDevice},
+        m_pDeferredCtx        {pDeferredCtx        },
+        m_vkCmdBuff           {vkCmdBuff           },
+        m_InheritedRenderPass {InheritedRenderPass },
+        m_InheritedFramebuffer{InheritedFramebuffer}
     {
     }
     
@@ -62,9 +66,16 @@ public:
         pDeferredCtx  = std::move(m_pDeferredCtx);
     }
 
+    // Secondary command buffers inherit render pass and framebuffer
+    bool          IsSecondary()            const { return m_InheritedRenderPass != VK_NULL_HANDLE; }
+    VkRenderPass  GetInheritedRenderPass() const { return m_InheritedRenderPass; }
+    VkFramebuffer GetInheritedFramebuffer()const { return m_InheritedFramebuffer; }
+
 private:
     RefCntAutoPtr<IDeviceContext> m_pDeferredCtx;
     VkCommandBuffer m_vkCmdBuff;
+    const VkRenderPass  m_InheritedRenderPass;
+    const VkFramebuffer m_InheritedFramebuffer;
 };
 
 }
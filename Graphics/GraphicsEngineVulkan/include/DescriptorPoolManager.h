@@ -30,7 +30,9 @@
 #include <deque>
 #include <mutex>
 #include <atomic>
+#include <unordered_map>
 #include "VulkanUtilities/VulkanObjectWrappers.h"
+#include "UniqueIdentifier.h"
 
 namespace Diligent
 {
@@ -226,6 +228,8 @@ private:
 // the class requests a new pool.
 // The class is not thread-safe as device contexts must not be used in multiple threads simultaneously.
 // All allocated pools are recycled at the end of every frame.
+// Sets that have been written are cached until the end of the frame, so that committing the same
+// resources again reuses the existing set instead of allocating and writing a new one.
 //   ____________________________________________________________________________
 //  |                                                                            |
 //  |                           DynamicDescriptorSetAllocator                    |
@@ -253,14 +257,37 @@ public:
 
     VkDescriptorSet Allocate(VkDescriptorSetLayout SetLayout, const char* DebugName);
 
+    // Returns a set allocated in the current frame that has the same layout and references
+    // exactly the same objects, or VK_NULL_HANDLE if there is no such set
+    VkDescriptorSet FindCachedSet(VkDescriptorSetLayout SetLayout, size_t Hash, const std::vector<UniqueIdentifier>& ResourceIds);
+
+    // Adds the set, whose descriptors have been written, to the cache
+    void CacheSet(VkDescriptorSetLayout SetLayout, size_t Hash, const std::vector<UniqueIdentifier>& ResourceIds, VkDescriptorSet Set);
+
     // Releases all allocated pools that are later returned to the global pool manager.
     // As global pool manager is hosted by the render device, the allocator can
     // be destroyed before the pools are actually returned to the global pool manager.
+    // All cached sets are invalidated.
     void ReleasePools(Uint64 QueueMask);
 
     size_t GetAllocatedPoolCount()const{return m_AllocatedPools.size();}
 
+    Uint64 GetCacheLookupCount()const{return m_CacheLookupCount;}
+    Uint64 GetCacheHitCount()   const{return m_CacheHitCount;   }
+
 private:
+    struct CachedSet
+    {
+        VkDescriptorSetLayout         SetLayout;
+        std::vector<UniqueIdentifier> ResourceIds;
+        VkDescriptorSet               Set;
+    };
+    // Layout and resource ids are compared for every entry with matching hash, so hash collisions 
+    // never result in a wrong set
+    std::unordered_multimap<size_t, CachedSet> m_SetCache;
+    Uint64 m_CacheLookupCount = 0;
+    Uint64 m_CacheHitCount    = 0;
+
     DescriptorPoolManager&                              m_GlobalPoolMgr;
     const std::string                                   m_Name;
     std::vector<VulkanUtilities::DescriptorPoolWrapper> m_AllocatedPools;
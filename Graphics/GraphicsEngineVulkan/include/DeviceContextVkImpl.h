@@ -102,6 +102,10 @@ public:
 
     virtual void Draw( DrawAttribs &DrawAttribs )override final;
 
+    virtual void MultiDraw(const MultiDrawAttribs& Attribs)override final;
+
+    virtual void MultiDrawIndirect(const MultiDrawIndirectAttribs& Attribs)override final;
+
     virtual void DispatchCompute( const DispatchComputeAttribs& DispatchAttrs )override final;
 
     virtual void ClearDepthStencil(ITextureView*                  pView,
@@ -140,6 +144,8 @@ public:
 
     virtual void CopyTexture(const CopyTextureAttribs& CopyAttribs)override final;
 
+    virtual void MultiCopyTexture(const CopyTextureAttribs* pCopies, Uint32 NumCopies)override final;
+
     virtual void MapTextureSubresource( ITexture*                 pTexture,
                                         Uint32                    MipLevel,
                                         Uint32                    ArraySlice,
@@ -190,6 +196,14 @@ public:
 
     virtual void BufferMemoryBarrier(IBuffer* pBuffer, VkAccessFlags NewAccessFlags)override final;
 
+    virtual void GetBarrierStatistics(BarrierStatisticsVk& Stats)override final;
+
+    virtual void GetDescriptorSetCacheStatistics(DescriptorSetCacheStatisticsVk& Stats)override final;
+
+    virtual void GetStateFilteringStatistics(StateFilteringStatisticsVk& Stats)override final;
+
+    virtual void BeginSecondaryCommandBuffer(Uint32 NumRenderTargets, ITextureView* ppRenderTargets[], ITextureView* pDepthStencil)override final;
+
 
     void AddWaitSemaphore(VkSemaphore Semaphore, VkPipelineStageFlags WaitDstStageMask)
     {
@@ -246,6 +260,11 @@ public:
         return m_DynamicDescrSetAllocator.Allocate(SetLayout, DebugName);
     }
 
+    DynamicDescriptorSetAllocator& GetDynamicDescriptorSetAllocator(){return m_DynamicDescrSetAllocator;}
+
+    // Scratch buffer used to look up dynamic descriptor sets in the cache
+    std::vector<UniqueIdentifier>& GetDynamicResourceIdsBuffer(){return m_DynamicResourceIds;}
+
     VulkanDynamicAllocation AllocateDynamicSpace(Uint32 SizeInBytes, Uint32 Alignment);
 
     void ResetRenderTargets();
@@ -256,7 +275,10 @@ public:
 private:
     void TransitionRenderTargets(RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
     inline void CommitRenderPassAndFramebuffer(bool VerifyStates);
+    void PrepareForDraw(DRAW_FLAGS Flags, bool IsIndexed, VALUE_TYPE IndexType);
+    void PrepareIndirectDrawBuffer(BufferVkImpl& Buffer, RESOURCE_STATE_TRANSITION_MODE TransitionMode, const char* OperationName);
     void CommitVkVertexBuffers();
+    void CommitVkIndexBuffer(VALUE_TYPE IndexType);
     void CommitViewports();
     void CommitScissorRects();
     
@@ -280,12 +302,21 @@ private:
         m_State.NumCommands = m_State.NumCommands != 0 ? m_State.NumCommands : 1;
         if (m_CommandBuffer.GetVkCmdBuffer() == VK_NULL_HANDLE)
         {
-            auto vkCmdBuff = m_CmdPool.GetCommandBuffer();
-            m_CommandBuffer.SetVkCmdBuffer(vkCmdBuff);
+            if (m_bRecordingSecondaryCmdBuffer)
+            {
+                BeginSecondaryVkCmdBuffer();
+            }
+            else
+            {
+                auto vkCmdBuff = m_CmdPool.GetCommandBuffer();
+                m_CommandBuffer.SetVkCmdBuffer(vkCmdBuff);
+            }
         }
     }
+    void BeginSecondaryVkCmdBuffer();
+    void ExecuteSecondaryCommandList(class CommandListVkImpl& CmdList);
     
-    inline void DisposeVkCmdBuffer(Uint32 CmdQueue, VkCommandBuffer vkCmdBuff, Uint64 FenceValue);
+    inline void DisposeVkCmdBuffer(Uint32 CmdQueue, VkCommandBuffer vkCmdBuff, Uint64 FenceValue, bool IsSecondary = false);
     inline void DisposeCurrentCmdBuffer(Uint32 CmdQueue, Uint64 FenceValue);
 
     struct BufferToTextureCopyInfo
@@ -311,6 +342,10 @@ private:
                              Uint32                         DstArraySlice,
                              RESOURCE_STATE_TRANSITION_MODE DstTextureTransitionMode);
 
+    // Records copies from a staging texture to a non-staging texture with a single vkCmdCopyBufferToImage
+    // command. All copies must use the same source and destination textures.
+    void CopyStagingTextureToTexture(const CopyTextureAttribs* pCopies, Uint32 NumCopies);
+
     void CopyTextureToBuffer(TextureVkImpl&                 SrcTextureVk,
                              const Box&                     SrcRegion,
                              Uint32                         SrcMipLevel,
@@ -334,6 +369,9 @@ private:
         /// Flag indicating if currently committed index buffer is up to date
         bool CommittedIBUpToDate = false;
 
+        /// Index type of the currently committed index buffer
+        VALUE_TYPE CommittedIBFormat = VT_UNDEFINED;
+
         Uint32 NumCommands = 0;
     }m_State;
 
@@ -346,6 +384,14 @@ private:
     /// This framebuffer may or may not be currently set in the command buffer
     VkFramebuffer m_Framebuffer = VK_NULL_HANDLE;
 
+    /// Indicates that the deferred context records a secondary command buffer
+    /// that inherits m_RenderPass and m_Framebuffer (see BeginSecondaryCommandBuffer())
+    bool m_bRecordingSecondaryCmdBuffer = false;
+
+    /// Secondary command buffers executed by the immediate context that will be 
+    /// disposed when the context is flushed
+    std::vector<std::pair<VkCommandBuffer, RefCntAutoPtr<IDeviceContext>>> m_PendingSecondaryCmdBuffers;
+
     FixedBlockMemoryAllocator m_CmdListAllocator;
 
     // Semaphores are not owned by the command context
@@ -389,6 +435,9 @@ private:
     VulkanUploadHeap                         m_UploadHeap;
     VulkanDynamicHeap                        m_DynamicHeap;
     DynamicDescriptorSetAllocator            m_DynamicDescrSetAllocator;
+    std::vector<UniqueIdentifier>            m_DynamicResourceIds;
+    // Scratch array of regions used by CopyStagingTextureToTexture()
+    std::vector<VkBufferImageCopy>           m_BufferImageCopies;
 
     PipelineLayout::DescriptorSetBindInfo m_DescrSetBindInfo;
     std::shared_ptr<GenerateMipsVkHelper> m_GenerateMipsHelper;
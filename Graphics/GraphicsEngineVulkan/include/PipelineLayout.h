@@ -39,6 +39,7 @@ namespace Diligent
 class RenderDeviceVkImpl;
 class DeviceContextVkImpl;
 class ShaderResourceCacheVk;
+class BindlessResourceHeapVk;
 
 /// Implementation of the Diligent::PipelineLayout class
 class PipelineLayout
@@ -48,7 +49,9 @@ public:
 
     PipelineLayout();
     void Release(RenderDeviceVkImpl* pDeviceVkImpl, Uint64 CommandQueueMask);
-    void Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice);
+    // If pBindlessHeap is not null, the heap's set layout is added to the pipeline layout at 
+    // index BindlessDescriptorSetVk, and all unused sets before it are filled with empty layouts
+    void Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, const BindlessResourceHeapVk* pBindlessHeap);
 
     VkPipelineLayout GetVkPipelineLayout()const{return m_LayoutMgr.GetVkPipelineLayout();}
     std::array<Uint32, 2> GetDescriptorSetSizes(Uint32& NumSets)const;
@@ -86,6 +89,11 @@ public:
         return m_LayoutMgr.GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC).VkLayout;
     }
 
+    Int32 GetDynamicDescriptorSetIndex()const
+    {
+        return m_LayoutMgr.GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC).SetIndex;
+    }
+
     struct DescriptorSetBindInfo
     {
         std::vector<VkDescriptorSet> vkSets;
@@ -130,6 +138,11 @@ public:
                                DescriptorSetBindInfo&        BindInfo,
                                VkDescriptorSet               VkDynamicDescrSet)const;
 
+    // Binds the bindless resource heap for pipelines that have no descriptor sets of their own.
+    // Pipelines that have their own sets bind the heap in PrepareDescriptorSets() because binding
+    // lower-numbered sets with an incompatible layout would disturb the heap binding.
+    void BindBindlessResourceHeap(DeviceContextVkImpl* pCtxVkImpl, bool IsCompute)const;
+
     // Computes dynamic offsets and binds descriptor sets
     void BindDescriptorSetsWithDynamicOffsets(DeviceContextVkImpl*    pCtxVkImpl,
                                               DescriptorSetBindInfo&  BindInfo)const;
@@ -176,9 +189,11 @@ private:
         DescriptorSetLayoutManager            (DescriptorSetLayoutManager&&)      = delete;
         DescriptorSetLayoutManager& operator= (DescriptorSetLayoutManager&&)      = delete;
         
-        void Finalize(const VulkanUtilities::VulkanLogicalDevice &LogicalDevice);
+        void Finalize(const VulkanUtilities::VulkanLogicalDevice &LogicalDevice, const BindlessResourceHeapVk* pBindlessHeap);
         void Release(RenderDeviceVkImpl* pRenderDeviceVk, Uint64 CommandQueueMask);
 
+        Uint32 GetNumActiveSets()const{return m_ActiveSets;}
+
               DescriptorSetLayout& GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE VarType)      { return m_DescriptorSetLayouts[VarType == SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC ? 1 : 0]; }
         const DescriptorSetLayout& GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE VarType)const { return m_DescriptorSetLayouts[VarType == SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC ? 1 : 0]; }
 
@@ -205,6 +220,11 @@ private:
 
     IMemoryAllocator&          m_MemAllocator;
     DescriptorSetLayoutManager m_LayoutMgr;
+
+    // Bindless resource heap set and the empty set that fills unused slots before it.
+    // Both are owned by the heap and are null if bindless resources are disabled.
+    VkDescriptorSet            m_vkBindlessSet = VK_NULL_HANDLE;
+    VkDescriptorSet            m_vkEmptySet    = VK_NULL_HANDLE;
 };
 
 }
@@ -53,7 +53,13 @@ class PipelineStateVkImpl final : public PipelineStateBase<IPipelineStateVk, Ren
 public:
     using TPipelineStateBase = PipelineStateBase<IPipelineStateVk, RenderDeviceVkImpl>;
 
-    PipelineStateVkImpl(IReferenceCounters* pRefCounters, RenderDeviceVkImpl* pDeviceVk, const PipelineStateDesc& PipelineDesc);
+    // If AsyncCompile is true, shader modules and the Vulkan pipeline are created on the device's 
+    // pipeline compiler thread pool, and the object remains pending until they are ready
+    PipelineStateVkImpl(IReferenceCounters*      pRefCounters,
+                        RenderDeviceVkImpl*      pDeviceVk,
+                        const PipelineStateDesc& PipelineDesc,
+                        bool                     AsyncCompile = false,
+                        IPipelineState*          pFallbackPSO = nullptr);
     ~PipelineStateVkImpl();
 
     virtual void QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface)override final;
@@ -111,6 +117,8 @@ public:
     void InitializeStaticSRBResources(ShaderResourceCacheVk& ResourceCache)const;
 
 private:
+    void CreatePipeline(const std::array<std::vector<uint32_t>, MaxShadersInPipeline>& ShaderSPIRVs);
+
     const ShaderResourceLayoutVk& GetStaticShaderResLayout(Uint32 ShaderInd)const
     {
         VERIFY_EXPR(ShaderInd < m_NumShaders);
@@ -142,6 +150,11 @@ private:
     VulkanUtilities::PipelineWrapper m_Pipeline;
     PipelineLayout                   m_PipelineLayout;
 
+    // Descriptor update template that writes dynamic resources of all shaders with a single call
+    VulkanUtilities::DescriptorUpdateTemplateWrapper m_DynamicResourceUpdateTemplate;
+    // Size of the packed descriptor data consumed by m_DynamicResourceUpdateTemplate
+    size_t m_DynamicResourceUpdateDataSize = 0;
+
     Int8 m_ResourceLayoutIndex[6] = {-1, -1, -1, -1, -1, -1};
     bool m_HasStaticResources     = false;
     bool m_HasNonStaticResources  = false;
@@ -44,6 +44,8 @@
 #include "FramebufferCache.h"
 #include "RenderPassCache.h"
 #include "CommandPoolManager.h"
+#include "BindlessResourceHeapVk.h"
+#include "BufferSuballocatorVk.h"
 #include "VulkanDynamicHeap.h"
 
 namespace Diligent
@@ -70,6 +72,8 @@ public:
 
     virtual void CreatePipelineState(const PipelineStateDesc& PipelineDesc, IPipelineState** ppPipelineState)override final;
 
+    virtual void CreatePipelineStateAsync(const PipelineStateDesc& PipelineDesc, IPipelineState* pFallbackPSO, IPipelineState** ppPipelineState)override final;
+
     virtual void CreateBuffer(const BufferDesc& BuffDesc, const BufferData* pBuffData, IBuffer** ppBuffer)override final;
 
     virtual void CreateShader(const ShaderCreateInfo& ShaderCreateInfo, IShader** ppShader)override final;
@@ -106,6 +110,12 @@ public:
     }
     DescriptorPoolManager& GetDynamicDescriptorPool(){return m_DynamicDescriptorPool;}
 
+    // Returns nullptr if bindless resources are not enabled
+    BindlessResourceHeapVk* GetBindlessResourceHeap(){return m_pBindlessHeap.get();}
+
+    // Returns nullptr if buffer suballocation is not enabled
+    BufferSuballocatorVk* GetBufferSuballocator(){return m_pBufferSuballocator.get();}
+
     std::shared_ptr<const VulkanUtilities::VulkanInstance> GetVulkanInstance()const { return m_VulkanInstance;}
     const VulkanUtilities::VulkanPhysicalDevice&           GetPhysicalDevice()const { return *m_PhysicalDevice;}
     const VulkanUtilities::VulkanLogicalDevice&            GetLogicalDevice ()      { return *m_LogicalVkDevice;}
@@ -150,6 +160,10 @@ private:
     VulkanUtilities::VulkanMemoryManager m_MemoryMgr;
 
     VulkanDynamicMemoryManager m_DynamicMemoryManager;
+
+    std::unique_ptr<BindlessResourceHeapVk> m_pBindlessHeap;
+
+    std::unique_ptr<BufferSuballocatorVk> m_pBufferSuballocator;
 };
 
 }
@@ -180,6 +180,11 @@ public:
 
     Uint32 GetDynamicBufferOffsets(DeviceContextVkImpl *pCtxVkImpl, std::vector<uint32_t>& Offsets)const;
 
+    // Writes unique identifiers of all objects referenced by the descriptor set to ResourceIds
+    // and returns the hash of the identifiers. Two sets with the same layout and identical 
+    // identifiers contain identical descriptors.
+    size_t GetDescriptorSetResourceIds(Uint32 SetIndex, std::vector<UniqueIdentifier>& ResourceIds)const;
+
 private:
 
     Resource* GetFirstResourcePtr()
@@ -95,6 +95,7 @@
 
 #include <array>
 #include <memory>
+#include <vector>
 
 #include "PipelineState.h"
 #include "ShaderBase.h"
@@ -278,6 +279,17 @@ public:
     void CommitDynamicResources(const ShaderResourceCacheVk& ResourceCache,
                                 VkDescriptorSet              vkDynamicDescriptorSet)const;
 
+    // Appends descriptor update template entries for all dynamic resources of this layout.
+    // Descriptor data of the entries is tightly packed starting at DataSize, which is
+    // incremented by the size of the data.
+    void GetDynamicResourceUpdateTemplateEntries(std::vector<VkDescriptorUpdateTemplateEntryKHR>& Entries,
+                                                 size_t&                                          DataSize)const;
+
+    // Writes dynamic resource descriptors from ResourceCache to pData in the order defined by
+    // GetDynamicResourceUpdateTemplateEntries(). Returns the pointer past the last written descriptor.
+    Uint8* WriteDynamicResourceUpdateData(const ShaderResourceCacheVk& ResourceCache,
+                                          Uint8*                       pData)const;
+
     const Char* GetShaderName()const
     {
         return m_pResources->GetShaderName();
@@ -54,6 +54,12 @@ public:
 
     VkImageView GetVulkanImageView()const override final{return m_ImageView;}
 
+    virtual Uint32 GetBindlessIndex()const override final{return m_BindlessIndex;}
+
+    // Allocates the view's descriptor in the bindless resource heap. 
+    // Only called for shader resource and unordered access views.
+    void AllocateBindlessIndex(BindlessResourceHeapVk& BindlessHeap);
+
     bool HasMipLevelViews() const
     {
         return m_MipLevelViews != nullptr;
@@ -84,6 +90,9 @@ protected:
 
     /// Individual mip level views used for mipmap generation
     MipLevelViewAutoPtrType*                m_MipLevelViews = nullptr;
+
+    /// Index of the view's descriptor in the bindless resource heap
+    Uint32                                  m_BindlessIndex = InvalidBindlessIndexVk;
 };
 
 }
@@ -23,6 +23,9 @@
 
 #pragma once
 
+#include <vector>
+#include <cstring>
+#include <algorithm>
 #include "vulkan.h"
 #include "DebugUtilities.h"
 
@@ -31,8 +34,12 @@ namespace VulkanUtilities
     class VulkanCommandBuffer
     {
     public:
-        VulkanCommandBuffer(VkPipelineStageFlags EnabledGraphicsShaderStages)noexcept : 
-            m_EnabledGraphicsShaderStages{EnabledGraphicsShaderStages}
+        VulkanCommandBuffer(VkPipelineStageFlags                    EnabledGraphicsShaderStages,
+                            PFN_vkCmdDrawIndirectCountKHR           vkCmdDrawIndirectCount        = nullptr,
+                            PFN_vkCmdDrawIndexedIndirectCountKHR    vkCmdDrawIndexedIndirectCount = nullptr)noexcept : 
+            m_EnabledGraphicsShaderStages  {EnabledGraphicsShaderStages  },
+            m_vkCmdDrawIndirectCount       {vkCmdDrawIndirectCount       },
+            m_vkCmdDrawIndexedIndirectCount{vkCmdDrawIndexedIndirectCount}
         {}
 
         VulkanCommandBuffer             (const VulkanCommandBuffer&)  = delete;
@@ -46,6 +53,7 @@ namespace VulkanUtilities
             VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdClearColorImage() must be called outside of render pass (17.1)");
             VERIFY(Subresource.aspectMask == VK_IMAGE_ASPECT_COLOR_BIT, "The aspectMask of all image subresource ranges must only include VK_IMAGE_ASPECT_COLOR_BIT (17.1)");
 
+            FlushBarriers();
             vkCmdClearColorImage(
                 m_VkCmdBuffer,
                 Image,
@@ -64,6 +72,7 @@ namespace VulkanUtilities
                     (Subresource.aspectMask & ~(VK_IMAGE_ASPECT_DEPTH_BIT|VK_IMAGE_ASPECT_STENCIL_BIT)) == 0,
                    "The aspectMask of all image subresource ranges must only include VK_IMAGE_ASPECT_DEPTH_BIT or VK_IMAGE_ASPECT_STENCIL_BIT(17.1)");
 
+            FlushBarriers();
             vkCmdClearDepthStencilImage(
                 m_VkCmdBuffer,
                 Image,
@@ -127,12 +136,34 @@ namespace VulkanUtilities
             vkCmdDrawIndexedIndirect(m_VkCmdBuffer, Buffer, Offset, DrawCount, Stride);
         }
 
+        void DrawIndirectCount(VkBuffer Buffer, VkDeviceSize Offset, VkBuffer CountBuffer, VkDeviceSize CountBufferOffset, uint32_t MaxDrawCount, uint32_t Stride)
+        {
+            VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+            VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawIndirectCountKHR() must be called inside render pass");
+            VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
+            VERIFY(m_vkCmdDrawIndirectCount != nullptr, "VK_KHR_draw_indirect_count extension is not enabled");
+
+            m_vkCmdDrawIndirectCount(m_VkCmdBuffer, Buffer, Offset, CountBuffer, CountBufferOffset, MaxDrawCount, Stride);
+        }
+
+        void DrawIndexedIndirectCount(VkBuffer Buffer, VkDeviceSize Offset, VkBuffer CountBuffer, VkDeviceSize CountBufferOffset, uint32_t MaxDrawCount, uint32_t Stride)
+        {
+            VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+            VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawIndexedIndirectCountKHR() must be called inside render pass");
+            VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
+            VERIFY(m_State.IndexBuffer != VK_NULL_HANDLE, "No index buffer bound");
+            VERIFY(m_vkCmdDrawIndexedIndirectCount != nullptr, "VK_KHR_draw_indirect_count extension is not enabled");
+
+            m_vkCmdDrawIndexedIndirectCount(m_VkCmdBuffer, Buffer, Offset, CountBuffer, CountBufferOffset, MaxDrawCount, Stride);
+        }
+
         void Dispatch(uint32_t GroupCountX, uint32_t GroupCountY, uint32_t GroupCountZ)
         {
             VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
             VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdDispatch() must be called outside of render pass (27)");
             VERIFY(m_State.ComputePipeline != VK_NULL_HANDLE, "No compute pipeline bound");
 
+            FlushBarriers();
             vkCmdDispatch(m_VkCmdBuffer, GroupCountX, GroupCountY, GroupCountZ);
         }
 
@@ -142,10 +173,15 @@ namespace VulkanUtilities
             VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdDispatchIndirect() must be called outside of render pass (27)");
             VERIFY(m_State.ComputePipeline != VK_NULL_HANDLE, "No compute pipeline bound");
 
+            FlushBarriers();
             vkCmdDispatchIndirect(m_VkCmdBuffer, Buffer, Offset);
         }
 
-        void BeginRenderPass(VkRenderPass RenderPass, VkFramebuffer Framebuffer, uint32_t FramebufferWidth, uint32_t FramebufferHeight)
+        void BeginRenderPass(VkRenderPass      RenderPass,
+                             VkFramebuffer     Framebuffer,
+                             uint32_t          FramebufferWidth,
+                             uint32_t          FramebufferHeight,
+                             VkSubpassContents Contents = VK_SUBPASS_CONTENTS_INLINE)
         {
             VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
             VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "Current pass has not been ended");
@@ -167,12 +203,15 @@ namespace VulkanUtilities
                                                   // corresponding to cleared attachments are used. Other elements of pClearValues are 
                                                   // ignored (7.4)
 
+                FlushBarriers();
                 vkCmdBeginRenderPass(m_VkCmdBuffer, &BeginInfo, 
-                    VK_SUBPASS_CONTENTS_INLINE // the contents of the subpass will be recorded inline in the 
-                                               // primary command buffer, and secondary command buffers must not 
-                                               // be executed within the subpass
+                    Contents // VK_SUBPASS_CONTENTS_INLINE: the contents of the subpass will be recorded inline in the 
+                             // primary command buffer, and secondary command buffers must not be executed within the subpass.
+                             // VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS: the contents are recorded in secondary 
+                             // command buffers, and vkCmdExecuteCommands is the only valid command in the subpass
                 );
                 m_State.RenderPass = RenderPass;
+                m_State.SubpassContents = Contents;
                 m_State.Framebuffer = Framebuffer;
                 m_State.FramebufferWidth = FramebufferWidth;
                 m_State.FramebufferHeight = FramebufferHeight;
@@ -182,24 +221,70 @@ namespace VulkanUtilities
         void EndRenderPass()
         {
             VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "Render pass has not been started");
+            VERIFY(!m_State.RenderPassInherited, "Secondary command buffer cannot end the render pass it inherits. "
+                   "All resources must be transitioned to required states before secondary command buffer recording begins.");
             VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
             vkCmdEndRenderPass(m_VkCmdBuffer);
             m_State.RenderPass  = VK_NULL_HANDLE;
             m_State.Framebuffer = VK_NULL_HANDLE;
             m_State.FramebufferWidth  = 0;
             m_State.FramebufferHeight = 0;
+            m_State.SubpassContents   = VK_SUBPASS_CONTENTS_INLINE;
+        }
+
+        // Sets the render pass that a secondary command buffer continues. The render pass
+        // is begun and ended by the primary command buffer that executes this one.
+        void SetInheritedRenderPass(VkRenderPass RenderPass, VkFramebuffer Framebuffer, uint32_t FramebufferWidth, uint32_t FramebufferHeight)
+        {
+            VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+            VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "Render pass has already been set");
+            m_State.RenderPass          = RenderPass;
+            m_State.Framebuffer         = Framebuffer;
+            m_State.FramebufferWidth    = FramebufferWidth;
+            m_State.FramebufferHeight   = FramebufferHeight;
+            m_State.RenderPassInherited = true;
+        }
+
+        void ExecuteCommands(uint32_t CommandBufferCount, const VkCommandBuffer* pCommandBuffers)
+        {
+            VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+            VERIFY(m_State.RenderPass == VK_NULL_HANDLE || m_State.SubpassContents == VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS,
+                   "Secondary command buffers can only be executed in a subpass begun with VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS");
+            FlushBarriers();
+            vkCmdExecuteCommands(m_VkCmdBuffer, CommandBufferCount, pCommandBuffers);
         }
 
         void EndCommandBuffer()
         {
             VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+            FlushBarriers();
             vkEndCommandBuffer(m_VkCmdBuffer);
         }
 
         void Reset()
         {
+            VERIFY(m_PendingImageBarriers.empty() && m_PendingBufferBarriers.empty(), "Resetting command buffer with pending barriers");
             m_VkCmdBuffer = VK_NULL_HANDLE;
             m_State = StateCache{};
+            ResetDynamicState();
+            ResetDescriptorSetBindings();
+            m_PendingImageBarriers.clear();
+            m_PendingBufferBarriers.clear();
+            m_PendingSrcStages = 0;
+            m_PendingDstStages = 0;
+        }
+
+        // The state of the primary command buffer is undefined after vkCmdExecuteCommands,
+        // so all cached bindings must be reset. The render pass is not affected.
+        void ResetBindings()
+        {
+            m_State.GraphicsPipeline  = VK_NULL_HANDLE;
+            m_State.ComputePipeline   = VK_NULL_HANDLE;
+            m_State.IndexBuffer       = VK_NULL_HANDLE;
+            m_State.IndexBufferOffset = 0;
+            m_State.IndexType         = VK_INDEX_TYPE_MAX_ENUM;
+            ResetDynamicState();
+            ResetDescriptorSetBindings();
         }
 
         void BindComputePipeline(VkPipeline ComputePipeline)
@@ -210,7 +295,10 @@ namespace VulkanUtilities
             {
                 vkCmdBindPipeline(m_VkCmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, ComputePipeline);
                 m_State.ComputePipeline = ComputePipeline;
+                ++m_StateStats.NumRecordedCommands;
             }
+            else
+                ++m_StateStats.NumFilteredCommands;
         }
 
         void BindGraphicsPipeline(VkPipeline GraphicsPipeline)
@@ -221,31 +309,61 @@ namespace VulkanUtilities
             {
                 vkCmdBindPipeline(m_VkCmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, GraphicsPipeline);
                 m_State.GraphicsPipeline = GraphicsPipeline;
+                ++m_StateStats.NumRecordedCommands;
             }
+            else
+                ++m_StateStats.NumFilteredCommands;
         }
 
         void SetViewports(uint32_t FirstViewport, uint32_t ViewportCount, const VkViewport* pViewports)
         {
             VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+            if (FilterState(m_Viewports, m_ValidViewportsMask, FirstViewport, ViewportCount, pViewports))
+                return;
             vkCmdSetViewport(m_VkCmdBuffer, FirstViewport, ViewportCount, pViewports);
         }
 
         void SetScissorRects(uint32_t FirstScissor, uint32_t ScissorCount, const VkRect2D* pScissors)
         {
             VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+            if (FilterState(m_Scissors, m_ValidScissorsMask, FirstScissor, ScissorCount, pScissors))
+                return;
             vkCmdSetScissor(m_VkCmdBuffer, FirstScissor, ScissorCount, pScissors);
         }
 
+        // Scissor rects set dynamically become undefined when a pipeline that does not have
+        // VK_DYNAMIC_STATE_SCISSOR dynamic state is bound
+        void InvalidateScissorRects()
+        {
+            m_ValidScissorsMask = 0;
+        }
+
         void SetStencilReference(uint32_t Reference)
         {
             VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+            if (m_StencilReferenceValid && m_StencilReference == Reference)
+            {
+                ++m_StateStats.NumFilteredCommands;
+                return;
+            }
             vkCmdSetStencilReference(m_VkCmdBuffer, VK_STENCIL_FRONT_AND_BACK, Reference);
+            m_StencilReference      = Reference;
+            m_StencilReferenceValid = true;
+            ++m_StateStats.NumRecordedCommands;
         }
 
         void SetBlendConstants(const float BlendConstants[4])
         {
             VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+            if (m_BlendConstantsValid && memcmp(m_BlendConstants, BlendConstants, sizeof(m_BlendConstants)) == 0)
+            {
+                ++m_StateStats.NumFilteredCommands;
+                return;
+            }
             vkCmdSetBlendConstants(m_VkCmdBuffer, BlendConstants);
+            memcpy(m_BlendConstants, BlendConstants, sizeof(m_BlendConstants));
+            m_BlendConstantsValid = true;
+            ++m_StateStats.NumRecordedCommands;
         }
 
         void BindIndexBuffer(VkBuffer Buffer, VkDeviceSize Offset, VkIndexType IndexType)
@@ -259,13 +377,35 @@ namespace VulkanUtilities
                 m_State.IndexBuffer = Buffer;
                 m_State.IndexBufferOffset = Offset;
                 m_State.IndexType = IndexType;
+                ++m_StateStats.NumRecordedCommands;
             }
+            else
+                ++m_StateStats.NumFilteredCommands;
         }
 
         void BindVertexBuffers(uint32_t firstBinding, uint32_t bindingCount, const VkBuffer* pBuffers, const VkDeviceSize* pOffsets)
         {
             VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+            bool IsRedundant = firstBinding + bindingCount <= MaxCachedVertexBuffers;
+            for (uint32_t i = 0; i < bindingCount && IsRedundant; ++i)
+            {
+                const auto& Binding = m_VertexBuffers[firstBinding + i];
+                IsRedundant = Binding.Buffer == pBuffers[i] && Binding.Offset == pOffsets[i];
+            }
+            if (IsRedundant)
+            {
+                ++m_StateStats.NumFilteredCommands;
+                return;
+            }
+
             vkCmdBindVertexBuffers(m_VkCmdBuffer, firstBinding, bindingCount, pBuffers, pOffsets);
+            for (uint32_t i = 0; i < bindingCount && firstBinding + i < MaxCachedVertexBuffers; ++i)
+            {
+                auto& Binding = m_VertexBuffers[firstBinding + i];
+                Binding.Buffer = pBuffers[i];
+                Binding.Offset = pOffsets[i];
+            }
+            ++m_StateStats.NumRecordedCommands;
         }
 
         static void TransitionImageLayout(VkCommandBuffer                CmdBuffer,
@@ -291,7 +431,8 @@ namespace VulkanUtilities
                 // dependencies between attachments
                 EndRenderPass();
             }
-            TransitionImageLayout(m_VkCmdBuffer, Image, OldLayout, NewLayout, SubresRange, m_EnabledGraphicsShaderStages, SrcStages, DestStages);
+            // The barrier is recorded by FlushBarriers() before the next command that accesses resources
+            AddImageBarrier(Image, OldLayout, NewLayout, SubresRange, SrcStages, DestStages);
         }
 
 
@@ -303,11 +444,14 @@ namespace VulkanUtilities
                                         VkPipelineStageFlags SrcStages  = 0,
                                         VkPipelineStageFlags DestStages = 0);
 
+        // Offset and Size define the range of a buffer that is suballocated from a shared VkBuffer
         void BufferMemoryBarrier(VkBuffer             Buffer, 
                                  VkAccessFlags        srcAccessMask,
                                  VkAccessFlags        dstAccessMask,
                                  VkPipelineStageFlags SrcStages  = 0,
-                                 VkPipelineStageFlags DestStages = 0)
+                                 VkPipelineStageFlags DestStages = 0,
+                                 VkDeviceSize         Offset     = 0,
+                                 VkDeviceSize         Size       = VK_WHOLE_SIZE)
         {
             VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
             if (m_State.RenderPass  != VK_NULL_HANDLE)
@@ -316,7 +460,7 @@ namespace VulkanUtilities
                 // dependencies between attachments
                 EndRenderPass();
             }
-            BufferMemoryBarrier(m_VkCmdBuffer, Buffer, srcAccessMask, dstAccessMask, m_EnabledGraphicsShaderStages, SrcStages, DestStages);
+            AddBufferBarrier(Buffer, srcAccessMask, dstAccessMask, SrcStages, DestStages, Offset, Size);
         }
 
         void BindDescriptorSets(VkPipelineBindPoint     pipelineBindPoint,
@@ -328,7 +472,28 @@ namespace VulkanUtilities
                                 const uint32_t*         pDynamicOffsets    = nullptr)
         {
             VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+            VERIFY_EXPR(pipelineBindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS || pipelineBindPoint == VK_PIPELINE_BIND_POINT_COMPUTE);
+
+            // Recording the same command twice in a row does not change the bindings, so the
+            // command is skipped if it is identical to the last one recorded for this bind point
+            auto& LastBinding = m_DescriptorSetBindings[pipelineBindPoint == VK_PIPELINE_BIND_POINT_COMPUTE ? 1 : 0];
+            if (LastBinding.Layout   == layout   &&
+                LastBinding.FirstSet == firstSet &&
+                LastBinding.Sets.size()           == descriptorSetCount &&
+                LastBinding.DynamicOffsets.size() == dynamicOffsetCount &&
+                std::equal(pDescriptorSets, pDescriptorSets + descriptorSetCount, LastBinding.Sets.begin()) &&
+                (dynamicOffsetCount == 0 || std::equal(pDynamicOffsets, pDynamicOffsets + dynamicOffsetCount, LastBinding.DynamicOffsets.begin())))
+            {
+                ++m_StateStats.NumFilteredCommands;
+                return;
+            }
+
             vkCmdBindDescriptorSets(m_VkCmdBuffer, pipelineBindPoint, layout, firstSet, descriptorSetCount, pDescriptorSets, dynamicOffsetCount, pDynamicOffsets);
+            LastBinding.Layout   = layout;
+            LastBinding.FirstSet = firstSet;
+            LastBinding.Sets.assign(pDescriptorSets, pDescriptorSets + descriptorSetCount);
+            LastBinding.DynamicOffsets.assign(pDynamicOffsets, pDynamicOffsets + dynamicOffsetCount);
+            ++m_StateStats.NumRecordedCommands;
         }
 
         void CopyBuffer(VkBuffer            srcBuffer,
@@ -342,6 +507,7 @@ namespace VulkanUtilities
                 // Copy buffer operation must be performed outside of render pass.
                 EndRenderPass();
             }
+            FlushBarriers();
             vkCmdCopyBuffer(m_VkCmdBuffer, srcBuffer, dstBuffer, regionCount, pRegions);
         }
                                           
@@ -359,6 +525,7 @@ namespace VulkanUtilities
                 EndRenderPass();
             }
 
+            FlushBarriers();
             vkCmdCopyImage(m_VkCmdBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, pRegions);
         }
 
@@ -375,6 +542,7 @@ namespace VulkanUtilities
                 EndRenderPass();
             }
 
+            FlushBarriers();
             vkCmdCopyBufferToImage(m_VkCmdBuffer, srcBuffer, dstImage, dstImageLayout, regionCount, pRegions);
         }
 
@@ -391,6 +559,7 @@ namespace VulkanUtilities
                 EndRenderPass();
             }
 
+            FlushBarriers();
             vkCmdCopyImageToBuffer(m_VkCmdBuffer, srcImage, srcImageLayout, dstBuffer, regionCount, pRegions);
         }
 
@@ -409,10 +578,46 @@ namespace VulkanUtilities
                 EndRenderPass();
             }
 
+            FlushBarriers();
             vkCmdBlitImage(m_VkCmdBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, pRegions, filter);
         }
 
-        void FlushBarriers();
+        // Records all pending barriers with a single vkCmdPipelineBarrier() command
+        void FlushBarriers()
+        {
+            if (HasPendingBarriers())
+                EmitPendingBarriers();
+        }
+
+        bool HasPendingBarriers()const
+        {
+            return !m_PendingImageBarriers.empty() || !m_PendingBufferBarriers.empty();
+        }
+
+        struct BarrierStatistics
+        {
+            // Total number of barriers requested through TransitionImageLayout() and BufferMemoryBarrier()
+            uint64_t NumRequestedBarriers       = 0;
+            // Number of read-to-read barriers that were dropped
+            uint64_t NumSkippedBarriers         = 0;
+            // Number of barriers merged with a pending barrier for the same resource
+            uint64_t NumMergedBarriers          = 0;
+            // Number of barriers recorded into the command buffer
+            uint64_t NumEmittedBarriers         = 0;
+            // Number of vkCmdPipelineBarrier() commands
+            uint64_t NumPipelineBarrierCommands = 0;
+        };
+        const BarrierStatistics& GetBarrierStatistics()const{return m_BarrierStats;}
+
+        struct StateStatistics
+        {
+            // Number of state-setting commands (pipeline, descriptor set, vertex and index buffer bindings, 
+            // viewports, scissor rects, stencil reference and blend constants) recorded into the command buffer
+            uint64_t NumRecordedCommands = 0;
+            // Number of state-setting commands skipped because they would set the same values
+            uint64_t NumFilteredCommands = 0;
+        };
+        const StateStatistics& GetStateStatistics()const{return m_StateStats;}
 
         void SetVkCmdBuffer(VkCommandBuffer VkCmdBuffer)
         {
@@ -431,13 +636,121 @@ namespace VulkanUtilities
             VkIndexType     IndexType           = VK_INDEX_TYPE_MAX_ENUM;
             uint32_t        FramebufferWidth    = 0;
             uint32_t        FramebufferHeight   = 0;
+            VkSubpassContents SubpassContents   = VK_SUBPASS_CONTENTS_INLINE;
+            // True if the render pass is inherited by a secondary command buffer
+            bool            RenderPassInherited = false;
         };
 
         const StateCache& GetState()const{return m_State;}
 
     private:
+        void AddImageBarrier(VkImage                        Image,
+                             VkImageLayout                  OldLayout,
+                             VkImageLayout                  NewLayout,
+                             const VkImageSubresourceRange& SubresRange,
+                             VkPipelineStageFlags           SrcStages,
+                             VkPipelineStageFlags           DestStages);
+
+        void AddBufferBarrier(VkBuffer             Buffer, 
+                              VkAccessFlags        srcAccessMask,
+                              VkAccessFlags        dstAccessMask,
+                              VkPipelineStageFlags SrcStages,
+                              VkPipelineStageFlags DestStages,
+                              VkDeviceSize         Offset,
+                              VkDeviceSize         Size);
+
+        void EmitPendingBarriers();
+
+        // Compares the range with the cached values and updates the cache. Returns true if
+        // the command that sets the range is redundant.
+        template<typename T, size_t N>
+        bool FilterState(T (&Cache)[N], uint32_t& ValidMask, uint32_t First, uint32_t Count, const T* pValues)
+        {
+            static_assert(N <= 32, "Valid mask is too small");
+            if (First + Count > N)
+            {
+                // Values are not cached
+                ++m_StateStats.NumRecordedCommands;
+                return false;
+            }
+
+            const uint32_t RangeMask = ((Count < 32 ? (1u << Count) : 0u) - 1u) << First;
+            if ((ValidMask & RangeMask) == RangeMask && memcmp(Cache + First, pValues, sizeof(T) * Count) == 0)
+            {
+                ++m_StateStats.NumFilteredCommands;
+                return true;
+            }
+
+            memcpy(Cache + First, pValues, sizeof(T) * Count);
+            ValidMask |= RangeMask;
+            ++m_StateStats.NumRecordedCommands;
+            return false;
+        }
+
+        void ResetDynamicState()
+        {
+            m_ValidViewportsMask    = 0;
+            m_ValidScissorsMask     = 0;
+            m_StencilReferenceValid = false;
+            m_BlendConstantsValid   = false;
+            for (auto& Binding : m_VertexBuffers)
+                Binding = VertexBufferBinding{};
+        }
+
+        void ResetDescriptorSetBindings()
+        {
+            for (auto& Binding : m_DescriptorSetBindings)
+            {
+                Binding.Layout   = VK_NULL_HANDLE;
+                Binding.FirstSet = 0;
+                Binding.Sets.clear();
+                Binding.DynamicOffsets.clear();
+            }
+        }
+
         StateCache m_State;
         VkCommandBuffer m_VkCmdBuffer = VK_NULL_HANDLE;
         const VkPipelineStageFlags m_EnabledGraphicsShaderStages;
+        // Barriers accumulated between two commands that access resources
+        std::vector<VkImageMemoryBarrier>  m_PendingImageBarriers;
+        std::vector<VkBufferMemoryBarrier> m_PendingBufferBarriers;
+        VkPipelineStageFlags               m_PendingSrcStages = 0;
+        VkPipelineStageFlags               m_PendingDstStages = 0;
+        BarrierStatistics                  m_BarrierStats;
+
+        // Shadow copies of the state set by the commands that are filtered
+        static constexpr uint32_t MaxCachedViewports     = 16;
+        static constexpr uint32_t MaxCachedVertexBuffers = 32;
+        VkViewport m_Viewports[MaxCachedViewports];
+        VkRect2D   m_Scissors [MaxCachedViewports];
+        uint32_t   m_ValidViewportsMask    = 0;
+        uint32_t   m_ValidScissorsMask     = 0;
+        uint32_t   m_StencilReference      = 0;
+        bool       m_StencilReferenceValid = false;
+        float      m_BlendConstants[4]     = {};
+        bool       m_BlendConstantsValid   = false;
+
+        struct VertexBufferBinding
+        {
+            VkBuffer     Buffer = VK_NULL_HANDLE;
+            VkDeviceSize Offset = 0;
+        };
+        VertexBufferBinding m_VertexBuffers[MaxCachedVertexBuffers];
+
+        // The last vkCmdBindDescriptorSets command recorded for graphics [0] and compute [1] bind points
+        struct DescriptorSetBinding
+        {
+            VkPipelineLayout             Layout   = VK_NULL_HANDLE;
+            uint32_t                     FirstSet = 0;
+            std::vector<VkDescriptorSet> Sets;
+            std::vector<uint32_t>        DynamicOffsets;
+        };
+        DescriptorSetBinding m_DescriptorSetBindings[2];
+
+        StateStatistics m_StateStats;
+
+        // Only available when VK_KHR_draw_indirect_count extension is enabled
+        const PFN_vkCmdDrawIndirectCountKHR        m_vkCmdDrawIndirectCount;
+        const PFN_vkCmdDrawIndexedIndirectCountKHR m_vkCmdDrawIndexedIndirectCount;
     };
 }
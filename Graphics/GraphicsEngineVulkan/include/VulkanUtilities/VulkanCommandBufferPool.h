@@ -47,9 +47,10 @@ namespace VulkanUtilities
 
         ~VulkanCommandBufferPool();
 
-        VkCommandBuffer GetCommandBuffer(const char* DebugName = "");
+        // If pInheritanceInfo is not null, a secondary command buffer is returned
+        VkCommandBuffer GetCommandBuffer(const char* DebugName = "", const VkCommandBufferInheritanceInfo* pInheritanceInfo = nullptr);
         // The GPU must have finished with the command buffer being returned to the pool
-        void FreeCommandBuffer(VkCommandBuffer&& CmdBuffer);
+        void FreeCommandBuffer(VkCommandBuffer&& CmdBuffer, bool IsSecondary = false);
 
         CommandPoolWrapper&& Release();
 
@@ -64,6 +65,7 @@ namespace VulkanUtilities
 
         std::mutex m_Mutex;
         std::deque< VkCommandBuffer > m_CmdBuffers;
+        std::deque< VkCommandBuffer > m_SecondaryCmdBuffers;
 #ifdef DEVELOPMENT
         std::atomic_int32_t m_BuffCounter;
 #endif
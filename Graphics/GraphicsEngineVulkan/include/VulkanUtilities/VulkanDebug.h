@@ -84,6 +84,7 @@ namespace VulkanUtilities
 	void SetDescriptorSetLayoutName (VkDevice device, VkDescriptorSetLayout descriptorSetLayout, const char * name);
 	void SetDescriptorSetName       (VkDevice device, VkDescriptorSet       descriptorSet,       const char * name);
     void SetDescriptorPoolName      (VkDevice device, VkDescriptorPool      descriptorPool,      const char * name);
+    void SetDescriptorUpdateTemplateName(VkDevice device, VkDescriptorUpdateTemplateKHR descriptorUpdateTemplate, const char * name);
 	void SetSemaphoreName           (VkDevice device, VkSemaphore           semaphore,           const char * name);
 	void SetFenceName               (VkDevice device, VkFence               fence,               const char * name);
 	void SetEventName               (VkDevice device, VkEvent               _event,              const char * name);
@@ -105,6 +106,7 @@ namespace VulkanUtilities
     void SetVulkanObjectName(VkDevice device, VkDescriptorSetLayout descriptorSetLayout, const char * name);
     void SetVulkanObjectName(VkDevice device, VkDescriptorSet       descriptorSet,       const char * name);
     void SetVulkanObjectName(VkDevice device, VkDescriptorPool      descriptorPool,      const char * name);
+    void SetVulkanObjectName(VkDevice device, VkDescriptorUpdateTemplateKHR descriptorUpdateTemplate, const char * name);
     void SetVulkanObjectName(VkDevice device, VkSemaphore           semaphore,           const char * name);
     void SetVulkanObjectName(VkDevice device, VkFence               fence,               const char * name);
     void SetVulkanObjectName(VkDevice device, VkEvent               _event,              const char * name);
@@ -59,6 +59,12 @@ namespace VulkanUtilities
         VkAllocationCallbacks* GetVkAllocator()const{return m_pVkAllocator;}
         VkInstance             GetVkInstance() const{return m_VkInstance;}
 
+        // Return vkGetPhysicalDeviceFeatures2KHR, vkGetPhysicalDeviceProperties2KHR and vkGetPhysicalDeviceMemoryProperties2KHR
+        // entry points if VK_KHR_get_physical_device_properties2 extension is enabled, and nullptr otherwise
+        PFN_vkGetPhysicalDeviceFeatures2KHR         GetPhysicalDeviceFeatures2Proc()        const{return m_vkGetPhysicalDeviceFeatures2KHR;}
+        PFN_vkGetPhysicalDeviceProperties2KHR       GetPhysicalDeviceProperties2Proc()      const{return m_vkGetPhysicalDeviceProperties2KHR;}
+        PFN_vkGetPhysicalDeviceMemoryProperties2KHR GetPhysicalDeviceMemoryProperties2Proc()const{return m_vkGetPhysicalDeviceMemoryProperties2KHR;}
+
     private:
         VulkanInstance(bool                   EnableValidation, 
                        uint32_t               GlobalExtensionCount, 
@@ -68,6 +74,9 @@ namespace VulkanUtilities
         bool m_DebugUtilsEnabled = false;
         VkAllocationCallbacks* const m_pVkAllocator;
         VkInstance m_VkInstance = VK_NULL_HANDLE;
+        PFN_vkGetPhysicalDeviceFeatures2KHR         m_vkGetPhysicalDeviceFeatures2KHR         = nullptr;
+        PFN_vkGetPhysicalDeviceProperties2KHR       m_vkGetPhysicalDeviceProperties2KHR       = nullptr;
+        PFN_vkGetPhysicalDeviceMemoryProperties2KHR m_vkGetPhysicalDeviceMemoryProperties2KHR = nullptr;
 
         std::vector<VkLayerProperties>     m_Layers;
         std::vector<VkExtensionProperties> m_Extensions;
@@ -47,6 +47,7 @@ namespace VulkanUtilities
     using DescriptorPoolWrapper = VulkanObjectWrapper<VkDescriptorPool>;
     using DescriptorSetLayoutWrapper = VulkanObjectWrapper<VkDescriptorSetLayout>;
     using SemaphoreWrapper      = VulkanObjectWrapper<VkSemaphore>;
+    using DescriptorUpdateTemplateWrapper = VulkanObjectWrapper<VkDescriptorUpdateTemplateKHR>;
 
     class VulkanLogicalDevice : public std::enable_shared_from_this<VulkanLogicalDevice>
     {
@@ -98,6 +99,7 @@ namespace VulkanUtilities
         DescriptorPoolWrapper CreateDescriptorPool(const VkDescriptorPoolCreateInfo &DescrPoolCI,   const char* DebugName = "")const;
         DescriptorSetLayoutWrapper CreateDescriptorSetLayout(const VkDescriptorSetLayoutCreateInfo &LayoutCI, const char* DebugName = "")const;
         SemaphoreWrapper    CreateSemaphore(const VkSemaphoreCreateInfo &SemaphoreCI, const char* DebugName = "")const;
+        DescriptorUpdateTemplateWrapper CreateDescriptorUpdateTemplate(const VkDescriptorUpdateTemplateCreateInfoKHR &TemplateCI, const char* DebugName = "")const;
 
         VkCommandBuffer     AllocateVkCommandBuffer(const VkCommandBufferAllocateInfo &AllocInfo, const char* DebugName = "")const;
         VkDescriptorSet     AllocateVkDescriptorSet(const VkDescriptorSetAllocateInfo &AllocInfo, const char* DebugName = "")const;
@@ -118,6 +120,7 @@ namespace VulkanUtilities
         void ReleaseVulkanObject(DescriptorPoolWrapper&& DescriptorPool)const;
         void ReleaseVulkanObject(DescriptorSetLayoutWrapper&& DescriptorSetLayout)const;
         void ReleaseVulkanObject(SemaphoreWrapper&&     Semaphore)const;
+        void ReleaseVulkanObject(DescriptorUpdateTemplateWrapper&& DescriptorUpdateTemplate)const;
 
         void FreeDescriptorSet(VkDescriptorPool Pool, VkDescriptorSet Set)const;
 
@@ -145,6 +148,23 @@ namespace VulkanUtilities
                                   uint32_t                      descriptorCopyCount,
                                   const VkCopyDescriptorSet*    pDescriptorCopies)const;
 
+        void UpdateDescriptorSetWithTemplate(VkDescriptorSet                descriptorSet,
+                                             VkDescriptorUpdateTemplateKHR  descriptorUpdateTemplate,
+                                             const void*                    pData)const;
+
+        // Descriptor update templates are only available when VK_KHR_descriptor_update_template extension is enabled
+        bool IsDescriptorUpdateTemplateSupported()const { return m_vkUpdateDescriptorSetWithTemplate != nullptr; }
+
+        // Indirect draw count functions are only available when VK_KHR_draw_indirect_count extension is enabled
+        bool IsDrawIndirectCountSupported()const { return m_vkCmdDrawIndirectCount != nullptr; }
+        PFN_vkCmdDrawIndirectCountKHR        GetCmdDrawIndirectCountFunc()       const { return m_vkCmdDrawIndirectCount; }
+        PFN_vkCmdDrawIndexedIndirectCountKHR GetCmdDrawIndexedIndirectCountFunc()const { return m_vkCmdDrawIndexedIndirectCount; }
+
+        bool IsMultiDrawIndirectEnabled()const { return m_MultiDrawIndirectEnabled; }
+
+        // Returns true if VK_EXT_descriptor_indexing extension is enabled
+        bool IsDescriptorIndexingEnabled()const { return m_DescriptorIndexingEnabled; }
+
         VkResult ResetCommandPool(VkCommandPool             vkCmdPool,
                                   VkCommandPoolResetFlags   flags = 0)const;
 
@@ -167,5 +187,15 @@ namespace VulkanUtilities
         VkDevice m_VkDevice = VK_NULL_HANDLE;
         const VkAllocationCallbacks* const m_VkAllocator;
         VkPipelineStageFlags m_EnabledGraphicsShaderStages = 0;
+
+        PFN_vkCreateDescriptorUpdateTemplateKHR  m_vkCreateDescriptorUpdateTemplate  = nullptr;
+        PFN_vkDestroyDescriptorUpdateTemplateKHR m_vkDestroyDescriptorUpdateTemplate = nullptr;
+        PFN_vkUpdateDescriptorSetWithTemplateKHR m_vkUpdateDescriptorSetWithTemplate = nullptr;
+
+        PFN_vkCmdDrawIndirectCountKHR        m_vkCmdDrawIndirectCount        = nullptr;
+        PFN_vkCmdDrawIndexedIndirectCountKHR m_vkCmdDrawIndexedIndirectCount = nullptr;
+
+        bool m_MultiDrawIndirectEnabled  = false;
+        bool m_DescriptorIndexingEnabled = false;
     };
 }
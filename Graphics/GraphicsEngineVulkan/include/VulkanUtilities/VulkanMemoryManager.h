@@ -99,7 +99,9 @@ public:
         m_ParentMemoryMgr {rhs.m_ParentMemoryMgr         },
         m_AllocationMgr   {std::move(rhs.m_AllocationMgr)},
         m_VkMemory        {std::move(rhs.m_VkMemory)     },
-        m_CPUMemory       {rhs.m_CPUMemory               }
+        m_CPUMemory       {rhs.m_CPUMemory               },
+        m_IsDraining      {rhs.m_IsDraining              },
+        m_NumDrainSteps   {rhs.m_NumDrainSteps           }
     {
         rhs.m_CPUMemory = nullptr;
     }
@@ -117,9 +119,14 @@ public:
 
     VkDeviceMemory GetVkMemory()const{return m_VkMemory;}
     void* GetCPUMemory()const{return m_CPUMemory;}
+
+    // Draining pages are only used for new allocations when no other page can accommodate
+    // them, and are released by the memory manager as soon as they become empty
+    bool IsDraining()const{return m_IsDraining;}
     
 private:
     friend struct VulkanMemoryAllocation;
+    friend class VulkanMemoryManager;
     
     // Memory is reclaimed immediately. The application is responsible to ensure it is not in use by the GPU    
     void Free(VulkanMemoryAllocation&& Allocation);
@@ -129,6 +136,10 @@ private:
     Diligent::VariableSizeAllocationsManager m_AllocationMgr;
     VulkanUtilities::DeviceMemoryWrapper     m_VkMemory;
     void*                                    m_CPUMemory = nullptr;
+
+    // Draining state is only accessed by the memory manager while its page mutex is locked
+    bool                                     m_IsDraining    = false;
+    uint32_t                                 m_NumDrainSteps = 0;
 };
 
 class VulkanMemoryManager
@@ -166,11 +177,19 @@ public:
         m_HostVisiblePageSize    {rhs.m_HostVisiblePageSize   },
         m_DeviceLocalReserveSize {rhs.m_DeviceLocalReserveSize},
         m_HostVisibleReserveSize {rhs.m_HostVisibleReserveSize},
+
+        m_MemoryBudgetCallback         {rhs.m_MemoryBudgetCallback        },
+        m_pMemoryBudgetCallbackUserData{rhs.m_pMemoryBudgetCallbackUserData},
+        m_MaxDrainPagesPerStep         {rhs.m_MaxDrainPagesPerStep        },
+        m_SparsePageUsageThreshold     {rhs.m_SparsePageUsageThreshold    },
     
         //m_CurrUsedSize      {rhs.m_CurrUsedSize},
         m_PeakUsedSize      {rhs.m_PeakUsedSize     },
         m_CurrAllocatedSize {rhs.m_CurrAllocatedSize},
-        m_PeakAllocatedSize {rhs.m_PeakAllocatedSize}
+        m_PeakAllocatedSize {rhs.m_PeakAllocatedSize},
+        m_HeapAllocatedSize {rhs.m_HeapAllocatedSize},
+        m_NumDrainedPages   {rhs.m_NumDrainedPages  },
+        m_NumOverBudgetPages{rhs.m_NumOverBudgetPages}
     {
         for(size_t i=0; i < m_CurrUsedSize.size(); ++i)
             m_CurrUsedSize[i].store(rhs.m_CurrUsedSize[i].load());
@@ -186,6 +205,31 @@ public:
 	VulkanMemoryAllocation Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps);
     void ShrinkMemory();
 
+    // Called when creating a new page would exceed the memory budget of the heap. Budget and usage
+    // are reported by VK_EXT_memory_budget if it is supported; otherwise the budget is the heap size 
+    // and the usage is the total size of the pages allocated by this manager from the heap.
+    // The callback is executed while the manager is locked and must not allocate device memory.
+    using MemoryBudgetCallbackType = void(*)(uint32_t HeapIndex, VkDeviceSize Budget, VkDeviceSize Usage, VkDeviceSize RequestedSize, void* pUserData);
+    void SetMemoryBudgetCallback(MemoryBudgetCallbackType Callback, void* pUserData)
+    {
+        m_MemoryBudgetCallback          = Callback;
+        m_pMemoryBudgetCallbackUserData = pUserData;
+    }
+
+    // Sets the maximum number of sparsely used pages that DefragmentMemory() starts draining
+    // in a single call, and the fraction of the page size below which a page is considered sparse.
+    // Zero MaxDrainPagesPerStep disables defragmentation.
+    void SetDefragmentationParameters(uint32_t MaxDrainPagesPerStep, float SparsePageUsageThreshold)
+    {
+        m_MaxDrainPagesPerStep     = MaxDrainPagesPerStep;
+        m_SparsePageUsageThreshold = SparsePageUsageThreshold;
+    }
+
+    // Performs one step of incremental defragmentation: releases draining pages that have become 
+    // empty and starts draining up to MaxDrainPagesPerStep new sparsely used pages. 
+    // Allocations are never moved; they leave draining pages when their owners release them.
+    void DefragmentMemory();
+
 protected:
     friend class VulkanMemoryPage;
 
@@ -225,20 +269,34 @@ protected:
             }
         };
     };
-    std::unordered_multimap<MemoryPageIndex, VulkanMemoryPage, MemoryPageIndex::Hasher> m_Pages;
+    using PageMapType = std::unordered_multimap<MemoryPageIndex, VulkanMemoryPage, MemoryPageIndex::Hasher>;
+    PageMapType m_Pages;
     
     const VkDeviceSize m_DeviceLocalPageSize;
     const VkDeviceSize m_HostVisiblePageSize;
     const VkDeviceSize m_DeviceLocalReserveSize;
     const VkDeviceSize m_HostVisibleReserveSize;
+
+    MemoryBudgetCallbackType m_MemoryBudgetCallback          = nullptr;
+    void*                    m_pMemoryBudgetCallbackUserData = nullptr;
+    uint32_t                 m_MaxDrainPagesPerStep          = 0;
+    float                    m_SparsePageUsageThreshold      = 0.25f;
     
     void OnFreeAllocation(VkDeviceSize Size, bool IsHostVisble);
 
+    // The following methods must be called while m_PagesMtx is locked
+    PageMapType::iterator DestroyPage(PageMapType::iterator PageIt, const char* Reason);
+    void CheckMemoryBudget(uint32_t MemoryTypeIndex, VkDeviceSize PageSize);
+    bool CanDrainPage(PageMapType::const_iterator PageIt)const;
+
     // 0 == Device local, 1 == Host-visible
     std::array<std::atomic_int64_t, 2> m_CurrUsedSize = {};
     std::array<VkDeviceSize, 2> m_PeakUsedSize = {};
     std::array<VkDeviceSize, 2> m_CurrAllocatedSize = {};
     std::array<VkDeviceSize, 2> m_PeakAllocatedSize = {};
+    std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> m_HeapAllocatedSize = {};
+    uint32_t m_NumDrainedPages    = 0;
+    uint32_t m_NumOverBudgetPages = 0;
 
     // If adding new member, do not forget to update move ctor
 };
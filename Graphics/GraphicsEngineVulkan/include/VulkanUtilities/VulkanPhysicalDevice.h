@@ -27,8 +27,25 @@
 #include <vector>
 #include "vulkan.h"
 
+#ifndef VK_EXT_memory_budget
+// Vulkan headers used by the engine predate VK_EXT_memory_budget extension
+#   define VK_EXT_memory_budget 1
+#   define VK_EXT_MEMORY_BUDGET_SPEC_VERSION 1
+#   define VK_EXT_MEMORY_BUDGET_EXTENSION_NAME "VK_EXT_memory_budget"
+#   define VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT static_cast<VkStructureType>(1000237000)
+
+typedef struct VkPhysicalDeviceMemoryBudgetPropertiesEXT {
+    VkStructureType    sType;
+    void*              pNext;
+    VkDeviceSize       heapBudget[VK_MAX_MEMORY_HEAPS];
+    VkDeviceSize       heapUsage[VK_MAX_MEMORY_HEAPS];
+} VkPhysicalDeviceMemoryBudgetPropertiesEXT;
+#endif
+
 namespace VulkanUtilities
 {
+    class VulkanInstance;
+
     class VulkanPhysicalDevice
     {
     public:
@@ -37,7 +54,9 @@ namespace VulkanUtilities
         VulkanPhysicalDevice& operator = (const VulkanPhysicalDevice&) = delete;
         VulkanPhysicalDevice& operator = (VulkanPhysicalDevice&&)      = delete;
 
-        static std::unique_ptr<VulkanPhysicalDevice> Create(VkPhysicalDevice vkDevice);
+        // If pInstance is not null and VK_KHR_get_physical_device_properties2 extension is enabled
+        // by the instance, extended device features and properties are queried
+        static std::unique_ptr<VulkanPhysicalDevice> Create(VkPhysicalDevice vkDevice, const VulkanInstance* pInstance = nullptr);
 
         uint32_t         FindQueueFamily     (VkQueueFlags QueueFlags)                           const;
         VkPhysicalDevice GetVkDeviceHandle   ()                                                  const { return m_VkDevice; }
@@ -48,16 +67,28 @@ namespace VulkanUtilities
         uint32_t GetMemoryTypeIndex(uint32_t typeBits, VkMemoryPropertyFlags properties)const;
         const VkPhysicalDeviceProperties& GetProperties() const {return m_Properties;}
         const VkPhysicalDeviceFeatures&   GetFeatures()   const {return m_Features;  }
+        // All members are VK_FALSE if VK_EXT_descriptor_indexing is not supported or extended features could not be queried
+        const VkPhysicalDeviceDescriptorIndexingFeaturesEXT&   GetDescriptorIndexingFeatures()  const {return m_DescriptorIndexingFeatures;  }
+        const VkPhysicalDeviceDescriptorIndexingPropertiesEXT& GetDescriptorIndexingProperties()const {return m_DescriptorIndexingProperties;}
+        const VkPhysicalDeviceMemoryProperties&                GetMemoryProperties()            const {return m_MemoryProperties;}
+        // Returns true if VK_EXT_memory_budget extension is supported
+        bool IsMemoryBudgetSupported()const { return m_vkGetPhysicalDeviceMemoryProperties2 != nullptr; }
+        // Queries current memory budget and usage of every memory heap. Returns false if 
+        // VK_EXT_memory_budget extension is not supported.
+        bool GetMemoryBudget(VkPhysicalDeviceMemoryBudgetPropertiesEXT& MemoryBudget)const;
         VkFormatProperties  GetPhysicalDeviceFormatProperties(VkFormat imageFormat)const;
 
     private:
-        VulkanPhysicalDevice(VkPhysicalDevice vkDevice);
+        VulkanPhysicalDevice(VkPhysicalDevice vkDevice, const VulkanInstance* pInstance);
 
         const VkPhysicalDevice               m_VkDevice;
         VkPhysicalDeviceProperties           m_Properties           = {};
         VkPhysicalDeviceFeatures             m_Features             = {};
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT   m_DescriptorIndexingFeatures   = {};
+        VkPhysicalDeviceDescriptorIndexingPropertiesEXT m_DescriptorIndexingProperties = {};
         VkPhysicalDeviceMemoryProperties     m_MemoryProperties     = {};
         std::vector<VkQueueFamilyProperties> m_QueueFamilyProperties;
         std::vector<VkExtensionProperties>   m_SupportedExtensions;
+        PFN_vkGetPhysicalDeviceMemoryProperties2KHR m_vkGetPhysicalDeviceMemoryProperties2 = nullptr;
     };
 }
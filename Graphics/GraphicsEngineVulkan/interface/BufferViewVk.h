@@ -42,6 +42,14 @@ public:
 
     /// Returns Vulkan buffer view object.
     virtual VkBufferView GetVkBufferView()const = 0;
+
+    /// Returns the index of the view's descriptor in the bindless resource heap.
+
+    /// \remarks The index is only assigned to shader resource and unordered access views
+    ///          when bindless resources are enabled (see EngineVkCreateInfo::EnableBindlessResources).
+    ///          Otherwise, the method returns InvalidBindlessIndexVk. The index remains valid 
+    ///          for the lifetime of the view.
+    virtual Uint32 GetBindlessIndex()const = 0;
 };
 
 }
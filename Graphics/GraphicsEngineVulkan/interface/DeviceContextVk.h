@@ -35,6 +35,52 @@ namespace Diligent
 static constexpr INTERFACE_ID IID_DeviceContextVk =
 { 0x72aeb1ba, 0xc6ad, 0x42ec,{ 0x88, 0x11, 0x7e, 0xd9, 0xc7, 0x21, 0x76, 0xbb } };
 
+/// Pipeline barrier statistics of the Vulkan device context
+
+/// Resource state transitions requested between two commands that access resources
+/// are accumulated and recorded by a single vkCmdPipelineBarrier() command.
+struct BarrierStatisticsVk
+{
+    /// Number of image and buffer barriers requested by resource state transitions
+    Uint64 NumRequestedBarriers       = 0;
+
+    /// Number of read-to-read barriers that were dropped as redundant
+    Uint64 NumSkippedBarriers         = 0;
+
+    /// Number of barriers merged with another pending barrier for the same resource
+    Uint64 NumMergedBarriers          = 0;
+
+    /// Number of barriers recorded into command buffers
+    Uint64 NumEmittedBarriers         = 0;
+
+    /// Number of vkCmdPipelineBarrier() commands recorded into command buffers
+    Uint64 NumPipelineBarrierCommands = 0;
+};
+
+/// Dynamic descriptor sets written by a context are cached until the end of the frame and 
+/// reused when the same resources are committed again.
+struct DescriptorSetCacheStatisticsVk
+{
+    /// Number of times a dynamic descriptor set was looked up in the cache
+    Uint64 NumLookups = 0;
+
+    /// Number of lookups that found a set with identical resources
+    Uint64 NumHits    = 0;
+};
+
+/// Redundant state filtering statistics of the Vulkan device context
+
+/// Command buffers keep shadow copies of the bound pipelines, descriptor sets, vertex and index 
+/// buffers and dynamic states, and skip commands that would set the same values again.
+struct StateFilteringStatisticsVk
+{
+    /// Number of state-setting commands recorded into command buffers
+    Uint64 NumRecordedCommands = 0;
+
+    /// Number of state-setting commands skipped as redundant
+    Uint64 NumFilteredCommands = 0;
+};
+
 /// Interface to the device context object implemented in Vulkan
 class IDeviceContextVk : public IDeviceContext
 {
@@ -53,6 +99,43 @@ public:
     /// \param [in] NewAccessFlags - Access flags to set for the buffer
     /// \remarks The buffer state must be known to the engine.
     virtual void BufferMemoryBarrier(IBuffer *pBuffer, VkAccessFlags NewAccessFlags) = 0;
+
+    /// Returns pipeline barrier statistics accumulated since the context was created
+
+    /// \param [out] Stats - Barrier statistics, see Diligent::BarrierStatisticsVk.
+    virtual void GetBarrierStatistics(BarrierStatisticsVk& Stats) = 0;
+
+    /// Returns dynamic descriptor set cache statistics accumulated since the context was created
+
+    /// \param [out] Stats - Cache statistics, see Diligent::DescriptorSetCacheStatisticsVk.
+    virtual void GetDescriptorSetCacheStatistics(DescriptorSetCacheStatisticsVk& Stats) = 0;
+
+    /// Returns redundant state filtering statistics accumulated since the context was created
+
+    /// \param [out] Stats - State filtering statistics, see Diligent::StateFilteringStatisticsVk.
+    virtual void GetStateFilteringStatistics(StateFilteringStatisticsVk& Stats) = 0;
+
+    /// Begins recording of a secondary command buffer in a deferred context
+
+    /// \param [in] NumRenderTargets - Number of render targets to bind
+    /// \param [in] ppRenderTargets  - Array of pointers to render target views
+    /// \param [in] pDepthStencil    - Pointer to the depth-stencil view
+    ///
+    /// \remarks All commands recorded by the deferred context until FinishCommandList() is called 
+    ///          are executed inside the render pass defined by the render targets. When the command
+    ///          list is executed by the immediate context, the same render targets must be bound 
+    ///          to it. The immediate context then begins the render pass and executes the command
+    ///          list with vkCmdExecuteCommands(), so that multiple threads can fill the same render pass.
+    ///
+    ///          Render targets are verified, but not transitioned, and no other resource state 
+    ///          transitions may be performed while recording the secondary command buffer. All resources
+    ///          must be transitioned to required states before the recording begins.
+    ///
+    ///          After the command list is executed, the pipeline state and shader resources must be 
+    ///          bound to the immediate context again.
+    ///
+    ///          This method can only be called for a deferred context before any other command is recorded.
+    virtual void BeginSecondaryCommandBuffer(Uint32 NumRenderTargets, ITextureView* ppRenderTargets[], ITextureView* pDepthStencil) = 0;
 };
 
 }
@@ -0,0 +1,319 @@
+/*     Copyright 2019 Diligent Graphics LLC
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "BindlessResourceHeapVk.h"
+#include "RenderDeviceVkImpl.h"
+
+namespace Diligent
+{
+
+static VkDescriptorType BindlessBindingToVkDescriptorType(BINDLESS_BINDING_VK Binding)
+{
+    switch (Binding)
+    {
+        case BINDLESS_BINDING_VK_SAMPLED_IMAGES:          return VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+        case BINDLESS_BINDING_VK_STORAGE_IMAGES:          return VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        case BINDLESS_BINDING_VK_UNIFORM_TEXEL_BUFFERS:   return VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+        case BINDLESS_BINDING_VK_STORAGE_TEXEL_BUFFERS:   return VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER;
+        case BINDLESS_BINDING_VK_STORAGE_BUFFERS:         return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        default: UNEXPECTED("Unexpected bindless binding"); return VK_DESCRIPTOR_TYPE_MAX_ENUM;
+    }
+}
+
+BindlessResourceHeapVk::BindlessResourceHeapVk(RenderDeviceVkImpl&                           DeviceVkImpl,
+                                               const EngineVkCreateInfo::DescriptorPoolSize& HeapSize) :
+    m_DeviceVkImpl{DeviceVkImpl}
+{
+    const auto& LogicalDevice  = DeviceVkImpl.GetLogicalDevice();
+    const auto& PhysicalDevice = DeviceVkImpl.GetPhysicalDevice();
+
+    // Total array size of the bindings must not exceed the update-after-bind per-stage limit of the corresponding 
+    // resource type. If the limits could not be queried (the device was attached by the application), 
+    // the core limits are used as they are guaranteed to be no greater.
+    const auto& Limits        = PhysicalDevice.GetProperties().limits;
+    const auto& IndexingProps = PhysicalDevice.GetDescriptorIndexingProperties();
+    auto MaxSampledImages  = std::max(IndexingProps.maxPerStageDescriptorUpdateAfterBindSampledImages,  Limits.maxPerStageDescriptorSampledImages);
+    auto MaxStorageImages  = std::max(IndexingProps.maxPerStageDescriptorUpdateAfterBindStorageImages,  Limits.maxPerStageDescriptorStorageImages);
+    auto MaxStorageBuffers = std::max(IndexingProps.maxPerStageDescriptorUpdateAfterBindStorageBuffers, Limits.maxPerStageDescriptorStorageBuffers);
+
+    // Uniform texel buffers count against the sampled image limit and storage texel buffers count against
+    // the storage image limit, so the limit is split between the two bindings in proportion to the requested
+    // sizes. Every binding keeps at least one descriptor (see below), which is reserved from the limit as well.
+    auto SplitLimit = [](Uint32 Limit, Uint32 NumRequested0, Uint32 NumRequested1, Uint32& Capacity0, Uint32& Capacity1)
+    {
+        if (Uint64{std::max(NumRequested0, Uint32{1})} + Uint64{std::max(NumRequested1, Uint32{1})} <= Limit)
+        {
+            Capacity0 = NumRequested0;
+            Capacity1 = NumRequested1;
+            return;
+        }
+        VERIFY(Limit >= 2, "Per-stage descriptor limits are guaranteed to be at least 4");
+        auto Share0 = static_cast<Uint32>(Uint64{Limit} * NumRequested0 / (Uint64{NumRequested0} + Uint64{NumRequested1}));
+        Capacity0 = std::min(NumRequested0, std::min(std::max(Share0, Uint32{1}), Limit - 1));
+        Capacity1 = std::min(NumRequested1, Limit - std::max(Capacity0, Uint32{1}));
+    };
+    SplitLimit(MaxSampledImages, HeapSize.NumSampledImageDescriptors, HeapSize.NumUniformTexelBufferDescriptors,
+               m_Allocators[BINDLESS_BINDING_VK_SAMPLED_IMAGES].Capacity, m_Allocators[BINDLESS_BINDING_VK_UNIFORM_TEXEL_BUFFERS].Capacity);
+    SplitLimit(MaxStorageImages, HeapSize.NumStorageImageDescriptors, HeapSize.NumStorageTexelBufferDescriptors,
+               m_Allocators[BINDLESS_BINDING_VK_STORAGE_IMAGES].Capacity, m_Allocators[BINDLESS_BINDING_VK_STORAGE_TEXEL_BUFFERS].Capacity);
+    m_Allocators[BINDLESS_BINDING_VK_STORAGE_BUFFERS].Capacity = std::min(HeapSize.NumStorageBufferDescriptors, MaxStorageBuffers);
+
+    std::array<VkDescriptorSetLayoutBinding, BINDLESS_BINDING_VK_NUM_BINDINGS> Bindings = {};
+    std::array<VkDescriptorBindingFlagsEXT,  BINDLESS_BINDING_VK_NUM_BINDINGS> BindingFlags = {};
+    std::array<VkDescriptorPoolSize,         BINDLESS_BINDING_VK_NUM_BINDINGS> PoolSizes = {};
+    for (Uint32 b = 0; b < BINDLESS_BINDING_VK_NUM_BINDINGS; ++b)
+    {
+        auto Binding = static_cast<BINDLESS_BINDING_VK>(b);
+        // Keep at least one descriptor in every binding so that the layout is the same regardless of heap size
+        auto Capacity = std::max(m_Allocators[b].Capacity, Uint32{1});
+
+        Bindings[b].binding            = b;
+        Bindings[b].descriptorType     = BindlessBindingToVkDescriptorType(Binding);
+        Bindings[b].descriptorCount    = Capacity;
+        Bindings[b].stageFlags         = VK_SHADER_STAGE_ALL;
+        Bindings[b].pImmutableSamplers = nullptr;
+
+        BindingFlags[b] = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT;
+
+        PoolSizes[b].type            = Bindings[b].descriptorType;
+        PoolSizes[b].descriptorCount = Capacity;
+    }
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT BindingFlagsCI = {};
+    BindingFlagsCI.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+    BindingFlagsCI.pNext         = nullptr;
+    BindingFlagsCI.bindingCount  = static_cast<uint32_t>(BindingFlags.size());
+    BindingFlagsCI.pBindingFlags = BindingFlags.data();
+
+    VkDescriptorSetLayoutCreateInfo SetLayoutCI = {};
+    SetLayoutCI.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    SetLayoutCI.pNext        = &BindingFlagsCI;
+    SetLayoutCI.flags        = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+    SetLayoutCI.bindingCount = static_cast<uint32_t>(Bindings.size());
+    SetLayoutCI.pBindings    = Bindings.data();
+    m_SetLayout = LogicalDevice.CreateDescriptorSetLayout(SetLayoutCI, "Bindless resource heap layout");
+
+    VkDescriptorSetLayoutCreateInfo EmptySetLayoutCI = {};
+    EmptySetLayoutCI.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    EmptySetLayoutCI.pNext        = nullptr;
+    EmptySetLayoutCI.flags        = 0;
+    EmptySetLayoutCI.bindingCount = 0;
+    EmptySetLayoutCI.pBindings    = nullptr;
+    m_EmptySetLayout = LogicalDevice.CreateDescriptorSetLayout(EmptySetLayoutCI, "Empty descriptor set layout");
+
+    VkDescriptorPoolCreateInfo PoolCI = {};
+    PoolCI.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    PoolCI.pNext         = nullptr;
+    // Sets allocated from the pool are never freed individually
+    PoolCI.flags         = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+    PoolCI.maxSets       = 2;
+    PoolCI.poolSizeCount = static_cast<uint32_t>(PoolSizes.size());
+    PoolCI.pPoolSizes    = PoolSizes.data();
+    m_Pool = LogicalDevice.CreateDescriptorPool(PoolCI, "Bindless resource heap pool");
+
+    VkDescriptorSetLayout SetLayouts[] = {m_SetLayout, m_EmptySetLayout};
+    VkDescriptorSet*      pSets[]      = {&m_vkSet, &m_vkEmptySet};
+    const char*           SetNames[]   = {"Bindless resource heap", "Empty descriptor set"};
+    for (size_t s = 0; s < _countof(SetLayouts); ++s)
+    {
+        VkDescriptorSetAllocateInfo DescrSetAllocInfo = {};
+        DescrSetAllocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        DescrSetAllocInfo.pNext              = nullptr;
+        DescrSetAllocInfo.descriptorPool     = m_Pool;
+        DescrSetAllocInfo.descriptorSetCount = 1;
+        DescrSetAllocInfo.pSetLayouts        = &SetLayouts[s];
+        *pSets[s] = LogicalDevice.AllocateVkDescriptorSet(DescrSetAllocInfo, SetNames[s]);
+        if (*pSets[s] == VK_NULL_HANDLE)
+            LOG_ERROR_AND_THROW("Failed to allocate ", SetNames[s]);
+    }
+
+    LOG_INFO_MESSAGE("Bindless resource heap: ",
+                     m_Allocators[BINDLESS_BINDING_VK_SAMPLED_IMAGES].Capacity,        " sampled images, ",
+                     m_Allocators[BINDLESS_BINDING_VK_STORAGE_IMAGES].Capacity,        " storage images, ",
+                     m_Allocators[BINDLESS_BINDING_VK_UNIFORM_TEXEL_BUFFERS].Capacity, " uniform texel buffers, ",
+                     m_Allocators[BINDLESS_BINDING_VK_STORAGE_TEXEL_BUFFERS].Capacity, " storage texel buffers, ",
+                     m_Allocators[BINDLESS_BINDING_VK_STORAGE_BUFFERS].Capacity,       " storage buffers");
+}
+
+BindlessResourceHeapVk::~BindlessResourceHeapVk()
+{
+#ifdef DEVELOPMENT
+    for (Uint32 b = 0; b < BINDLESS_BINDING_VK_NUM_BINDINGS; ++b)
+    {
+        const auto& Allocator = m_Allocators[b];
+        DEV_CHECK_ERR(Allocator.FreeIndices.size() == Allocator.FirstUnused, Allocator.FirstUnused - Allocator.FreeIndices.size(),
+                      " descriptor(s) in binding ", b, " of the bindless resource heap have not been released");
+    }
+#endif
+    // Descriptor sets are freed when the pool is destroyed. The heap is destroyed by the 
+    // render device after the GPU is idle, so the pool and layouts are released immediately.
+}
+
+Uint32 BindlessResourceHeapVk::AllocateIndex(BINDLESS_BINDING_VK Binding)
+{
+    // Must be called while the mutex is locked
+    auto& Allocator = m_Allocators[Binding];
+    if (!Allocator.FreeIndices.empty())
+    {
+        auto Index = Allocator.FreeIndices.back();
+        Allocator.FreeIndices.pop_back();
+        return Index;
+    }
+
+    if (Allocator.FirstUnused < Allocator.Capacity)
+        return Allocator.FirstUnused++;
+
+    LOG_ERROR_MESSAGE("Bindless resource heap is full: all ", Allocator.Capacity, " descriptors in binding ", Uint32{Binding},
+                      " are in use. Increase EngineVkCreateInfo::BindlessHeapSize.");
+    return InvalidBindlessIndexVk;
+}
+
+void BindlessResourceHeapVk::ReleaseIndex(BINDLESS_BINDING_VK Binding, Uint32 Index)
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    auto& Allocator = m_Allocators[Binding];
+    VERIFY_EXPR(Index < Allocator.FirstUnused);
+    // The stale descriptor is left in the set. This is valid as the binding is partially bound
+    // and the descriptor is never accessed by shaders until the index is reused.
+    Allocator.FreeIndices.push_back(Index);
+}
+
+Uint32 BindlessResourceHeapVk::AllocateImageDescriptor(BINDLESS_BINDING_VK Binding, VkImageView vkImageView, VkImageLayout Layout)
+{
+    VERIFY_EXPR(Binding == BINDLESS_BINDING_VK_SAMPLED_IMAGES || Binding == BINDLESS_BINDING_VK_STORAGE_IMAGES);
+
+    VkDescriptorImageInfo ImageInfo = {};
+    ImageInfo.sampler     = VK_NULL_HANDLE;
+    ImageInfo.imageView   = vkImageView;
+    ImageInfo.imageLayout = Layout;
+
+    VkWriteDescriptorSet WriteDescrSet = {};
+    WriteDescrSet.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    WriteDescrSet.dstSet          = m_vkSet;
+    WriteDescrSet.dstBinding      = Binding;
+    WriteDescrSet.descriptorCount = 1;
+    WriteDescrSet.descriptorType  = BindlessBindingToVkDescriptorType(Binding);
+    WriteDescrSet.pImageInfo      = &ImageInfo;
+
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    auto Index = AllocateIndex(Binding);
+    if (Index != InvalidBindlessIndexVk)
+    {
+        WriteDescrSet.dstArrayElement = Index;
+        m_DeviceVkImpl.GetLogicalDevice().UpdateDescriptorSets(1, &WriteDescrSet, 0, nullptr);
+    }
+    return Index;
+}
+
+Uint32 BindlessResourceHeapVk::AllocateTexelBufferDescriptor(BINDLESS_BINDING_VK Binding, VkBufferView vkBufferView)
+{
+    VERIFY_EXPR(Binding == BINDLESS_BINDING_VK_UNIFORM_TEXEL_BUFFERS || Binding == BINDLESS_BINDING_VK_STORAGE_TEXEL_BUFFERS);
+
+    VkWriteDescriptorSet WriteDescrSet = {};
+    WriteDescrSet.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    WriteDescrSet.dstSet           = m_vkSet;
+    WriteDescrSet.dstBinding       = Binding;
+    WriteDescrSet.descriptorCount  = 1;
+    WriteDescrSet.descriptorType   = BindlessBindingToVkDescriptorType(Binding);
+    WriteDescrSet.pTexelBufferView = &vkBufferView;
+
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    auto Index = AllocateIndex(Binding);
+    if (Index != InvalidBindlessIndexVk)
+    {
+        WriteDescrSet.dstArrayElement = Index;
+        m_DeviceVkImpl.GetLogicalDevice().UpdateDescriptorSets(1, &WriteDescrSet, 0, nullptr);
+    }
+    return Index;
+}
+
+Uint32 BindlessResourceHeapVk::AllocateStorageBufferDescriptor(VkBuffer vkBuffer, VkDeviceSize Offset, VkDeviceSize Range)
+{
+    VkDescriptorBufferInfo BufferInfo = {};
+    BufferInfo.buffer = vkBuffer;
+    BufferInfo.offset = Offset;
+    BufferInfo.range  = Range;
+
+    VkWriteDescriptorSet WriteDescrSet = {};
+    WriteDescrSet.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    WriteDescrSet.dstSet          = m_vkSet;
+    WriteDescrSet.dstBinding      = BINDLESS_BINDING_VK_STORAGE_BUFFERS;
+    WriteDescrSet.descriptorCount = 1;
+    WriteDescrSet.descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    WriteDescrSet.pBufferInfo     = &BufferInfo;
+
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    auto Index = AllocateIndex(BINDLESS_BINDING_VK_STORAGE_BUFFERS);
+    if (Index != InvalidBindlessIndexVk)
+    {
+        WriteDescrSet.dstArrayElement = Index;
+        m_DeviceVkImpl.GetLogicalDevice().UpdateDescriptorSets(1, &WriteDescrSet, 0, nullptr);
+    }
+    return Index;
+}
+
+void BindlessResourceHeapVk::FreeDescriptor(BINDLESS_BINDING_VK Binding, Uint32 Index, Uint64 CmdQueueMask)
+{
+    class IndexReleaser
+    {
+    public:
+        IndexReleaser(BindlessResourceHeapVk& _Heap,
+                      BINDLESS_BINDING_VK     _Binding,
+                      Uint32                  _Index) noexcept : 
+            Heap    (&_Heap   ),
+            Binding (_Binding ),
+            Index   (_Index   )
+        {}
+
+        IndexReleaser             (const IndexReleaser&) = delete;
+        IndexReleaser& operator = (const IndexReleaser&) = delete;
+        IndexReleaser& operator = (      IndexReleaser&&)= delete;
+
+        IndexReleaser(IndexReleaser&& rhs)noexcept : 
+            Heap    (rhs.Heap   ),
+            Binding (rhs.Binding),
+            Index   (rhs.Index  )
+        {
+            rhs.Heap = nullptr;
+        }
+
+        ~IndexReleaser()
+        {
+            if (Heap != nullptr)
+            {
+                Heap->ReleaseIndex(Binding, Index);
+            }
+        }
+
+    private:
+        BindlessResourceHeapVk* Heap;
+        BINDLESS_BINDING_VK     Binding;
+        Uint32                  Index;
+    };
+
+    VERIFY_EXPR(Index != InvalidBindlessIndexVk);
+    m_DeviceVkImpl.SafeReleaseDeviceObject(IndexReleaser{*this, Binding, Index}, CmdQueueMask);
+}
+
+}
@@ -0,0 +1,211 @@
+/*     Copyright 2019 Diligent Graphics LLC
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "BufferSuballocatorVk.h"
+#include "RenderDeviceVkImpl.h"
+#include "EngineMemory.h"
+
+namespace Diligent
+{
+
+BufferSuballocatorVk::Page::Page(VkBufferUsageFlags _Usage, VkDeviceSize Size) :
+    Usage   {_Usage                                                      },
+    AllocMgr{static_cast<VariableSizeAllocationsManager::OffsetType>(Size), GetRawAllocator()}
+{
+}
+
+BufferSuballocatorVk::BufferSuballocatorVk(RenderDeviceVkImpl& DeviceVkImpl,
+                                           Uint32              PageSize,
+                                           Uint32              MaxBufferSize) :
+    m_DeviceVkImpl {DeviceVkImpl },
+    m_PageSize     {PageSize     },
+    m_MaxBufferSize{std::min(MaxBufferSize, PageSize)},
+    // Offsets of suballocated buffers are used as copy destination offsets, 
+    // vertex buffer offsets and index buffer offsets. The latter must be a multiple
+    // of the index type size (19.2), which is covered by the minimum alignment.
+    m_Alignment    {std::max(VkDeviceSize{16}, DeviceVkImpl.GetPhysicalDevice().GetProperties().limits.optimalBufferCopyOffsetAlignment)}
+{
+    VERIFY(IsPowerOfTwo(m_Alignment), "Alignment is not power of 2!");
+}
+
+BufferSuballocatorVk::~BufferSuballocatorVk()
+{
+    for (const auto& pPage : m_Pages)
+    {
+        DEV_CHECK_ERR(pPage->AllocMgr.IsEmpty(), "All suballocated buffers must have been released");
+    }
+    LOG_INFO_MESSAGE("Vulkan buffer suballocator: ", m_NumAllocations, " allocations, peak page count: ", m_PeakPageCount, 
+                     " (", m_PageSize >> 10, " KB each), peak used size: ", m_PeakUsedSize >> 10, " KB");
+}
+
+BufferSuballocationVk BufferSuballocatorVk::Allocate(VkBufferUsageFlags Usage, VkDeviceSize Size)
+{
+    VERIFY_EXPR(IsSuballocationAllowed(Size));
+
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    BufferSuballocationVk Allocation;
+    auto AllocateFromPage = [&](Page& page)
+    {
+        auto Region = page.AllocMgr.Allocate(static_cast<VariableSizeAllocationsManager::OffsetType>(Size), static_cast<VariableSizeAllocationsManager::OffsetType>(m_Alignment));
+        if (!Region.IsValid())
+            return false;
+
+        // All regions are aligned, so unaligned offset is the aligned offset
+        VERIFY_EXPR(Region.UnalignedOffset % m_Alignment == 0);
+        Allocation.vkBuffer = page.Buffer;
+        Allocation.Offset   = Region.UnalignedOffset;
+        Allocation.Size     = Region.Size;
+        Allocation.pPage    = &page;
+        m_UsedSize    += Region.Size;
+        m_PeakUsedSize = std::max(m_PeakUsedSize, m_UsedSize);
+        ++m_NumAllocations;
+        return true;
+    };
+
+    for (auto& pPage : m_Pages)
+    {
+        if (pPage->Usage == Usage && AllocateFromPage(*pPage))
+            return Allocation;
+    }
+
+    const auto& LogicalDevice = m_DeviceVkImpl.GetLogicalDevice();
+
+    std::unique_ptr<Page> pNewPage{new Page{Usage, m_PageSize}};
+
+    VkBufferCreateInfo BuffCI = {};
+    BuffCI.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    BuffCI.pNext                 = nullptr;
+    BuffCI.flags                 = 0;
+    BuffCI.size                  = m_PageSize;
+    BuffCI.usage                 = Usage;
+    BuffCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+    BuffCI.queueFamilyIndexCount = 0;
+    BuffCI.pQueueFamilyIndices   = nullptr;
+    pNewPage->Buffer = LogicalDevice.CreateBuffer(BuffCI, "Suballocated buffer page");
+
+    VkMemoryRequirements MemReqs = LogicalDevice.GetBufferMemoryRequirements(pNewPage->Buffer);
+    VERIFY(IsPowerOfTwo(MemReqs.alignment), "Alignment is not power of 2!");
+    pNewPage->Memory = m_DeviceVkImpl.AllocateMemory(MemReqs, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (pNewPage->Memory.Page == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Failed to allocate memory for a suballocated buffer page");
+        return Allocation;
+    }
+
+    auto AlignedOffset = Align(VkDeviceSize{pNewPage->Memory.UnalignedOffset}, MemReqs.alignment);
+    VERIFY(pNewPage->Memory.Size >= MemReqs.size + (AlignedOffset - pNewPage->Memory.UnalignedOffset), "Size of memory allocation is too small");
+    auto err = LogicalDevice.BindBufferMemory(pNewPage->Buffer, pNewPage->Memory.Page->GetVkMemory(), AlignedOffset);
+    if (err != VK_SUCCESS)
+    {
+        LOG_ERROR_MESSAGE("Failed to bind memory of a suballocated buffer page");
+        return Allocation;
+    }
+
+    m_Pages.emplace_back(std::move(pNewPage));
+    m_PeakPageCount = std::max(m_PeakPageCount, m_Pages.size());
+
+    auto Allocated = AllocateFromPage(*m_Pages.back());
+    VERIFY(Allocated, "Allocation from a new page must never fail"); (void)Allocated;
+    return Allocation;
+}
+
+void BufferSuballocatorVk::ReleaseRegion(Page* pPage, VkDeviceSize Offset, VkDeviceSize Size)
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    pPage->AllocMgr.Free(static_cast<VariableSizeAllocationsManager::OffsetType>(Offset), static_cast<VariableSizeAllocationsManager::OffsetType>(Size));
+    VERIFY_EXPR(m_UsedSize >= Size);
+    m_UsedSize -= Size;
+
+    if (pPage->AllocMgr.IsEmpty())
+    {
+        // The region is released when the GPU no longer uses it, so no command buffer can
+        // reference the page, and its buffer and memory can be destroyed immediately.
+        // One empty page of every usage is kept to avoid recreating it when a single 
+        // buffer is repeatedly created and released.
+        auto PageIt = m_Pages.end();
+        bool HasOtherEmptyPage = false;
+        for (auto it = m_Pages.begin(); it != m_Pages.end(); ++it)
+        {
+            if (it->get() == pPage)
+                PageIt = it;
+            else if ((*it)->Usage == pPage->Usage && (*it)->AllocMgr.IsEmpty())
+                HasOtherEmptyPage = true;
+        }
+        VERIFY_EXPR(PageIt != m_Pages.end());
+        if (HasOtherEmptyPage)
+            m_Pages.erase(PageIt);
+    }
+}
+
+void BufferSuballocatorVk::Free(BufferSuballocationVk&& Allocation, Uint64 CmdQueueMask)
+{
+    class RegionReleaser
+    {
+    public:
+        RegionReleaser(BufferSuballocatorVk& _Suballocator,
+                       Page*                 _pPage,
+                       VkDeviceSize          _Offset,
+                       VkDeviceSize          _Size) noexcept : 
+            Suballocator(&_Suballocator),
+            pPage       (_pPage        ),
+            Offset      (_Offset       ),
+            Size        (_Size         )
+        {}
+
+        RegionReleaser             (const RegionReleaser&) = delete;
+        RegionReleaser& operator = (const RegionReleaser&) = delete;
+        RegionReleaser& operator = (      RegionReleaser&&)= delete;
+
+        RegionReleaser(RegionReleaser&& rhs)noexcept : 
+            Suballocator(rhs.Suballocator),
+            pPage       (rhs.pPage       ),
+            Offset      (rhs.Offset      ),
+            Size        (rhs.Size        )
+        {
+            rhs.Suballocator = nullptr;
+        }
+
+        ~RegionReleaser()
+        {
+            if (Suballocator != nullptr)
+            {
+                Suballocator->ReleaseRegion(pPage, Offset, Size);
+            }
+        }
+
+    private:
+        BufferSuballocatorVk* Suballocator;
+        Page*                 pPage;
+        VkDeviceSize          Offset;
+        VkDeviceSize          Size;
+    };
+
+    VERIFY_EXPR(Allocation.IsValid() && Allocation.pPage != nullptr);
+    m_DeviceVkImpl.SafeReleaseDeviceObject(RegionReleaser{*this, static_cast<Page*>(Allocation.pPage), Allocation.Offset, Allocation.Size}, CmdQueueMask);
+    Allocation = BufferSuballocationVk{};
+}
+
+}
@@ -47,8 +47,48 @@ BufferViewVkImpl::BufferViewVkImpl( IReferenceCounters*                  pRefCou
 {
 }
 
+void BufferViewVkImpl::AllocateBindlessIndex(BindlessResourceHeapVk& BindlessHeap)
+{
+    VERIFY(m_BindlessIndex == InvalidBindlessIndexVk, "Bindless index has already been allocated");
+    const auto* pBufferVk = GetBufferVk();
+    const auto& BuffDesc  = pBufferVk->GetDesc();
+    if (BuffDesc.Usage == USAGE_DYNAMIC)
+    {
+        // Dynamic buffers are suballocated from the dynamic heap every time they are mapped, 
+        // so there is no stable memory location that a descriptor could reference
+        return;
+    }
+
+    if (BuffDesc.Mode == BUFFER_MODE_FORMATTED)
+    {
+        VERIFY_EXPR(m_BuffView != VK_NULL_HANDLE);
+        m_BindlessBinding = m_Desc.ViewType == BUFFER_VIEW_UNORDERED_ACCESS ? BINDLESS_BINDING_VK_STORAGE_TEXEL_BUFFERS : BINDLESS_BINDING_VK_UNIFORM_TEXEL_BUFFERS;
+        m_BindlessIndex = BindlessHeap.AllocateTexelBufferDescriptor(m_BindlessBinding, m_BuffView);
+    }
+    else
+    {
+        // Structured and raw buffers are accessed as storage buffers
+        const auto& Limits = m_pDevice->GetPhysicalDevice().GetProperties().limits;
+        if ((m_Desc.ByteOffset % Limits.minStorageBufferOffsetAlignment) != 0)
+        {
+            LOG_WARNING_MESSAGE("Offset (", m_Desc.ByteOffset, ") of buffer view '", m_Desc.Name, "' is not a multiple of minStorageBufferOffsetAlignment (",
+                                Limits.minStorageBufferOffsetAlignment, "). The view will not be added to the bindless resource heap.");
+            return;
+        }
+        m_BindlessBinding = BINDLESS_BINDING_VK_STORAGE_BUFFERS;
+        m_BindlessIndex = BindlessHeap.AllocateStorageBufferDescriptor(pBufferVk->GetVkBuffer(), m_Desc.ByteOffset, m_Desc.ByteWidth);
+    }
+}
+
 BufferViewVkImpl::~BufferViewVkImpl()
 {
+    if (m_BindlessIndex != InvalidBindlessIndexVk)
+    {
+        auto* pBindlessHeap = m_pDevice->GetBindlessResourceHeap();
+        VERIFY_EXPR(pBindlessHeap != nullptr);
+        pBindlessHeap->FreeDescriptor(m_BindlessBinding, m_BindlessIndex, m_pBuffer->GetDesc().CommandQueueMask);
+    }
+
     m_pDevice->SafeReleaseDeviceObject(std::move(m_BuffView), m_pBuffer->GetDesc().CommandQueueMask);
 }
 
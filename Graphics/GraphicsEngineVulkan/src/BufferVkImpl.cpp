@@ -173,24 +173,40 @@ BufferVkImpl :: BufferVkImpl(IReferenceCounters*        pRefCounters,
         VkBuffCI.pQueueFamilyIndices = nullptr; // list of queue families that will access this buffer 
                                                 // (ignored if sharingMode is not VK_SHARING_MODE_CONCURRENT).
 
-        m_VulkanBuffer = LogicalDevice.CreateBuffer(VkBuffCI, m_Desc.Name);
+        // Small static and default vertex and index buffers may share a VkBuffer with other buffers
+        auto* pSuballocator = pRenderDeviceVk->GetBufferSuballocator();
+        if (pSuballocator != nullptr &&
+            (m_Desc.Usage == USAGE_STATIC || m_Desc.Usage == USAGE_DEFAULT) &&
+            (m_Desc.BindFlags & ~(BIND_VERTEX_BUFFER | BIND_INDEX_BUFFER)) == 0 &&
+            pSuballocator->IsSuballocationAllowed(VkBuffCI.size))
+        {
+            m_Suballocation = pSuballocator->Allocate(VkBuffCI.usage, VkBuffCI.size);
+        }
+
+        VkResult err = VK_SUCCESS;
+        if (!m_Suballocation.IsValid())
+        {
+            m_VulkanBuffer = LogicalDevice.CreateBuffer(VkBuffCI, m_Desc.Name);
 
-        VkMemoryRequirements MemReqs = LogicalDevice.GetBufferMemoryRequirements(m_VulkanBuffer);
+            VkMemoryRequirements MemReqs = LogicalDevice.GetBufferMemoryRequirements(m_VulkanBuffer);
 
-        VkMemoryPropertyFlags BufferMemoryFlags = 0;
-        if (m_Desc.Usage == USAGE_STAGING)
-            BufferMemoryFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-        else
-            BufferMemoryFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+            VkMemoryPropertyFlags BufferMemoryFlags = 0;
+            if (m_Desc.Usage == USAGE_STAGING)
+                BufferMemoryFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+            else
+                BufferMemoryFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
-        VERIFY( IsPowerOfTwo(MemReqs.alignment), "Alignment is not power of 2!");
-        m_MemoryAllocation = pRenderDeviceVk->AllocateMemory(MemReqs, BufferMemoryFlags);
+            VERIFY( IsPowerOfTwo(MemReqs.alignment), "Alignment is not power of 2!");
+            m_MemoryAllocation = pRenderDeviceVk->AllocateMemory(MemReqs, BufferMemoryFlags);
 
-        auto AlignedOffset = Align(VkDeviceSize{m_MemoryAllocation.UnalignedOffset}, MemReqs.alignment);
-        VERIFY(m_MemoryAllocation.Size >= MemReqs.size + (AlignedOffset - m_MemoryAllocation.UnalignedOffset), "Size of memory allocation is too small");
-        auto Memory = m_MemoryAllocation.Page->GetVkMemory();
-        auto err = LogicalDevice.BindBufferMemory(m_VulkanBuffer, Memory, AlignedOffset);
-        CHECK_VK_ERROR_AND_THROW(err, "Failed to bind buffer memory");
+            auto AlignedOffset = Align(VkDeviceSize{m_MemoryAllocation.UnalignedOffset}, MemReqs.alignment);
+            VERIFY(m_MemoryAllocation.Size >= MemReqs.size + (AlignedOffset - m_MemoryAllocation.UnalignedOffset), "Size of memory allocation is too small");
+            auto Memory = m_MemoryAllocation.Page->GetVkMemory();
+            err = LogicalDevice.BindBufferMemory(m_VulkanBuffer, Memory, AlignedOffset);
+            CHECK_VK_ERROR_AND_THROW(err, "Failed to bind buffer memory");
+        }
+        const VkBuffer     vkDstBuffer = GetVkBuffer();
+        const VkDeviceSize DstOffset   = m_Suballocation.Offset;
 
         bool bInitializeBuffer = (pBuffData != nullptr && pBuffData->pData != nullptr && pBuffData->DataSize > 0);
         RESOURCE_STATE InitialState = RESOURCE_STATE_UNDEFINED;
@@ -232,15 +248,15 @@ BufferVkImpl :: BufferVkImpl(IReferenceCounters*        pRefCounters,
             InitialState = RESOURCE_STATE_COPY_DEST;
             VkAccessFlags AccessFlags = ResourceStateFlagsToVkAccessFlags(InitialState);
             VERIFY_EXPR(AccessFlags == VK_ACCESS_TRANSFER_WRITE_BIT);
-            VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, m_VulkanBuffer, 0, AccessFlags, EnabledGraphicsShaderStages);
+            VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, vkDstBuffer, 0, AccessFlags, EnabledGraphicsShaderStages);
 
             // Copy commands MUST be recorded outside of a render pass instance. This is OK here
             // as copy will be the only command in the cmd buffer
             VkBufferCopy BuffCopy = {};
             BuffCopy.srcOffset = 0;
-            BuffCopy.dstOffset = 0;
+            BuffCopy.dstOffset = DstOffset;
             BuffCopy.size = VkBuffCI.size;
-            vkCmdCopyBuffer(vkCmdBuff, StagingBuffer, m_VulkanBuffer, 1, &BuffCopy);
+            vkCmdCopyBuffer(vkCmdBuff, StagingBuffer, vkDstBuffer, 1, &BuffCopy);
 
             Uint32 QueueIndex = 0;
 	        pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(QueueIndex, vkCmdBuff, std::move(CmdPool));
@@ -301,6 +317,8 @@ BufferVkImpl :: ~BufferVkImpl()
         m_pDevice->SafeReleaseDeviceObject(std::move(m_VulkanBuffer), m_Desc.CommandQueueMask);
     if(m_MemoryAllocation.Page != nullptr)
         m_pDevice->SafeReleaseDeviceObject(std::move(m_MemoryAllocation), m_Desc.CommandQueueMask);
+    if(m_Suballocation.IsValid())
+        m_pDevice->GetBufferSuballocator()->Free(std::move(m_Suballocation), m_Desc.CommandQueueMask);
 }
 
 IMPLEMENT_QUERY_INTERFACE( BufferVkImpl, IID_BufferVk, TBufferBase )
@@ -323,8 +341,11 @@ void BufferVkImpl::CreateViewInternal( const BufferViewDesc& OrigViewDesc, IBuff
         if( ViewDesc.ViewType == BUFFER_VIEW_UNORDERED_ACCESS || ViewDesc.ViewType == BUFFER_VIEW_SHADER_RESOURCE )
         {
             auto View = CreateView(ViewDesc);
-            *ppView = NEW_RC_OBJ(BuffViewAllocator, "BufferViewVkImpl instance", BufferViewVkImpl, bIsDefaultView ? this : nullptr)
-                                (GetDevice(), ViewDesc, this, std::move(View), bIsDefaultView );
+            auto* pViewVk = NEW_RC_OBJ(BuffViewAllocator, "BufferViewVkImpl instance", BufferViewVkImpl, bIsDefaultView ? this : nullptr)
+                                      (GetDevice(), ViewDesc, this, std::move(View), bIsDefaultView );
+            if (auto* pBindlessHeap = m_pDevice->GetBindlessResourceHeap())
+                pViewVk->AllocateBindlessIndex(*pBindlessHeap);
+            *ppView = pViewVk;
         }
 
         if( !bIsDefaultView && *ppView )
@@ -372,6 +393,8 @@ VkBuffer BufferVkImpl::GetVkBuffer()const
 {
     if (m_VulkanBuffer != VK_NULL_HANDLE)
         return m_VulkanBuffer;
+    else if (m_Suballocation.IsValid())
+        return m_Suballocation.vkBuffer;
     else
     {
         VERIFY(m_Desc.Usage == USAGE_DYNAMIC, "Dynamic buffer expected");
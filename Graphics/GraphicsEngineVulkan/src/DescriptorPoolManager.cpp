@@ -23,6 +23,7 @@
 
 #include "pch.h"
 #include "DescriptorPoolManager.h"
+#include "CPUProfiler.h"
 #include "RenderDeviceVkImpl.h"
 
 namespace Diligent
@@ -41,6 +42,7 @@ void DescriptorSetAllocation::Release()
 
 VulkanUtilities::DescriptorPoolWrapper DescriptorPoolManager::CreateDescriptorPool(const char* DebugName)const
 {
+    CPU_PROFILE_SCOPE("DescriptorPoolManager::CreateDescriptorPool");
     VkDescriptorPoolCreateInfo PoolCI = {};
     PoolCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     PoolCI.pNext = nullptr;
@@ -257,8 +259,33 @@ VkDescriptorSet DynamicDescriptorSetAllocator::Allocate(VkDescriptorSetLayout Se
     return set;
 }
 
+VkDescriptorSet DynamicDescriptorSetAllocator::FindCachedSet(VkDescriptorSetLayout SetLayout, size_t Hash, const std::vector<UniqueIdentifier>& ResourceIds)
+{
+    ++m_CacheLookupCount;
+    auto Range = m_SetCache.equal_range(Hash);
+    for (auto it = Range.first; it != Range.second; ++it)
+    {
+        const auto& Entry = it->second;
+        if (Entry.SetLayout == SetLayout && Entry.ResourceIds == ResourceIds)
+        {
+            ++m_CacheHitCount;
+            return Entry.Set;
+        }
+    }
+    return VK_NULL_HANDLE;
+}
+
+void DynamicDescriptorSetAllocator::CacheSet(VkDescriptorSetLayout SetLayout, size_t Hash, const std::vector<UniqueIdentifier>& ResourceIds, VkDescriptorSet Set)
+{
+    VERIFY_EXPR(Set != VK_NULL_HANDLE);
+    m_SetCache.emplace(Hash, CachedSet{SetLayout, ResourceIds, Set});
+}
+
 void DynamicDescriptorSetAllocator::ReleasePools(Uint64 QueueMask)
 {
+    // Cached sets are freed when their pools are reset
+    m_SetCache.clear();
+
     for(auto& Pool : m_AllocatedPools)
     {
         m_GlobalPoolMgr.DisposePool(std::move(Pool), QueueMask);
@@ -270,7 +297,7 @@ void DynamicDescriptorSetAllocator::ReleasePools(Uint64 QueueMask)
 DynamicDescriptorSetAllocator::~DynamicDescriptorSetAllocator()
 {
     DEV_CHECK_ERR(m_AllocatedPools.empty(), "All allocated pools must be returned to the parent descriptor pool manager");
-    LOG_INFO_MESSAGE(m_Name, " peak descriptor pool count: ", m_PeakPoolCount);
+    LOG_INFO_MESSAGE(m_Name, " peak descriptor pool count: ", m_PeakPoolCount, ", set cache hits: ", m_CacheHitCount, " out of ", m_CacheLookupCount, " lookups");
 }
 
 }
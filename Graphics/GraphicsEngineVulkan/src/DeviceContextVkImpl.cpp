@@ -25,6 +25,7 @@
 #include <sstream>
 #include "RenderDeviceVkImpl.h"
 #include "DeviceContextVkImpl.h"
+#include "CPUProfiler.h"
 #include "SwapChainVk.h"
 #include "PipelineStateVkImpl.h"
 #include "TextureVkImpl.h"
@@ -63,7 +64,12 @@ namespace Diligent
             bIsDeferred ? std::numeric_limits<decltype(m_NumCommandsToFlush)>::max() : EngineCI.NumCommandsToFlushCmdBuffer,
             bIsDeferred
         },
-        m_CommandBuffer { pDeviceVkImpl->GetLogicalDevice().GetEnabledGraphicsShaderStages() },
+        m_CommandBuffer
+        {
+            pDeviceVkImpl->GetLogicalDevice().GetEnabledGraphicsShaderStages(),
+            pDeviceVkImpl->GetLogicalDevice().GetCmdDrawIndirectCountFunc(),
+            pDeviceVkImpl->GetLogicalDevice().GetCmdDrawIndexedIndirectCountFunc()
+        },
         m_CmdListAllocator { GetRawAllocator(), sizeof(CommandListVkImpl), 64 },
         // Command pools must be thread safe because command buffers are returned into pools by release queues
         // potentially running in another thread
@@ -153,16 +159,18 @@ namespace Diligent
 
     IMPLEMENT_QUERY_INTERFACE( DeviceContextVkImpl, IID_DeviceContextVk, TDeviceContextBase )
 
-    void DeviceContextVkImpl::DisposeVkCmdBuffer(Uint32 CmdQueue, VkCommandBuffer vkCmdBuff, Uint64 FenceValue)
+    void DeviceContextVkImpl::DisposeVkCmdBuffer(Uint32 CmdQueue, VkCommandBuffer vkCmdBuff, Uint64 FenceValue, bool IsSecondary)
     {
         VERIFY_EXPR(vkCmdBuff != VK_NULL_HANDLE);
         class CmdBufferDeleter
         {
         public:
             CmdBufferDeleter(VkCommandBuffer                           _vkCmdBuff, 
-                             VulkanUtilities::VulkanCommandBufferPool& _Pool) noexcept :
-                vkCmdBuff (_vkCmdBuff),
-                Pool      (&_Pool)
+                             VulkanUtilities::VulkanCommandBufferPool& _Pool,
+                             bool                                      _IsSecondary) noexcept :
+                vkCmdBuff   (_vkCmdBuff),
+                Pool        (&_Pool),
+                IsSecondary (_IsSecondary)
             {
                 VERIFY_EXPR(vkCmdBuff != VK_NULL_HANDLE);
             }
@@ -172,8 +180,9 @@ namespace Diligent
             CmdBufferDeleter& operator = (      CmdBufferDeleter&&) = delete;
 
             CmdBufferDeleter(CmdBufferDeleter&& rhs) noexcept : 
-                vkCmdBuff (rhs.vkCmdBuff),
-                Pool      (rhs.Pool)
+                vkCmdBuff   (rhs.vkCmdBuff),
+                Pool        (rhs.Pool),
+                IsSecondary (rhs.IsSecondary)
             {
                 rhs.vkCmdBuff = VK_NULL_HANDLE;
                 rhs.Pool      = nullptr;
@@ -183,17 +192,18 @@ namespace Diligent
             {
                 if(Pool != nullptr)
                 {
-                    Pool->FreeCommandBuffer(std::move(vkCmdBuff));
+                    Pool->FreeCommandBuffer(std::move(vkCmdBuff), IsSecondary);
                 }
             }
 
         private:
             VkCommandBuffer                           vkCmdBuff;
             VulkanUtilities::VulkanCommandBufferPool* Pool;
+            bool                                      IsSecondary;
         };
 
         auto& ReleaseQueue = m_pDevice.RawPtr<RenderDeviceVkImpl>()->GetReleaseQueue(CmdQueue);
-        ReleaseQueue.DiscardResource(CmdBufferDeleter{vkCmdBuff, m_CmdPool}, FenceValue);
+        ReleaseQueue.DiscardResource(CmdBufferDeleter{vkCmdBuff, m_CmdPool, IsSecondary}, FenceValue);
     }
 
     inline void DeviceContextVkImpl::DisposeCurrentCmdBuffer(Uint32 CmdQueue, Uint64 FenceValue)
@@ -210,7 +220,10 @@ namespace Diligent
 
     void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
     {
-        auto* pPipelineStateVk = ValidatedCast<PipelineStateVkImpl>(pPipelineState);
+        auto* pPipelineStateVk = SelectReadyPipelineState(ValidatedCast<PipelineStateVkImpl>(pPipelineState));
+        if (pPipelineStateVk == nullptr)
+            return; // The pipeline is still being compiled and there is no fallback: skip draw commands
+
         if (PipelineStateVkImpl::IsSameObject(m_pPipelineState, pPipelineStateVk))
             return;
 
@@ -255,6 +268,8 @@ namespace Diligent
         {
             auto vkPipeline = pPipelineStateVk->GetVkPipeline();
             m_CommandBuffer.BindGraphicsPipeline(vkPipeline);
+            if (!PSODesc.GraphicsPipeline.RasterizerDesc.ScissorEnable)
+                m_CommandBuffer.InvalidateScissorRects();
 
             if (CommitStates)
             {
@@ -271,6 +286,10 @@ namespace Diligent
         }
 
         m_DescrSetBindInfo.Reset();
+
+        // Pipelines without their own descriptor sets never commit shader resources, 
+        // so the bindless resource heap is bound right away
+        pPipelineStateVk->GetPipelineLayout().BindBindlessResourceHeap(this, PSODesc.IsComputePipeline);
     }
 
     void DeviceContextVkImpl::TransitionShaderResources(IPipelineState *pPipelineState, IShaderResourceBinding *pShaderResourceBinding)
@@ -283,6 +302,10 @@ namespace Diligent
 
     void DeviceContextVkImpl::CommitShaderResources(IShaderResourceBinding *pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
     {
+        CPU_PROFILE_SCOPE("DeviceContextVkImpl::CommitShaderResources");
+        if (m_bPipelineStateNotReady)
+            return;
+
         if (!DeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0 /*Dummy*/))
             return;
 
@@ -339,8 +362,9 @@ namespace Diligent
             else
             {
                 // We can't bind null vertex buffer in Vulkan and have to use a dummy one
+                // The dummy buffer may be suballocated from a shared buffer as any other small vertex buffer
                 vkVertexBuffers[slot] = m_DummyVB->GetVkBuffer();
-                Offsets[slot] = 0;
+                Offsets[slot] = m_DummyVB->GetDynamicOffset(m_ContextId, this);
             }
         }
 
@@ -352,6 +376,24 @@ namespace Diligent
         m_State.CommittedVBsUpToDate = !DynamicBufferPresent;
     }
 
+    void DeviceContextVkImpl::CommitVkIndexBuffer(VALUE_TYPE IndexType)
+    {
+        VERIFY(m_pIndexBuffer != nullptr, "Index buffer is not set up for indexed draw command");
+        DEV_CHECK_ERR(IndexType == VT_UINT16 || IndexType == VT_UINT32, "Unsupported index format. Only R16_UINT and R32_UINT are allowed.");
+
+        bool IsDynamic = m_pIndexBuffer->GetDesc().Usage == USAGE_DYNAMIC;
+#ifdef DEVELOPMENT
+        if (IsDynamic)
+            m_pIndexBuffer->DvpVerifyDynamicAllocation(this);
+#endif
+        VkIndexType vkIndexType = IndexType == VT_UINT16 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+        m_CommandBuffer.BindIndexBuffer(m_pIndexBuffer->GetVkBuffer(), m_IndexDataStartOffset + m_pIndexBuffer->GetDynamicOffset(m_ContextId, this), vkIndexType);
+
+        // GPU offset for a dynamic index buffer can change every time a draw command is invoked
+        m_State.CommittedIBFormat   = IndexType;
+        m_State.CommittedIBUpToDate = !IsDynamic;
+    }
+
     void DeviceContextVkImpl::DvpLogRenderPass_PSOMismatch()
     {
         std::stringstream ss;
@@ -393,20 +435,17 @@ namespace Diligent
         LOG_ERROR_MESSAGE(ss.str());
     }
 
-    void DeviceContextVkImpl::Draw( DrawAttribs& drawAttribs )
+    void DeviceContextVkImpl::PrepareForDraw(DRAW_FLAGS Flags, bool IsIndexed, VALUE_TYPE IndexType)
     {
 #ifdef DEVELOPMENT
-        if ((drawAttribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) != 0 && !DvpVerifyDrawArguments(drawAttribs))
-            return;
-
-        if ((drawAttribs.Flags & DRAW_FLAG_VERIFY_RENDER_TARGETS) != 0)
+        if ((Flags & DRAW_FLAG_VERIFY_RENDER_TARGETS) != 0)
             DvpVerifyRenderTargets();
 #endif
 
         EnsureVkCmdBuffer();
 
-        const bool VerifyStates = (drawAttribs.Flags & DRAW_FLAG_VERIFY_STATES) != 0;
-        if ( drawAttribs.IsIndexed )
+        const bool VerifyStates = (Flags & DRAW_FLAG_VERIFY_STATES) != 0;
+        if ( IsIndexed )
         {
 #ifdef DEVELOPMENT
             if (VerifyStates)
@@ -414,9 +453,10 @@ namespace Diligent
                 DvpVerifyBufferState(*m_pIndexBuffer, RESOURCE_STATE_INDEX_BUFFER, "Indexed draw call (DeviceContextVkImpl::Draw)");
             }
 #endif
-            DEV_CHECK_ERR(drawAttribs.IndexType == VT_UINT16 || drawAttribs.IndexType == VT_UINT32, "Unsupported index format. Only R16_UINT and R32_UINT are allowed.");
-            VkIndexType vkIndexType = drawAttribs.IndexType == VT_UINT16 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
-            m_CommandBuffer.BindIndexBuffer(m_pIndexBuffer->GetVkBuffer(), m_IndexDataStartOffset + m_pIndexBuffer->GetDynamicOffset(m_ContextId, this), vkIndexType);
+            if (m_State.CommittedIBFormat != IndexType)
+                m_State.CommittedIBUpToDate = false;
+            if (!m_State.CommittedIBUpToDate)
+                CommitVkIndexBuffer(IndexType);
         }
 
         if (!m_State.CommittedVBsUpToDate && m_pPipelineState->GetNumBufferSlotsUsed() > 0)
@@ -448,30 +488,47 @@ namespace Diligent
 #endif
 #endif
 
-        auto* pIndirectDrawAttribsVk = ValidatedCast<BufferVkImpl>(drawAttribs.pIndirectDrawAttribs);
-        if (pIndirectDrawAttribsVk != nullptr)
-        {
-            // Buffer memory barries must be executed outside of render pass
-            TransitionOrVerifyBufferState(*pIndirectDrawAttribsVk, drawAttribs.IndirectAttribsBufferStateTransitionMode, RESOURCE_STATE_INDIRECT_ARGUMENT,
-                                          VK_ACCESS_INDIRECT_COMMAND_READ_BIT, "Indirect draw (DeviceContextVkImpl::Draw)");
-        }
-
 #ifdef DEVELOPMENT
         if (m_pPipelineState->GetVkRenderPass() != m_RenderPass)
         {
             DvpLogRenderPass_PSOMismatch();
         }
 #endif
+    }
 
-        CommitRenderPassAndFramebuffer(VerifyStates);
+    void DeviceContextVkImpl::PrepareIndirectDrawBuffer(BufferVkImpl& Buffer, RESOURCE_STATE_TRANSITION_MODE TransitionMode, const char* OperationName)
+    {
+        // Buffer memory barries must be executed outside of render pass
+        TransitionOrVerifyBufferState(Buffer, TransitionMode, RESOURCE_STATE_INDIRECT_ARGUMENT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT, OperationName);
+#ifdef DEVELOPMENT
+        if (Buffer.GetDesc().Usage == USAGE_DYNAMIC)
+            Buffer.DvpVerifyDynamicAllocation(this);
+#endif
+    }
+
+    void DeviceContextVkImpl::Draw( DrawAttribs& drawAttribs )
+    {
+        CPU_PROFILE_SCOPE("DeviceContextVkImpl::Draw");
+        if (m_bPipelineStateNotReady)
+            return;
 
-        if (pIndirectDrawAttribsVk != nullptr)
-        {
 #ifdef DEVELOPMENT
-            if (pIndirectDrawAttribsVk->GetDesc().Usage == USAGE_DYNAMIC)
-                pIndirectDrawAttribsVk->DvpVerifyDynamicAllocation(this);
+        if ((drawAttribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) != 0 && !DvpVerifyDrawArguments(drawAttribs))
+            return;
 #endif
 
+        PrepareForDraw(drawAttribs.Flags, drawAttribs.IsIndexed, drawAttribs.IndexType);
+
+        auto* pIndirectDrawAttribsVk = ValidatedCast<BufferVkImpl>(drawAttribs.pIndirectDrawAttribs);
+        if (pIndirectDrawAttribsVk != nullptr)
+        {
+            PrepareIndirectDrawBuffer(*pIndirectDrawAttribsVk, drawAttribs.IndirectAttribsBufferStateTransitionMode, "Indirect draw (DeviceContextVkImpl::Draw)");
+        }
+
+        CommitRenderPassAndFramebuffer((drawAttribs.Flags & DRAW_FLAG_VERIFY_STATES) != 0);
+
+        if (pIndirectDrawAttribsVk != nullptr)
+        {
             if ( drawAttribs.IsIndexed )
                 m_CommandBuffer.DrawIndexedIndirect(pIndirectDrawAttribsVk->GetVkBuffer(), pIndirectDrawAttribsVk->GetDynamicOffset(m_ContextId, this) + drawAttribs.IndirectDrawArgsOffset, 1, 0);
             else
@@ -488,8 +545,102 @@ namespace Diligent
         ++m_State.NumCommands;
     }
 
+    void DeviceContextVkImpl::MultiDraw(const MultiDrawAttribs& Attribs)
+    {
+        CPU_PROFILE_SCOPE("DeviceContextVkImpl::MultiDraw");
+        if (m_bPipelineStateNotReady)
+            return;
+
+#ifdef DEVELOPMENT
+        if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) != 0 && !DvpVerifyMultiDrawArguments(Attribs))
+            return;
+#endif
+        if (Attribs.DrawCount == 0)
+            return;
+
+        PrepareForDraw(Attribs.Flags, Attribs.IsIndexed, Attribs.IndexType);
+        CommitRenderPassAndFramebuffer((Attribs.Flags & DRAW_FLAG_VERIFY_STATES) != 0);
+
+        // Vulkan 1.0 has no direct multi-draw command, but all states have already been 
+        // committed, so every draw only records the draw command itself
+        for (Uint32 i=0; i < Attribs.DrawCount; ++i)
+        {
+            const auto& Item = Attribs.pDrawItems[i];
+            if (Attribs.IsIndexed)
+                m_CommandBuffer.DrawIndexed(Item.NumIndices, Item.NumInstances, Item.FirstIndexLocation, Item.BaseVertex, Item.FirstInstanceLocation);
+            else
+                m_CommandBuffer.Draw(Item.NumVertices, Item.NumInstances, Item.StartVertexLocation, Item.FirstInstanceLocation);
+        }
+
+        m_State.NumCommands += Attribs.DrawCount;
+    }
+
+    void DeviceContextVkImpl::MultiDrawIndirect(const MultiDrawIndirectAttribs& Attribs)
+    {
+        CPU_PROFILE_SCOPE("DeviceContextVkImpl::MultiDrawIndirect");
+        if (m_bPipelineStateNotReady)
+            return;
+
+#ifdef DEVELOPMENT
+        if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) != 0 && !DvpVerifyMultiDrawIndirectArguments(Attribs))
+            return;
+#endif
+        if (Attribs.DrawCount == 0)
+            return;
+
+        PrepareForDraw(Attribs.Flags, Attribs.IsIndexed, Attribs.IndexType);
+
+        auto* pAttribsBufferVk = ValidatedCast<BufferVkImpl>(Attribs.pAttribsBuffer);
+        auto* pCountBufferVk   = ValidatedCast<BufferVkImpl>(Attribs.pCountBuffer);
+        PrepareIndirectDrawBuffer(*pAttribsBufferVk, Attribs.AttribsBufferStateTransitionMode, "Multi-draw indirect (DeviceContextVkImpl::MultiDrawIndirect)");
+        if (pCountBufferVk != nullptr)
+            PrepareIndirectDrawBuffer(*pCountBufferVk, Attribs.CountBufferStateTransitionMode, "Reading indirect draw count (DeviceContextVkImpl::MultiDrawIndirect)");
+
+        CommitRenderPassAndFramebuffer((Attribs.Flags & DRAW_FLAG_VERIFY_STATES) != 0);
+
+        const Uint32 Stride = Attribs.DrawArgsStride != 0 ? 
+            Attribs.DrawArgsStride : 
+            static_cast<Uint32>(Attribs.IsIndexed ? sizeof(VkDrawIndexedIndirectCommand) : sizeof(VkDrawIndirectCommand));
+        const VkBuffer     vkAttribsBuffer = pAttribsBufferVk->GetVkBuffer();
+        const VkDeviceSize ArgsOffset      = pAttribsBufferVk->GetDynamicOffset(m_ContextId, this) + Attribs.DrawArgsOffset;
+        if (pCountBufferVk != nullptr)
+        {
+            DEV_CHECK_ERR(m_pDevice.RawPtr<RenderDeviceVkImpl>()->GetLogicalDevice().IsDrawIndirectCountSupported(), "Indirect draw count is not supported by this device");
+            const VkBuffer     vkCountBuffer = pCountBufferVk->GetVkBuffer();
+            const VkDeviceSize CountOffset   = pCountBufferVk->GetDynamicOffset(m_ContextId, this) + Attribs.CountBufferOffset;
+            if (Attribs.IsIndexed)
+                m_CommandBuffer.DrawIndexedIndirectCount(vkAttribsBuffer, ArgsOffset, vkCountBuffer, CountOffset, Attribs.DrawCount, Stride);
+            else
+                m_CommandBuffer.DrawIndirectCount(vkAttribsBuffer, ArgsOffset, vkCountBuffer, CountOffset, Attribs.DrawCount, Stride);
+        }
+        else if (m_pDevice.RawPtr<RenderDeviceVkImpl>()->GetLogicalDevice().IsMultiDrawIndirectEnabled())
+        {
+            if (Attribs.IsIndexed)
+                m_CommandBuffer.DrawIndexedIndirect(vkAttribsBuffer, ArgsOffset, Attribs.DrawCount, Stride);
+            else
+                m_CommandBuffer.DrawIndirect(vkAttribsBuffer, ArgsOffset, Attribs.DrawCount, Stride);
+        }
+        else
+        {
+            // If multiDrawIndirect feature is not enabled, drawCount must be 0 or 1
+            for (Uint32 i=0; i < Attribs.DrawCount; ++i)
+            {
+                if (Attribs.IsIndexed)
+                    m_CommandBuffer.DrawIndexedIndirect(vkAttribsBuffer, ArgsOffset + VkDeviceSize{Stride} * i, 1, 0);
+                else
+                    m_CommandBuffer.DrawIndirect(vkAttribsBuffer, ArgsOffset + VkDeviceSize{Stride} * i, 1, 0);
+            }
+        }
+
+        m_State.NumCommands += Attribs.DrawCount;
+    }
+
     void DeviceContextVkImpl::DispatchCompute( const DispatchComputeAttribs& DispatchAttrs )
     {
+        CPU_PROFILE_SCOPE("DeviceContextVkImpl::DispatchCompute");
+        if (m_bPipelineStateNotReady)
+            return;
+
 #ifdef DEVELOPMENT
         if (!DvpVerifyDispatchArguments(DispatchAttrs))
             return;
@@ -760,6 +911,8 @@ namespace Diligent
 
     void DeviceContextVkImpl::FinishFrame()
     {
+        if (!m_bIsDeferred)
+            CPU_PROFILE_FRAME_BOUNDARY();
 #ifdef _DEBUG
         for(const auto& MappedBuffIt : m_DbgMappedBuffers)
         {
@@ -831,7 +984,8 @@ namespace Diligent
         auto vkCmdBuff = m_CommandBuffer.GetVkCmdBuffer();
         if (vkCmdBuff != VK_NULL_HANDLE )
         {
-            if (m_State.NumCommands != 0)
+            // A command buffer that only contains state transitions must be submitted as well
+            if (m_State.NumCommands != 0 || m_CommandBuffer.HasPendingBarriers())
             {
                 if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
                 {
@@ -867,6 +1021,15 @@ namespace Diligent
             DisposeCurrentCmdBuffer(m_CommandQueueId, SubmittedFenceValue);
         }
 
+        // Secondary command buffers executed by the primary buffer can only be 
+        // returned to their pools once the primary buffer has been completed
+        for (auto& SecondaryCmdBuff : m_PendingSecondaryCmdBuffers)
+        {
+            auto* pDeferredCtxVkImpl = SecondaryCmdBuff.second.RawPtr<DeviceContextVkImpl>();
+            pDeferredCtxVkImpl->DisposeVkCmdBuffer(m_CommandQueueId, SecondaryCmdBuff.first, SubmittedFenceValue, true);
+        }
+        m_PendingSecondaryCmdBuffers.clear();
+
         m_State = ContextState{};
         m_DescrSetBindInfo.Reset();
         m_CommandBuffer.Reset();
@@ -1033,7 +1196,16 @@ namespace Diligent
     inline void DeviceContextVkImpl::CommitRenderPassAndFramebuffer(bool VerifyStates)
     {
         const auto& CmdBufferState = m_CommandBuffer.GetState();
-        if (CmdBufferState.Framebuffer != m_Framebuffer)
+        if (CmdBufferState.RenderPassInherited)
+        {
+            // Render pass inherited by the secondary command buffer can't be changed
+            DEV_CHECK_ERR(CmdBufferState.Framebuffer == m_Framebuffer, "Render targets bound to the context do not match the render pass inherited by the secondary command buffer. "
+                          "Render targets must not be changed after BeginSecondaryCommandBuffer() has been called.");
+            return;
+        }
+
+        // Render pass that executes secondary command buffers can't contain inline commands
+        if (CmdBufferState.Framebuffer != m_Framebuffer || CmdBufferState.SubpassContents != VK_SUBPASS_CONTENTS_INLINE)
         {
             if (CmdBufferState.RenderPass != VK_NULL_HANDLE)
                 m_CommandBuffer.EndRenderPass();
@@ -1142,9 +1314,9 @@ namespace Diligent
 
         VkBufferCopy CopyRegion;
         CopyRegion.srcOffset = SrcOffset;
-        CopyRegion.dstOffset = DstOffset;
+        CopyRegion.dstOffset = DstOffset + pBuffVk->GetSuballocationOffset();
         CopyRegion.size = NumBytes;
-        VERIFY(pBuffVk->m_VulkanBuffer != VK_NULL_HANDLE, "Copy destination buffer must not be suballocated");
+        VERIFY(pBuffVk->m_VulkanBuffer != VK_NULL_HANDLE || pBuffVk->IsSuballocated(), "Copy destination buffer must not be dynamic");
         m_CommandBuffer.CopyBuffer(vkSrcBuffer, pBuffVk->GetVkBuffer(), 1, &CopyRegion);
         ++m_State.NumCommands;
     }
@@ -1205,10 +1377,9 @@ namespace Diligent
 
         VkBufferCopy CopyRegion;
         CopyRegion.srcOffset = SrcOffset + pSrcBuffVk->GetDynamicOffset(m_ContextId, this);
-        CopyRegion.dstOffset = DstOffset;
+        CopyRegion.dstOffset = DstOffset + pDstBuffVk->GetSuballocationOffset();
         CopyRegion.size = Size;
-        VERIFY(pDstBuffVk->m_VulkanBuffer != VK_NULL_HANDLE, "Copy destination buffer must not be suballocated");
-        VERIFY_EXPR(pDstBuffVk->GetDynamicOffset(m_ContextId, this) == 0);
+        VERIFY(pDstBuffVk->m_VulkanBuffer != VK_NULL_HANDLE || pDstBuffVk->IsSuballocated(), "Copy destination buffer must not be dynamic");
         m_CommandBuffer.CopyBuffer(pSrcBuffVk->GetVkBuffer(), pDstBuffVk->GetVkBuffer(), 1, &CopyRegion);
         ++m_State.NumCommands;
     }
@@ -1346,7 +1517,6 @@ namespace Diligent
             pSrcBox = &FullMipBox;
         }
         const auto& DstFmtAttribs = GetTextureFormatAttribs(DstTexDesc.Format);
-        const auto& SrcFmtAttribs = GetTextureFormatAttribs(SrcTexDesc.Format);
         if (SrcTexDesc.Usage != USAGE_STAGING && DstTexDesc.Usage != USAGE_STAGING)
         {
             VkImageCopy CopyRegion = {};
@@ -1385,37 +1555,7 @@ namespace Diligent
         }
         else if (SrcTexDesc.Usage == USAGE_STAGING && DstTexDesc.Usage != USAGE_STAGING)
         {
-            DEV_CHECK_ERR((SrcTexDesc.CPUAccessFlags & CPU_ACCESS_WRITE), "Attempting to copy from staging texture that was not created with CPU_ACCESS_WRITE flag");
-            DEV_CHECK_ERR(pSrcTexVk->GetState() == RESOURCE_STATE_COPY_SOURCE, "Source staging texture must permanently be in RESOURCE_STATE_COPY_SOURCE state");
-
-            auto SrcBufferOffset    = GetStagingDataOffset(SrcTexDesc, CopyAttribs.SrcSlice, CopyAttribs.SrcMipLevel);
-            auto SrcMipLevelAttribs = GetMipLevelProperties(SrcTexDesc, CopyAttribs.SrcMipLevel);
-            // address of (x,y,z) = region->bufferOffset + (((z * imageHeight) + y) * rowLength + x) * texelBlockSize; (18.4.1)
-            SrcBufferOffset +=
-                // For compressed-block formats, RowSize is the size of one compressed row.
-                // For non-compressed formats, BlockHeight is 1.
-                (pSrcBox->MinZ * SrcMipLevelAttribs.StorageHeight + pSrcBox->MinY) / SrcFmtAttribs.BlockHeight  * SrcMipLevelAttribs.RowSize + 
-                // For non-compressed formats, BlockWidth is 1.
-                (pSrcBox->MinX / SrcFmtAttribs.BlockWidth) * SrcFmtAttribs.GetElementSize();
-
-            Box DstBox;
-            DstBox.MinX = CopyAttribs.DstX;
-            DstBox.MinY = CopyAttribs.DstY;
-            DstBox.MinZ = CopyAttribs.DstZ;
-            DstBox.MaxX = DstBox.MinX + pSrcBox->MaxX - pSrcBox->MinX;
-            DstBox.MaxY = DstBox.MinY + pSrcBox->MaxY - pSrcBox->MinY;
-            DstBox.MaxZ = DstBox.MinZ + pSrcBox->MaxZ - pSrcBox->MinZ;
-
-            CopyBufferToTexture(
-                pSrcTexVk->GetVkStagingBuffer(),
-                SrcBufferOffset,
-                SrcMipLevelAttribs.StorageWidth,
-                *pDstTexVk,
-                DstBox,
-                CopyAttribs.DstMipLevel,
-                CopyAttribs.DstSlice,
-                CopyAttribs.DstTextureTransitionMode                
-            );
+            CopyStagingTextureToTexture(&CopyAttribs, 1);
         }
         else if (SrcTexDesc.Usage != USAGE_STAGING && DstTexDesc.Usage == USAGE_STAGING)
         {
@@ -1449,6 +1589,37 @@ namespace Diligent
         }
     }
 
+    void DeviceContextVkImpl::MultiCopyTexture(const CopyTextureAttribs* pCopies, Uint32 NumCopies)
+    {
+        Uint32 i = 0;
+        while (i < NumCopies)
+        {
+            const auto& FirstCopy = pCopies[i];
+            if (FirstCopy.pSrcTexture == nullptr || FirstCopy.pDstTexture == nullptr ||
+                FirstCopy.pSrcTexture->GetDesc().Usage != USAGE_STAGING || FirstCopy.pDstTexture->GetDesc().Usage == USAGE_STAGING)
+            {
+                CopyTexture(FirstCopy);
+                ++i;
+                continue;
+            }
+
+            // Find consecutive copies that can be recorded with one command
+            Uint32 NumBatchCopies = 0;
+            while (i + NumBatchCopies < NumCopies)
+            {
+                const auto& Copy = pCopies[i + NumBatchCopies];
+                if (Copy.pSrcTexture != FirstCopy.pSrcTexture || Copy.pDstTexture != FirstCopy.pDstTexture ||
+                    Copy.DstTextureTransitionMode != FirstCopy.DstTextureTransitionMode)
+                    break;
+                TDeviceContextBase::CopyTexture(Copy);
+                ++NumBatchCopies;
+            }
+
+            CopyStagingTextureToTexture(pCopies + i, NumBatchCopies);
+            i += NumBatchCopies;
+        }
+    }
+
     void DeviceContextVkImpl::CopyTextureRegion(TextureVkImpl*                 pSrcTexture,
                                                 RESOURCE_STATE_TRANSITION_MODE SrcTextureTransitionMode,
                                                 TextureVkImpl*                 pDstTexture,
@@ -1678,6 +1849,66 @@ namespace Diligent
             &BuffImgCopy);
     }
 
+    void DeviceContextVkImpl::CopyStagingTextureToTexture(const CopyTextureAttribs* pCopies, Uint32 NumCopies)
+    {
+        VERIFY_EXPR(NumCopies > 0);
+        auto* pSrcTexVk = ValidatedCast<TextureVkImpl>(pCopies[0].pSrcTexture);
+        auto* pDstTexVk = ValidatedCast<TextureVkImpl>(pCopies[0].pDstTexture);
+        const auto& SrcTexDesc    = pSrcTexVk->GetDesc();
+        const auto& DstTexDesc    = pDstTexVk->GetDesc();
+        const auto& SrcFmtAttribs = GetTextureFormatAttribs(SrcTexDesc.Format);
+        DEV_CHECK_ERR((SrcTexDesc.CPUAccessFlags & CPU_ACCESS_WRITE), "Attempting to copy from staging texture that was not created with CPU_ACCESS_WRITE flag");
+        DEV_CHECK_ERR(pSrcTexVk->GetState() == RESOURCE_STATE_COPY_SOURCE, "Source staging texture must permanently be in RESOURCE_STATE_COPY_SOURCE state");
+
+        m_BufferImageCopies.clear();
+        for (Uint32 i=0; i < NumCopies; ++i)
+        {
+            const auto& CopyAttribs = pCopies[i];
+            VERIFY(CopyAttribs.pSrcTexture == pSrcTexVk && CopyAttribs.pDstTexture == pDstTexVk, "All copies must use the same source and destination textures");
+
+            auto SrcMipLevelAttribs = GetMipLevelProperties(SrcTexDesc, CopyAttribs.SrcMipLevel);
+            auto* pSrcBox = CopyAttribs.pSrcBox;
+            Box FullMipBox;
+            if (pSrcBox == nullptr)
+            {
+                FullMipBox.MaxX = SrcMipLevelAttribs.LogicalWidth;
+                FullMipBox.MaxY = SrcMipLevelAttribs.LogicalHeight;
+                FullMipBox.MaxZ = SrcMipLevelAttribs.Depth;
+                pSrcBox = &FullMipBox;
+            }
+
+            auto SrcBufferOffset = GetStagingDataOffset(SrcTexDesc, CopyAttribs.SrcSlice, CopyAttribs.SrcMipLevel);
+            // address of (x,y,z) = region->bufferOffset + (((z * imageHeight) + y) * rowLength + x) * texelBlockSize; (18.4.1)
+            SrcBufferOffset +=
+                // For compressed-block formats, RowSize is the size of one compressed row.
+                // For non-compressed formats, BlockHeight is 1.
+                (pSrcBox->MinZ * SrcMipLevelAttribs.StorageHeight + pSrcBox->MinY) / SrcFmtAttribs.BlockHeight  * SrcMipLevelAttribs.RowSize + 
+                // For non-compressed formats, BlockWidth is 1.
+                (pSrcBox->MinX / SrcFmtAttribs.BlockWidth) * SrcFmtAttribs.GetElementSize();
+
+            Box DstBox;
+            DstBox.MinX = CopyAttribs.DstX;
+            DstBox.MinY = CopyAttribs.DstY;
+            DstBox.MinZ = CopyAttribs.DstZ;
+            DstBox.MaxX = DstBox.MinX + pSrcBox->MaxX - pSrcBox->MinX;
+            DstBox.MaxY = DstBox.MinY + pSrcBox->MaxY - pSrcBox->MinY;
+            DstBox.MaxZ = DstBox.MinZ + pSrcBox->MaxZ - pSrcBox->MinZ;
+
+            m_BufferImageCopies.emplace_back(GetBufferImageCopyInfo(SrcBufferOffset, SrcMipLevelAttribs.StorageWidth, DstTexDesc, DstBox, CopyAttribs.DstMipLevel, CopyAttribs.DstSlice));
+        }
+
+        EnsureVkCmdBuffer();
+        TransitionOrVerifyTextureState(*pDstTexVk, pCopies[0].DstTextureTransitionMode, RESOURCE_STATE_COPY_DEST, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                       "Using texture as copy destination (DeviceContextVkImpl::CopyStagingTextureToTexture)");
+
+        m_CommandBuffer.CopyBufferToImage(
+            pSrcTexVk->GetVkStagingBuffer(),
+            pDstTexVk->GetVkImage(),
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, // must be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL (18.4)
+            static_cast<uint32_t>(m_BufferImageCopies.size()),
+            m_BufferImageCopies.data());
+    }
+
     void DeviceContextVkImpl::CopyTextureToBuffer(TextureVkImpl&                 SrcTextureVk,
                                                   const Box&                     SrcRegion,
                                                   Uint32                         SrcMipLevel,
@@ -1857,20 +2088,31 @@ namespace Diligent
 
     void DeviceContextVkImpl::FinishCommandList(class ICommandList **ppCommandList)
     {
-        if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+        const auto& CmdBufferState = m_CommandBuffer.GetState();
+        VkRenderPass  InheritedRenderPass  = VK_NULL_HANDLE;
+        VkFramebuffer InheritedFramebuffer = VK_NULL_HANDLE;
+        if (CmdBufferState.RenderPassInherited)
+        {
+            // Inherited render pass is ended by the primary command buffer
+            InheritedRenderPass  = CmdBufferState.RenderPass;
+            InheritedFramebuffer = CmdBufferState.Framebuffer;
+        }
+        else if (CmdBufferState.RenderPass != VK_NULL_HANDLE)
         {
             m_CommandBuffer.EndRenderPass();
         }
 
+        m_CommandBuffer.FlushBarriers();
         auto vkCmdBuff = m_CommandBuffer.GetVkCmdBuffer();
         auto err = vkEndCommandBuffer(vkCmdBuff);
         DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to end command buffer"); (void)err;
 
         auto* pDeviceVkImpl = m_pDevice.RawPtr<RenderDeviceVkImpl>();
         CommandListVkImpl *pCmdListVk( NEW_RC_OBJ(m_CmdListAllocator, "CommandListVkImpl instance", CommandListVkImpl)
-                                                 (pDeviceVkImpl, this, vkCmdBuff) );
+                                                 (pDeviceVkImpl, this, vkCmdBuff, InheritedRenderPass, InheritedFramebuffer) );
         pCmdListVk->QueryInterface( IID_CommandList, reinterpret_cast<IObject**>(ppCommandList) );
 
+        m_bRecordingSecondaryCmdBuffer = false;
         m_CommandBuffer.Reset();
         m_State = ContextState{};
         m_DescrSetBindInfo.Reset();
@@ -1887,11 +2129,17 @@ namespace Diligent
             return;
         }
 
+        CommandListVkImpl* pCmdListVk = ValidatedCast<CommandListVkImpl>(pCommandList);
+        if (pCmdListVk->IsSecondary())
+        {
+            ExecuteSecondaryCommandList(*pCmdListVk);
+            return;
+        }
+
         Flush();
 
         InvalidateState();
 
-        CommandListVkImpl* pCmdListVk = ValidatedCast<CommandListVkImpl>(pCommandList);
         VkCommandBuffer vkCmdBuff = VK_NULL_HANDLE;
         RefCntAutoPtr<IDeviceContext> pDeferredCtx;
         pCmdListVk->Close(vkCmdBuff, pDeferredCtx);
@@ -1913,6 +2161,124 @@ namespace Diligent
         pDeferredCtxVkImpl->DisposeVkCmdBuffer(m_CommandQueueId, vkCmdBuff, SubmittedFenceValue);
     }
 
+    void DeviceContextVkImpl::ExecuteSecondaryCommandList(CommandListVkImpl& CmdList)
+    {
+        // Validate the command list before it is closed, so that it remains valid
+        // and can be executed after the correct render targets have been bound
+        if (m_Framebuffer != CmdList.GetInheritedFramebuffer() || m_RenderPass != CmdList.GetInheritedRenderPass())
+        {
+            LOG_ERROR_MESSAGE("Render targets bound to the immediate context do not match the render targets of the secondary command buffer. "
+                              "Bind the same render targets that were passed to BeginSecondaryCommandBuffer() before executing the command list.");
+            return;
+        }
+
+        VkCommandBuffer vkCmdBuff = VK_NULL_HANDLE;
+        RefCntAutoPtr<IDeviceContext> pDeferredCtx;
+        CmdList.Close(vkCmdBuff, pDeferredCtx);
+        VERIFY(vkCmdBuff != VK_NULL_HANDLE, "Trying to execute empty command buffer");
+        VERIFY_EXPR(pDeferredCtx);
+
+        EnsureVkCmdBuffer();
+        const auto& CmdBufferState = m_CommandBuffer.GetState();
+        if (CmdBufferState.Framebuffer != m_Framebuffer || CmdBufferState.SubpassContents != VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS)
+        {
+            if (CmdBufferState.RenderPass != VK_NULL_HANDLE)
+                m_CommandBuffer.EndRenderPass();
+#ifdef DEVELOPMENT
+            TransitionRenderTargets(RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+#endif
+            m_CommandBuffer.BeginRenderPass(m_RenderPass, m_Framebuffer, m_FramebufferWidth, m_FramebufferHeight, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+        }
+        m_CommandBuffer.ExecuteCommands(1, &vkCmdBuff);
+        ++m_State.NumCommands;
+
+        auto* pDeferredCtxVkImpl = pDeferredCtx.RawPtr<DeviceContextVkImpl>();
+        // Set the bit in the deferred context cmd queue mask corresponding to cmd queue of this context
+        pDeferredCtxVkImpl->m_SubmittedBuffersCmdQueueMask |= Uint64{1} << m_CommandQueueId;
+        // The buffer will be disposed when the primary command buffer is submitted
+        m_PendingSecondaryCmdBuffers.emplace_back(vkCmdBuff, std::move(pDeferredCtx));
+
+        // Command buffer state is undefined after vkCmdExecuteCommands, 
+        // so all bindings must be committed again
+        m_CommandBuffer.ResetBindings();
+        m_State.CommittedVBsUpToDate = false;
+        m_State.CommittedIBUpToDate  = false;
+        m_DescrSetBindInfo.Reset();
+        m_pPipelineState = nullptr;
+    }
+
+    void DeviceContextVkImpl::GetBarrierStatistics(BarrierStatisticsVk& Stats)
+    {
+        const auto& CmdBuffStats = m_CommandBuffer.GetBarrierStatistics();
+        Stats.NumRequestedBarriers       = CmdBuffStats.NumRequestedBarriers;
+        Stats.NumSkippedBarriers         = CmdBuffStats.NumSkippedBarriers;
+        Stats.NumMergedBarriers          = CmdBuffStats.NumMergedBarriers;
+        Stats.NumEmittedBarriers         = CmdBuffStats.NumEmittedBarriers;
+        Stats.NumPipelineBarrierCommands = CmdBuffStats.NumPipelineBarrierCommands;
+    }
+
+    void DeviceContextVkImpl::GetStateFilteringStatistics(StateFilteringStatisticsVk& Stats)
+    {
+        const auto& CmdBuffStats = m_CommandBuffer.GetStateStatistics();
+        Stats.NumRecordedCommands = CmdBuffStats.NumRecordedCommands;
+        Stats.NumFilteredCommands = CmdBuffStats.NumFilteredCommands;
+    }
+
+    void DeviceContextVkImpl::GetDescriptorSetCacheStatistics(DescriptorSetCacheStatisticsVk& Stats)
+    {
+        Stats.NumLookups = m_DynamicDescrSetAllocator.GetCacheLookupCount();
+        Stats.NumHits    = m_DynamicDescrSetAllocator.GetCacheHitCount();
+    }
+
+    void DeviceContextVkImpl::BeginSecondaryCommandBuffer(Uint32 NumRenderTargets, ITextureView* ppRenderTargets[], ITextureView* pDepthStencil)
+    {
+        if (!m_bIsDeferred)
+        {
+            LOG_ERROR_MESSAGE("Secondary command buffers can only be recorded by deferred contexts");
+            return;
+        }
+        if (m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE)
+        {
+            LOG_ERROR_MESSAGE("BeginSecondaryCommandBuffer() must be called before any command is recorded by the deferred context");
+            return;
+        }
+        if (NumRenderTargets == 0 && pDepthStencil == nullptr)
+        {
+            LOG_ERROR_MESSAGE("At least one render target or depth-stencil buffer must be provided to BeginSecondaryCommandBuffer()");
+            return;
+        }
+
+        m_bRecordingSecondaryCmdBuffer = true;
+        // SetRenderTargets() will request the command buffer to set the viewport,
+        // which begins the secondary command buffer with the new render pass
+        SetRenderTargets(NumRenderTargets, ppRenderTargets, pDepthStencil, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        if (m_CommandBuffer.GetVkCmdBuffer() == VK_NULL_HANDLE)
+        {
+            // Render targets have not changed
+            EnsureVkCmdBuffer();
+            SetViewports(1, nullptr, 0, 0);
+        }
+    }
+
+    void DeviceContextVkImpl::BeginSecondaryVkCmdBuffer()
+    {
+        VERIFY_EXPR(m_bIsDeferred && m_bRecordingSecondaryCmdBuffer);
+        VERIFY(m_RenderPass != VK_NULL_HANDLE && m_Framebuffer != VK_NULL_HANDLE, "Render pass and framebuffer must be set to begin secondary command buffer");
+
+        VkCommandBufferInheritanceInfo InheritanceInfo = {};
+        InheritanceInfo.sType                = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        InheritanceInfo.pNext                = nullptr;
+        InheritanceInfo.renderPass           = m_RenderPass;
+        InheritanceInfo.subpass              = 0;
+        InheritanceInfo.framebuffer          = m_Framebuffer;
+        InheritanceInfo.occlusionQueryEnable = VK_FALSE;
+        InheritanceInfo.queryFlags           = 0;
+        InheritanceInfo.pipelineStatistics   = 0;
+        auto vkCmdBuff = m_CmdPool.GetCommandBuffer("Secondary command buffer", &InheritanceInfo);
+        m_CommandBuffer.SetVkCmdBuffer(vkCmdBuff);
+        m_CommandBuffer.SetInheritedRenderPass(m_RenderPass, m_Framebuffer, m_FramebufferWidth, m_FramebufferHeight);
+    }
+
     void DeviceContextVkImpl::SignalFence(IFence* pFence, Uint64 Value)
     {
         VERIFY(!m_bIsDeferred, "Fence can only be signaled from immediate context");
@@ -2103,14 +2469,21 @@ namespace Diligent
         // to make sure that all UAV writes are complete and visible.
         if (((OldState & NewState) != NewState) || NewState == RESOURCE_STATE_UNORDERED_ACCESS)
         {
-            DEV_CHECK_ERR(BufferVk.m_VulkanBuffer != VK_NULL_HANDLE, "Cannot transition suballocated buffer");
-            VERIFY_EXPR(BufferVk.GetDynamicOffset(m_ContextId, this) == 0);
+            DEV_CHECK_ERR(BufferVk.m_VulkanBuffer != VK_NULL_HANDLE || BufferVk.IsSuballocated(), "Cannot transition dynamic buffer");
 
             EnsureVkCmdBuffer();
             auto vkBuff = BufferVk.GetVkBuffer();
             auto OldAccessFlags = ResourceStateFlagsToVkAccessFlags(OldState);
             auto NewAccessFlags = ResourceStateFlagsToVkAccessFlags(NewState);
-            m_CommandBuffer.BufferMemoryBarrier(vkBuff, OldAccessFlags, NewAccessFlags);
+            if (BufferVk.IsSuballocated())
+            {
+                // Only the region of the shared buffer that belongs to this buffer is transitioned
+                m_CommandBuffer.BufferMemoryBarrier(vkBuff, OldAccessFlags, NewAccessFlags, 0, 0, BufferVk.GetSuballocationOffset(), BufferVk.GetDesc().uiSizeInBytes);
+            }
+            else
+            {
+                m_CommandBuffer.BufferMemoryBarrier(vkBuff, OldAccessFlags, NewAccessFlags);
+            }
             if (UpdateBufferState)
             {
                 BufferVk.SetState(NewState);
@@ -2154,6 +2527,7 @@ namespace Diligent
 
     void DeviceContextVkImpl::TransitionResourceStates(Uint32 BarrierCount, StateTransitionDesc* pResourceBarriers)
     {
+        CPU_PROFILE_SCOPE("DeviceContextVkImpl::TransitionResourceStates");
         if (BarrierCount == 0)
             return;
 
@@ -126,7 +126,7 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
             reinterpret_cast<VkAllocationCallbacks*>(EngineCI.pVkAllocator));
 
         auto vkDevice = Instance->SelectPhysicalDevice();
-        auto PhysicalDevice = VulkanUtilities::VulkanPhysicalDevice::Create(vkDevice);
+        auto PhysicalDevice = VulkanUtilities::VulkanPhysicalDevice::Create(vkDevice, Instance.get());
         const auto& PhysicalDeviceFeatures = PhysicalDevice->GetFeatures();
 
         // If an implementation exposes any queue family that supports graphics operations, 
@@ -181,6 +181,7 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
         ENABLE_FEATURE(vertexPipelineStoresAndAtomics)
         ENABLE_FEATURE(fragmentStoresAndAtomics)
         ENABLE_FEATURE(shaderStorageImageExtendedFormats)
+        ENABLE_FEATURE(multiDrawIndirect)
 #undef ENABLE_FEATURE
 
         DeviceCreateInfo.pEnabledFeatures = &DeviceFeatures; // NULL or a pointer to a VkPhysicalDeviceFeatures structure that contains 
@@ -191,6 +192,60 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
             VK_KHR_SWAPCHAIN_EXTENSION_NAME, 
             VK_KHR_MAINTENANCE1_EXTENSION_NAME // To allow negative viewport height
         };
+        // Descriptor update templates allow writing all dynamic descriptors of a pipeline with a single call
+        if (PhysicalDevice->IsExtensionSupported(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME))
+            DeviceExtensions.push_back(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME);
+        // Allows reading the number of indirect draws from a buffer
+        if (PhysicalDevice->IsExtensionSupported(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME))
+            DeviceExtensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+        // Allows the memory manager to query per-heap memory budget
+        if (PhysicalDevice->IsMemoryBudgetSupported())
+            DeviceExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+
+        // Bindless resources require descriptor arrays that are indexed at run time, may be partially 
+        // populated and can be updated while the descriptor set is in use by the GPU
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT DescriptorIndexingFeatures = {};
+        DescriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+        if (EngineCI.EnableBindlessResources)
+        {
+            const auto& SupportedFeatures = PhysicalDevice->GetDescriptorIndexingFeatures();
+            if (PhysicalDevice->IsExtensionSupported(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME) &&
+                PhysicalDevice->IsExtensionSupported(VK_KHR_MAINTENANCE3_EXTENSION_NAME)        &&
+                SupportedFeatures.runtimeDescriptorArray                        &&
+                SupportedFeatures.descriptorBindingPartiallyBound               &&
+                SupportedFeatures.descriptorBindingSampledImageUpdateAfterBind  &&
+                SupportedFeatures.descriptorBindingStorageImageUpdateAfterBind  &&
+                SupportedFeatures.descriptorBindingStorageBufferUpdateAfterBind &&
+                SupportedFeatures.descriptorBindingUniformTexelBufferUpdateAfterBind &&
+                SupportedFeatures.descriptorBindingStorageTexelBufferUpdateAfterBind)
+            {
+                DescriptorIndexingFeatures.runtimeDescriptorArray                        = VK_TRUE;
+                DescriptorIndexingFeatures.descriptorBindingPartiallyBound               = VK_TRUE;
+                DescriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind  = VK_TRUE;
+                DescriptorIndexingFeatures.descriptorBindingStorageImageUpdateAfterBind  = VK_TRUE;
+                DescriptorIndexingFeatures.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+                DescriptorIndexingFeatures.descriptorBindingUniformTexelBufferUpdateAfterBind = VK_TRUE;
+                DescriptorIndexingFeatures.descriptorBindingStorageTexelBufferUpdateAfterBind = VK_TRUE;
+                // Non-uniform indexing is optional and is only enabled if supported
+                DescriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing  = SupportedFeatures.shaderSampledImageArrayNonUniformIndexing;
+                DescriptorIndexingFeatures.shaderStorageImageArrayNonUniformIndexing  = SupportedFeatures.shaderStorageImageArrayNonUniformIndexing;
+                DescriptorIndexingFeatures.shaderStorageBufferArrayNonUniformIndexing = SupportedFeatures.shaderStorageBufferArrayNonUniformIndexing;
+                DescriptorIndexingFeatures.shaderUniformTexelBufferArrayNonUniformIndexing = SupportedFeatures.shaderUniformTexelBufferArrayNonUniformIndexing;
+                DescriptorIndexingFeatures.shaderStorageTexelBufferArrayNonUniformIndexing = SupportedFeatures.shaderStorageTexelBufferArrayNonUniformIndexing;
+
+                // VK_EXT_descriptor_indexing requires VK_KHR_maintenance3
+                DeviceExtensions.push_back(VK_KHR_MAINTENANCE3_EXTENSION_NAME);
+                DeviceExtensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+                DeviceCreateInfo.pNext = &DescriptorIndexingFeatures;
+            }
+            else
+            {
+                LOG_WARNING_MESSAGE("Bindless resources are requested, but " VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME " extension or "
+                                    "required descriptor indexing features are not supported by the physical device. Bindless resources will be disabled.");
+                EngineCI.EnableBindlessResources = false;
+            }
+        }
+
         DeviceCreateInfo.ppEnabledExtensionNames = DeviceExtensions.empty() ? nullptr : DeviceExtensions.data();
         DeviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(DeviceExtensions.size());
 
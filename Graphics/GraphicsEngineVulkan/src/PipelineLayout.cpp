@@ -32,6 +32,7 @@
 #include "BufferVkImpl.h"
 #include "VulkanTypeConversions.h"
 #include "HashUtils.h"
+#include "BindlessResourceHeapVk.h"
 
 namespace Diligent
 {
@@ -239,7 +240,7 @@ size_t PipelineLayout::DescriptorSetLayoutManager::DescriptorSetLayout::GetHash(
     return Hash;
 }
 
-void PipelineLayout::DescriptorSetLayoutManager::Finalize(const VulkanUtilities::VulkanLogicalDevice &LogicalDevice)
+void PipelineLayout::DescriptorSetLayoutManager::Finalize(const VulkanUtilities::VulkanLogicalDevice &LogicalDevice, const BindlessResourceHeapVk* pBindlessHeap)
 {
     size_t TotalBindings = 0;
     for (const auto &Layout : m_DescriptorSetLayouts)
@@ -248,7 +249,7 @@ void PipelineLayout::DescriptorSetLayoutManager::Finalize(const VulkanUtilities:
     }
     m_LayoutBindings.resize(TotalBindings);
     size_t BindingOffset = 0;
-    std::array<VkDescriptorSetLayout, 2> ActiveDescrSetLayouts = {};
+    std::array<VkDescriptorSetLayout, BindlessDescriptorSetVk + 1> ActiveDescrSetLayouts = {};
     for (auto &Layout : m_DescriptorSetLayouts)
     {
         if (Layout.SetIndex >= 0)
@@ -264,11 +265,21 @@ void PipelineLayout::DescriptorSetLayoutManager::Finalize(const VulkanUtilities:
                 m_ActiveSets == 1 && ActiveDescrSetLayouts[0] != VK_NULL_HANDLE && ActiveDescrSetLayouts[1] == VK_NULL_HANDLE ||
                 m_ActiveSets == 2 && ActiveDescrSetLayouts[0] != VK_NULL_HANDLE && ActiveDescrSetLayouts[1] != VK_NULL_HANDLE);
 
+    Uint32 SetLayoutCount = m_ActiveSets;
+    if (pBindlessHeap != nullptr)
+    {
+        // Pipeline layouts must not have gaps, so unused sets are filled with the empty layout
+        for (Uint32 s = m_ActiveSets; s < BindlessDescriptorSetVk; ++s)
+            ActiveDescrSetLayouts[s] = pBindlessHeap->GetEmptyVkDescriptorSetLayout();
+        ActiveDescrSetLayouts[BindlessDescriptorSetVk] = pBindlessHeap->GetVkDescriptorSetLayout();
+        SetLayoutCount = BindlessDescriptorSetVk + 1;
+    }
+
     VkPipelineLayoutCreateInfo PipelineLayoutCI = {};
     PipelineLayoutCI.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
     PipelineLayoutCI.pNext = nullptr;
     PipelineLayoutCI.flags = 0; // reserved for future use
-    PipelineLayoutCI.setLayoutCount = m_ActiveSets;
+    PipelineLayoutCI.setLayoutCount = SetLayoutCount;
     PipelineLayoutCI.pSetLayouts = PipelineLayoutCI.setLayoutCount != 0 ? ActiveDescrSetLayouts.data() : nullptr;
     PipelineLayoutCI.pushConstantRangeCount = 0;
     PipelineLayoutCI.pPushConstantRanges = nullptr;
@@ -382,9 +393,14 @@ void PipelineLayout::AllocateResourceSlot(const SPIRVShaderResourceAttribs& ResA
     SPIRV[ResAttribs.DescriptorSetDecorationOffset] = DescriptorSet;
 }
 
-void PipelineLayout::Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice)
+void PipelineLayout::Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, const BindlessResourceHeapVk* pBindlessHeap)
 {
-    m_LayoutMgr.Finalize(LogicalDevice);
+    m_LayoutMgr.Finalize(LogicalDevice, pBindlessHeap);
+    if (pBindlessHeap != nullptr)
+    {
+        m_vkBindlessSet = pBindlessHeap->GetVkDescriptorSet();
+        m_vkEmptySet    = pBindlessHeap->GetEmptyVkDescriptorSet();
+    }
 }
 
 std::array<Uint32, 2> PipelineLayout::GetDescriptorSetSizes(Uint32& NumSets)const
@@ -473,6 +489,17 @@ void PipelineLayout::PrepareDescriptorSets(DeviceContextVkImpl*          pCtxVkI
         TotalDynamicDescriptors += Set.NumDynamicDescriptors;
     }
 
+    if (m_vkBindlessSet != VK_NULL_HANDLE)
+    {
+        // The heap is bound together with the pipeline's own sets so that it is never disturbed
+        if (BindInfo.vkSets.size() < BindlessDescriptorSetVk + 1)
+            BindInfo.vkSets.resize(BindlessDescriptorSetVk + 1);
+        for (Uint32 s = BindInfo.SetCout; s < BindlessDescriptorSetVk; ++s)
+            BindInfo.vkSets[s] = m_vkEmptySet;
+        BindInfo.vkSets[BindlessDescriptorSetVk] = m_vkBindlessSet;
+        BindInfo.SetCout = BindlessDescriptorSetVk + 1;
+    }
+
 #ifdef _DEBUG
     for (const auto& set : BindInfo.vkSets)
         VERIFY(set != VK_NULL_HANDLE, "Descriptor set must not be null");
@@ -501,6 +528,26 @@ void PipelineLayout::PrepareDescriptorSets(DeviceContextVkImpl*          pCtxVkI
     }
 }
 
+void PipelineLayout::BindBindlessResourceHeap(DeviceContextVkImpl* pCtxVkImpl, bool IsCompute)const
+{
+    if (m_vkBindlessSet == VK_NULL_HANDLE || m_LayoutMgr.GetNumActiveSets() != 0)
+        return;
+
+    VkDescriptorSet vkSets[BindlessDescriptorSetVk + 1];
+    for (Uint32 s = 0; s < BindlessDescriptorSetVk; ++s)
+        vkSets[s] = m_vkEmptySet;
+    vkSets[BindlessDescriptorSetVk] = m_vkBindlessSet;
+
+    auto& CmdBuffer = pCtxVkImpl->GetCommandBuffer();
+    CmdBuffer.BindDescriptorSets(IsCompute ? VK_PIPELINE_BIND_POINT_COMPUTE : VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                 m_LayoutMgr.GetVkPipelineLayout(), 
+                                 0, // First set
+                                 _countof(vkSets),
+                                 vkSets,
+                                 0, 
+                                 nullptr);
+}
+
 void PipelineLayout::BindDescriptorSetsWithDynamicOffsets(DeviceContextVkImpl*    pCtxVkImpl,
                                                           DescriptorSetBindInfo&  BindInfo)const
 {
@@ -146,7 +146,9 @@ static std::vector<uint32_t> StripReflection(const std::vector<uint32_t>& Origin
 
 PipelineStateVkImpl :: PipelineStateVkImpl(IReferenceCounters*      pRefCounters,
                                            RenderDeviceVkImpl*      pDeviceVk,
-                                           const PipelineStateDesc& PipelineDesc) : 
+                                           const PipelineStateDesc& PipelineDesc,
+                                           bool                     AsyncCompile,
+                                           IPipelineState*          pFallbackPSO) : 
     TPipelineStateBase{pRefCounters, pDeviceVk, PipelineDesc},
     m_SRBMemAllocator {GetRawAllocator()}
 {
@@ -178,7 +180,35 @@ PipelineStateVkImpl :: PipelineStateVkImpl(IReferenceCounters*      pRefCounters
     }
     ShaderResourceLayoutVk::Initialize(pDeviceVk, m_NumShaders, m_ShaderResourceLayouts, ShaderResources.data(), GetRawAllocator(),
                                        PipelineDesc.ResourceLayout, ShaderSPIRVs.data(), m_PipelineLayout);
-    m_PipelineLayout.Finalize(LogicalDevice);
+    m_PipelineLayout.Finalize(LogicalDevice, pDeviceVk->GetBindlessResourceHeap());
+
+    auto DynamicDescriptorSetVkLayout = m_PipelineLayout.GetDynamicDescriptorSetVkLayout();
+    if (DynamicDescriptorSetVkLayout != VK_NULL_HANDLE && LogicalDevice.IsDescriptorUpdateTemplateSupported())
+    {
+        std::vector<VkDescriptorUpdateTemplateEntryKHR> TemplateEntries;
+        for (Uint32 s=0; s < m_NumShaders; ++s)
+        {
+            m_ShaderResourceLayouts[s].GetDynamicResourceUpdateTemplateEntries(TemplateEntries, m_DynamicResourceUpdateDataSize);
+        }
+
+        if (!TemplateEntries.empty())
+        {
+            VkDescriptorUpdateTemplateCreateInfoKHR TemplateCI = {};
+            TemplateCI.sType                      = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO_KHR;
+            TemplateCI.pNext                      = nullptr;
+            TemplateCI.flags                      = 0; // reserved for future use
+            TemplateCI.descriptorUpdateEntryCount = static_cast<uint32_t>(TemplateEntries.size());
+            TemplateCI.pDescriptorUpdateEntries   = TemplateEntries.data();
+            TemplateCI.templateType               = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET_KHR;
+            TemplateCI.descriptorSetLayout        = DynamicDescriptorSetVkLayout;
+            // pipelineBindPoint, pipelineLayout, and set are ignored for descriptor set templates
+            m_DynamicResourceUpdateTemplate = LogicalDevice.CreateDescriptorUpdateTemplate(TemplateCI, m_Desc.Name);
+        }
+        else
+        {
+            m_DynamicResourceUpdateDataSize = 0;
+        }
+    }
 
     if (PipelineDesc.SRBAllocationGranularity > 1)
     {
@@ -197,6 +227,54 @@ PipelineStateVkImpl :: PipelineStateVkImpl(IReferenceCounters*      pRefCounters
         m_SRBMemAllocator.Initialize(PipelineDesc.SRBAllocationGranularity, m_NumShaders, ShaderVariableDataSizes.data(), 1, &CacheMemorySize);
     }
 
+    if (!m_Desc.IsComputePipeline)
+    {
+        // Render pass is looked up right away so that GetVkRenderPass() is valid while the pipeline is pending
+        const auto& GraphicsPipeline = m_Desc.GraphicsPipeline;
+        auto& RPCache = pDeviceVk->GetRenderPassCache();
+        RenderPassCache::RenderPassCacheKey Key(
+            GraphicsPipeline.NumRenderTargets,
+            GraphicsPipeline.SmplDesc.Count,
+            GraphicsPipeline.RTVFormats,
+            GraphicsPipeline.DSVFormat);
+        m_RenderPass = RPCache.GetRenderPass(Key);
+    }
+
+    m_HasStaticResources = false;
+    m_HasNonStaticResources = false;
+    for (Uint32 s=0; s < m_NumShaders; ++s)
+    {
+        const auto& Layout = m_ShaderResourceLayouts[s];
+        if (Layout.GetResourceCount(SHADER_RESOURCE_VARIABLE_TYPE_STATIC) != 0)
+            m_HasStaticResources = true;
+
+        if (Layout.GetResourceCount(SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE) != 0 ||
+            Layout.GetResourceCount(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC) != 0)
+            m_HasNonStaticResources = true;
+    }
+
+    m_ShaderResourceLayoutHash = m_PipelineLayout.GetHash();
+
+    if (AsyncCompile)
+    {
+        // Shader modules and the pipeline are created on the worker thread
+        CompileAsync(pDeviceVk->GetPipelineCompilerPool(), pFallbackPSO,
+            [this, ShaderSPIRVs]()
+            {
+                CreatePipeline(ShaderSPIRVs);
+            }
+        );
+    }
+    else
+    {
+        CreatePipeline(ShaderSPIRVs);
+    }
+}
+
+void PipelineStateVkImpl::CreatePipeline(const std::array<std::vector<uint32_t>, MaxShadersInPipeline>& ShaderSPIRVs)
+{
+    const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
+
     // Create shader modules and initialize shader stages
     std::array<VkPipelineShaderStageCreateInfo, MaxShadersInPipeline> ShaderStages = {};
     for (Uint32 s = 0; s < m_NumShaders; ++s)
@@ -272,18 +350,10 @@ PipelineStateVkImpl :: PipelineStateVkImpl(IReferenceCounters*      pRefCounters
     }
     else
     {
-        const auto& PhysicalDevice = pDeviceVk->GetPhysicalDevice();
+        const auto& PhysicalDevice = m_pDevice->GetPhysicalDevice();
         
         auto& GraphicsPipeline = m_Desc.GraphicsPipeline;
 
-        auto& RPCache = pDeviceVk->GetRenderPassCache();
-        RenderPassCache::RenderPassCacheKey Key(
-            GraphicsPipeline.NumRenderTargets,
-            GraphicsPipeline.SmplDesc.Count,
-            GraphicsPipeline.RTVFormats,
-            GraphicsPipeline.DSVFormat);
-        m_RenderPass = RPCache.GetRenderPass(Key);
-
         VkGraphicsPipelineCreateInfo PipelineCI = {};
         PipelineCI.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
         PipelineCI.pNext = nullptr;
@@ -419,27 +489,16 @@ PipelineStateVkImpl :: PipelineStateVkImpl(IReferenceCounters*      pRefCounters
 
         m_Pipeline = LogicalDevice.CreateGraphicsPipeline(PipelineCI, VK_NULL_HANDLE, m_Desc.Name);
     }
-
-    m_HasStaticResources = false;
-    m_HasNonStaticResources = false;
-    for (Uint32 s=0; s < m_NumShaders; ++s)
-    {
-        const auto& Layout = m_ShaderResourceLayouts[s];
-        if (Layout.GetResourceCount(SHADER_RESOURCE_VARIABLE_TYPE_STATIC) != 0)
-            m_HasStaticResources = true;
-
-        if (Layout.GetResourceCount(SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE) != 0 ||
-            Layout.GetResourceCount(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC) != 0)
-            m_HasNonStaticResources = true;
-    }
-
-    m_ShaderResourceLayoutHash = m_PipelineLayout.GetHash();
 }
 
 PipelineStateVkImpl::~PipelineStateVkImpl()
 {
+    CancelAsyncCompilation();
+
     m_pDevice->SafeReleaseDeviceObject(std::move(m_Pipeline), m_Desc.CommandQueueMask);
     m_PipelineLayout.Release(m_pDevice, m_Desc.CommandQueueMask);
+    if (m_DynamicResourceUpdateTemplate != VK_NULL_HANDLE)
+        m_pDevice->SafeReleaseDeviceObject(std::move(m_DynamicResourceUpdateTemplate), m_Desc.CommandQueueMask);
 
     for (auto& ShaderModule : m_ShaderModules)
     {
@@ -588,8 +647,19 @@ void PipelineStateVkImpl::CommitAndTransitionShaderResources(IShaderResourceBind
     if (CommitResources)
     {
         VkDescriptorSet DynamicDescrSet = VK_NULL_HANDLE;
+        size_t ResourceIdsHash = 0;
         auto DynamicDescriptorSetVkLayout = m_PipelineLayout.GetDynamicDescriptorSetVkLayout();
         if (DynamicDescriptorSetVkLayout != VK_NULL_HANDLE)
+        {
+            // Look for a set written earlier in this frame that references the same objects
+            auto& DynamicDescrSetAllocator = pCtxVkImpl->GetDynamicDescriptorSetAllocator();
+            auto& ResourceIds = pCtxVkImpl->GetDynamicResourceIdsBuffer();
+            VERIFY_EXPR(m_PipelineLayout.GetDynamicDescriptorSetIndex() >= 0);
+            ResourceIdsHash = ResourceCache.GetDescriptorSetResourceIds(static_cast<Uint32>(m_PipelineLayout.GetDynamicDescriptorSetIndex()), ResourceIds);
+            DynamicDescrSet = DynamicDescrSetAllocator.FindCachedSet(DynamicDescriptorSetVkLayout, ResourceIdsHash, ResourceIds);
+        }
+
+        if (DynamicDescriptorSetVkLayout != VK_NULL_HANDLE && DynamicDescrSet == VK_NULL_HANDLE)
         {
             const char* DynamicDescrSetName = "Dynamic Descriptor Set";
 #ifdef DEVELOPMENT
@@ -599,13 +669,43 @@ void PipelineStateVkImpl::CommitAndTransitionShaderResources(IShaderResourceBind
 #endif
             // Allocate vulkan descriptor set for dynamic resources
             DynamicDescrSet = pCtxVkImpl->AllocateDynamicDescriptorSet(DynamicDescriptorSetVkLayout, DynamicDescrSetName);
-            // Commit all dynamic resource descriptors
-            for (Uint32 s=0; s < m_NumShaders; ++s)
+            if (m_DynamicResourceUpdateTemplate != VK_NULL_HANDLE)
             {
-                const auto& Layout = m_ShaderResourceLayouts[s];
-                if (Layout.GetResourceCount(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC) != 0)
-                    Layout.CommitDynamicResources(ResourceCache, DynamicDescrSet);
+                // Pack descriptors of all dynamic resources in the template order and
+                // write them to the set with a single call
+                alignas(VkDescriptorBufferInfo) Uint8 LocalData[2048];
+                std::vector<Uint8> HeapData;
+                Uint8* pData = LocalData;
+                if (m_DynamicResourceUpdateDataSize > sizeof(LocalData))
+                {
+                    HeapData.resize(m_DynamicResourceUpdateDataSize);
+                    pData = HeapData.data();
+                }
+
+                auto* pDataEnd = pData;
+                for (Uint32 s=0; s < m_NumShaders; ++s)
+                {
+                    const auto& Layout = m_ShaderResourceLayouts[s];
+                    if (Layout.GetResourceCount(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC) != 0)
+                        pDataEnd = Layout.WriteDynamicResourceUpdateData(ResourceCache, pDataEnd);
+                }
+                VERIFY_EXPR(static_cast<size_t>(pDataEnd - pData) == m_DynamicResourceUpdateDataSize);
+                m_pDevice->GetLogicalDevice().UpdateDescriptorSetWithTemplate(DynamicDescrSet, m_DynamicResourceUpdateTemplate, pData);
             }
+            else
+            {
+                // Commit all dynamic resource descriptors
+                for (Uint32 s=0; s < m_NumShaders; ++s)
+                {
+                    const auto& Layout = m_ShaderResourceLayouts[s];
+                    if (Layout.GetResourceCount(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC) != 0)
+                        Layout.CommitDynamicResources(ResourceCache, DynamicDescrSet);
+                }
+            }
+
+            // ResourceIds and ResourceIdsHash are still valid as the resource cache has not been modified
+            auto& ResourceIds = pCtxVkImpl->GetDynamicResourceIdsBuffer();
+            pCtxVkImpl->GetDynamicDescriptorSetAllocator().CacheSet(DynamicDescriptorSetVkLayout, ResourceIdsHash, ResourceIds, DynamicDescrSet);
         }
         // Prepare descriptor sets, and also bind them if there are no dynamic descriptors
         VERIFY_EXPR(pDescrSetBindInfo != nullptr);
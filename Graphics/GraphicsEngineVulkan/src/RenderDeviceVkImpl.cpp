@@ -23,6 +23,7 @@
 
 #include "pch.h"
 #include "RenderDeviceVkImpl.h"
+#include "CPUProfiler.h"
 #include "PipelineStateVkImpl.h"
 #include "ShaderVkImpl.h"
 #include "TextureVkImpl.h"
@@ -65,7 +66,8 @@ RenderDeviceVkImpl :: RenderDeviceVkImpl(IReferenceCounters*
             sizeof(PipelineStateVkImpl),
             sizeof(ShaderResourceBindingVkImpl),
             sizeof(FenceVkImpl)
-        }
+        },
+        EngineCI.ObjectPoolPageSizes
     },
     m_VulkanInstance    {Instance                 },
     m_PhysicalDevice    {std::move(PhysicalDevice)},
@@ -149,6 +151,29 @@ RenderDeviceVkImpl :: RenderDeviceVkImpl(IReferenceCounters*
 
     m_DeviceCaps.bGeometryShadersSupported = EngineCI.EnabledFeatures.geometryShader;
     m_DeviceCaps.bTessellationSupported    = EngineCI.EnabledFeatures.tessellationShader;
+    m_DeviceCaps.bMultiDrawIndirectSupported = m_LogicalVkDevice->IsMultiDrawIndirectEnabled();
+    m_DeviceCaps.bIndirectDrawCountSupported = m_LogicalVkDevice->IsDrawIndirectCountSupported();
+
+    m_MemoryMgr.SetMemoryBudgetCallback(EngineCI.MemoryBudgetCallback, EngineCI.pMemoryBudgetCallbackUserData);
+    m_MemoryMgr.SetDefragmentationParameters(EngineCI.MemoryDefragmentationPagesPerFrame, EngineCI.MemoryDefragmentationUsageThreshold);
+
+    if (m_EngineAttribs.EnableBindlessResources)
+    {
+        if (m_LogicalVkDevice->IsDescriptorIndexingEnabled())
+        {
+            m_pBindlessHeap.reset(new BindlessResourceHeapVk{*this, EngineCI.BindlessHeapSize});
+        }
+        else
+        {
+            LOG_WARNING_MESSAGE("Bindless resources are requested, but " VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME " extension is not enabled by the logical device. Bindless resources will be disabled.");
+            m_EngineAttribs.EnableBindlessResources = false;
+        }
+    }
+
+    if (m_EngineAttribs.EnableBufferSuballocation)
+    {
+        m_pBufferSuballocator.reset(new BufferSuballocatorVk{*this, EngineCI.BufferSuballocationPageSize, EngineCI.MaxSuballocatedBufferSize});
+    }
 }
 
 RenderDeviceVkImpl::~RenderDeviceVkImpl()
@@ -170,6 +195,12 @@ RenderDeviceVkImpl::~RenderDeviceVkImpl()
     // Immediately destroys all command pools
     m_TransientCmdPoolMgr.DestroyPools();
 
+    // All bindless indices have been returned to the heap by ReleaseStaleResources()
+    m_pBindlessHeap.reset();
+
+    // All suballocated regions have been returned to their pages by ReleaseStaleResources()
+    m_pBufferSuballocator.reset();
+
     // We must destroy command queues explicitly prior to releasing Vulkan device
     DestroyCommandQueues();
 
@@ -312,6 +343,9 @@ void RenderDeviceVkImpl::FlushStaleResources(Uint32 CmdQueueIndex)
 
 void RenderDeviceVkImpl::ReleaseStaleResources(bool ForceRelease)
 {
+    // ReleaseStaleResources() is called by the swap chain once per frame, which makes it 
+    // the natural place to advance incremental defragmentation
+    m_MemoryMgr.DefragmentMemory();
     m_MemoryMgr.ShrinkMemory();
     PurgeReleaseQueues(ForceRelease);
 }
@@ -411,6 +445,7 @@ IMPLEMENT_QUERY_INTERFACE( RenderDeviceVkImpl, IID_RenderDeviceVk, TRenderDevice
 
 void RenderDeviceVkImpl::CreatePipelineState(const PipelineStateDesc &PipelineDesc, IPipelineState **ppPipelineState)
 {
+    CPU_PROFILE_SCOPE("RenderDeviceVkImpl::CreatePipelineState");
     CreateDeviceObject("Pipeline State", PipelineDesc, ppPipelineState, 
         [&]()
         {
@@ -421,6 +456,19 @@ void RenderDeviceVkImpl::CreatePipelineState(const PipelineStateDesc &PipelineDe
     );
 }
 
+void RenderDeviceVkImpl::CreatePipelineStateAsync(const PipelineStateDesc& PipelineDesc, IPipelineState* pFallbackPSO, IPipelineState** ppPipelineState)
+{
+    CPU_PROFILE_SCOPE("RenderDeviceVkImpl::CreatePipelineStateAsync");
+    CreateDeviceObject("Pipeline State", PipelineDesc, ppPipelineState, 
+        [&]()
+        {
+            PipelineStateVkImpl *pPipelineStateVk( NEW_RC_OBJ(m_PSOAllocator, "PipelineStateVkImpl instance", PipelineStateVkImpl)(this, PipelineDesc, true, pFallbackPSO) );
+            pPipelineStateVk->QueryInterface( IID_PipelineState, reinterpret_cast<IObject**>(ppPipelineState) );
+            OnCreateDeviceObject( pPipelineStateVk );
+        } 
+    );
+}
+
 
 void RenderDeviceVkImpl :: CreateBufferFromVulkanResource(VkBuffer vkBuffer, const BufferDesc& BuffDesc, RESOURCE_STATE InitialState, IBuffer** ppBuffer)
 {
@@ -452,6 +500,7 @@ void RenderDeviceVkImpl :: CreateBuffer(const BufferDesc& BuffDesc, const Buffer
 
 void RenderDeviceVkImpl :: CreateShader(const ShaderCreateInfo& ShaderCI, IShader **ppShader)
 {
+    CPU_PROFILE_SCOPE("RenderDeviceVkImpl::CreateShader");
     CreateDeviceObject( "shader", ShaderCI.Desc, ppShader, 
         [&]()
         {
@@ -31,6 +31,7 @@
 #include "TextureVkImpl.h"
 #include "SamplerVkImpl.h"
 #include "VulkanTypeConversions.h"
+#include "HashUtils.h"
 
 namespace Diligent
 {
@@ -494,4 +495,60 @@ Uint32 ShaderResourceCacheVk::GetDynamicBufferOffsets(DeviceContextVkImpl *pCtxV
     return OffsetInd;
 }
 
+
+size_t ShaderResourceCacheVk::GetDescriptorSetResourceIds(Uint32 SetIndex, std::vector<UniqueIdentifier>& ResourceIds)const
+{
+    const auto& Set = GetDescriptorSet(SetIndex);
+    ResourceIds.clear();
+    size_t Hash = 0;
+    for (Uint32 r=0; r < Set.GetSize(); ++r)
+    {
+        const auto& Res = Set.GetResource(r);
+        UniqueIdentifier Id = 0;
+        if (Res.pObject)
+        {
+            switch (Res.Type)
+            {
+                case SPIRVShaderResourceAttribs::ResourceType::UniformBuffer:
+                    Id = Res.pObject.RawPtr<const BufferVkImpl>()->GetUniqueID();
+                break;
+
+                case SPIRVShaderResourceAttribs::ResourceType::ROStorageBuffer:
+                case SPIRVShaderResourceAttribs::ResourceType::RWStorageBuffer:
+                case SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer:
+                case SPIRVShaderResourceAttribs::ResourceType::StorageTexelBuffer:
+                    Id = Res.pObject.RawPtr<const BufferViewVkImpl>()->GetUniqueID();
+                break;
+
+                case SPIRVShaderResourceAttribs::ResourceType::StorageImage:
+                case SPIRVShaderResourceAttribs::ResourceType::SeparateImage:
+                    Id = Res.pObject.RawPtr<const TextureViewVkImpl>()->GetUniqueID();
+                break;
+
+                case SPIRVShaderResourceAttribs::ResourceType::SampledImage:
+                {
+                    const auto* pTexViewVk = Res.pObject.RawPtr<const TextureViewVkImpl>();
+                    Id = pTexViewVk->GetUniqueID();
+                    // Combined image sampler descriptors also reference the sampler assigned to the view, 
+                    // which may be changed after the view is created
+                    const auto* pSamplerVk = ValidatedCast<const SamplerVkImpl>(pTexViewVk->GetSampler());
+                    UniqueIdentifier SamplerId = pSamplerVk != nullptr ? pSamplerVk->GetUniqueID() : 0;
+                    ResourceIds.push_back(SamplerId);
+                    HashCombine(Hash, SamplerId);
+                }
+                break;
+
+                case SPIRVShaderResourceAttribs::ResourceType::SeparateSampler:
+                    Id = Res.pObject.RawPtr<const SamplerVkImpl>()->GetUniqueID();
+                break;
+
+                default: UNEXPECTED("Unexpected resource type");
+            }
+        }
+        ResourceIds.push_back(Id);
+        HashCombine(Hash, Id);
+    }
+    return Hash;
+}
+
 }
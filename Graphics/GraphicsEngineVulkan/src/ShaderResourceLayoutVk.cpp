@@ -818,6 +818,12 @@ void ShaderResourceLayoutVk::VkResource::BindResource(IDeviceObject* pObj, Uint3
     auto& DstRes = DstDescrSet.GetResource(CacheOffset + ArrayIndex);
     VERIFY(DstRes.Type == SpirvAttribs.Type, "Inconsistent types");
 
+    // Dynamic variables are often set to the same object before every draw call. The cached object
+    // has already been validated, so skip QueryInterface() and reference counting in this case.
+    // Separate images still need to update the separate sampler that may have been changed in the view.
+    if (pObj != nullptr && DstRes.pObject.RawPtr() == pObj && SamplerInd == InvalidSamplerInd)
+        return;
+
     if( pObj )
     {
         switch (SpirvAttribs.Type)
@@ -1166,4 +1172,113 @@ void ShaderResourceLayoutVk::CommitDynamicResources(const ShaderResourceCacheVk&
     }
 }
 
+// Returns the size of the descriptor data of one array element in the descriptor update template,
+// or 0 if the resource does not need to be written
+static size_t GetDescriptorUpdateDataStride(const ShaderResourceLayoutVk::VkResource& Res)
+{
+    switch (Res.SpirvAttribs.Type)
+    {
+        case SPIRVShaderResourceAttribs::ResourceType::UniformBuffer:
+        case SPIRVShaderResourceAttribs::ResourceType::ROStorageBuffer:
+        case SPIRVShaderResourceAttribs::ResourceType::RWStorageBuffer:
+            return sizeof(VkDescriptorBufferInfo);
+
+        case SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer:
+        case SPIRVShaderResourceAttribs::ResourceType::StorageTexelBuffer:
+            return sizeof(VkBufferView);
+
+        case SPIRVShaderResourceAttribs::ResourceType::SeparateImage:
+        case SPIRVShaderResourceAttribs::ResourceType::StorageImage:
+        case SPIRVShaderResourceAttribs::ResourceType::SampledImage:
+            return sizeof(VkDescriptorImageInfo);
+
+        case SPIRVShaderResourceAttribs::ResourceType::SeparateSampler:
+            // Immutable samplers are permanently bound into the set layout
+            return Res.IsImmutableSamplerAssigned() ? 0 : sizeof(VkDescriptorImageInfo);
+
+        case SPIRVShaderResourceAttribs::ResourceType::AtomicCounter:
+            return 0;
+
+        default:
+            UNEXPECTED("Unexpected resource type");
+            return 0;
+    }
+}
+
+void ShaderResourceLayoutVk::GetDynamicResourceUpdateTemplateEntries(std::vector<VkDescriptorUpdateTemplateEntryKHR>& Entries,
+                                                                     size_t&                                          DataSize)const
+{
+    Uint32 NumDynamicResources = m_NumResources[SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC];
+    for (Uint32 r = 0; r < NumDynamicResources; ++r)
+    {
+        const auto& Res = GetResource(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC, r);
+        const auto Stride = GetDescriptorUpdateDataStride(Res);
+        if (Stride == 0)
+            continue;
+
+        VkDescriptorUpdateTemplateEntryKHR Entry = {};
+        Entry.dstBinding      = Res.Binding;
+        Entry.dstArrayElement = 0;
+        Entry.descriptorCount = Res.SpirvAttribs.ArraySize;
+        Entry.descriptorType  = PipelineLayout::GetVkDescriptorType(Res.SpirvAttribs);
+        Entry.offset          = DataSize;
+        Entry.stride          = Stride;
+        Entries.push_back(Entry);
+
+        // All descriptor info structures are multiples of 8 bytes, so the data remains properly aligned
+        DataSize += Stride * Res.SpirvAttribs.ArraySize;
+    }
+}
+
+Uint8* ShaderResourceLayoutVk::WriteDynamicResourceUpdateData(const ShaderResourceCacheVk& ResourceCache,
+                                                              Uint8*                       pData)const
+{
+    Uint32 NumDynamicResources = m_NumResources[SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC];
+    for (Uint32 r = 0; r < NumDynamicResources; ++r)
+    {
+        const auto& Res = GetResource(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC, r);
+        const auto Stride = GetDescriptorUpdateDataStride(Res);
+        if (Stride == 0)
+            continue;
+
+        const auto& SetResources = ResourceCache.GetDescriptorSet(Res.DescriptorSet);
+        VERIFY(SetResources.GetVkDescriptorSet() == VK_NULL_HANDLE, "Dynamic descriptor set must not be assigned to the resource cache");
+        for (Uint32 ArrElem = 0; ArrElem < Res.SpirvAttribs.ArraySize; ++ArrElem)
+        {
+            const auto& CachedRes = SetResources.GetResource(Res.CacheOffset + ArrElem);
+            switch (Res.SpirvAttribs.Type)
+            {
+                case SPIRVShaderResourceAttribs::ResourceType::UniformBuffer:
+                    *reinterpret_cast<VkDescriptorBufferInfo*>(pData) = CachedRes.GetUniformBufferDescriptorWriteInfo();
+                break;
+
+                case SPIRVShaderResourceAttribs::ResourceType::ROStorageBuffer:
+                case SPIRVShaderResourceAttribs::ResourceType::RWStorageBuffer:
+                    *reinterpret_cast<VkDescriptorBufferInfo*>(pData) = CachedRes.GetStorageBufferDescriptorWriteInfo();
+                break;
+
+                case SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer:
+                case SPIRVShaderResourceAttribs::ResourceType::StorageTexelBuffer:
+                    *reinterpret_cast<VkBufferView*>(pData) = CachedRes.GetBufferViewWriteInfo();
+                break;
+
+                case SPIRVShaderResourceAttribs::ResourceType::SeparateImage:
+                case SPIRVShaderResourceAttribs::ResourceType::StorageImage:
+                case SPIRVShaderResourceAttribs::ResourceType::SampledImage:
+                    *reinterpret_cast<VkDescriptorImageInfo*>(pData) = CachedRes.GetImageDescriptorWriteInfo(Res.IsImmutableSamplerAssigned());
+                break;
+
+                case SPIRVShaderResourceAttribs::ResourceType::SeparateSampler:
+                    *reinterpret_cast<VkDescriptorImageInfo*>(pData) = CachedRes.GetSamplerDescriptorWriteInfo();
+                break;
+
+                default:
+                    UNEXPECTED("Unexpected resource type");
+            }
+            pData += Stride;
+        }
+    }
+    return pData;
+}
+
 }
@@ -47,8 +47,37 @@ TextureViewVkImpl::TextureViewVkImpl( IReferenceCounters*                 pRefCo
 {
 }
 
+static BINDLESS_BINDING_VK GetBindlessBinding(TEXTURE_VIEW_TYPE ViewType)
+{
+    VERIFY_EXPR(ViewType == TEXTURE_VIEW_SHADER_RESOURCE || ViewType == TEXTURE_VIEW_UNORDERED_ACCESS);
+    return ViewType == TEXTURE_VIEW_UNORDERED_ACCESS ? BINDLESS_BINDING_VK_STORAGE_IMAGES : BINDLESS_BINDING_VK_SAMPLED_IMAGES;
+}
+
+void TextureViewVkImpl::AllocateBindlessIndex(BindlessResourceHeapVk& BindlessHeap)
+{
+    VERIFY(m_BindlessIndex == InvalidBindlessIndexVk, "Bindless index has already been allocated");
+
+    // Layouts must match the layouts used by ShaderResourceCacheVk::Resource::GetImageDescriptorWriteInfo().
+    // Textures accessed through the bindless heap are not transitioned by the engine; the application 
+    // is responsible for transitioning them to the appropriate state.
+    VkImageLayout Layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    if (m_Desc.ViewType == TEXTURE_VIEW_UNORDERED_ACCESS)
+        Layout = VK_IMAGE_LAYOUT_GENERAL;
+    else if (m_pTexture->GetDesc().BindFlags & BIND_DEPTH_STENCIL)
+        Layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+
+    m_BindlessIndex = BindlessHeap.AllocateImageDescriptor(GetBindlessBinding(m_Desc.ViewType), m_ImageView, Layout);
+}
+
 TextureViewVkImpl::~TextureViewVkImpl()
 {
+    if (m_BindlessIndex != InvalidBindlessIndexVk)
+    {
+        auto* pBindlessHeap = m_pDevice->GetBindlessResourceHeap();
+        VERIFY_EXPR(pBindlessHeap != nullptr);
+        pBindlessHeap->FreeDescriptor(GetBindlessBinding(m_Desc.ViewType), m_BindlessIndex, m_pTexture->GetDesc().CommandQueueMask);
+    }
+
     if (m_MipLevelViews != nullptr)
     {
         for (Uint32 MipView=0; MipView < m_Desc.NumMipLevels * 2; ++MipView)
@@ -518,6 +518,13 @@ void TextureVkImpl::CreateViewInternal(const TextureViewDesc& ViewDesc, ITexture
                                  (GetDevice(), UpdatedViewDesc, this, std::move(ImgView), bIsDefaultView);
         VERIFY( pViewVk->GetDesc().ViewType == ViewDesc.ViewType, "Incorrect view type" );
 
+        // Internal mip level views are never accessed through the bindless heap
+        if (auto* pBindlessHeap = m_pDevice->GetBindlessResourceHeap())
+        {
+            if (UpdatedViewDesc.ViewType == TEXTURE_VIEW_SHADER_RESOURCE || UpdatedViewDesc.ViewType == TEXTURE_VIEW_UNORDERED_ACCESS)
+                pViewVk->AllocateBindlessIndex(*pBindlessHeap);
+        }
+
         if (bIsDefaultView)
             *ppView = pViewVk;
         else
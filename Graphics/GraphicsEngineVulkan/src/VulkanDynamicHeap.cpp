@@ -25,6 +25,7 @@
 #include <chrono>
 #include <thread>
 #include "VulkanDynamicHeap.h"
+#include "CPUProfiler.h"
 #include "RenderDeviceVkImpl.h"
 
 namespace Diligent
@@ -126,6 +127,7 @@ VulkanDynamicMemoryManager::~VulkanDynamicMemoryManager()
 
 VulkanDynamicMemoryManager::MasterBlock VulkanDynamicMemoryManager::AllocateMasterBlock(OffsetType SizeInBytes, OffsetType Alignment)
 {
+    CPU_PROFILE_SCOPE("VulkanDynamicMemoryManager::AllocateMasterBlock");
     if (Alignment == 0)
         Alignment = MasterBlockAlignment;
    
@@ -23,6 +23,7 @@
 
 #include "pch.h"
 #include "VulkanUploadHeap.h"
+#include "CPUProfiler.h"
 #include "RenderDeviceVkImpl.h"
 
 namespace Diligent
@@ -47,6 +48,7 @@ VulkanUploadHeap::~VulkanUploadHeap()
 
 VulkanUploadHeap::UploadPageInfo VulkanUploadHeap::CreateNewPage(VkDeviceSize SizeInBytes)const
 {
+    CPU_PROFILE_SCOPE("VulkanUploadHeap::CreateNewPage");
     VkBufferCreateInfo StagingBufferCI = {};
     StagingBufferCI.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
     StagingBufferCI.pNext                 = nullptr;
@@ -231,22 +231,25 @@ static VkPipelineStageFlags AccessMaskFromImageLayout(VkImageLayout Layout,
     return AccessMask;
 }
 
-void VulkanCommandBuffer::TransitionImageLayout(VkCommandBuffer                CmdBuffer,
-                                                VkImage                        Image,
-                                                VkImageLayout                  OldLayout,
-                                                VkImageLayout                  NewLayout,
-                                                const VkImageSubresourceRange& SubresRange,
-                                                VkPipelineStageFlags           EnabledGraphicsShaderStages,
-                                                VkPipelineStageFlags           SrcStages, 
-                                                VkPipelineStageFlags           DestStages)
+static constexpr VkAccessFlags WriteAccessMask = 
+    VK_ACCESS_SHADER_WRITE_BIT                  |
+    VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT        |
+    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT|
+    VK_ACCESS_TRANSFER_WRITE_BIT                |
+    VK_ACCESS_HOST_WRITE_BIT                    |
+    VK_ACCESS_MEMORY_WRITE_BIT;
+
+static void InitImageBarrier(VkImageMemoryBarrier&          ImgBarrier,
+                             VkImage                        Image,
+                             VkImageLayout                  OldLayout,
+                             VkImageLayout                  NewLayout,
+                             const VkImageSubresourceRange& SubresRange,
+                             VkPipelineStageFlags           EnabledGraphicsShaderStages,
+                             VkPipelineStageFlags&          SrcStages, 
+                             VkPipelineStageFlags&          DestStages)
 {
-    VERIFY_EXPR(CmdBuffer != VK_NULL_HANDLE);
-
-    VkImageMemoryBarrier ImgBarrier = {};
     ImgBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     ImgBarrier.pNext = nullptr;
-    ImgBarrier.srcAccessMask = 0;
-    ImgBarrier.dstAccessMask = 0;
     ImgBarrier.oldLayout = OldLayout;
     ImgBarrier.newLayout = NewLayout;
     ImgBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED; // source queue family for a queue family ownership transfer.
@@ -299,6 +302,59 @@ void VulkanCommandBuffer::TransitionImageLayout(VkCommandBuffer                C
     // synchronization scope includes logically later pipeline stages.
     // However, note that access scopes are not affected in this way - only the precise stages specified 
     // are considered part of each access scope.  (6.1.2)
+}
+
+static void InitBufferBarrier(VkBufferMemoryBarrier& BuffBarrier,
+                              VkBuffer               Buffer, 
+                              VkAccessFlags          srcAccessMask,
+                              VkAccessFlags          dstAccessMask,
+                              VkPipelineStageFlags   EnabledGraphicsShaderStages,
+                              VkPipelineStageFlags&  SrcStages, 
+                              VkPipelineStageFlags&  DestStages,
+                              VkDeviceSize           Offset = 0,
+                              VkDeviceSize           Size   = VK_WHOLE_SIZE)
+{
+    BuffBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    BuffBarrier.pNext = nullptr;
+    BuffBarrier.srcAccessMask = srcAccessMask;
+    BuffBarrier.dstAccessMask = dstAccessMask;
+    BuffBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    BuffBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    BuffBarrier.buffer = Buffer;
+    BuffBarrier.offset = Offset;
+    BuffBarrier.size   = Size;
+    if (SrcStages == 0)
+    {
+        if (BuffBarrier.srcAccessMask != 0)
+            SrcStages = PipelineStageFromAccessFlags(BuffBarrier.srcAccessMask, EnabledGraphicsShaderStages);
+        else
+        {
+            // An execution dependency with only VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT in the source stage 
+            // mask will effectively not wait for any prior commands to complete. (6.1.2)
+            SrcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        }
+    }
+
+    if (DestStages == 0)
+    {
+        VERIFY(BuffBarrier.dstAccessMask != 0, "Dst access mask must not be zero");
+        DestStages = PipelineStageFromAccessFlags(BuffBarrier.dstAccessMask, EnabledGraphicsShaderStages);
+    }
+}
+
+void VulkanCommandBuffer::TransitionImageLayout(VkCommandBuffer                CmdBuffer,
+                                                VkImage                        Image,
+                                                VkImageLayout                  OldLayout,
+                                                VkImageLayout                  NewLayout,
+                                                const VkImageSubresourceRange& SubresRange,
+                                                VkPipelineStageFlags           EnabledGraphicsShaderStages,
+                                                VkPipelineStageFlags           SrcStages, 
+                                                VkPipelineStageFlags           DestStages)
+{
+    VERIFY_EXPR(CmdBuffer != VK_NULL_HANDLE);
+
+    VkImageMemoryBarrier ImgBarrier;
+    InitImageBarrier(ImgBarrier, Image, OldLayout, NewLayout, SubresRange, EnabledGraphicsShaderStages, SrcStages, DestStages);
 
     vkCmdPipelineBarrier(CmdBuffer,
         SrcStages,  // must not be 0
@@ -327,33 +383,8 @@ void VulkanCommandBuffer::BufferMemoryBarrier(VkCommandBuffer      CmdBuffer,
                                               VkPipelineStageFlags SrcStages, 
                                               VkPipelineStageFlags DestStages)
 {
-    VkBufferMemoryBarrier BuffBarrier = {};
-    BuffBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
-    BuffBarrier.pNext = nullptr;
-    BuffBarrier.srcAccessMask = srcAccessMask;
-    BuffBarrier.dstAccessMask = dstAccessMask;
-    BuffBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    BuffBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    BuffBarrier.buffer = Buffer;
-    BuffBarrier.offset = 0;
-    BuffBarrier.size   = VK_WHOLE_SIZE;
-    if (SrcStages == 0)
-    {
-        if (BuffBarrier.srcAccessMask != 0)
-            SrcStages = PipelineStageFromAccessFlags(BuffBarrier.srcAccessMask, EnabledGraphicsShaderStages);
-        else
-        {
-            // An execution dependency with only VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT in the source stage 
-            // mask will effectively not wait for any prior commands to complete. (6.1.2)
-            SrcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-        }
-    }
-
-    if (DestStages == 0)
-    {
-        VERIFY(BuffBarrier.dstAccessMask != 0, "Dst access mask must not be zero");
-        DestStages = PipelineStageFromAccessFlags(BuffBarrier.dstAccessMask, EnabledGraphicsShaderStages);
-    }
+    VkBufferMemoryBarrier BuffBarrier;
+    InitBufferBarrier(BuffBarrier, Buffer, srcAccessMask, dstAccessMask, EnabledGraphicsShaderStages, SrcStages, DestStages);
 
     vkCmdPipelineBarrier(CmdBuffer,
         SrcStages,    // must not be 0
@@ -367,9 +398,150 @@ void VulkanCommandBuffer::BufferMemoryBarrier(VkCommandBuffer      CmdBuffer,
         nullptr);
 }
 
-void VulkanCommandBuffer::FlushBarriers()
+static bool SubresourceRangesOverlap(const VkImageSubresourceRange& Range0, const VkImageSubresourceRange& Range1)
+{
+    auto RangesOverlap = [](uint32_t Start0, uint32_t Count0, uint32_t Start1, uint32_t Count1)
+    {
+        // VK_REMAINING_MIP_LEVELS and VK_REMAINING_ARRAY_LAYERS extend the range to the end of the resource
+        auto End0 = Count0 == ~0u ? ~0u : Start0 + Count0;
+        auto End1 = Count1 == ~0u ? ~0u : Start1 + Count1;
+        return Start0 < End1 && Start1 < End0;
+    };
+    return (Range0.aspectMask & Range1.aspectMask) != 0 &&
+           RangesOverlap(Range0.baseMipLevel,   Range0.levelCount, Range1.baseMipLevel,   Range1.levelCount) &&
+           RangesOverlap(Range0.baseArrayLayer, Range0.layerCount, Range1.baseArrayLayer, Range1.layerCount);
+}
+
+void VulkanCommandBuffer::AddImageBarrier(VkImage                        Image,
+                                          VkImageLayout                  OldLayout,
+                                          VkImageLayout                  NewLayout,
+                                          const VkImageSubresourceRange& SubresRange,
+                                          VkPipelineStageFlags           SrcStages, 
+                                          VkPipelineStageFlags           DestStages)
 {
+    ++m_BarrierStats.NumRequestedBarriers;
+
+    VkImageMemoryBarrier ImgBarrier;
+    InitImageBarrier(ImgBarrier, Image, OldLayout, NewLayout, SubresRange, m_EnabledGraphicsShaderStages, SrcStages, DestStages);
+
+    // The pending barrier is merged first, so that the accesses of the new state are made
+    // visible when the pending barrier synchronizes a write
+    bool FlushPending = false;
+    for (auto& PendingBarrier : m_PendingImageBarriers)
+    {
+        if (PendingBarrier.image != Image)
+            continue;
+
+        const auto& PendingRange = PendingBarrier.subresourceRange;
+        if (PendingBarrier.newLayout    == OldLayout                  &&
+            PendingRange.aspectMask     == SubresRange.aspectMask     &&
+            PendingRange.baseMipLevel   == SubresRange.baseMipLevel   &&
+            PendingRange.levelCount     == SubresRange.levelCount     &&
+            PendingRange.baseArrayLayer == SubresRange.baseArrayLayer &&
+            PendingRange.layerCount     == SubresRange.layerCount)
+        {
+            // No commands have been recorded since the pending barrier, so intermediate
+            // layout is never accessed and both transitions can be performed at once
+            PendingBarrier.newLayout      = NewLayout;
+            PendingBarrier.dstAccessMask |= ImgBarrier.dstAccessMask;
+            m_PendingDstStages |= DestStages;
+            ++m_BarrierStats.NumMergedBarriers;
+            return;
+        }
 
+        if (SubresourceRangesOverlap(PendingRange, SubresRange))
+        {
+            // Barriers in the same vkCmdPipelineBarrier() command are not ordered, so
+            // transitions of overlapping subresources must be separated
+            FlushPending = true;
+            break;
+        }
+    }
+
+    // Read-to-read transition that does not change the layout has no effect if the new accesses
+    // and stages are already covered by the old ones: the data have been made visible to them
+    if (OldLayout == NewLayout && ((ImgBarrier.srcAccessMask | ImgBarrier.dstAccessMask) & WriteAccessMask) == 0 &&
+        (ImgBarrier.dstAccessMask & ~ImgBarrier.srcAccessMask) == 0 && (DestStages & ~SrcStages) == 0)
+    {
+        ++m_BarrierStats.NumSkippedBarriers;
+        return;
+    }
+
+    if (FlushPending)
+        FlushBarriers();
+
+    m_PendingImageBarriers.push_back(ImgBarrier);
+    m_PendingSrcStages |= SrcStages;
+    m_PendingDstStages |= DestStages;
+}
+
+void VulkanCommandBuffer::AddBufferBarrier(VkBuffer             Buffer, 
+                                           VkAccessFlags        srcAccessMask,
+                                           VkAccessFlags        dstAccessMask,
+                                           VkPipelineStageFlags SrcStages, 
+                                           VkPipelineStageFlags DestStages,
+                                           VkDeviceSize         Offset,
+                                           VkDeviceSize         Size)
+{
+    ++m_BarrierStats.NumRequestedBarriers;
+
+    VkBufferMemoryBarrier BuffBarrier;
+    InitBufferBarrier(BuffBarrier, Buffer, srcAccessMask, dstAccessMask, m_EnabledGraphicsShaderStages, SrcStages, DestStages, Offset, Size);
+
+    // The pending barrier is merged first, so that the accesses of the new state are made
+    // visible when the pending barrier synchronizes a write
+    for (auto& PendingBarrier : m_PendingBufferBarriers)
+    {
+        // Buffers suballocated from the same VkBuffer are different resources
+        if (PendingBarrier.buffer == Buffer && PendingBarrier.offset == Offset && PendingBarrier.size == Size)
+        {
+            // No commands have been recorded since the pending barrier
+            PendingBarrier.dstAccessMask |= dstAccessMask;
+            m_PendingDstStages |= DestStages;
+            ++m_BarrierStats.NumMergedBarriers;
+            return;
+        }
+    }
+
+    // There is no hazard between two reads, and buffers do not have layouts. The barrier may only 
+    // be skipped if the new accesses and stages are already covered by the old ones, otherwise 
+    // the data written before the old state may not be visible to them.
+    if (((srcAccessMask | dstAccessMask) & WriteAccessMask) == 0 &&
+        (dstAccessMask & ~srcAccessMask) == 0 && (DestStages & ~SrcStages) == 0)
+    {
+        ++m_BarrierStats.NumSkippedBarriers;
+        return;
+    }
+
+    m_PendingBufferBarriers.push_back(BuffBarrier);
+    m_PendingSrcStages |= SrcStages;
+    m_PendingDstStages |= DestStages;
+}
+
+void VulkanCommandBuffer::EmitPendingBarriers()
+{
+    VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+    VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "Pipeline barriers must be recorded outside of render pass");
+    VERIFY_EXPR(m_PendingSrcStages != 0 && m_PendingDstStages != 0);
+
+    vkCmdPipelineBarrier(m_VkCmdBuffer,
+        m_PendingSrcStages,
+        m_PendingDstStages,
+        0,       // a bitmask specifying how execution and memory dependencies are formed
+        0,       // memoryBarrierCount
+        nullptr, // pMemoryBarriers
+        static_cast<uint32_t>(m_PendingBufferBarriers.size()),
+        m_PendingBufferBarriers.empty() ? nullptr : m_PendingBufferBarriers.data(),
+        static_cast<uint32_t>(m_PendingImageBarriers.size()),
+        m_PendingImageBarriers.empty() ? nullptr : m_PendingImageBarriers.data());
+
+    m_BarrierStats.NumEmittedBarriers += m_PendingBufferBarriers.size() + m_PendingImageBarriers.size();
+    ++m_BarrierStats.NumPipelineBarrierCommands;
+
+    m_PendingBufferBarriers.clear();
+    m_PendingImageBarriers.clear();
+    m_PendingSrcStages = 0;
+    m_PendingDstStages = 0;
 }
 
 }
@@ -53,22 +53,24 @@ namespace VulkanUtilities
         DEV_CHECK_ERR(m_BuffCounter == 0, m_BuffCounter, " command buffer(s) have not been returned to the pool. If there are outstanding references to these buffers in release queues, FreeCommandBuffer() will crash when attempting to return a buffer to the pool.");
     }
 
-    VkCommandBuffer VulkanCommandBufferPool::GetCommandBuffer(const char* DebugName)
+    VkCommandBuffer VulkanCommandBufferPool::GetCommandBuffer(const char* DebugName, const VkCommandBufferInheritanceInfo* pInheritanceInfo)
     {
         VkCommandBuffer CmdBuffer = VK_NULL_HANDLE;
 
+        const bool IsSecondary = pInheritanceInfo != nullptr;
         {
             std::lock_guard<std::mutex> Lock{m_Mutex};
 
-            if (!m_CmdBuffers.empty())
+            auto& CmdBuffers = IsSecondary ? m_SecondaryCmdBuffers : m_CmdBuffers;
+            if (!CmdBuffers.empty())
             {
-                CmdBuffer = m_CmdBuffers.front();
+                CmdBuffer = CmdBuffers.front();
                 auto err = vkResetCommandBuffer(CmdBuffer, 
                     0 // VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT -  specifies that most or all memory resources currently 
                       // owned by the command buffer should be returned to the parent command pool.
                 );
                 DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to reset command buffer"); (void)err;
-                m_CmdBuffers.pop_front();
+                CmdBuffers.pop_front();
             }
         }
 
@@ -79,7 +81,7 @@ namespace VulkanUtilities
             BuffAllocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
             BuffAllocInfo.pNext              = nullptr;
             BuffAllocInfo.commandPool        = m_CmdPool;
-            BuffAllocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            BuffAllocInfo.level              = IsSecondary ? VK_COMMAND_BUFFER_LEVEL_SECONDARY : VK_COMMAND_BUFFER_LEVEL_PRIMARY;
             BuffAllocInfo.commandBufferCount = 1;
 
             CmdBuffer = m_LogicalDevice->AllocateVkCommandBuffer(BuffAllocInfo);
@@ -92,7 +94,12 @@ namespace VulkanUtilities
         CmdBuffBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT; // Each recording of the command buffer will only be 
                                                                               // submitted once, and the command buffer will be reset 
                                                                               // and recorded again between each submission.
-        CmdBuffBeginInfo.pInheritanceInfo = nullptr; // Ignored for a primary command buffer
+        if (IsSecondary && pInheritanceInfo->renderPass != VK_NULL_HANDLE)
+        {
+            // The secondary command buffer will be executed entirely inside a render pass
+            CmdBuffBeginInfo.flags |= VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+        }
+        CmdBuffBeginInfo.pInheritanceInfo = pInheritanceInfo; // Ignored for a primary command buffer
         auto err = vkBeginCommandBuffer(CmdBuffer, &CmdBuffBeginInfo);
         DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to begin command buffer"); (void)err;
 #ifdef DEVELOPMENT
@@ -101,10 +108,10 @@ namespace VulkanUtilities
         return CmdBuffer;
     }
 
-    void VulkanCommandBufferPool::FreeCommandBuffer(VkCommandBuffer&& CmdBuffer)
+    void VulkanCommandBufferPool::FreeCommandBuffer(VkCommandBuffer&& CmdBuffer, bool IsSecondary)
     {
         std::lock_guard<std::mutex> Lock{m_Mutex};
-        m_CmdBuffers.emplace_back(CmdBuffer);
+        (IsSecondary ? m_SecondaryCmdBuffers : m_CmdBuffers).emplace_back(CmdBuffer);
         CmdBuffer = VK_NULL_HANDLE;
 #ifdef DEVELOPMENT
         --m_BuffCounter;
@@ -115,6 +122,7 @@ namespace VulkanUtilities
     {
         m_LogicalDevice.reset();
         m_CmdBuffers.clear();
+        m_SecondaryCmdBuffers.clear();
         return std::move(m_CmdPool);
     }
 }
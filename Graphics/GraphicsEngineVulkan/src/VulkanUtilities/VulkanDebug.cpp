@@ -364,6 +364,11 @@ namespace VulkanUtilities
         SetObjectName(device, (uint64_t)descriptorPool, VK_OBJECT_TYPE_DESCRIPTOR_POOL, name);
     }
 
+    void SetDescriptorUpdateTemplateName(VkDevice device, VkDescriptorUpdateTemplateKHR descriptorUpdateTemplate, const char * name)
+    {
+        SetObjectName(device, (uint64_t)descriptorUpdateTemplate, VK_OBJECT_TYPE_DESCRIPTOR_UPDATE_TEMPLATE, name);
+    }
+
     void SetSemaphoreName(VkDevice device, VkSemaphore semaphore, const char * name)
     {
         SetObjectName(device, (uint64_t)semaphore, VK_OBJECT_TYPE_SEMAPHORE, name);
@@ -467,6 +472,11 @@ namespace VulkanUtilities
         SetDescriptorPoolName(device, descriptorPool, name);
     }
 
+    void SetVulkanObjectName(VkDevice device, VkDescriptorUpdateTemplateKHR descriptorUpdateTemplate, const char * name)
+    {
+        SetDescriptorUpdateTemplateName(device, descriptorUpdateTemplate, name);
+    }
+
     void SetVulkanObjectName(VkDevice device, VkSemaphore semaphore, const char * name)
     {
         SetSemaphoreName(device, semaphore, name);
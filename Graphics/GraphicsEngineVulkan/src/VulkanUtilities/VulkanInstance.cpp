@@ -141,6 +141,17 @@ namespace VulkanUtilities
             }
         }
 
+        // Extended physical device feature queries are required to detect descriptor indexing support
+        bool PhysicalDeviceProperties2Enabled = IsExtensionAvailable(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+        if (PhysicalDeviceProperties2Enabled)
+        {
+            bool AlreadyRequested = false;
+            for (const auto* ExtName : GlobalExtensions)
+                AlreadyRequested = AlreadyRequested || strcmp(ExtName, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) == 0;
+            if (!AlreadyRequested)
+                GlobalExtensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+        }
+
         VkApplicationInfo appInfo = {};
         appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
         appInfo.pNext = nullptr; // Pointer to an extension-specific structure.
@@ -179,6 +190,13 @@ namespace VulkanUtilities
         auto res = vkCreateInstance(&InstanceCreateInfo, m_pVkAllocator, &m_VkInstance);
         CHECK_VK_ERROR_AND_THROW(res, "Failed to create Vulkan instance");
 
+        if (PhysicalDeviceProperties2Enabled)
+        {
+            m_vkGetPhysicalDeviceFeatures2KHR         = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>        (vkGetInstanceProcAddr(m_VkInstance, "vkGetPhysicalDeviceFeatures2KHR"));
+            m_vkGetPhysicalDeviceProperties2KHR       = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2KHR>      (vkGetInstanceProcAddr(m_VkInstance, "vkGetPhysicalDeviceProperties2KHR"));
+            m_vkGetPhysicalDeviceMemoryProperties2KHR = reinterpret_cast<PFN_vkGetPhysicalDeviceMemoryProperties2KHR>(vkGetInstanceProcAddr(m_VkInstance, "vkGetPhysicalDeviceMemoryProperties2KHR"));
+        }
+
         // If requested, we enable the default validation layers for debugging
         if (m_DebugUtilsEnabled)
         {
@@ -22,6 +22,7 @@
 */
 
 #include <limits>
+#include <cstring>
 #include "VulkanErrors.h"
 #include "VulkanUtilities/VulkanLogicalDevice.h"
 #include "VulkanUtilities/VulkanDebug.h"
@@ -55,6 +56,39 @@ namespace VulkanUtilities
             m_EnabledGraphicsShaderStages = VK_PIPELINE_STAGE_GEOMETRY_SHADER_BIT;
         if (DeviceCI.pEnabledFeatures->tessellationShader)
             m_EnabledGraphicsShaderStages = VK_PIPELINE_STAGE_TESSELLATION_CONTROL_SHADER_BIT | VK_PIPELINE_STAGE_TESSELLATION_EVALUATION_SHADER_BIT;
+        m_MultiDrawIndirectEnabled = DeviceCI.pEnabledFeatures->multiDrawIndirect != VK_FALSE;
+
+        for (uint32_t ext = 0; ext < DeviceCI.enabledExtensionCount; ++ext)
+        {
+            if (strcmp(DeviceCI.ppEnabledExtensionNames[ext], VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME) == 0)
+            {
+                m_vkCreateDescriptorUpdateTemplate  = reinterpret_cast<PFN_vkCreateDescriptorUpdateTemplateKHR> (vkGetDeviceProcAddr(m_VkDevice, "vkCreateDescriptorUpdateTemplateKHR"));
+                m_vkDestroyDescriptorUpdateTemplate = reinterpret_cast<PFN_vkDestroyDescriptorUpdateTemplateKHR>(vkGetDeviceProcAddr(m_VkDevice, "vkDestroyDescriptorUpdateTemplateKHR"));
+                m_vkUpdateDescriptorSetWithTemplate = reinterpret_cast<PFN_vkUpdateDescriptorSetWithTemplateKHR>(vkGetDeviceProcAddr(m_VkDevice, "vkUpdateDescriptorSetWithTemplateKHR"));
+                if (m_vkCreateDescriptorUpdateTemplate == nullptr || m_vkDestroyDescriptorUpdateTemplate == nullptr || m_vkUpdateDescriptorSetWithTemplate == nullptr)
+                {
+                    LOG_WARNING_MESSAGE("Failed to load descriptor update template functions. Descriptor update templates will be disabled.");
+                    m_vkCreateDescriptorUpdateTemplate  = nullptr;
+                    m_vkDestroyDescriptorUpdateTemplate = nullptr;
+                    m_vkUpdateDescriptorSetWithTemplate = nullptr;
+                }
+            }
+            else if (strcmp(DeviceCI.ppEnabledExtensionNames[ext], VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME) == 0)
+            {
+                m_vkCmdDrawIndirectCount        = reinterpret_cast<PFN_vkCmdDrawIndirectCountKHR>       (vkGetDeviceProcAddr(m_VkDevice, "vkCmdDrawIndirectCountKHR"));
+                m_vkCmdDrawIndexedIndirectCount = reinterpret_cast<PFN_vkCmdDrawIndexedIndirectCountKHR>(vkGetDeviceProcAddr(m_VkDevice, "vkCmdDrawIndexedIndirectCountKHR"));
+                if (m_vkCmdDrawIndirectCount == nullptr || m_vkCmdDrawIndexedIndirectCount == nullptr)
+                {
+                    LOG_WARNING_MESSAGE("Failed to load indirect draw count functions. Indirect draw count will be disabled.");
+                    m_vkCmdDrawIndirectCount        = nullptr;
+                    m_vkCmdDrawIndexedIndirectCount = nullptr;
+                }
+            }
+            else if (strcmp(DeviceCI.ppEnabledExtensionNames[ext], VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME) == 0)
+            {
+                m_DescriptorIndexingEnabled = true;
+            }
+        }
     }
 
     VkQueue VulkanLogicalDevice::GetQueue(uint32_t queueFamilyIndex, uint32_t queueIndex)
@@ -233,6 +267,13 @@ namespace VulkanUtilities
         return CreateVulkanObject<VkDescriptorSetLayout>(vkCreateDescriptorSetLayout, LayoutCI, DebugName, "descriptor set layout");
     }
 
+    DescriptorUpdateTemplateWrapper VulkanLogicalDevice::CreateDescriptorUpdateTemplate(const VkDescriptorUpdateTemplateCreateInfoKHR &TemplateCI, const char* DebugName)const
+    {
+        VERIFY_EXPR(TemplateCI.sType == VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO_KHR);
+        VERIFY(IsDescriptorUpdateTemplateSupported(), "Descriptor update templates are not supported by this device");
+        return CreateVulkanObject<VkDescriptorUpdateTemplateKHR>(m_vkCreateDescriptorUpdateTemplate, TemplateCI, DebugName, "descriptor update template");
+    }
+
     SemaphoreWrapper VulkanLogicalDevice::CreateSemaphore(const VkSemaphoreCreateInfo &SemaphoreCI, const char* DebugName)const
     {
         VERIFY_EXPR(SemaphoreCI.sType == VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO);
@@ -371,6 +412,13 @@ namespace VulkanUtilities
         Semaphore.m_VkObject = VK_NULL_HANDLE;
     }
 
+    void VulkanLogicalDevice::ReleaseVulkanObject(DescriptorUpdateTemplateWrapper&& DescriptorUpdateTemplate)const
+    {
+        VERIFY_EXPR(m_vkDestroyDescriptorUpdateTemplate != nullptr);
+        m_vkDestroyDescriptorUpdateTemplate(m_VkDevice, DescriptorUpdateTemplate.m_VkObject, m_VkAllocator);
+        DescriptorUpdateTemplate.m_VkObject = VK_NULL_HANDLE;
+    }
+
 
     void VulkanLogicalDevice::FreeDescriptorSet(VkDescriptorPool Pool, VkDescriptorSet Set)const
     {
@@ -453,6 +501,14 @@ namespace VulkanUtilities
         vkUpdateDescriptorSets(m_VkDevice, descriptorWriteCount, pDescriptorWrites, descriptorCopyCount, pDescriptorCopies);
     }
 
+    void VulkanLogicalDevice::UpdateDescriptorSetWithTemplate(VkDescriptorSet                descriptorSet,
+                                                              VkDescriptorUpdateTemplateKHR  descriptorUpdateTemplate,
+                                                              const void*                    pData)const
+    {
+        VERIFY_EXPR(m_vkUpdateDescriptorSetWithTemplate != nullptr);
+        m_vkUpdateDescriptorSetWithTemplate(m_VkDevice, descriptorSet, descriptorUpdateTemplate, pData);
+    }
+
     VkResult VulkanLogicalDevice::ResetCommandPool(VkCommandPool            vkCmdPool,
                                                    VkCommandPoolResetFlags  flags)const
     {
@@ -24,6 +24,7 @@
 #include "pch.h"
 #include <sstream>
 #include "VulkanUtilities/VulkanMemoryManager.h"
+#include "CPUProfiler.h"
 
 namespace VulkanUtilities
 {
@@ -147,20 +148,41 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDevice
     auto range = m_Pages.equal_range(PageIdx);
     for(auto page_it = range.first; page_it != range.second; ++page_it)
     {
+        if (page_it->second.IsDraining())
+            continue;
+
         Allocation = page_it->second.Allocate(Size, Alignment);
         if (Allocation.Page != nullptr)
             break;
     }
 
+    if (Allocation.Page == nullptr)
+    {
+        // Draining pages are only used when the alternative is to create a new page
+        for(auto page_it = range.first; page_it != range.second; ++page_it)
+        {
+            if (!page_it->second.IsDraining())
+                continue;
+
+            Allocation = page_it->second.Allocate(Size, Alignment);
+            if (Allocation.Page != nullptr)
+                break;
+        }
+    }
+
     size_t stat_ind = HostVisible ? 1 : 0;
     if (Allocation.Page == nullptr)
     {
+        CPU_PROFILE_SCOPE("VulkanMemoryManager::CreateNewPage");
         auto PageSize = HostVisible ? m_HostVisiblePageSize : m_DeviceLocalPageSize;
         while (PageSize < Size)
             PageSize *= 2;
 
+        CheckMemoryBudget(MemoryTypeIndex, PageSize);
+
         m_CurrAllocatedSize[stat_ind] += PageSize;
         m_PeakAllocatedSize[stat_ind] = std::max(m_PeakAllocatedSize[stat_ind], m_CurrAllocatedSize[stat_ind]);
+        m_HeapAllocatedSize[m_PhysicalDevice.GetMemoryProperties().memoryTypes[MemoryTypeIndex].heapIndex] += PageSize;
 
         auto it = m_Pages.emplace(PageIdx, VulkanMemoryPage{*this, PageSize, MemoryTypeIndex, HostVisible});
         LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': created new ", (HostVisible ? "host-visible" : "device-local"), 
@@ -191,21 +213,134 @@ void VulkanMemoryManager::ShrinkMemory()
     auto it = m_Pages.begin();
     while (it != m_Pages.end())
     {
-        auto curr_it = it;
-        ++it;
-        auto& Page = curr_it->second;
+        const auto& Page = it->second;
         bool IsHostVisible = Page.GetCPUMemory() != nullptr;
         auto ReserveSize = IsHostVisible ? m_HostVisibleReserveSize : m_DeviceLocalReserveSize;
         if (Page.IsEmpty() && m_CurrAllocatedSize[IsHostVisible ? 1 : 0] > ReserveSize)
+            it = DestroyPage(it, "");
+        else
+            ++it;
+    }
+}
+
+VulkanMemoryManager::PageMapType::iterator VulkanMemoryManager::DestroyPage(PageMapType::iterator PageIt, const char* Reason)
+{
+    auto& Page = PageIt->second;
+    VERIFY(Page.IsEmpty(), "Destroying a page that contains outstanding allocations");
+    bool IsHostVisible = Page.GetCPUMemory() != nullptr;
+    auto PageSize = Page.GetPageSize();
+    auto HeapIndex = m_PhysicalDevice.GetMemoryProperties().memoryTypes[PageIt->first.MemoryTypeIndex].heapIndex;
+    m_CurrAllocatedSize[IsHostVisible ? 1 : 0] -= PageSize;
+    VERIFY_EXPR(m_HeapAllocatedSize[HeapIndex] >= PageSize);
+    m_HeapAllocatedSize[HeapIndex] -= PageSize;
+    LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': destroying ", (IsHostVisible ? "host-visible" : "device-local"), 
+                     " page (", Diligent::FormatMemorySize(PageSize, 2), ")", Reason, "."
+                     " Current allocated size: ", Diligent::FormatMemorySize(m_CurrAllocatedSize[IsHostVisible ? 1 : 0], 2));
+    OnPageDestroy(Page);
+    return m_Pages.erase(PageIt);
+}
+
+void VulkanMemoryManager::CheckMemoryBudget(uint32_t MemoryTypeIndex, VkDeviceSize PageSize)
+{
+    const auto& MemoryProps = m_PhysicalDevice.GetMemoryProperties();
+    const auto HeapIndex = MemoryProps.memoryTypes[MemoryTypeIndex].heapIndex;
+
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT MemoryBudget;
+    const bool BudgetQueried = m_PhysicalDevice.GetMemoryBudget(MemoryBudget);
+    auto Budget = BudgetQueried ? MemoryBudget.heapBudget[HeapIndex] : MemoryProps.memoryHeaps[HeapIndex].size;
+    auto Usage  = BudgetQueried ? MemoryBudget.heapUsage [HeapIndex] : m_HeapAllocatedSize[HeapIndex];
+    if (Usage + PageSize <= Budget)
+        return;
+
+    // Release empty pages that are kept in reserve on the same heap first
+    auto it = m_Pages.begin();
+    while (it != m_Pages.end())
+    {
+        if (it->second.IsEmpty() && MemoryProps.memoryTypes[it->first.MemoryTypeIndex].heapIndex == HeapIndex)
+        {
+            auto ReleasedSize = it->second.GetPageSize();
+            it = DestroyPage(it, " to stay within memory budget");
+            Usage -= std::min(Usage, ReleasedSize);
+        }
+        else
+            ++it;
+    }
+    if (Usage + PageSize <= Budget)
+        return;
+
+    ++m_NumOverBudgetPages;
+    if (m_MemoryBudgetCallback != nullptr)
+    {
+        m_MemoryBudgetCallback(HeapIndex, Budget, Usage, PageSize, m_pMemoryBudgetCallbackUserData);
+    }
+    else
+    {
+        LOG_WARNING_MESSAGE("VulkanMemoryManager '", m_MgrName, "': allocating new ", Diligent::FormatMemorySize(PageSize, 2),
+                            " page exceeds the budget of memory heap ", HeapIndex, ". Current usage: ", Diligent::FormatMemorySize(Usage, 2),
+                            ", budget: ", Diligent::FormatMemorySize(Budget, 2));
+    }
+}
+
+bool VulkanMemoryManager::CanDrainPage(PageMapType::const_iterator PageIt)const
+{
+    const auto& Page = PageIt->second;
+    if (Page.IsDraining() || Page.IsEmpty())
+        return false;
+
+    auto UsedSize = Page.GetUsedSize();
+    if (static_cast<float>(UsedSize) >= static_cast<float>(Page.GetPageSize()) * m_SparsePageUsageThreshold)
+        return false;
+
+    // Only drain the page if other pages of the same type have enough free space to 
+    // accommodate its allocations once they are recreated
+    VkDeviceSize FreeSize = 0;
+    auto range = m_Pages.equal_range(PageIt->first);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it != PageIt && !it->second.IsDraining())
+            FreeSize += it->second.GetPageSize() - it->second.GetUsedSize();
+    }
+    return FreeSize >= UsedSize;
+}
+
+void VulkanMemoryManager::DefragmentMemory()
+{
+    if (m_MaxDrainPagesPerStep == 0)
+        return;
+
+    // Draining pages that still contain allocations after this many steps
+    // are returned to regular use
+    static constexpr uint32_t MaxDrainSteps = 256;
+
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+    uint32_t NumNewDrainingPages = 0;
+    auto it = m_Pages.begin();
+    while (it != m_Pages.end())
+    {
+        auto& Page = it->second;
+        if (Page.IsDraining())
+        {
+            if (Page.IsEmpty())
+            {
+                // Drained pages are released regardless of the reserve size
+                ++m_NumDrainedPages;
+                it = DestroyPage(it, " after draining");
+                continue;
+            }
+
+            if (++Page.m_NumDrainSteps >= MaxDrainSteps)
+            {
+                Page.m_IsDraining    = false;
+                Page.m_NumDrainSteps = 0;
+            }
+        }
+        else if (NumNewDrainingPages < m_MaxDrainPagesPerStep && CanDrainPage(it))
         {
-            auto PageSize = Page.GetPageSize();
-            m_CurrAllocatedSize[IsHostVisible ? 1 : 0] -= PageSize;
-            LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': destroying ", (IsHostVisible ? "host-visible" : "device-local"), 
-                             " page (", Diligent::FormatMemorySize(PageSize, 2), ")."
-                             " Current allocated size: ", Diligent::FormatMemorySize(m_CurrAllocatedSize[IsHostVisible ? 1 : 0], 2));
-            OnPageDestroy(Page);
-            m_Pages.erase(curr_it);
+            Page.m_IsDraining    = true;
+            Page.m_NumDrainSteps = 0;
+            ++NumNewDrainingPages;
         }
+        ++it;
     }
 }
 
@@ -226,7 +361,9 @@ VulkanMemoryManager::~VulkanMemoryManager()
                      "\n                       Peak used/allocated host-visible memory size: ", 
                      Diligent::FormatMemorySize(m_PeakUsedSize[1],      2, m_PeakAllocatedSize[1]), " / ",
                      Diligent::FormatMemorySize(m_PeakAllocatedSize[1], 2, m_PeakAllocatedSize[1]),
-                     " (", PeakHostVisisblePages, (PeakHostVisisblePages == 1 ? " page)" : " pages)")
+                     " (", PeakHostVisisblePages, (PeakHostVisisblePages == 1 ? " page)" : " pages)"),
+                     "\n                       Pages released after draining: ", m_NumDrainedPages,
+                     ", pages allocated over budget: ", m_NumOverBudgetPages
         );
     
     for(auto it=m_Pages.begin(); it != m_Pages.end(); ++it )
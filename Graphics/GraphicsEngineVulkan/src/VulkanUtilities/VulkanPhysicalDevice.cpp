@@ -25,16 +25,17 @@
 #include <cstring>
 #include "VulkanErrors.h"
 #include "VulkanUtilities/VulkanPhysicalDevice.h"
+#include "VulkanUtilities/VulkanInstance.h"
 
 namespace VulkanUtilities
 {
-    std::unique_ptr<VulkanPhysicalDevice> VulkanPhysicalDevice::Create(VkPhysicalDevice vkDevice)
+    std::unique_ptr<VulkanPhysicalDevice> VulkanPhysicalDevice::Create(VkPhysicalDevice vkDevice, const VulkanInstance* pInstance)
     {
-        auto* PhysicalDevice = new VulkanPhysicalDevice{vkDevice};
+        auto* PhysicalDevice = new VulkanPhysicalDevice{vkDevice, pInstance};
         return std::unique_ptr<VulkanPhysicalDevice>{PhysicalDevice};
     }
 
-    VulkanPhysicalDevice::VulkanPhysicalDevice(VkPhysicalDevice vkDevice) :
+    VulkanPhysicalDevice::VulkanPhysicalDevice(VkPhysicalDevice vkDevice, const VulkanInstance* pInstance) :
         m_VkDevice{vkDevice}
     {
         VERIFY_EXPR(m_VkDevice != VK_NULL_HANDLE);
@@ -59,6 +60,48 @@ namespace VulkanUtilities
             VERIFY_EXPR(res == VK_SUCCESS); (void)res;
             VERIFY_EXPR(ExtensionCount == m_SupportedExtensions.size());
         }
+
+        m_DescriptorIndexingFeatures.sType   = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+        m_DescriptorIndexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+        if (pInstance != nullptr && IsExtensionSupported(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME))
+        {
+            auto vkGetPhysicalDeviceFeatures2   = pInstance->GetPhysicalDeviceFeatures2Proc();
+            auto vkGetPhysicalDeviceProperties2 = pInstance->GetPhysicalDeviceProperties2Proc();
+            if (vkGetPhysicalDeviceFeatures2 != nullptr && vkGetPhysicalDeviceProperties2 != nullptr)
+            {
+                VkPhysicalDeviceFeatures2 Features2 = {};
+                Features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+                Features2.pNext = &m_DescriptorIndexingFeatures;
+                vkGetPhysicalDeviceFeatures2(m_VkDevice, &Features2);
+                m_DescriptorIndexingFeatures.pNext = nullptr;
+
+                VkPhysicalDeviceProperties2 Properties2 = {};
+                Properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+                Properties2.pNext = &m_DescriptorIndexingProperties;
+                vkGetPhysicalDeviceProperties2(m_VkDevice, &Properties2);
+                m_DescriptorIndexingProperties.pNext = nullptr;
+            }
+        }
+
+        if (pInstance != nullptr && IsExtensionSupported(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME))
+        {
+            m_vkGetPhysicalDeviceMemoryProperties2 = pInstance->GetPhysicalDeviceMemoryProperties2Proc();
+        }
+    }
+
+    bool VulkanPhysicalDevice::GetMemoryBudget(VkPhysicalDeviceMemoryBudgetPropertiesEXT& MemoryBudget)const
+    {
+        if (m_vkGetPhysicalDeviceMemoryProperties2 == nullptr)
+            return false;
+
+        MemoryBudget = {};
+        MemoryBudget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+        VkPhysicalDeviceMemoryProperties2 MemoryProperties2 = {};
+        MemoryProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+        MemoryProperties2.pNext = &MemoryBudget;
+        m_vkGetPhysicalDeviceMemoryProperties2(m_VkDevice, &MemoryProperties2);
+        MemoryBudget.pNext = nullptr;
+        return true;
     }
 
     uint32_t VulkanPhysicalDevice::FindQueueFamily(VkQueueFlags QueueFlags)const
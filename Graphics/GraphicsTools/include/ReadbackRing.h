@@ -0,0 +1,181 @@
+/*     Copyright 2019 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <memory>
+#include <functional>
+#include <atomic>
+#include <future>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/SwapChain.h"
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/RefCntAutoPtr.h"
+
+namespace ThreadingTools
+{
+    class ThreadPool;
+}
+
+namespace Diligent
+{
+
+/// Asynchronous texture readback ring
+
+/// The ring owns a fixed number of staging textures. Every capture copies the source texture into the next
+/// staging texture and signals a fence. Once the fence is complete, the staging texture is mapped and the callback
+/// receives the pointer to the mapped memory (the pixel pack buffer in OpenGL, host-visible memory in Vulkan and
+/// Direct3D), so the data is not copied on the CPU. The optional conversion and the callback are executed by
+/// a worker thread in the order of captures. The texture is unmapped by the first Update() call after the callback
+/// has returned. If all staging textures are in use, the capture is dropped rather than stalling the GPU.
+///
+/// All methods must be called by the thread that owns the device context. Flush() must be called before the
+/// ring is destroyed.
+class ReadbackRing
+{
+public:
+    enum class CONVERSION : Uint8
+    {
+        /// The callback receives the mapped staging memory
+        NONE = 0,
+
+        /// 8-bit BGRA data is converted to RGBA. RGBA data is not converted.
+        BGRA_TO_RGBA,
+
+        /// sRGB-encoded 8-bit color channels are converted to linear space. Alpha and the order of the
+        /// channels are not changed.
+        SRGB_TO_LINEAR,
+
+        /// 8-bit RGBA or BGRA data is converted to planar YUV 4:2:0 (I420, BT.709 limited range).
+        /// Y plane is followed by U and V planes that have half the width and height of the Y plane (rounded up).
+        RGBA_TO_YUV420
+    };
+
+    struct ReadbackData
+    {
+        /// Pointer to the captured data. The pointer is only valid inside the callback.
+        const void*    pData      = nullptr;
+        /// Row stride in bytes; for YUV420 data, the stride of the Y plane
+        Uint32         Stride     = 0;
+        /// Total size of the data in bytes
+        size_t         DataSize   = 0;
+        Uint32         Width      = 0;
+        Uint32         Height     = 0;
+        /// Format of the captured texture
+        TEXTURE_FORMAT Format     = TEX_FORMAT_UNKNOWN;
+        /// Conversion that was applied to the data
+        CONVERSION     Conversion = CONVERSION::NONE;
+        Uint32         FrameId    = 0;
+    };
+
+    using CallbackType = std::function<void(const ReadbackData& Data)>;
+
+    struct CreateInfo
+    {
+        /// Number of staging textures in the ring
+        Uint32       RingSize        = 3;
+        CONVERSION   Conversion      = CONVERSION::NONE;
+        /// If false, conversion and the callback are executed by the thread that calls Update()
+        bool         UseWorkerThread = true;
+        CallbackType Callback;
+    };
+
+    struct Statistics
+    {
+        Uint32 NumPending   = 0;
+        Uint64 NumCaptured  = 0;
+        Uint64 NumDelivered = 0;
+        Uint64 NumDropped   = 0;
+    };
+
+    ReadbackRing(IRenderDevice* pDevice, const CreateInfo& CI);
+    ~ReadbackRing();
+
+    ReadbackRing(const ReadbackRing&)  = delete;
+    ReadbackRing(      ReadbackRing&&) = delete;
+    ReadbackRing& operator = (const ReadbackRing&)  = delete;
+    ReadbackRing& operator = (      ReadbackRing&&) = delete;
+
+    /// Captures the current back buffer of the swap chain. Returns false if the capture was dropped.
+    /// \note The back buffer is not accessible in OpenGL backend, capture a render target texture instead.
+    bool Capture(ISwapChain* pSwapChain, IDeviceContext* pContext, Uint32 FrameId);
+
+    /// Captures the most detailed mip level of the first slice of a non-multisampled texture.
+    /// Returns false if the capture was dropped.
+    bool Capture(ITexture* pSrcTexture, IDeviceContext* pContext, Uint32 FrameId);
+
+    /// Delivers completed captures and recycles staging textures. Capture() calls this method automatically.
+    void Update(IDeviceContext* pContext);
+
+    /// Waits until all pending captures are delivered
+    void Flush(IDeviceContext* pContext);
+
+    Statistics GetStatistics()const;
+
+private:
+    enum class SLOT_STATE : Uint8
+    {
+        FREE,       // Staging texture may be used for a new capture
+        COPYING,    // Waiting for the fence
+        PROCESSING, // Mapped; waiting for the conversion and the callback
+        PROCESSED   // Callback has returned; must be unmapped
+    };
+
+    struct Slot
+    {
+        RefCntAutoPtr<ITexture>  pStagingTex;
+        Uint64                   FenceValue = 0;
+        Uint32                   FrameId    = 0;
+        MappedTextureSubresource MappedData;
+        std::atomic<SLOT_STATE>  State{SLOT_STATE::FREE};
+        std::future<void>        ProcessingDone;
+        // Conversion output that is reused between captures
+        std::vector<Uint8>       ConvertedData;
+    };
+
+    void ProcessSlot(Slot& S);
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+    RefCntAutoPtr<IFence>        m_pFence;
+    Uint64                       m_FenceValue = 0;
+
+    const CONVERSION   m_Conversion;
+    const CallbackType m_Callback;
+    // sRGB to linear conversion table for 8-bit channels
+    Uint8              m_SRGBToLinearLUT[256] = {};
+
+    const Uint32             m_RingSize;
+    std::unique_ptr<Slot[]>  m_Slots;
+    // Slot that will be used by the next capture. It is also the oldest slot in the ring.
+    Uint32                   m_NextSlot = 0;
+
+    std::unique_ptr<ThreadingTools::ThreadPool> m_pWorker;
+
+    Uint64 m_NumCaptured  = 0;
+    Uint64 m_NumDelivered = 0;
+    Uint64 m_NumDropped   = 0;
+};
+
+}
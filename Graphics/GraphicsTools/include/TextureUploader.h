@@ -39,10 +39,12 @@ namespace Diligent
 
         bool operator == (const UploadBufferDesc &rhs) const
         {
-            return Width  == rhs.Width  && 
-                   Height == rhs.Height &&
-                   Depth  == rhs.Depth  &&
-                   Format == rhs.Format;
+            return Width     == rhs.Width     && 
+                   Height    == rhs.Height    &&
+                   Depth     == rhs.Depth     &&
+                   MipLevels == rhs.MipLevels &&
+                   ArraySize == rhs.ArraySize &&
+                   Format    == rhs.Format;
         }
     };
 
@@ -56,12 +58,65 @@ namespace Diligent
 
     struct TextureUploaderDesc
     {
+        /// Maximum number of bytes copied by one RenderThreadUpdate() call. 0 means no limit.
+        /// At least one copy is executed by every update, so uploads larger than the budget still make progress.
+        Uint32 MaxBytesPerUpdate = 0;
 
+        /// Maximum time in milliseconds spent on copies by one RenderThreadUpdate() call. 0 means no limit.
+        float  MaxTimePerUpdateMs = 0;
+    };
+
+    /// Upload priority. Pending copies with higher priority are executed first, copies with
+    /// the same priority are executed in the order they were scheduled. A copy that overlaps
+    /// a pending lower-priority copy to the same texture subresource is executed after that copy.
+    enum UPLOAD_PRIORITY : Uint8
+    {
+        UPLOAD_PRIORITY_LOW = 0,
+        UPLOAD_PRIORITY_NORMAL,
+        UPLOAD_PRIORITY_HIGH,
+        UPLOAD_PRIORITY_COUNT
+    };
+
+    /// Describes a region of an upload buffer subresource that is copied to a texture
+    struct TextureUploadRegion
+    {
+        /// Source subresource of the upload buffer
+        Uint32 SrcMip   = 0;
+        Uint32 SrcSlice = 0;
+
+        /// Region of the source subresource. For compressed formats, the region must be block-aligned.
+        Box    SrcBox;
+
+        /// Destination subresource and the offset of the region in the destination subresource
+        Uint32 DstMip   = 0;
+        Uint32 DstSlice = 0;
+        Uint32 DstX     = 0;
+        Uint32 DstY     = 0;
+        Uint32 DstZ     = 0;
     };
 
     struct TextureUploaderStats
     {
         Uint32 NumPendingOperations = 0;
+
+        /// Number of copies that were canceled because they were superseded by a newer copy
+        /// to the same subresources or canceled by CancelCopies()
+        Uint64 NumCanceledCopies = 0;
+
+        /// Total number of bytes copied to textures
+        Uint64 NumBytesUploaded = 0;
+
+        /// Upload throughput, in bytes per second, and the average and maximum time between
+        /// ScheduleGPUCopy() and the execution of the copy. The values are measured over the
+        /// last complete one-second interval.
+        double BytesPerSecond      = 0;
+        float  AvgQueueLatencyMs   = 0;
+        float  MaxQueueLatencyMs   = 0;
+
+        /// Number of upload buffers created by AllocateUploadBuffer() and the number of
+        /// requests that were served by a recycled buffer
+        Uint32 NumUploadBuffersCreated = 0;
+        Uint32 NumUploadBuffersReused  = 0;
     };
 
     class ITextureUploader : public IObject
@@ -72,10 +127,32 @@ namespace Diligent
         virtual void AllocateUploadBuffer(const UploadBufferDesc& Desc,
                                           bool                    IsRenderThread,
                                           IUploadBuffer**         ppBuffer) = 0;
-        virtual void ScheduleGPUCopy(ITexture*      pDstTexture,
-                                     Uint32         ArraySlice,
-                                     Uint32         MipLevel,
-                                     IUploadBuffer* pUploadBuffer) = 0;
+
+        /// Schedules the copy of all subresources of the upload buffer to the texture. If a copy to the same or
+        /// smaller range of subresources of the texture is still pending, it is canceled.
+        /// All subresources are copied as one batch, so a whole mip chain or a range of array slices
+        /// is uploaded with a single copy command in Vulkan.
+        virtual void ScheduleGPUCopy(ITexture*       pDstTexture,
+                                     Uint32          ArraySlice,
+                                     Uint32          MipLevel,
+                                     IUploadBuffer*  pUploadBuffer,
+                                     UPLOAD_PRIORITY Priority = UPLOAD_PRIORITY_NORMAL) = 0;
+
+        /// Schedules the copy of the regions of the upload buffer to the texture, e.g. for sparse tile updates.
+        /// The regions are executed as one batch. Regions that are vertically adjacent in both the upload buffer 
+        /// and the texture are merged. Pending region copies are canceled by a later ScheduleGPUCopy() call
+        /// that overwrites all their destination subresources. If NumRegions is zero, no copy is scheduled.
+        /// The OpenGL backend only supports regions that cover a single depth slice.
+        virtual void ScheduleGPUCopyRegions(ITexture*                  pDstTexture,
+                                            IUploadBuffer*             pUploadBuffer,
+                                            const TextureUploadRegion* pRegions,
+                                            Uint32                     NumRegions,
+                                            UPLOAD_PRIORITY            Priority = UPLOAD_PRIORITY_NORMAL) = 0;
+
+        /// Cancels all pending copies to the texture. Threads waiting for these copies are released
+        /// by the next RenderThreadUpdate() call.
+        virtual void CancelCopies(ITexture* pDstTexture) = 0;
+
         virtual void RecycleBuffer(IUploadBuffer* pUploadBuffer) = 0;
 
         virtual TextureUploaderStats GetStats() = 0;
@@ -24,11 +24,15 @@
 #pragma once
 
 #include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
 
 #include "TextureUploader.h"
 #include "../../../Common/interface/ObjectBase.h"
 #include "../../../Common/interface/HashUtils.h"
 #include "../../../Common/interface/RefCntAutoPtr.h"
+#include "../../../Common/interface/Timer.h"
 
 namespace std
 {
@@ -37,7 +41,7 @@ namespace std
     {
         size_t operator()(const Diligent::UploadBufferDesc &Desc) const
         {
-            return Diligent::ComputeHash(Desc.Width, Desc.Height, Desc.Depth, static_cast<Diligent::Int32>(Desc.Format));
+            return Diligent::ComputeHash(Desc.Width, Desc.Height, Desc.Depth, Desc.MipLevels, Desc.ArraySize, static_cast<Diligent::Int32>(Desc.Format));
         }
     };
 }
@@ -84,16 +88,94 @@ namespace Diligent
         std::vector<MappedTextureSubresource> m_MappedData;
     };
 
+    // Implements the copy queue that is shared by all backends. Copies are kept in per-priority FIFO queues
+    // and executed by ProcessPendingCopies() within the per-update budget. Backends implement the actual copy
+    // and cancellation, and manage upload buffers.
     class TextureUploaderBase : public ObjectBase<ITextureUploader>
     {
     public:
         TextureUploaderBase(IReferenceCounters* pRefCounters, IRenderDevice* pDevice, const TextureUploaderDesc Desc) :
             ObjectBase<ITextureUploader>(pRefCounters),
-            m_pDevice(pDevice)
+            m_pDevice(pDevice),
+            m_Desc(Desc)
         {}
 
+        virtual void ScheduleGPUCopyRegions(ITexture*                  pDstTexture,
+                                            IUploadBuffer*             pUploadBuffer,
+                                            const TextureUploadRegion* pRegions,
+                                            Uint32                     NumRegions,
+                                            UPLOAD_PRIORITY            Priority)override final;
+
+        virtual void CancelCopies(ITexture* pDstTexture)override final;
+
+        virtual TextureUploaderStats GetStats()override final;
+
     protected:
+        struct PendingCopy
+        {
+            RefCntAutoPtr<UploadBufferBase>  pUploadBuffer;
+            RefCntAutoPtr<ITexture>          pDstTexture;
+            Uint32                           DstSlice = 0;
+            Uint32                           DstMip   = 0;
+            // Regions to copy. If empty, all subresources of the upload buffer are copied
+            // to the range of subresources starting at DstSlice and DstMip.
+            std::vector<TextureUploadRegion> Regions;
+            // Total size of the copied data
+            Uint32                           NumBytes = 0;
+            // Measures the time the copy spends in the queue
+            Timer                            QueueTimer;
+        };
+
+        void EnqueueCopy(UploadBufferBase* pUploadBuffer, ITexture* pDstTexture, Uint32 DstSlice, Uint32 DstMip, UPLOAD_PRIORITY Priority);
+
+        // Cancels superseded copies and executes pending copies in the order of priority until 
+        // the budget is exhausted. Must only be called by RenderThreadUpdate().
+        void ProcessPendingCopies(IDeviceContext* pContext);
+
+        // Copies the upload buffer to the texture and releases threads waiting for the copy
+        virtual void ExecuteCopy(IDeviceContext* pContext, PendingCopy& Copy) = 0;
+
+        // Releases threads waiting for the copy without copying the data. The upload buffer
+        // must be ready to be recycled.
+        virtual void CancelCopy(IDeviceContext* pContext, PendingCopy& Copy) = 0;
+
+        virtual Uint32 GetNumPendingMapOperations() = 0;
+
+        void OnUploadBufferCreated() { ++m_NumUploadBuffersCreated; }
+        void OnUploadBufferReused()  { ++m_NumUploadBuffersReused;  }
+
         RefCntAutoPtr<IRenderDevice> m_pDevice;
+        const TextureUploaderDesc    m_Desc;
+
+    private:
+        // Supersedes pending copies whose destination is overwritten by the new copy and adds it to the queue.
+        // If a lower-priority copy to the same subresources is still pending, the new copy is added to that
+        // copy's queue so that copies to the same subresources are executed in the order they were scheduled.
+        void PushCopy(PendingCopy&& Copy, UPLOAD_PRIORITY Priority);
+
+        void UpdateThroughputStats(Uint64 NumBytes, Uint32 NumCopies, double LatencySum, double MaxLatency);
+
+        std::mutex               m_CopyQueueMtx;
+        std::deque<PendingCopy>  m_CopyQueues[UPLOAD_PRIORITY_COUNT];
+        // Copies that have been canceled, but whose waiting threads have not been released yet
+        std::vector<PendingCopy> m_CanceledCopies;
+        Uint64                   m_NumCanceledCopies = 0;
+
+        std::mutex m_StatsMtx;
+        Uint64     m_NumBytesUploaded = 0;
+        // Current measurement interval
+        Timer      m_IntervalTimer;
+        Uint64     m_IntervalNumBytes   = 0;
+        Uint32     m_IntervalNumCopies  = 0;
+        double     m_IntervalLatencySum = 0;
+        double     m_IntervalMaxLatency = 0;
+        // Results of the last complete interval
+        double     m_BytesPerSecond    = 0;
+        float      m_AvgQueueLatencyMs = 0;
+        float      m_MaxQueueLatencyMs = 0;
+
+        std::atomic<Uint32> m_NumUploadBuffersCreated{0};
+        std::atomic<Uint32> m_NumUploadBuffersReused{0};
     };
 
 }
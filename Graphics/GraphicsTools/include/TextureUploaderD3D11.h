@@ -39,13 +39,17 @@ namespace Diligent
         virtual void AllocateUploadBuffer(const UploadBufferDesc& Desc,
                                           bool                    IsRenderThread,
                                           IUploadBuffer**         ppBuffer)override final;
-        virtual void ScheduleGPUCopy(ITexture*      pDstTexture,
-                                     Uint32         ArraySlice,
-                                     Uint32         MipLevel,
-                                     IUploadBuffer* pUploadBuffer)override final;
+        virtual void ScheduleGPUCopy(ITexture*       pDstTexture,
+                                     Uint32          ArraySlice,
+                                     Uint32          MipLevel,
+                                     IUploadBuffer*  pUploadBuffer,
+                                     UPLOAD_PRIORITY Priority)override final;
         virtual void RecycleBuffer(IUploadBuffer* pUploadBuffer)override final;
 
-        virtual TextureUploaderStats GetStats()override final;
+    protected:
+        virtual void ExecuteCopy(IDeviceContext* pContext, PendingCopy& Copy)override final;
+        virtual void CancelCopy(IDeviceContext* pContext, PendingCopy& Copy)override final;
+        virtual Uint32 GetNumPendingMapOperations()override final;
 
     private:
         struct InternalData;
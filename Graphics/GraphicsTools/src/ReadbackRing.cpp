@@ -0,0 +1,397 @@
+/*     Copyright 2019 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include <algorithm>
+
+#include "ReadbackRing.h"
+#include "ThreadPool.h"
+#include "GraphicsAccessories.h"
+#include "ColorConversion.h"
+
+namespace Diligent
+{
+
+namespace
+{
+
+bool IsBGRAFormat(TEXTURE_FORMAT Format)
+{
+    switch (Format)
+    {
+        case TEX_FORMAT_BGRA8_TYPELESS:
+        case TEX_FORMAT_BGRA8_UNORM:
+        case TEX_FORMAT_BGRA8_UNORM_SRGB:
+        case TEX_FORMAT_BGRX8_TYPELESS:
+        case TEX_FORMAT_BGRX8_UNORM:
+        case TEX_FORMAT_BGRX8_UNORM_SRGB:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+bool Is8BitRGBAFormat(TEXTURE_FORMAT Format)
+{
+    const auto& FmtAttribs = GetTextureFormatAttribs(Format);
+    return FmtAttribs.ComponentSize == 1 && FmtAttribs.NumComponents == 4 && FmtAttribs.ComponentType != COMPONENT_TYPE_COMPRESSED;
+}
+
+void ConvertBGRAToRGBA(const Uint8* pSrc, Uint32 SrcStride, Uint32 Width, Uint32 Height, Uint8* pDst)
+{
+    for (Uint32 y=0; y < Height; ++y)
+    {
+        const auto* pSrcRow = pSrc + size_t{SrcStride} * y;
+        auto*       pDstRow = pDst + size_t{Width} * 4 * y;
+        for (Uint32 x=0; x < Width; ++x)
+        {
+            pDstRow[x*4 + 0] = pSrcRow[x*4 + 2];
+            pDstRow[x*4 + 1] = pSrcRow[x*4 + 1];
+            pDstRow[x*4 + 2] = pSrcRow[x*4 + 0];
+            pDstRow[x*4 + 3] = pSrcRow[x*4 + 3];
+        }
+    }
+}
+
+void ConvertSRGBToLinear(const Uint8* pSrc, Uint32 SrcStride, Uint32 Width, Uint32 Height, const Uint8* LUT, Uint8* pDst)
+{
+    for (Uint32 y=0; y < Height; ++y)
+    {
+        const auto* pSrcRow = pSrc + size_t{SrcStride} * y;
+        auto*       pDstRow = pDst + size_t{Width} * 4 * y;
+        for (Uint32 x=0; x < Width; ++x)
+        {
+            pDstRow[x*4 + 0] = LUT[pSrcRow[x*4 + 0]];
+            pDstRow[x*4 + 1] = LUT[pSrcRow[x*4 + 1]];
+            pDstRow[x*4 + 2] = LUT[pSrcRow[x*4 + 2]];
+            pDstRow[x*4 + 3] = pSrcRow[x*4 + 3];
+        }
+    }
+}
+
+// BT.709 limited range coefficients in 8.8 fixed point
+inline Uint8 RGBToY(int R, int G, int B)
+{
+    return static_cast<Uint8>(((47 * R + 157 * G + 16 * B + 128) >> 8) + 16);
+}
+
+inline Uint8 RGBToU(int R, int G, int B)
+{
+    return static_cast<Uint8>(((-26 * R - 87 * G + 112 * B + 128) >> 8) + 128);
+}
+
+inline Uint8 RGBToV(int R, int G, int B)
+{
+    return static_cast<Uint8>(((112 * R - 102 * G - 10 * B + 128) >> 8) + 128);
+}
+
+// Converts 8-bit RGBA or BGRA data to I420. Chroma is computed from the average color of every 2x2 block.
+void ConvertRGBAToYUV420(const Uint8* pSrc, Uint32 SrcStride, Uint32 Width, Uint32 Height, bool IsBGRA, Uint8* pDst)
+{
+    const Uint32 ChromaWidth  = (Width  + 1) / 2;
+    const Uint32 ChromaHeight = (Height + 1) / 2;
+    auto* pYPlane = pDst;
+    auto* pUPlane = pYPlane + size_t{Width} * Height;
+    auto* pVPlane = pUPlane + size_t{ChromaWidth} * ChromaHeight;
+
+    const Uint32 RIdx = IsBGRA ? 2 : 0;
+    const Uint32 BIdx = IsBGRA ? 0 : 2;
+    for (Uint32 cy=0; cy < ChromaHeight; ++cy)
+    {
+        const Uint32 Rows[2] = {cy * 2, std::min(cy * 2 + 1, Height - 1)};
+        for (Uint32 cx=0; cx < ChromaWidth; ++cx)
+        {
+            const Uint32 Cols[2] = {cx * 2, std::min(cx * 2 + 1, Width - 1)};
+            int SumR = 0, SumG = 0, SumB = 0;
+            for (Uint32 j=0; j < 2; ++j)
+            {
+                const auto* pSrcRow = pSrc + size_t{SrcStride} * Rows[j];
+                for (Uint32 i=0; i < 2; ++i)
+                {
+                    const auto* pTexel = pSrcRow + Cols[i] * 4;
+                    const int R = pTexel[RIdx];
+                    const int G = pTexel[1];
+                    const int B = pTexel[BIdx];
+                    // Texels on the last row and column of odd-sized images are visited twice, which
+                    // writes the same Y value and duplicates the texel in the chroma average
+                    pYPlane[size_t{Width} * Rows[j] + Cols[i]] = RGBToY(R, G, B);
+                    SumR += R;
+                    SumG += G;
+                    SumB += B;
+                }
+            }
+            const int R = (SumR + 2) >> 2;
+            const int G = (SumG + 2) >> 2;
+            const int B = (SumB + 2) >> 2;
+            pUPlane[size_t{ChromaWidth} * cy + cx] = RGBToU(R, G, B);
+            pVPlane[size_t{ChromaWidth} * cy + cx] = RGBToV(R, G, B);
+        }
+    }
+}
+
+}
+
+ReadbackRing::ReadbackRing(IRenderDevice* pDevice, const CreateInfo& CI) :
+    m_pDevice    {pDevice},
+    m_Conversion {CI.Conversion},
+    m_Callback   {CI.Callback},
+    m_RingSize   {std::max(CI.RingSize, 1u)},
+    m_Slots      {new Slot[m_RingSize]}
+{
+    VERIFY(m_Callback, "Readback callback must not be null");
+
+    FenceDesc fenceDesc;
+    fenceDesc.Name = "Readback ring fence";
+    m_pDevice->CreateFence(fenceDesc, &m_pFence);
+
+    if (m_Conversion == CONVERSION::SRGB_TO_LINEAR)
+    {
+        for (Uint32 i=0; i < 256; ++i)
+            m_SRGBToLinearLUT[i] = static_cast<Uint8>(SRGBToLinear(static_cast<Uint8>(i)) * 255.f + 0.5f);
+    }
+
+    if (CI.UseWorkerThread)
+    {
+        // Single thread guarantees that captures are delivered in order
+        m_pWorker.reset(new ThreadingTools::ThreadPool{1});
+    }
+}
+
+ReadbackRing::~ReadbackRing()
+{
+    // Completes all enqueued tasks
+    m_pWorker.reset();
+
+    for (Uint32 i=0; i < m_RingSize; ++i)
+    {
+        if (m_Slots[i].State.load() != SLOT_STATE::FREE)
+        {
+            LOG_WARNING_MESSAGE("Readback ring is destroyed while some captures are pending. Call Flush() before destroying the ring.");
+            break;
+        }
+    }
+}
+
+bool ReadbackRing::Capture(ISwapChain* pSwapChain, IDeviceContext* pContext, Uint32 FrameId)
+{
+    auto* pCurrentRTV = pSwapChain->GetCurrentBackBufferRTV();
+    if (pCurrentRTV == nullptr)
+    {
+        LOG_ERROR_MESSAGE_ONCE("The swap chain back buffer can't be captured because it is not exposed as a texture. Capture a render target texture instead.");
+        return false;
+    }
+    return Capture(pCurrentRTV->GetTexture(), pContext, FrameId);
+}
+
+bool ReadbackRing::Capture(ITexture* pSrcTexture, IDeviceContext* pContext, Uint32 FrameId)
+{
+    Update(pContext);
+
+    const auto& SrcDesc = pSrcTexture->GetDesc();
+    if (m_Conversion != CONVERSION::NONE && !Is8BitRGBAFormat(SrcDesc.Format))
+    {
+        LOG_ERROR_MESSAGE_ONCE("Readback conversion requires 8-bit 4-component texture format, but texture '", SrcDesc.Name, "' has format ", GetTextureFormatAttribs(SrcDesc.Format).Name);
+        return false;
+    }
+
+    auto& S = m_Slots[m_NextSlot];
+    if (S.State.load() != SLOT_STATE::FREE)
+    {
+        // All staging textures are in use. Dropping the frame is better than stalling the GPU.
+        ++m_NumDropped;
+        return false;
+    }
+
+    if (S.pStagingTex)
+    {
+        const auto& StagingDesc = S.pStagingTex->GetDesc();
+        if ( !(StagingDesc.Width  == SrcDesc.Width  &&
+               StagingDesc.Height == SrcDesc.Height &&
+               StagingDesc.Format == SrcDesc.Format) )
+        {
+            S.pStagingTex.Release();
+        }
+    }
+
+    if (!S.pStagingTex)
+    {
+        TextureDesc TexDesc;
+        TexDesc.Name           = "Readback ring staging texture";
+        TexDesc.Type           = RESOURCE_DIM_TEX_2D;
+        TexDesc.Width          = SrcDesc.Width;
+        TexDesc.Height         = SrcDesc.Height;
+        TexDesc.Format         = SrcDesc.Format;
+        TexDesc.Usage          = USAGE_STAGING;
+        TexDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        m_pDevice->CreateTexture(TexDesc, nullptr, &S.pStagingTex);
+        if (!S.pStagingTex)
+        {
+            LOG_ERROR_MESSAGE("Failed to create readback staging texture");
+            return false;
+        }
+    }
+
+    CopyTextureAttribs CopyAttribs(pSrcTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, S.pStagingTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->CopyTexture(CopyAttribs);
+    pContext->SignalFence(m_pFence, ++m_FenceValue);
+
+    S.FenceValue = m_FenceValue;
+    S.FrameId    = FrameId;
+    S.State.store(SLOT_STATE::COPYING);
+    m_NextSlot = (m_NextSlot + 1) % m_RingSize;
+    ++m_NumCaptured;
+
+    return true;
+}
+
+void ReadbackRing::Update(IDeviceContext* pContext)
+{
+    const auto CompletedFenceValue = m_pFence->GetCompletedValue();
+    // Slots are visited from the oldest to the newest
+    for (Uint32 i=0; i < m_RingSize; ++i)
+    {
+        auto& S = m_Slots[(m_NextSlot + i) % m_RingSize];
+
+        if (S.State.load() == SLOT_STATE::COPYING && S.FenceValue <= CompletedFenceValue)
+        {
+            // The fence guarantees that the copy is complete, so there is no need to synchronize again
+            pContext->MapTextureSubresource(S.pStagingTex, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_SYNCHRONIZE, nullptr, S.MappedData);
+            if (S.MappedData.pData == nullptr)
+            {
+                LOG_ERROR_MESSAGE("Failed to map readback staging texture. Frame ", S.FrameId, " is dropped.");
+                S.MappedData = MappedTextureSubresource{};
+                S.State.store(SLOT_STATE::FREE);
+                ++m_NumDropped;
+                continue;
+            }
+            S.State.store(SLOT_STATE::PROCESSING);
+            if (m_pWorker)
+                S.ProcessingDone = m_pWorker->EnqueueTask([this, &S](){ProcessSlot(S);});
+            else
+                ProcessSlot(S);
+        }
+
+        if (S.State.load() == SLOT_STATE::PROCESSED)
+        {
+            if (S.ProcessingDone.valid())
+                S.ProcessingDone.get();
+            pContext->UnmapTextureSubresource(S.pStagingTex, 0, 0);
+            S.MappedData = MappedTextureSubresource{};
+            S.State.store(SLOT_STATE::FREE);
+            ++m_NumDelivered;
+        }
+    }
+}
+
+void ReadbackRing::Flush(IDeviceContext* pContext)
+{
+    pContext->WaitForFence(m_pFence, m_FenceValue, true);
+    Update(pContext);
+    for (Uint32 i=0; i < m_RingSize; ++i)
+    {
+        auto& S = m_Slots[i];
+        if (S.ProcessingDone.valid())
+            S.ProcessingDone.wait();
+    }
+    Update(pContext);
+}
+
+ReadbackRing::Statistics ReadbackRing::GetStatistics()const
+{
+    Statistics Stats;
+    for (Uint32 i=0; i < m_RingSize; ++i)
+    {
+        if (m_Slots[i].State.load() != SLOT_STATE::FREE)
+            ++Stats.NumPending;
+    }
+    Stats.NumCaptured  = m_NumCaptured;
+    Stats.NumDelivered = m_NumDelivered;
+    Stats.NumDropped   = m_NumDropped;
+    return Stats;
+}
+
+void ReadbackRing::ProcessSlot(Slot& S)
+{
+    const auto& TexDesc = S.pStagingTex->GetDesc();
+    const auto* pSrc      = static_cast<const Uint8*>(S.MappedData.pData);
+    const auto  SrcStride = S.MappedData.Stride;
+
+    ReadbackData Data;
+    Data.Width      = TexDesc.Width;
+    Data.Height     = TexDesc.Height;
+    Data.Format     = TexDesc.Format;
+    Data.Conversion = m_Conversion;
+    Data.FrameId    = S.FrameId;
+
+    const auto IsBGRA = IsBGRAFormat(TexDesc.Format);
+    if (m_Conversion == CONVERSION::NONE || (m_Conversion == CONVERSION::BGRA_TO_RGBA && !IsBGRA))
+    {
+        // Deliver the mapped memory directly
+        const auto& FmtAttribs = GetTextureFormatAttribs(TexDesc.Format);
+        const auto  MipProps   = GetMipLevelProperties(TexDesc, 0);
+        const auto  NumRows    = FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED ?
+                                     MipProps.StorageHeight / FmtAttribs.BlockHeight :
+                                     MipProps.StorageHeight;
+        Data.pData      = pSrc;
+        Data.Stride     = SrcStride;
+        Data.DataSize   = size_t{SrcStride} * (NumRows - 1) + MipProps.RowSize;
+        Data.Conversion = CONVERSION::NONE;
+    }
+    else
+    {
+        auto& Dst = S.ConvertedData;
+        switch (m_Conversion)
+        {
+            case CONVERSION::BGRA_TO_RGBA:
+                Dst.resize(size_t{Data.Width} * Data.Height * 4);
+                ConvertBGRAToRGBA(pSrc, SrcStride, Data.Width, Data.Height, Dst.data());
+                Data.Stride = Data.Width * 4;
+            break;
+
+            case CONVERSION::SRGB_TO_LINEAR:
+                Dst.resize(size_t{Data.Width} * Data.Height * 4);
+                ConvertSRGBToLinear(pSrc, SrcStride, Data.Width, Data.Height, m_SRGBToLinearLUT, Dst.data());
+                Data.Stride = Data.Width * 4;
+            break;
+
+            case CONVERSION::RGBA_TO_YUV420:
+                Dst.resize(size_t{Data.Width} * Data.Height + size_t{(Data.Width + 1) / 2} * ((Data.Height + 1) / 2) * 2);
+                ConvertRGBAToYUV420(pSrc, SrcStride, Data.Width, Data.Height, IsBGRA, Dst.data());
+                Data.Stride = Data.Width;
+            break;
+
+            default:
+                UNEXPECTED("Unexpected conversion");
+        }
+        Data.pData    = Dst.data();
+        Data.DataSize = Dst.size();
+    }
+
+    m_Callback(Data);
+
+    S.State.store(SLOT_STATE::PROCESSED);
+}
+
+}
@@ -38,6 +38,12 @@ ScreenCapture::ScreenCapture(IRenderDevice* pDevice) :
 void ScreenCapture::Capture(ISwapChain* pSwapChain, IDeviceContext* pContext, Uint32 FrameId)
 {
     auto* pCurrentRTV        = pSwapChain->GetCurrentBackBufferRTV();
+    if (pCurrentRTV == nullptr)
+    {
+        // OpenGL swap chain does not expose the back buffer
+        LOG_ERROR_MESSAGE_ONCE("Screen capture is not supported because the swap chain back buffer is not accessible");
+        return;
+    }
     auto* pCurrentBackBuffer = pCurrentRTV->GetTexture();
     const auto& SCDesc       = pSwapChain->GetDesc();
 
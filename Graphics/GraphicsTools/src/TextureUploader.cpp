@@ -22,9 +22,12 @@
  */
 
 #include "pch.h"
+#include <algorithm>
+
 #include "TextureUploaderD3D11.h"
 #include "TextureUploaderD3D12_Vk.h"
 #include "TextureUploaderGL.h"
+#include "GraphicsAccessories.h"
 
 namespace Diligent
 {
@@ -53,4 +56,330 @@ namespace Diligent
         if (*ppUploader != nullptr)
             (*ppUploader)->AddRef();
     }
+
+    static TextureDesc GetUploadBufferTexDesc(const UploadBufferDesc& BuffDesc)
+    {
+        TextureDesc BuffTexDesc;
+        BuffTexDesc.Type      = BuffDesc.Depth > 1 ? RESOURCE_DIM_TEX_3D : RESOURCE_DIM_TEX_2D;
+        BuffTexDesc.Width     = BuffDesc.Width;
+        BuffTexDesc.Height    = BuffDesc.Height;
+        BuffTexDesc.Depth     = BuffDesc.Depth;
+        BuffTexDesc.Format    = BuffDesc.Format;
+        BuffTexDesc.MipLevels = BuffDesc.MipLevels;
+        return BuffTexDesc;
+    }
+
+    // Merges the region into the previous one if they form a single box in both the source 
+    // and the destination subresource
+    static bool MergeRegions(TextureUploadRegion& Prev, const TextureUploadRegion& Region)
+    {
+        if (Prev.SrcMip  != Region.SrcMip  || Prev.SrcSlice != Region.SrcSlice ||
+            Prev.DstMip  != Region.DstMip  || Prev.DstSlice != Region.DstSlice ||
+            Prev.SrcBox.MinZ != Region.SrcBox.MinZ || Prev.SrcBox.MaxZ != Region.SrcBox.MaxZ || Prev.DstZ != Region.DstZ)
+            return false;
+
+        const auto& PrevBox = Prev.SrcBox;
+        const auto& Box     = Region.SrcBox;
+        if (PrevBox.MinX == Box.MinX && PrevBox.MaxX == Box.MaxX && Prev.DstX == Region.DstX &&
+            PrevBox.MaxY == Box.MinY && Prev.DstY + (PrevBox.MaxY - PrevBox.MinY) == Region.DstY)
+        {
+            Prev.SrcBox.MaxY = Box.MaxY;
+            return true;
+        }
+
+        if (PrevBox.MinY == Box.MinY && PrevBox.MaxY == Box.MaxY && Prev.DstY == Region.DstY &&
+            PrevBox.MaxX == Box.MinX && Prev.DstX + (PrevBox.MaxX - PrevBox.MinX) == Region.DstX)
+        {
+            Prev.SrcBox.MaxX = Box.MaxX;
+            return true;
+        }
+
+        return false;
+    }
+
+    void TextureUploaderBase::EnqueueCopy(UploadBufferBase* pUploadBuffer, ITexture* pDstTexture, Uint32 DstSlice, Uint32 DstMip, UPLOAD_PRIORITY Priority)
+    {
+        const auto& BuffDesc = pUploadBuffer->GetDesc();
+
+        PendingCopy Copy;
+        Copy.pUploadBuffer = pUploadBuffer;
+        Copy.pDstTexture   = pDstTexture;
+        Copy.DstSlice      = DstSlice;
+        Copy.DstMip        = DstMip;
+
+        auto BuffTexDesc = GetUploadBufferTexDesc(BuffDesc);
+        for (Uint32 Mip = 0; Mip < BuffDesc.MipLevels; ++Mip)
+            Copy.NumBytes += GetMipLevelProperties(BuffTexDesc, Mip).MipSize * BuffDesc.ArraySize;
+
+        PushCopy(std::move(Copy), Priority);
+    }
+
+    void TextureUploaderBase::ScheduleGPUCopyRegions(ITexture*                  pDstTexture,
+                                                     IUploadBuffer*             pUploadBuffer,
+                                                     const TextureUploadRegion* pRegions,
+                                                     Uint32                     NumRegions,
+                                                     UPLOAD_PRIORITY            Priority)
+    {
+        DEV_CHECK_ERR(NumRegions > 0, "At least one region must be specified");
+        if (NumRegions == 0)
+            return;
+
+        auto* pUploadBufferBase = ValidatedCast<UploadBufferBase>(pUploadBuffer);
+        const auto& BuffDesc = pUploadBufferBase->GetDesc();
+        const auto  BuffTexDesc = GetUploadBufferTexDesc(BuffDesc);
+        const auto& FmtAttribs  = GetTextureFormatAttribs(BuffDesc.Format);
+
+        PendingCopy Copy;
+        Copy.pUploadBuffer = pUploadBufferBase;
+        Copy.pDstTexture   = pDstTexture;
+        Copy.Regions.reserve(NumRegions);
+        for (Uint32 r = 0; r < NumRegions; ++r)
+        {
+            const auto& Region = pRegions[r];
+            const auto& Box    = Region.SrcBox;
+            DEV_CHECK_ERR(Region.SrcMip < BuffDesc.MipLevels && Region.SrcSlice < BuffDesc.ArraySize, "Source subresource of region ", r, " is out of range");
+            DEV_CHECK_ERR(Box.MinX < Box.MaxX && Box.MinY < Box.MaxY && Box.MinZ < Box.MaxZ, "Source box of region ", r, " is empty");
+#ifdef DEVELOPMENT
+            {
+                auto MipProps = GetMipLevelProperties(BuffTexDesc, Region.SrcMip);
+                DEV_CHECK_ERR(Box.MaxX <= MipProps.StorageWidth && Box.MaxY <= MipProps.StorageHeight && Box.MaxZ <= MipProps.Depth,
+                              "Source box of region ", r, " exceeds the dimensions of the upload buffer subresource");
+            }
+#endif
+
+            Uint32 RegionWidth  = Box.MaxX - Box.MinX;
+            Uint32 RegionHeight = Box.MaxY - Box.MinY;
+            if (FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED)
+            {
+                RegionWidth  = (RegionWidth  + FmtAttribs.BlockWidth  - 1) / FmtAttribs.BlockWidth;
+                RegionHeight = (RegionHeight + FmtAttribs.BlockHeight - 1) / FmtAttribs.BlockHeight;
+            }
+            Copy.NumBytes += RegionWidth * RegionHeight * (Box.MaxZ - Box.MinZ) * FmtAttribs.GetElementSize();
+
+            if (Copy.Regions.empty() || !MergeRegions(Copy.Regions.back(), Region))
+                Copy.Regions.emplace_back(Region);
+        }
+
+        PushCopy(std::move(Copy), Priority);
+    }
+
+    void TextureUploaderBase::PushCopy(PendingCopy&& Copy, UPLOAD_PRIORITY Priority)
+    {
+        VERIFY(Priority < UPLOAD_PRIORITY_COUNT, "Invalid upload priority");
+
+        std::lock_guard<std::mutex> QueueLock(m_CopyQueueMtx);
+
+        // Returns true if the copy writes to the given subresource of its destination texture
+        auto WritesSubresource = [](const PendingCopy& C, Uint32 Slice, Uint32 Mip)
+        {
+            if (C.Regions.empty())
+            {
+                const auto& BuffDesc = C.pUploadBuffer->GetDesc();
+                return Slice >= C.DstSlice && Slice < C.DstSlice + BuffDesc.ArraySize &&
+                       Mip   >= C.DstMip   && Mip   < C.DstMip   + BuffDesc.MipLevels;
+            }
+            return std::any_of(C.Regions.begin(), C.Regions.end(),
+                [&](const TextureUploadRegion& Region){ return Region.DstSlice == Slice && Region.DstMip == Mip; });
+        };
+        auto IsOverwritten = [&](Uint32 Slice, Uint32 Mip)
+        {
+            return WritesSubresource(Copy, Slice, Mip);
+        };
+
+        // Pending copies whose destination subresources are all overwritten by the new copy are superseded.
+        // Region copies only overwrite parts of subresources and never supersede other copies.
+        if (Copy.Regions.empty())
+        {
+            for (auto& Queue : m_CopyQueues)
+            {
+                for (auto it = Queue.begin(); it != Queue.end(); )
+                {
+                    bool IsSuperseded = false;
+                    if (it->pDstTexture == Copy.pDstTexture)
+                    {
+                        if (it->Regions.empty())
+                        {
+                            const auto& OldBuffDesc = it->pUploadBuffer->GetDesc();
+                            IsSuperseded = IsOverwritten(it->DstSlice, it->DstMip) &&
+                                           IsOverwritten(it->DstSlice + OldBuffDesc.ArraySize - 1, it->DstMip + OldBuffDesc.MipLevels - 1);
+                        }
+                        else
+                        {
+                            IsSuperseded = std::all_of(it->Regions.begin(), it->Regions.end(),
+                                [&](const TextureUploadRegion& Region){ return IsOverwritten(Region.DstSlice, Region.DstMip); });
+                        }
+                    }
+
+                    if (IsSuperseded)
+                    {
+                        m_CanceledCopies.emplace_back(std::move(*it));
+                        it = Queue.erase(it);
+                        ++m_NumCanceledCopies;
+                    }
+                    else
+                        ++it;
+                }
+            }
+        }
+
+        // Remaining copies to the same subresources must be executed before the new copy. Queues are
+        // processed from the highest to the lowest priority, so the new copy is demoted to the lowest
+        // priority of these copies, which places it after all of them.
+        for (int QueuePriority = 0; QueuePriority < Priority; ++QueuePriority)
+        {
+            const auto& Queue = m_CopyQueues[QueuePriority];
+            bool HasOverlappingCopy = std::any_of(Queue.begin(), Queue.end(),
+                [&](const PendingCopy& OldCopy)
+                {
+                    if (OldCopy.pDstTexture != Copy.pDstTexture)
+                        return false;
+                    if (OldCopy.Regions.empty())
+                    {
+                        // Check the new copy's subresources against the full range of the old copy
+                        if (!Copy.Regions.empty())
+                        {
+                            return std::any_of(Copy.Regions.begin(), Copy.Regions.end(),
+                                [&](const TextureUploadRegion& Region){ return WritesSubresource(OldCopy, Region.DstSlice, Region.DstMip); });
+                        }
+                        const auto& OldBuffDesc = OldCopy.pUploadBuffer->GetDesc();
+                        const auto& NewBuffDesc = Copy.pUploadBuffer->GetDesc();
+                        return OldCopy.DstSlice < Copy.DstSlice + NewBuffDesc.ArraySize && Copy.DstSlice < OldCopy.DstSlice + OldBuffDesc.ArraySize &&
+                               OldCopy.DstMip   < Copy.DstMip   + NewBuffDesc.MipLevels && Copy.DstMip   < OldCopy.DstMip   + OldBuffDesc.MipLevels;
+                    }
+                    return std::any_of(OldCopy.Regions.begin(), OldCopy.Regions.end(),
+                        [&](const TextureUploadRegion& Region){ return IsOverwritten(Region.DstSlice, Region.DstMip); });
+                });
+            if (HasOverlappingCopy)
+            {
+                Priority = static_cast<UPLOAD_PRIORITY>(QueuePriority);
+                break;
+            }
+        }
+
+        m_CopyQueues[Priority].emplace_back(std::move(Copy));
+    }
+
+    void TextureUploaderBase::CancelCopies(ITexture* pDstTexture)
+    {
+        std::lock_guard<std::mutex> QueueLock(m_CopyQueueMtx);
+        for (auto& Queue : m_CopyQueues)
+        {
+            for (auto it = Queue.begin(); it != Queue.end(); )
+            {
+                if (it->pDstTexture.RawPtr() == pDstTexture)
+                {
+                    m_CanceledCopies.emplace_back(std::move(*it));
+                    it = Queue.erase(it);
+                    ++m_NumCanceledCopies;
+                }
+                else
+                    ++it;
+            }
+        }
+    }
+
+    void TextureUploaderBase::ProcessPendingCopies(IDeviceContext* pContext)
+    {
+        {
+            std::vector<PendingCopy> CanceledCopies;
+            {
+                std::lock_guard<std::mutex> QueueLock(m_CopyQueueMtx);
+                CanceledCopies.swap(m_CanceledCopies);
+            }
+            for (auto& Copy : CanceledCopies)
+                CancelCopy(pContext, Copy);
+        }
+
+        Timer  UpdateTimer;
+        Uint64 NumBytes   = 0;
+        Uint32 NumCopies  = 0;
+        double LatencySum = 0;
+        double MaxLatency = 0;
+        for (;;)
+        {
+            PendingCopy Copy;
+            {
+                std::lock_guard<std::mutex> QueueLock(m_CopyQueueMtx);
+                std::deque<PendingCopy>* pQueue = nullptr;
+                for (int Priority = UPLOAD_PRIORITY_COUNT - 1; Priority >= 0 && pQueue == nullptr; --Priority)
+                {
+                    if (!m_CopyQueues[Priority].empty())
+                        pQueue = &m_CopyQueues[Priority];
+                }
+                if (pQueue == nullptr)
+                    break;
+
+                // The first copy is always executed so that copies that exceed the budget make progress
+                if (NumCopies > 0 && m_Desc.MaxBytesPerUpdate != 0 && NumBytes + pQueue->front().NumBytes > m_Desc.MaxBytesPerUpdate)
+                    break;
+
+                Copy = std::move(pQueue->front());
+                pQueue->pop_front();
+            }
+
+            auto Latency = Copy.QueueTimer.GetElapsedTime();
+            ExecuteCopy(pContext, Copy);
+
+            NumBytes   += Copy.NumBytes;
+            LatencySum += Latency;
+            MaxLatency  = std::max(MaxLatency, Latency);
+            ++NumCopies;
+
+            if (m_Desc.MaxTimePerUpdateMs > 0 && UpdateTimer.GetElapsedTime() * 1000.0 >= m_Desc.MaxTimePerUpdateMs)
+                break;
+        }
+
+        UpdateThroughputStats(NumBytes, NumCopies, LatencySum, MaxLatency);
+    }
+
+    void TextureUploaderBase::UpdateThroughputStats(Uint64 NumBytes, Uint32 NumCopies, double LatencySum, double MaxLatency)
+    {
+        std::lock_guard<std::mutex> StatsLock(m_StatsMtx);
+        m_NumBytesUploaded   += NumBytes;
+        m_IntervalNumBytes   += NumBytes;
+        m_IntervalNumCopies  += NumCopies;
+        m_IntervalLatencySum += LatencySum;
+        m_IntervalMaxLatency  = std::max(m_IntervalMaxLatency, MaxLatency);
+
+        auto IntervalTime = m_IntervalTimer.GetElapsedTime();
+        if (IntervalTime >= 1.0)
+        {
+            m_BytesPerSecond    = static_cast<double>(m_IntervalNumBytes) / IntervalTime;
+            m_AvgQueueLatencyMs = m_IntervalNumCopies > 0 ? static_cast<float>(m_IntervalLatencySum / m_IntervalNumCopies * 1000.0) : 0.f;
+            m_MaxQueueLatencyMs = static_cast<float>(m_IntervalMaxLatency * 1000.0);
+
+            m_IntervalNumBytes   = 0;
+            m_IntervalNumCopies  = 0;
+            m_IntervalLatencySum = 0;
+            m_IntervalMaxLatency = 0;
+            m_IntervalTimer.Restart();
+        }
+    }
+
+    TextureUploaderStats TextureUploaderBase::GetStats()
+    {
+        TextureUploaderStats Stats;
+        Stats.NumPendingOperations = GetNumPendingMapOperations();
+
+        {
+            std::lock_guard<std::mutex> QueueLock(m_CopyQueueMtx);
+            for (const auto& Queue : m_CopyQueues)
+                Stats.NumPendingOperations += static_cast<Uint32>(Queue.size());
+            Stats.NumPendingOperations += static_cast<Uint32>(m_CanceledCopies.size());
+            Stats.NumCanceledCopies = m_NumCanceledCopies;
+        }
+
+        {
+            std::lock_guard<std::mutex> StatsLock(m_StatsMtx);
+            Stats.NumBytesUploaded  = m_NumBytesUploaded;
+            Stats.BytesPerSecond    = m_BytesPerSecond;
+            Stats.AvgQueueLatencyMs = m_AvgQueueLatencyMs;
+            Stats.MaxQueueLatencyMs = m_MaxQueueLatencyMs;
+        }
+
+        Stats.NumUploadBuffersCreated = m_NumUploadBuffersCreated;
+        Stats.NumUploadBuffersReused  = m_NumUploadBuffersReused;
+
+        return Stats;
+    }
 }
@@ -112,27 +112,14 @@ struct TextureUploaderD3D11::InternalData
         enum Operation
         {
             Map,
-            Copy,
             MapAndCache
         }operation;
         RefCntAutoPtr<UploadBufferD3D11> pUploadBuffer;
-        CComPtr<ID3D11Resource> pd3d11NativeDstTexture;
-        Uint32 DstMip       = 0;
-        Uint32 DstSlice     = 0;
-        Uint32 DstMipLevels = 0;
 
         PendingBufferOperation(Operation op, UploadBufferD3D11* pBuff) :
             operation    (op),
             pUploadBuffer(pBuff)
         {}
-        PendingBufferOperation(Operation op, UploadBufferD3D11* pBuff, ID3D11Resource* pd3d11DstTex, Uint32 Mip, Uint32 Slice, Uint32 MipLevels) :
-            operation             (op),
-            pUploadBuffer         (pBuff),
-            pd3d11NativeDstTexture(pd3d11DstTex),
-            DstMip                (Mip),
-            DstSlice              (Slice),
-            DstMipLevels          (MipLevels)
-        {}
     };
 
     InternalData(IRenderDevice* pDevice)
@@ -149,12 +136,6 @@ struct TextureUploaderD3D11::InternalData
         m_PendingOperations.swap(m_InWorkOperations);
     }
 
-    void EnqueCopy(UploadBufferD3D11* pUploadBuffer, ID3D11Resource* pd3d11DstTex, Uint32 Mip, Uint32 Slice, Uint32 MipLevels)
-    {
-        std::lock_guard<std::mutex> QueueLock(m_PendingOperationsMtx);
-        m_PendingOperations.emplace_back(PendingBufferOperation::Operation::Copy, pUploadBuffer, pd3d11DstTex, Mip, Slice, MipLevels);
-    }
-
     void EnqueMap(UploadBufferD3D11 *pUploadBuffer, PendingBufferOperation::Operation Op)
     {
         std::lock_guard<std::mutex> QueueLock(m_PendingOperationsMtx);
@@ -260,45 +241,101 @@ void TextureUploaderD3D11::RenderThreadUpdate(IDeviceContext* pContext)
                     }
                 }
                 break;
-
-                case InternalData::PendingBufferOperation::Copy:
-                {
-                    VERIFY(pBuffer->DbgIsMapped(), "Upload buffer must be copied only after it has been mapped");
-                    // Unmap all subresources first to avoid D3D11 warnings
-                    for (Uint32 Subres = 0; Subres < UploadBuffDesc.MipLevels * UploadBuffDesc.ArraySize; ++Subres)
-                    {
-                        pd3d11NativeCtx->Unmap(pBuffer->GetStagingTex(), Subres);
-                    }
-
-                    for (Uint32 Slice = 0; Slice < UploadBuffDesc.ArraySize; ++Slice)
-                    {
-                        for (Uint32 Mip = 0; Mip < UploadBuffDesc.MipLevels; ++Mip)
-                        {
-                            UINT SrcSubres = D3D11CalcSubresource(
-                                static_cast<UINT>(Mip),
-                                static_cast<UINT>(Slice),
-                                static_cast<UINT>(UploadBuffDesc.MipLevels)
-                            );
-                            UINT DstSubres = D3D11CalcSubresource(
-                                static_cast<UINT>(OperationInfo.DstMip   + Mip),
-                                static_cast<UINT>(OperationInfo.DstSlice + Slice),
-                                static_cast<UINT>(OperationInfo.DstMipLevels)
-                            );
-                            pd3d11NativeCtx->CopySubresourceRegion(OperationInfo.pd3d11NativeDstTexture, DstSubres,
-                                0, 0, 0,  // DstX, DstY, DstZ
-                                pBuffer->GetStagingTex(),
-                                SrcSubres,
-                                nullptr // pSrcBox
-                            );
-                        }
-                    }
-                    pBuffer->SignalCopyScheduled();
-                }
-                break;
             }
         }
         m_pInternalData->m_InWorkOperations.clear();
     }
+
+    ProcessPendingCopies(pContext);
+}
+
+void TextureUploaderD3D11::ExecuteCopy(IDeviceContext* pContext, PendingCopy& Copy)
+{
+    RefCntAutoPtr<IDeviceContextD3D11> pContextD3D11(pContext, IID_DeviceContextD3D11);
+    auto* pd3d11NativeCtx = pContextD3D11->GetD3D11DeviceContext();
+    RefCntAutoPtr<ITextureD3D11> pDstTexD3D11(Copy.pDstTexture.RawPtr(), IID_TextureD3D11);
+    auto* pd3d11NativeDstTex = pDstTexD3D11->GetD3D11Texture();
+    const auto DstMipLevels = Copy.pDstTexture->GetDesc().MipLevels;
+
+    auto* pBuffer = Copy.pUploadBuffer.RawPtr<UploadBufferD3D11>();
+    const auto& UploadBuffDesc = pBuffer->GetDesc();
+    VERIFY(pBuffer->DbgIsMapped(), "Upload buffer must be copied only after it has been mapped");
+    // Unmap all subresources first to avoid D3D11 warnings
+    for (Uint32 Subres = 0; Subres < UploadBuffDesc.MipLevels * UploadBuffDesc.ArraySize; ++Subres)
+    {
+        pd3d11NativeCtx->Unmap(pBuffer->GetStagingTex(), Subres);
+    }
+
+    if (!Copy.Regions.empty())
+    {
+        for (const auto& Region : Copy.Regions)
+        {
+            UINT SrcSubres = D3D11CalcSubresource(
+                static_cast<UINT>(Region.SrcMip),
+                static_cast<UINT>(Region.SrcSlice),
+                static_cast<UINT>(UploadBuffDesc.MipLevels)
+            );
+            UINT DstSubres = D3D11CalcSubresource(
+                static_cast<UINT>(Region.DstMip),
+                static_cast<UINT>(Region.DstSlice),
+                static_cast<UINT>(DstMipLevels)
+            );
+            D3D11_BOX SrcBox;
+            SrcBox.left   = Region.SrcBox.MinX;
+            SrcBox.right  = Region.SrcBox.MaxX;
+            SrcBox.top    = Region.SrcBox.MinY;
+            SrcBox.bottom = Region.SrcBox.MaxY;
+            SrcBox.front  = Region.SrcBox.MinZ;
+            SrcBox.back   = Region.SrcBox.MaxZ;
+            pd3d11NativeCtx->CopySubresourceRegion(pd3d11NativeDstTex, DstSubres,
+                Region.DstX, Region.DstY, Region.DstZ,
+                pBuffer->GetStagingTex(),
+                SrcSubres,
+                &SrcBox
+            );
+        }
+        pBuffer->SignalCopyScheduled();
+        return;
+    }
+
+    for (Uint32 Slice = 0; Slice < UploadBuffDesc.ArraySize; ++Slice)
+    {
+        for (Uint32 Mip = 0; Mip < UploadBuffDesc.MipLevels; ++Mip)
+        {
+            UINT SrcSubres = D3D11CalcSubresource(
+                static_cast<UINT>(Mip),
+                static_cast<UINT>(Slice),
+                static_cast<UINT>(UploadBuffDesc.MipLevels)
+            );
+            UINT DstSubres = D3D11CalcSubresource(
+                static_cast<UINT>(Copy.DstMip   + Mip),
+                static_cast<UINT>(Copy.DstSlice + Slice),
+                static_cast<UINT>(DstMipLevels)
+            );
+            pd3d11NativeCtx->CopySubresourceRegion(pd3d11NativeDstTex, DstSubres,
+                0, 0, 0,  // DstX, DstY, DstZ
+                pBuffer->GetStagingTex(),
+                SrcSubres,
+                nullptr // pSrcBox
+            );
+        }
+    }
+    pBuffer->SignalCopyScheduled();
+}
+
+void TextureUploaderD3D11::CancelCopy(IDeviceContext* pContext, PendingCopy& Copy)
+{
+    RefCntAutoPtr<IDeviceContextD3D11> pContextD3D11(pContext, IID_DeviceContextD3D11);
+    auto* pd3d11NativeCtx = pContextD3D11->GetD3D11DeviceContext();
+
+    auto* pBuffer = Copy.pUploadBuffer.RawPtr<UploadBufferD3D11>();
+    const auto& UploadBuffDesc = pBuffer->GetDesc();
+    // All subresources are mapped again when the buffer is recycled
+    for (Uint32 Subres = 0; Subres < UploadBuffDesc.MipLevels * UploadBuffDesc.ArraySize; ++Subres)
+    {
+        pd3d11NativeCtx->Unmap(pBuffer->GetStagingTex(), Subres);
+    }
+    pBuffer->SignalCopyScheduled();
 }
 
 void TextureUploaderD3D11::AllocateUploadBuffer(const UploadBufferDesc& Desc, bool IsRenderThread, IUploadBuffer **ppBuffer)
@@ -318,6 +355,7 @@ void TextureUploaderD3D11::AllocateUploadBuffer(const UploadBufferDesc& Desc, bo
                 {
                     *ppBuffer = Deque.front().Detach();
                     Deque.pop_front();
+                    OnUploadBufferReused();
                 }
             }
         }
@@ -351,22 +389,21 @@ void TextureUploaderD3D11::AllocateUploadBuffer(const UploadBufferDesc& Desc, bo
                          m_pDevice->GetTextureFormatInfo(Desc.Format).Name, " staging texture");
 
         RefCntAutoPtr<UploadBufferD3D11> pUploadBuffer(MakeNewRCObj<UploadBufferD3D11>()(Desc, pStagingTex));
+        OnUploadBufferCreated();
         m_pInternalData->EnqueMap(pUploadBuffer, InternalData::PendingBufferOperation::Map);
         pUploadBuffer->WaitForMap();
         *ppBuffer = pUploadBuffer.Detach();
     }
 }
 
-void TextureUploaderD3D11::ScheduleGPUCopy(ITexture*      pDstTexture,
-                                           Uint32         ArraySlice,
-                                           Uint32         MipLevel,
-                                           IUploadBuffer* pUploadBuffer)
+void TextureUploaderD3D11::ScheduleGPUCopy(ITexture*       pDstTexture,
+                                           Uint32          ArraySlice,
+                                           Uint32          MipLevel,
+                                           IUploadBuffer*  pUploadBuffer,
+                                           UPLOAD_PRIORITY Priority)
 {
     auto* pUploadBufferD3D11 = ValidatedCast<UploadBufferD3D11>(pUploadBuffer);
-    RefCntAutoPtr<ITextureD3D11> pDstTexD3D11(pDstTexture, IID_TextureD3D11);
-    auto* pd3d11NativeDstTex = pDstTexD3D11->GetD3D11Texture();
-    const auto& DstTexDesc = pDstTexture->GetDesc();
-    m_pInternalData->EnqueCopy(pUploadBufferD3D11, pd3d11NativeDstTex, MipLevel, ArraySlice, DstTexDesc.MipLevels);
+    EnqueueCopy(pUploadBufferD3D11, pDstTexture, ArraySlice, MipLevel, Priority);
 }
 
 void TextureUploaderD3D11::RecycleBuffer(IUploadBuffer *pUploadBuffer)
@@ -378,19 +415,18 @@ void TextureUploaderD3D11::RecycleBuffer(IUploadBuffer *pUploadBuffer)
     m_pInternalData->EnqueMap(pUploadBufferD3D11, InternalData::PendingBufferOperation::MapAndCache);
 }
 
-TextureUploaderStats TextureUploaderD3D11::GetStats()
+Uint32 TextureUploaderD3D11::GetNumPendingMapOperations()
 {
-    TextureUploaderStats Stats;
+    Uint32 NumPendingMaps = 0;
     std::lock_guard<std::mutex> QueueLock(m_pInternalData->m_PendingOperationsMtx);
     for (auto &OperationInfo : m_pInternalData->m_PendingOperations)
     {
         // Do not count MapAndCache operations as they are performed as part of the 
         // buffer recycling.
-        if (OperationInfo.operation == InternalData::PendingBufferOperation::Map ||
-            OperationInfo.operation == InternalData::PendingBufferOperation::Copy)
-            ++Stats.NumPendingOperations;
+        if (OperationInfo.operation == InternalData::PendingBufferOperation::Map)
+            ++NumPendingMaps;
     }
-    return Stats;
+    return NumPendingMaps;
 }
 
 } // namespace Diligent
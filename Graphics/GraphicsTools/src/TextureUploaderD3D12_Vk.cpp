@@ -133,31 +133,6 @@ private:
     
 struct TextureUploaderD3D12_Vk::InternalData
 {
-    struct PendingBufferOperation
-    {
-        enum Operation
-        {
-            Copy,
-            Map
-        }operation;
-        RefCntAutoPtr<UploadTexture> pUploadTexture;
-        RefCntAutoPtr<ITexture>      pDstTexture;
-        Uint32                       DstSlice       = 0;
-        Uint32                       DstMip         = 0;
-
-        PendingBufferOperation(Operation op, UploadTexture* pUploadTex) :
-            operation     (op),
-            pUploadTexture(pUploadTex)
-        {}
-        PendingBufferOperation(Operation op, UploadTexture* pUploadTex, ITexture* pDstTex, Uint32 dstSlice, Uint32 dstMip) :
-            operation      (op),
-            pUploadTexture (pUploadTex),
-            pDstTexture    (pDstTex),
-            DstSlice       (dstSlice),
-            DstMip         (dstMip)
-        {}
-    };
-
     InternalData(IRenderDevice* pDevice)
     {
         FenceDesc fenceDesc;
@@ -178,23 +153,17 @@ struct TextureUploaderD3D12_Vk::InternalData
         }
     }
 
-    std::vector<PendingBufferOperation>& SwapMapQueues()
-    {
-        std::lock_guard<std::mutex> QueueLock(m_PendingOperationsMtx);
-        m_PendingOperations.swap(m_InWorkOperations);
-        return m_InWorkOperations;
-    }
-
-    void EnqueCopy(UploadTexture* pUploadBuffer, ITexture* pDstTex, Uint32 dstSlice, Uint32 dstMip)
+    std::vector< RefCntAutoPtr<UploadTexture> >& SwapMapQueues()
     {
-        std::lock_guard<std::mutex> QueueLock(m_PendingOperationsMtx);
-        m_PendingOperations.emplace_back(PendingBufferOperation::Operation::Copy, pUploadBuffer, pDstTex, dstSlice, dstMip);
+        std::lock_guard<std::mutex> QueueLock(m_PendingMapsMtx);
+        m_PendingMaps.swap(m_InWorkMaps);
+        return m_InWorkMaps;
     }
 
     void EnqueMap(UploadTexture* pUploadBuffer)
     {
-        std::lock_guard<std::mutex> QueueLock(m_PendingOperationsMtx);
-        m_PendingOperations.emplace_back(PendingBufferOperation::Operation::Map, pUploadBuffer);
+        std::lock_guard<std::mutex> QueueLock(m_PendingMapsMtx);
+        m_PendingMaps.emplace_back(pUploadBuffer);
     }
 
     Uint64 SignalFence(IDeviceContext* pContext)
@@ -243,16 +212,23 @@ struct TextureUploaderD3D12_Vk::InternalData
         Deque.emplace_back(pUploadTexture);
     }
 
-    Uint32 GetNumPendingOperations()
+    Uint32 GetNumPendingMaps()
     {
-        std::lock_guard<std::mutex> QueueLock(m_PendingOperationsMtx);
-        return static_cast<Uint32>(m_PendingOperations.size());
+        std::lock_guard<std::mutex> QueueLock(m_PendingMapsMtx);
+        return static_cast<Uint32>(m_PendingMaps.size());
     }
 
+    // Upload textures whose copies have been executed or canceled by the current update.
+    // Only accessed by the render thread.
+    std::vector< RefCntAutoPtr<UploadTexture> > m_ProcessedCopies;
+
+    // Scratch array of copy commands of one batch. Only accessed by the render thread.
+    std::vector<CopyTextureAttribs> m_CopyAttribs;
+
 private:
-    std::mutex                          m_PendingOperationsMtx;
-    std::vector<PendingBufferOperation> m_PendingOperations;
-    std::vector<PendingBufferOperation> m_InWorkOperations;
+    std::mutex                                  m_PendingMapsMtx;
+    std::vector< RefCntAutoPtr<UploadTexture> > m_PendingMaps;
+    std::vector< RefCntAutoPtr<UploadTexture> > m_InWorkMaps;
 
     std::mutex m_UploadTexturesCacheMtx;
     std::unordered_map< UploadBufferDesc, std::deque< RefCntAutoPtr<UploadTexture> > > m_UploadTexturesCache;
@@ -270,7 +246,7 @@ TextureUploaderD3D12_Vk::TextureUploaderD3D12_Vk(IReferenceCounters* pRefCounter
 
 TextureUploaderD3D12_Vk::~TextureUploaderD3D12_Vk()
 {
-    auto NumPendingOperations = m_pInternalData->GetNumPendingOperations();
+    auto NumPendingOperations = TextureUploaderD3D12_Vk::GetStats().NumPendingOperations;
     if (NumPendingOperations != 0)
     {
         LOG_WARNING_MESSAGE("TextureUploaderD3D12_Vk::~TextureUploaderD3D12_Vk(): there ", (NumPendingOperations > 1 ? "are " : "is "),
@@ -283,88 +259,140 @@ TextureUploaderD3D12_Vk::~TextureUploaderD3D12_Vk()
 
 void TextureUploaderD3D12_Vk::RenderThreadUpdate(IDeviceContext* pContext)
 {
-    auto& InWorkOperations = m_pInternalData->SwapMapQueues();
-    if (!InWorkOperations.empty())
+    auto& InWorkMaps = m_pInternalData->SwapMapQueues();
+    if (!InWorkMaps.empty())
     {
-        Uint32 NumCopyOperations = 0;
-        for (auto& OperationInfo : InWorkOperations)
+        for (auto& pUploadTex : InWorkMaps)
         {
-            auto& pUploadTex = OperationInfo.pUploadTexture;
             const auto& StagingTexDesc = pUploadTex->GetDesc();
-
-            switch (OperationInfo.operation)
+            for (Uint32 Slice = 0; Slice < StagingTexDesc.ArraySize; ++Slice)
             {
-                case InternalData::PendingBufferOperation::Map:
-                {
-                    for (Uint32 Slice = 0; Slice < StagingTexDesc.ArraySize; ++Slice)
-                    {
-                        for (Uint32 Mip = 0; Mip < StagingTexDesc.MipLevels; ++Mip)
-                        {
-                            pUploadTex->Map(pContext, Mip, Slice);
-                        }
-                    }
-                    pUploadTex->SignalMapped();
-                }
-                break;
-
-                case InternalData::PendingBufferOperation::Copy:
+                for (Uint32 Mip = 0; Mip < StagingTexDesc.MipLevels; ++Mip)
                 {
-                    VERIFY(pUploadTex->DbgIsMapped(), "Upload texture must be copied only after it has been mapped");
-                    for (Uint32 Slice = 0; Slice < StagingTexDesc.ArraySize; ++Slice)
-                    {
-                        for (Uint32 Mip = 0; Mip < StagingTexDesc.MipLevels; ++Mip)
-                        {
-                            pUploadTex->Unmap(pContext, Mip, Slice);
-
-                            CopyTextureAttribs CopyInfo
-                            {
-                                pUploadTex->GetStagingTexture(),
-                                RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
-                                OperationInfo.pDstTexture,
-                                RESOURCE_STATE_TRANSITION_MODE_TRANSITION
-                            };
-                            CopyInfo.SrcMipLevel = Mip;
-                            CopyInfo.SrcSlice    = Slice;
-                            CopyInfo.DstMipLevel = OperationInfo.DstMip   + Mip;
-                            CopyInfo.DstSlice    = OperationInfo.DstSlice + Slice;
-                            pContext->CopyTexture(CopyInfo);
-                        }
-                    }
-                    ++NumCopyOperations;
+                    pUploadTex->Map(pContext, Mip, Slice);
                 }
-                break;
             }
+            pUploadTex->SignalMapped();
         }
+        InWorkMaps.clear();
+    }
+
+    ProcessPendingCopies(pContext);
+
+    auto& ProcessedCopies = m_pInternalData->m_ProcessedCopies;
+    if (!ProcessedCopies.empty())
+    {
+        // The buffer may be recycled immediately after the copy scheduled is signaled,
+        // so we must signal the fence first.
+        auto SignaledFenceValue = m_pInternalData->SignalFence(pContext);
+
+        for (auto& pUploadTex : ProcessedCopies)
+            pUploadTex->SignalCopyScheduled(SignaledFenceValue);
+
+        ProcessedCopies.clear();
+    }
 
-        if (NumCopyOperations > 0)
+    // This must be called by the same thread that signals the fence
+    m_pInternalData->UpdatedCompletedFenceValue();
+}
+
+void TextureUploaderD3D12_Vk::ExecuteCopy(IDeviceContext* pContext, PendingCopy& Copy)
+{
+    auto* pUploadTex = Copy.pUploadBuffer.RawPtr<UploadTexture>();
+    const auto& StagingTexDesc = pUploadTex->GetDesc();
+    VERIFY(pUploadTex->DbgIsMapped(), "Upload texture must be copied only after it has been mapped");
+    for (Uint32 Slice = 0; Slice < StagingTexDesc.ArraySize; ++Slice)
+    {
+        for (Uint32 Mip = 0; Mip < StagingTexDesc.MipLevels; ++Mip)
         {
-            // The buffer may be recycled immediately after the copy scheduled is signaled,
-            // so we must signal the fence first.
-            auto SignaledFenceValue = m_pInternalData->SignalFence(pContext);
+            pUploadTex->Unmap(pContext, Mip, Slice);
+        }
+    }
 
-            for (auto& OperationInfo : InWorkOperations)
+    // All copies of the batch are issued with one MultiCopyTexture() call, so that
+    // Vulkan backend records them with a single buffer-to-image copy command
+    auto& CopyAttribs = m_pInternalData->m_CopyAttribs;
+    CopyAttribs.clear();
+    const CopyTextureAttribs BaseCopyInfo
+    {
+        pUploadTex->GetStagingTexture(),
+        RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+        Copy.pDstTexture,
+        RESOURCE_STATE_TRANSITION_MODE_TRANSITION
+    };
+    if (Copy.Regions.empty())
+    {
+        for (Uint32 Slice = 0; Slice < StagingTexDesc.ArraySize; ++Slice)
+        {
+            for (Uint32 Mip = 0; Mip < StagingTexDesc.MipLevels; ++Mip)
             {
-                if (OperationInfo.operation == InternalData::PendingBufferOperation::Copy)
-                    OperationInfo.pUploadTexture->SignalCopyScheduled(SignaledFenceValue);
+                CopyAttribs.emplace_back(BaseCopyInfo);
+                auto& CopyInfo = CopyAttribs.back();
+                CopyInfo.SrcMipLevel = Mip;
+                CopyInfo.SrcSlice    = Slice;
+                CopyInfo.DstMipLevel = Copy.DstMip   + Mip;
+                CopyInfo.DstSlice    = Copy.DstSlice + Slice;
             }
         }
-
-        InWorkOperations.clear();
     }
+    else
+    {
+        for (const auto& Region : Copy.Regions)
+        {
+            CopyAttribs.emplace_back(BaseCopyInfo);
+            auto& CopyInfo = CopyAttribs.back();
+            CopyInfo.SrcMipLevel = Region.SrcMip;
+            CopyInfo.SrcSlice    = Region.SrcSlice;
+            CopyInfo.pSrcBox     = &Region.SrcBox;
+            CopyInfo.DstMipLevel = Region.DstMip;
+            CopyInfo.DstSlice    = Region.DstSlice;
+            CopyInfo.DstX        = Region.DstX;
+            CopyInfo.DstY        = Region.DstY;
+            CopyInfo.DstZ        = Region.DstZ;
+        }
+    }
+    pContext->MultiCopyTexture(CopyAttribs.data(), static_cast<Uint32>(CopyAttribs.size()));
 
-    // This must be called by the same thread that signals the fence
-    m_pInternalData->UpdatedCompletedFenceValue();
+    m_pInternalData->m_ProcessedCopies.emplace_back(pUploadTex);
+}
+
+void TextureUploaderD3D12_Vk::CancelCopy(IDeviceContext* pContext, PendingCopy& Copy)
+{
+    auto* pUploadTex = Copy.pUploadBuffer.RawPtr<UploadTexture>();
+    const auto& StagingTexDesc = pUploadTex->GetDesc();
+    // The texture is mapped again when it is reused
+    for (Uint32 Slice = 0; Slice < StagingTexDesc.ArraySize; ++Slice)
+    {
+        for (Uint32 Mip = 0; Mip < StagingTexDesc.MipLevels; ++Mip)
+        {
+            pUploadTex->Unmap(pContext, Mip, Slice);
+        }
+    }
+    m_pInternalData->m_ProcessedCopies.emplace_back(pUploadTex);
 }
 
 void TextureUploaderD3D12_Vk::AllocateUploadBuffer(const UploadBufferDesc& Desc, bool IsRenderThread, IUploadBuffer** ppBuffer)
 {
     RefCntAutoPtr<UploadTexture> pUploadTexture = m_pInternalData->FindCachedUploadTexture(Desc);
 
-    // No available buffer found in the cache
-    if (!pUploadTexture)
+    if (pUploadTexture)
     {
+        OnUploadBufferReused();
+    }
+    else
+    {
+        // No available buffer found in the cache
         TextureDesc StagingTexDesc;
-        StagingTexDesc.Type           = RESOURCE_DIM_TEX_2D;
+        if (Desc.Depth > 1)
+        {
+            StagingTexDesc.Type       = RESOURCE_DIM_TEX_3D;
+            StagingTexDesc.Depth      = Desc.Depth;
+        }
+        else
+        {
+            StagingTexDesc.Type       = Desc.ArraySize > 1 ? RESOURCE_DIM_TEX_2D_ARRAY : RESOURCE_DIM_TEX_2D;
+            StagingTexDesc.ArraySize  = Desc.ArraySize;
+        }
         StagingTexDesc.Width          = Desc.Width;
         StagingTexDesc.Height         = Desc.Height;
         StagingTexDesc.Format         = Desc.Format;
@@ -379,6 +407,7 @@ void TextureUploaderD3D12_Vk::AllocateUploadBuffer(const UploadBufferDesc& Desc,
                           GetTextureFormatAttribs(Desc.Format).Name, " staging texture");
 
         pUploadTexture = MakeNewRCObj<UploadTexture>()(Desc, pStagingTexture);
+        OnUploadBufferCreated();
     }
 
     m_pInternalData->EnqueMap(pUploadTexture);
@@ -389,10 +418,11 @@ void TextureUploaderD3D12_Vk::AllocateUploadBuffer(const UploadBufferDesc& Desc,
 void TextureUploaderD3D12_Vk::ScheduleGPUCopy(ITexture*        pDstTexture,
                                             Uint32           ArraySlice,
                                             Uint32           MipLevel,
-                                            IUploadBuffer*   pUploadBuffer)
+                                            IUploadBuffer*   pUploadBuffer,
+                                            UPLOAD_PRIORITY  Priority)
 {
     auto* pUploadTexture = ValidatedCast<UploadTexture>(pUploadBuffer);
-    m_pInternalData->EnqueCopy(pUploadTexture, pDstTexture, ArraySlice, MipLevel);
+    EnqueueCopy(pUploadTexture, pDstTexture, ArraySlice, MipLevel, Priority);
 }
 
 void TextureUploaderD3D12_Vk::RecycleBuffer(IUploadBuffer* pUploadBuffer)
@@ -403,11 +433,9 @@ void TextureUploaderD3D12_Vk::RecycleBuffer(IUploadBuffer* pUploadBuffer)
     m_pInternalData->RecycleUploadTexture(pUploadTexture);
 }
 
-TextureUploaderStats TextureUploaderD3D12_Vk::GetStats()
+Uint32 TextureUploaderD3D12_Vk::GetNumPendingMapOperations()
 {
-    TextureUploaderStats Stats;
-    Stats.NumPendingOperations = static_cast<Uint32>(m_pInternalData->GetNumPendingOperations());
-    return Stats;
+    return m_pInternalData->GetNumPendingMaps();
 }
 
 } // namespace Diligent
@@ -145,51 +145,19 @@ struct TextureUploaderGL::InternalData
 {
     void SwapMapQueues()
     {
-        std::lock_guard<std::mutex> QueueLock(m_PendingOperationsMtx);
-        m_PendingOperations.swap(m_InWorkOperations);
-    }
-
-    void EnqueCopy(UploadBufferGL *pUploadBuffer, ITexture *pDstTexture, Uint32 dstSlice, Uint32 dstMip)
-    {
-        std::lock_guard<std::mutex> QueueLock(m_PendingOperationsMtx);
-        m_PendingOperations.emplace_back(PendingBufferOperation::Operation::Copy, pUploadBuffer, pDstTexture, dstSlice, dstMip);
+        std::lock_guard<std::mutex> QueueLock(m_PendingMapsMtx);
+        m_PendingMaps.swap(m_InWorkMaps);
     }
 
     void EnqueMap(UploadBufferGL *pUploadBuffer)
     {
-        std::lock_guard<std::mutex> QueueLock(m_PendingOperationsMtx);
-        m_PendingOperations.emplace_back(PendingBufferOperation::Operation::Map, pUploadBuffer);
+        std::lock_guard<std::mutex> QueueLock(m_PendingMapsMtx);
+        m_PendingMaps.emplace_back(pUploadBuffer);
     }
 
-        
-    struct PendingBufferOperation
-    {
-        enum Operation
-        {
-            Map,
-            Copy
-        }operation;
-        RefCntAutoPtr<UploadBufferGL> pUploadBuffer;
-        RefCntAutoPtr<ITexture> pDstTexture;
-        Uint32 DstSlice = 0;
-        Uint32 DstMip = 0;
-
-        PendingBufferOperation(Operation op, UploadBufferGL* pBuff) :
-            operation(op),
-            pUploadBuffer(pBuff)
-        {}
-        PendingBufferOperation(Operation op, UploadBufferGL* pBuff, ITexture *pDstTex, Uint32 dstSlice, Uint32 dstMip) :
-            operation(op),
-            pUploadBuffer(pBuff),
-            pDstTexture(pDstTex),
-            DstSlice(dstSlice),
-            DstMip(dstMip)
-        {}
-    };
-
-    std::mutex m_PendingOperationsMtx;
-    std::vector< PendingBufferOperation > m_PendingOperations;
-    std::vector< PendingBufferOperation > m_InWorkOperations;
+    std::mutex m_PendingMapsMtx;
+    std::vector< RefCntAutoPtr<UploadBufferGL> > m_PendingMaps;
+    std::vector< RefCntAutoPtr<UploadBufferGL> > m_InWorkMaps;
 
     std::mutex m_UploadBuffCacheMtx;
     std::unordered_map< UploadBufferDesc, std::deque<RefCntAutoPtr<UploadBufferGL> > > m_UploadBufferCache;
@@ -226,62 +194,114 @@ TextureUploaderGL::~TextureUploaderGL()
 void TextureUploaderGL::RenderThreadUpdate(IDeviceContext *pContext)
 {
     m_pInternalData->SwapMapQueues();
-    if (!m_pInternalData->m_InWorkOperations.empty())
+    if (!m_pInternalData->m_InWorkMaps.empty())
+    {
+        for (auto& pBuffer : m_pInternalData->m_InWorkMaps)
+        {
+            if (pBuffer->m_pStagingBuffer == nullptr)
+            {
+                BufferDesc BuffDesc;
+                BuffDesc.Name           = "Staging buffer for UploadBufferGL";
+                BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+                BuffDesc.Usage          = USAGE_STAGING;
+                BuffDesc.uiSizeInBytes  = pBuffer->GetTotalSize();
+                m_pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer->m_pStagingBuffer);
+            }
+
+            PVoid CpuAddress = nullptr;
+            pContext->MapBuffer(pBuffer->m_pStagingBuffer, MAP_WRITE, MAP_FLAG_DISCARD, CpuAddress);
+            pBuffer->SetDataPtr(reinterpret_cast<Uint8*>(CpuAddress));
+
+            pBuffer->SignalMapped();
+        }
+        m_pInternalData->m_InWorkMaps.clear();
+    }
+
+    ProcessPendingCopies(pContext);
+}
+
+void TextureUploaderGL::ExecuteCopy(IDeviceContext* pContext, PendingCopy& Copy)
+{
+    auto* pBuffer = Copy.pUploadBuffer.RawPtr<UploadBufferGL>();
+    const auto& UploadBuffDesc = pBuffer->GetDesc();
+    const auto& TexDesc        = Copy.pDstTexture->GetDesc();
+    pContext->UnmapBuffer(pBuffer->m_pStagingBuffer, MAP_WRITE);
+    if (!Copy.Regions.empty())
     {
-        for (auto& OperationInfo : m_pInternalData->m_InWorkOperations)
+        // Every region is uploaded with one glTexSubImage call that reads the rows of the region 
+        // directly from the staging buffer. Adjacent regions have been merged by the base class.
+        const auto& FmtAttribs = GetTextureFormatAttribs(UploadBuffDesc.Format);
+        for (const auto& Region : Copy.Regions)
         {
-            auto& pBuffer = OperationInfo.pUploadBuffer;
-            const auto& UploadBuffDesc = pBuffer->GetDesc();
+            const auto& SrcBox = Region.SrcBox;
+            // GL upload buffers store a single depth slice per subresource
+            if (SrcBox.MinZ != 0 || SrcBox.MaxZ != 1)
+            {
+                LOG_ERROR_MESSAGE("TextureUploaderGL: source box [", SrcBox.MinZ, ", ", SrcBox.MaxZ, ") spans more than one depth slice. "
+                                  "Only 2D regions are supported by the OpenGL backend; the region is skipped.");
+                continue;
+            }
 
-            switch (OperationInfo.operation)
+            auto SrcStride = pBuffer->GetStride(Region.SrcMip, Region.SrcSlice);
+            auto SrcOffset = pBuffer->GetOffset(Region.SrcMip, Region.SrcSlice) +
+                             SrcBox.MinY / Uint32{FmtAttribs.BlockHeight} * SrcStride +
+                             SrcBox.MinX / Uint32{FmtAttribs.BlockWidth}  * FmtAttribs.GetElementSize();
+            Box DstBox
             {
-                case InternalData::PendingBufferOperation::Map:
-                {
-                    if (pBuffer->m_pStagingBuffer == nullptr)
-                    {
-                        BufferDesc BuffDesc;
-                        BuffDesc.Name           = "Staging buffer for UploadBufferGL";
-                        BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
-                        BuffDesc.Usage          = USAGE_STAGING;
-                        BuffDesc.uiSizeInBytes  = pBuffer->GetTotalSize();
-                        RefCntAutoPtr<IBuffer> pStagingBuffer;
-                        m_pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer->m_pStagingBuffer);
-                    }
-
-                    PVoid CpuAddress = nullptr;
-                    pContext->MapBuffer(pBuffer->m_pStagingBuffer, MAP_WRITE, MAP_FLAG_DISCARD, CpuAddress);
-                    pBuffer->SetDataPtr(reinterpret_cast<Uint8*>(CpuAddress));
-
-                    pBuffer->SignalMapped();
-                }
-                break;
+                Region.DstX, Region.DstX + (SrcBox.MaxX - SrcBox.MinX),
+                Region.DstY, Region.DstY + (SrcBox.MaxY - SrcBox.MinY),
+                Region.DstZ, Region.DstZ + 1
+            };
 
-                case InternalData::PendingBufferOperation::Copy:
+            auto RegionRowSize = (SrcBox.MaxX - SrcBox.MinX + FmtAttribs.BlockWidth - 1) / Uint32{FmtAttribs.BlockWidth} * FmtAttribs.GetElementSize();
+            if (FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED && RegionRowSize != SrcStride)
+            {
+                // Compressed data must be tightly packed as GL does not use unpack row length 
+                // for compressed formats, so every row of blocks is uploaded separately
+                for (Uint32 y = DstBox.MinY; y < DstBox.MaxY; y += FmtAttribs.BlockHeight)
                 {
-                    const auto& TexDesc    = OperationInfo.pDstTexture->GetDesc();
-                    pContext->UnmapBuffer(pBuffer->m_pStagingBuffer, MAP_WRITE);
-                    for (Uint32 Slice = 0; Slice < UploadBuffDesc.ArraySize; ++Slice)
-                    {
-                        for (Uint32 Mip = 0; Mip < UploadBuffDesc.MipLevels; ++Mip)
-                        {
-                            auto SrcOffset = pBuffer->GetOffset(Mip, Slice);
-                            auto SrcStride = pBuffer->GetMappedData(Mip, Slice).Stride;
-                            TextureSubResData SubResData(pBuffer->m_pStagingBuffer, SrcOffset, SrcStride);
-                            auto MipLevelProps = GetMipLevelProperties(TexDesc, Mip);
-                            Box DstBox;
-                            DstBox.MaxX = MipLevelProps.LogicalWidth;
-                            DstBox.MaxY = MipLevelProps.LogicalHeight;
-                            pContext->UpdateTexture(OperationInfo.pDstTexture, OperationInfo.DstMip + Mip, OperationInfo.DstSlice + Slice, DstBox,
-                                                    SubResData, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-                        }
-                    }
-                    pBuffer->SignalCopyScheduled();
+                    TextureSubResData SubResData(pBuffer->m_pStagingBuffer, SrcOffset, RegionRowSize);
+                    Box RowBox{DstBox.MinX, DstBox.MaxX, y, std::min(y + FmtAttribs.BlockHeight, DstBox.MaxY), DstBox.MinZ, DstBox.MaxZ};
+                    pContext->UpdateTexture(Copy.pDstTexture, Region.DstMip, Region.DstSlice, RowBox,
+                                            SubResData, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+                    SrcOffset += SrcStride;
                 }
-                break;
+            }
+            else
+            {
+                TextureSubResData SubResData(pBuffer->m_pStagingBuffer, SrcOffset, SrcStride);
+                pContext->UpdateTexture(Copy.pDstTexture, Region.DstMip, Region.DstSlice, DstBox,
+                                        SubResData, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
             }
         }
-        m_pInternalData->m_InWorkOperations.clear();
+        pBuffer->SignalCopyScheduled();
+        return;
     }
+
+    for (Uint32 Slice = 0; Slice < UploadBuffDesc.ArraySize; ++Slice)
+    {
+        for (Uint32 Mip = 0; Mip < UploadBuffDesc.MipLevels; ++Mip)
+        {
+            auto SrcOffset = pBuffer->GetOffset(Mip, Slice);
+            auto SrcStride = pBuffer->GetMappedData(Mip, Slice).Stride;
+            TextureSubResData SubResData(pBuffer->m_pStagingBuffer, SrcOffset, SrcStride);
+            auto MipLevelProps = GetMipLevelProperties(TexDesc, Copy.DstMip + Mip);
+            Box DstBox;
+            DstBox.MaxX = MipLevelProps.LogicalWidth;
+            DstBox.MaxY = MipLevelProps.LogicalHeight;
+            pContext->UpdateTexture(Copy.pDstTexture, Copy.DstMip + Mip, Copy.DstSlice + Slice, DstBox,
+                                    SubResData, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        }
+    }
+    pBuffer->SignalCopyScheduled();
+}
+
+void TextureUploaderGL::CancelCopy(IDeviceContext* pContext, PendingCopy& Copy)
+{
+    auto* pBuffer = Copy.pUploadBuffer.RawPtr<UploadBufferGL>();
+    // The buffer is mapped again when it is reused
+    pContext->UnmapBuffer(pBuffer->m_pStagingBuffer, MAP_WRITE);
+    pBuffer->SignalCopyScheduled();
 }
 
 void TextureUploaderGL::AllocateUploadBuffer(const UploadBufferDesc& Desc, bool IsRenderThread, IUploadBuffer **ppBuffer)
@@ -302,6 +322,7 @@ void TextureUploaderGL::AllocateUploadBuffer(const UploadBufferDesc& Desc, bool
                 {
                     pUploadBuffer.Attach(Deque.front().Detach());
                     Deque.pop_front();
+                    OnUploadBufferReused();
                 }
             }
         }
@@ -310,6 +331,7 @@ void TextureUploaderGL::AllocateUploadBuffer(const UploadBufferDesc& Desc, bool
     if( !pUploadBuffer )
     {
         pUploadBuffer = MakeNewRCObj<UploadBufferGL>()(Desc);
+        OnUploadBufferCreated();
         LOG_INFO_MESSAGE("TextureUploaderGL: created upload buffer for ", Desc.Width, 'x', Desc.Height, 'x', Desc.Depth, ' ', Desc.MipLevels,  "-mip ",
                          m_pDevice->GetTextureFormatInfo(Desc.Format).Name, " texture");
     }
@@ -322,10 +344,11 @@ void TextureUploaderGL::AllocateUploadBuffer(const UploadBufferDesc& Desc, bool
 void TextureUploaderGL::ScheduleGPUCopy(ITexture *pDstTexture,
     Uint32 ArraySlice,
     Uint32 MipLevel,
-    IUploadBuffer *pUploadBuffer)
+    IUploadBuffer *pUploadBuffer,
+    UPLOAD_PRIORITY Priority)
 {
     auto *pUploadBufferGL = ValidatedCast<UploadBufferGL>(pUploadBuffer);
-    m_pInternalData->EnqueCopy(pUploadBufferGL, pDstTexture, ArraySlice, MipLevel);
+    EnqueueCopy(pUploadBufferGL, pDstTexture, ArraySlice, MipLevel, Priority);
 }
 
 void TextureUploaderGL::RecycleBuffer(IUploadBuffer *pUploadBuffer)
@@ -340,12 +363,10 @@ void TextureUploaderGL::RecycleBuffer(IUploadBuffer *pUploadBuffer)
     Deque.emplace_back( pUploadBufferGL );
 }
 
-TextureUploaderStats TextureUploaderGL::GetStats()
+Uint32 TextureUploaderGL::GetNumPendingMapOperations()
 {
-    TextureUploaderStats Stats;
-    std::lock_guard<std::mutex> QueueLock(m_pInternalData->m_PendingOperationsMtx);
-    Stats.NumPendingOperations = static_cast<Uint32>(m_pInternalData->m_PendingOperations.size());
-    return Stats;
+    std::lock_guard<std::mutex> QueueLock(m_pInternalData->m_PendingMapsMtx);
+    return static_cast<Uint32>(m_pInternalData->m_PendingMaps.size());
 }
 
 } // namespace Diligent
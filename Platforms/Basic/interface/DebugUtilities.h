@@ -33,7 +33,7 @@
 
 #define ASSERTION_FAILED(Message, ...)\
 do{                                         \
-    auto msg = Diligent::FormatString(Message, ##__VA_ARGS__);\
+    Diligent::FormattedString<> msg{Message, ##__VA_ARGS__};\
     DebugAssertionFailed( msg.c_str(), __FUNCTION__, __FILE__, __LINE__); \
 }while(false)
 
@@ -62,4 +62,16 @@ extern DebugMessageCallbackType DebugMessageCallback;
 ///       wants to use the callback.
 void SetDebugMessageCallback(DebugMessageCallbackType DbgMessageCallback);
 
+
+/// Minimum severity of the messages that are passed to the debug message callback.
+/// Messages with lower severity are discarded before they are formatted.
+/// Fatal errors are never discarded.
+extern DebugMessageSeverity MinDebugMessageSeverity;
+
+/// Sets the minimum debug message severity
+
+/// \note As SetDebugMessageCallback, this function needs to be called for
+///       every executable module.
+void SetMinDebugMessageSeverity(DebugMessageSeverity MinSeverity);
+
 }
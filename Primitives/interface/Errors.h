@@ -34,34 +34,40 @@ namespace Diligent
 {
 
 template<bool>
-void ThrowIf(std::string &&)
+void ThrowIf(const char*)
 {
 }
 
 template<>
-inline void ThrowIf<true>(std::string &&msg)
+inline void ThrowIf<true>(const char* msg)
 {
-    throw std::runtime_error( std::move(msg) );
+    throw std::runtime_error( msg );
 }
 
 template<bool bThrowException, typename... ArgsType>
 void LogError( const char *Function, const char *FullFilePath, int Line, const ArgsType&... Args )
 {
-    std::string FileName(FullFilePath);
-    auto LastSlashPos = FileName.find_last_of("/\\");
-    if(LastSlashPos != std::string::npos)
-        FileName.erase(0, LastSlashPos+1);
-    auto Msg = FormatString(Args...);
+    // Non-fatal errors below the minimum severity are not even formatted
+    if(!bThrowException && DebugMessageSeverity::Error < MinDebugMessageSeverity)
+        return;
+
+    const char* FileName = FullFilePath;
+    for (const char* c = FullFilePath; *c != 0; ++c)
+    {
+        if (*c == '/' || *c == '\\')
+            FileName = c + 1;
+    }
+    FormattedString<> Msg{Args...};
     if(DebugMessageCallback != nullptr)
     {
-        DebugMessageCallback( bThrowException ? DebugMessageSeverity::FatalError : DebugMessageSeverity::Error, Msg.c_str(), Function, FileName.c_str(), Line);
+        DebugMessageCallback( bThrowException ? DebugMessageSeverity::FatalError : DebugMessageSeverity::Error, Msg.c_str(), Function, FileName, Line);
     }
     else
     {
         // No callback set - output to cerr
-        std::cerr << "Diligent Engine: " << (bThrowException ? "Fatal Error" : "Error") << " in " << Function << "() (" << FileName << ", " << Line << "): " << Msg << '\n';
+        std::cerr << "Diligent Engine: " << (bThrowException ? "Fatal Error" : "Error") << " in " << Function << "() (" << FileName << ", " << Line << "): " << Msg.c_str() << '\n';
     }
-    ThrowIf<bThrowException>(std::move(Msg));
+    ThrowIf<bThrowException>(Msg.c_str());
 }
 
 }
@@ -93,8 +99,11 @@ do{                                     \
 
 #define LOG_DEBUG_MESSAGE(Severity, ...)\
 do{                                                     \
-    auto _msg = Diligent::FormatString( __VA_ARGS__ );\
-    if(Diligent::DebugMessageCallback != nullptr) Diligent::DebugMessageCallback( Severity, _msg.c_str(), nullptr, nullptr, 0 );\
+    if(Diligent::DebugMessageCallback != nullptr && Severity >= Diligent::MinDebugMessageSeverity)\
+    {                                                   \
+        Diligent::FormattedString<> _msg{ __VA_ARGS__ };\
+        Diligent::DebugMessageCallback( Severity, _msg.c_str(), nullptr, nullptr, 0 );\
+    }                                                   \
 }while(false)
 
 #define LOG_ERROR_MESSAGE(...)    LOG_DEBUG_MESSAGE(Diligent::DebugMessageSeverity::Error,   ##__VA_ARGS__)
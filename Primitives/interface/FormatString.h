@@ -25,6 +25,13 @@
 
 #include <sstream>
 #include <iomanip>
+#include <string>
+#include <cstring>
+#include <cstdio>
+#include <type_traits>
+#include <new>
+
+#include "BasicTypes.h"
 
 namespace Diligent
 {
@@ -46,14 +53,6 @@ namespace Diligent
         FormatStrSS( ss, RestArgs... ); // recursive call using pack expansion syntax
     }
 
-    template<typename... RestArgsType>
-    std::string FormatString(const RestArgsType&... Args)
-    {
-        std::stringstream ss;
-        FormatStrSS(ss, Args...);
-        return ss.str();
-    }
-
     template<typename Type>
     struct MemorySizeFormatter
     {
@@ -94,4 +93,359 @@ namespace Diligent
             ss << Arg.size << ( ((Arg.size & 0x01) == 0x01) ? " Byte" : " Bytes" );
         }
     }
+
+
+    /// Formats arguments into a caller-provided fixed-size buffer without allocating memory.
+
+    /// Strings, characters, integers, floating-point values, enums, pointers and
+    /// MemorySizeFormatter are formatted directly into the buffer (the dispatch is resolved
+    /// at compile time). All other types as well as stream manipulators (std::hex,
+    /// std::setprecision, etc.) are handled by std::ostream that writes into the same buffer.
+    /// The stream is only created when the first such argument is encountered, after which all
+    /// remaining arguments are formatted through the stream to respect its state.
+    /// Output that does not fit into the buffer is truncated.
+    class FixedStringFormatter
+    {
+    public:
+        FixedStringFormatter(Char* Buffer, size_t BufferSize) :
+            m_Buffer    {Buffer},
+            m_BufferSize{BufferSize},
+            m_StreamBuf {*this}
+        {
+            if (m_BufferSize != 0)
+                m_Buffer[0] = 0;
+        }
+
+        ~FixedStringFormatter()
+        {
+            if (m_pStream != nullptr)
+                m_pStream->~basic_ostream();
+        }
+
+        FixedStringFormatter             (const FixedStringFormatter&) = delete;
+        FixedStringFormatter& operator = (const FixedStringFormatter&) = delete;
+
+        void Append(const Char* Str, size_t Len)
+        {
+            m_RequiredLength += Len;
+            if (m_BufferSize == 0)
+            {
+                m_IsTruncated = m_IsTruncated || Len != 0;
+                return;
+            }
+
+            const auto Available = m_BufferSize - 1 - m_Length;
+            if (Len > Available)
+            {
+                Len           = Available;
+                m_IsTruncated = true;
+            }
+            memcpy(m_Buffer + m_Length, Str, Len);
+            m_Length += Len;
+            m_Buffer[m_Length] = 0;
+        }
+
+        void Append(const Char* Str)
+        {
+            if (Str != nullptr)
+                Append(Str, strlen(Str));
+        }
+
+        template<typename ArgType>
+        void AppendArg(const ArgType& Arg)
+        {
+            if (m_pStream != nullptr)
+                FormatStrSS(*m_pStream, Arg);
+            else
+                AppendArgImpl(Arg);
+        }
+
+        void AppendArgs()
+        {
+        }
+
+        template<typename FirstArgType, typename... RestArgsType>
+        void AppendArgs(const FirstArgType& FirstArg, const RestArgsType&... RestArgs)
+        {
+            AppendArg(FirstArg);
+            AppendArgs(RestArgs...);
+        }
+
+        const Char* GetString()   const { return m_BufferSize != 0 ? m_Buffer : ""; }
+        size_t      GetLength()   const { return m_Length; }
+        // Length of the string that would have been written if the buffer was large enough
+        size_t      GetRequiredLength() const { return m_RequiredLength; }
+        bool        IsTruncated() const { return m_IsTruncated; }
+
+    private:
+        class StreamBuf : public std::streambuf
+        {
+        public:
+            explicit StreamBuf(FixedStringFormatter& Formatter) :
+                m_Formatter{Formatter}
+            {}
+
+        protected:
+            virtual int_type overflow(int_type Ch)override final
+            {
+                if (!traits_type::eq_int_type(Ch, traits_type::eof()))
+                {
+                    const auto c = traits_type::to_char_type(Ch);
+                    m_Formatter.Append(&c, 1);
+                }
+                return traits_type::not_eof(Ch);
+            }
+
+            virtual std::streamsize xsputn(const char_type* Str, std::streamsize Count)override final
+            {
+                m_Formatter.Append(Str, static_cast<size_t>(Count));
+                return Count;
+            }
+
+        private:
+            FixedStringFormatter& m_Formatter;
+        };
+
+        std::ostream& GetStream()
+        {
+            if (m_pStream == nullptr)
+                m_pStream = new(&m_StreamStorage) std::ostream{&m_StreamBuf};
+            return *m_pStream;
+        }
+
+        template<typename UnsignedType>
+        void AppendUnsigned(UnsignedType Value, bool IsNegative)
+        {
+            Char  Digits[24]; // Enough for 64-bit integer and the sign
+            Char* pEnd  = Digits + sizeof(Digits);
+            Char* pCurr = pEnd;
+            do
+            {
+                *(--pCurr) = static_cast<Char>('0' + Value % 10u);
+                Value /= 10u;
+            } while (Value != 0);
+            if (IsNegative)
+                *(--pCurr) = '-';
+            Append(pCurr, static_cast<size_t>(pEnd - pCurr));
+        }
+
+        template<typename IntType>
+        void AppendInteger(IntType Value, std::true_type /*IsSigned*/)
+        {
+            using UnsignedType = typename std::make_unsigned<IntType>::type;
+            if (Value < 0)
+                AppendUnsigned(static_cast<UnsignedType>(UnsignedType{0} - static_cast<UnsignedType>(Value)), true);
+            else
+                AppendUnsigned(static_cast<UnsignedType>(Value), false);
+        }
+
+        template<typename IntType>
+        void AppendInteger(IntType Value, std::false_type /*IsSigned*/)
+        {
+            AppendUnsigned(Value, false);
+        }
+
+        template<typename IntType>
+        void AppendInteger(IntType Value)
+        {
+            AppendInteger(Value, std::is_signed<IntType>{});
+        }
+
+        void AppendFloat(double Value, int Precision, bool Fixed)
+        {
+            char Str[64];
+            auto Len = snprintf(Str, sizeof(Str), Fixed ? "%.*f" : "%.*g", Precision, Value);
+            if (Len < 0 || static_cast<size_t>(Len) >= sizeof(Str))
+            {
+                // Very large numbers in fixed notation do not fit into the local buffer
+                GetStream() << std::setprecision(Precision) << (Fixed ? std::fixed : std::defaultfloat) << Value;
+                *m_pStream << std::setprecision(6) << std::defaultfloat;
+            }
+            else
+                Append(Str, static_cast<size_t>(Len));
+        }
+
+        // Argument categories
+        struct StringArg{};
+        struct CharArg{};
+        struct BoolArg{};
+        struct IntegerArg{};
+        struct FloatArg{};
+        struct EnumArg{};
+        struct PointerArg{};
+        struct StreamArg{};
+
+        template<typename ArgType>
+        using ArgCategory =
+            typename std::conditional<std::is_same<ArgType, bool>::value, BoolArg,
+            typename std::conditional<std::is_same<ArgType, char>::value || std::is_same<ArgType, signed char>::value || std::is_same<ArgType, unsigned char>::value, CharArg,
+            typename std::conditional<std::is_integral<ArgType>::value, IntegerArg,
+            typename std::conditional<std::is_floating_point<ArgType>::value, FloatArg,
+            typename std::conditional<std::is_enum<ArgType>::value, EnumArg,
+            typename std::conditional<std::is_same<typename std::decay<ArgType>::type, char*>::value || std::is_same<typename std::decay<ArgType>::type, const char*>::value, StringArg,
+            typename std::conditional<std::is_pointer<ArgType>::value && !std::is_function<typename std::remove_pointer<ArgType>::type>::value, PointerArg,
+                                      StreamArg>::type>::type>::type>::type>::type>::type>::type;
+
+        template<typename ArgType>
+        void AppendArgImpl(const ArgType& Arg)
+        {
+            AppendArgImpl(Arg, ArgCategory<ArgType>{});
+        }
+
+        void AppendArgImpl(const std::string& Str)
+        {
+            Append(Str.c_str(), Str.length());
+        }
+
+        template<typename Type>
+        void AppendArgImpl(const MemorySizeFormatter<Type>& Arg)
+        {
+            auto ref_size = Arg.ref_size != 0 ? Arg.ref_size : Arg.size;
+            if (ref_size >= (1 << 30))
+            {
+                AppendFloat(static_cast<double>(Arg.size) / double{ 1 << 30 }, Arg.precision, true);
+                Append(" GB", 3);
+            }
+            else if(ref_size >= (1 << 20))
+            {
+                AppendFloat(static_cast<double>(Arg.size) / double{ 1 << 20 }, Arg.precision, true);
+                Append(" MB", 3);
+            }
+            else if (ref_size >= (1 << 10))
+            {
+                AppendFloat(static_cast<double>(Arg.size) / double{ 1 << 10 }, Arg.precision, true);
+                Append(" KB", 3);
+            }
+            else
+            {
+                AppendArgImpl(Arg.size);
+                Append( ((Arg.size & 0x01) == 0x01) ? " Byte" : " Bytes" );
+            }
+        }
+
+        template<typename ArgType>
+        void AppendArgImpl(const ArgType& Arg, StringArg)
+        {
+            Append(static_cast<const Char*>(Arg));
+        }
+
+        template<typename ArgType>
+        void AppendArgImpl(const ArgType& Arg, CharArg)
+        {
+            const auto c = static_cast<Char>(Arg);
+            Append(&c, 1);
+        }
+
+        template<typename ArgType>
+        void AppendArgImpl(const ArgType& Arg, BoolArg)
+        {
+            Append(Arg ? "1" : "0", 1);
+        }
+
+        template<typename ArgType>
+        void AppendArgImpl(const ArgType& Arg, IntegerArg)
+        {
+            AppendInteger(Arg);
+        }
+
+        template<typename ArgType>
+        void AppendArgImpl(const ArgType& Arg, FloatArg)
+        {
+            // Matches default std::ostream floating-point formatting
+            AppendFloat(static_cast<double>(Arg), 6, false);
+        }
+
+        template<typename ArgType>
+        void AppendArgImpl(const ArgType& Arg, EnumArg)
+        {
+            AppendInteger(static_cast<typename std::underlying_type<ArgType>::type>(Arg));
+        }
+
+        template<typename ArgType>
+        void AppendArgImpl(const ArgType& Arg, PointerArg)
+        {
+            static const Char HexDigits[] = "0123456789abcdef";
+            auto  Value = reinterpret_cast<size_t>(Arg);
+            Char  Digits[2 + sizeof(size_t) * 2];
+            Char* pEnd  = Digits + sizeof(Digits);
+            Char* pCurr = pEnd;
+            do
+            {
+                *(--pCurr) = HexDigits[Value & 0x0F];
+                Value >>= 4;
+            } while (Value != 0);
+            *(--pCurr) = 'x';
+            *(--pCurr) = '0';
+            Append(pCurr, static_cast<size_t>(pEnd - pCurr));
+        }
+
+        template<typename ArgType>
+        void AppendArgImpl(const ArgType& Arg, StreamArg)
+        {
+            FormatStrSS(GetStream(), Arg);
+        }
+
+        Char* const  m_Buffer;
+        const size_t m_BufferSize;
+        size_t       m_Length         = 0;
+        size_t       m_RequiredLength = 0;
+        bool         m_IsTruncated    = false;
+
+        StreamBuf     m_StreamBuf;
+        std::ostream* m_pStream = nullptr;
+        typename std::aligned_storage<sizeof(std::ostream), alignof(std::ostream)>::type m_StreamStorage;
+    };
+
+    /// Formats arguments into the caller-provided buffer without allocating memory.
+    /// The output is truncated if it does not fit into the buffer.
+
+    /// \\return Length of the formatted string, excluding the terminating null.
+    template<typename... ArgsType>
+    size_t FormatStringToBuffer(Char* Buffer, size_t BufferSize, const ArgsType&... Args)
+    {
+        FixedStringFormatter Formatter{Buffer, BufferSize};
+        Formatter.AppendArgs(Args...);
+        return Formatter.GetLength();
+    }
+
+    /// String formatted into the local buffer. Messages that do not fit
+    /// into the buffer are formatted into the heap-allocated string.
+    template<size_t BufferSize = 512>
+    class FormattedString
+    {
+    public:
+        template<typename... ArgsType>
+        explicit FormattedString(const ArgsType&... Args)
+        {
+            FixedStringFormatter Formatter{m_Buffer, BufferSize};
+            Formatter.AppendArgs(Args...);
+            m_Length = Formatter.GetLength();
+            if (Formatter.IsTruncated())
+            {
+                const auto RequiredLength = Formatter.GetRequiredLength();
+                m_LongString.resize(RequiredLength + 1);
+                FormatStringToBuffer(&m_LongString[0], m_LongString.size(), Args...);
+                m_LongString.resize(RequiredLength);
+            }
+        }
+
+        FormattedString             (const FormattedString&) = delete;
+        FormattedString& operator = (const FormattedString&) = delete;
+
+        const Char* c_str()  const { return m_LongString.empty() ? m_Buffer : m_LongString.c_str(); }
+        size_t      length() const { return m_LongString.empty() ? m_Length : m_LongString.length(); }
+
+        std::string str()const { return m_LongString.empty() ? std::string{m_Buffer, m_Length} : m_LongString; }
+
+    private:
+        Char        m_Buffer[BufferSize];
+        size_t      m_Length = 0;
+        std::string m_LongString;
+    };
+
+    template<typename... RestArgsType>
+    std::string FormatString(const RestArgsType&... Args)
+    {
+        return FormattedString<>{Args...}.str();
+    }
 }
@@ -33,4 +33,11 @@ void SetDebugMessageCallback(DebugMessageCallbackType DbgMessageCallback)
     DebugMessageCallback = DbgMessageCallback;
 }
 
+DebugMessageSeverity MinDebugMessageSeverity = DebugMessageSeverity::Info;
+
+void SetMinDebugMessageSeverity(DebugMessageSeverity MinSeverity)
+{
+    MinDebugMessageSeverity = MinSeverity;
+}
+
 }